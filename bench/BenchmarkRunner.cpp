@@ -0,0 +1,245 @@
+#include "BenchmarkRunner.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QRegularExpression>
+#include <QSysInfo>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+
+namespace DroneMapper {
+namespace Bench {
+
+namespace {
+
+constexpr qint64 MAX_ITERATIONS = qint64(1) << 30;
+
+struct Entry {
+    QString name;
+    BenchmarkRunner::Body body;
+};
+
+QVector<Entry>& registry()
+{
+    // Function-local so registration order across files does not matter
+    static QVector<Entry> entries;
+    return entries;
+}
+
+double median(QVector<double> values)
+{
+    if (values.isEmpty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const int middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+QString formatNs(double ns)
+{
+    if (ns >= 1e9) return QString::number(ns / 1e9, 'f', 2) + " s";
+    if (ns >= 1e6) return QString::number(ns / 1e6, 'f', 2) + " ms";
+    if (ns >= 1e3) return QString::number(ns / 1e3, 'f', 2) + " us";
+    return QString::number(ns, 'f', 1) + " ns";
+}
+
+} // namespace
+
+// BenchmarkContext implementation
+
+BenchmarkContext::BenchmarkContext(qint64 minSampleNs, int samples)
+    : m_minSampleNs(minSampleNs)
+    , m_sampleCount(samples)
+    , m_iterations(0)
+    , m_itemsPerIteration(0)
+{
+}
+
+void BenchmarkContext::measure(const std::function<void()>& operation)
+{
+    QElapsedTimer timer;
+
+    // Warm caches and lazy initialization
+    operation();
+
+    // Double the batch until one batch fills a sample
+    qint64 iterations = 1;
+    for (;;) {
+        timer.start();
+        for (qint64 i = 0; i < iterations; ++i) {
+            operation();
+        }
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        if (elapsed >= m_minSampleNs || iterations >= MAX_ITERATIONS) {
+            break;
+        }
+
+        // Jump close to the target instead of doubling from tiny batches
+        const double scale = elapsed > 0 ? 1.4 * m_minSampleNs / elapsed : 10.0;
+        iterations = std::min(MAX_ITERATIONS, std::max(iterations * 2, qint64(iterations * std::min(scale, 100.0))));
+    }
+
+    m_iterations = iterations;
+    m_samples.clear();
+    m_samples.reserve(m_sampleCount);
+
+    for (int sample = 0; sample < m_sampleCount; ++sample) {
+        timer.start();
+        for (qint64 i = 0; i < iterations; ++i) {
+            operation();
+        }
+        m_samples.append(double(timer.nsecsElapsed()) / iterations);
+    }
+}
+
+// BenchmarkRunner implementation
+
+void BenchmarkRunner::registerBenchmark(const QString& name, const Body& body)
+{
+    registry().append({ name, body });
+}
+
+QStringList BenchmarkRunner::names()
+{
+    QStringList result;
+    for (const Entry& entry : registry()) {
+        result.append(entry.name);
+    }
+    result.sort();
+    return result;
+}
+
+QJsonObject BenchmarkRunner::run(const Options& options)
+{
+    QTextStream err(stderr);
+    const QRegularExpression filter(options.filter);
+
+    QVector<Entry> entries = registry();
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+
+    QJsonArray results;
+
+    for (const Entry& entry : entries) {
+        if (!options.filter.isEmpty() && !filter.match(entry.name).hasMatch()) {
+            continue;
+        }
+
+        err << entry.name << " ... " << Qt::flush;
+
+        BenchmarkContext context(options.minSampleMs * 1000000, std::max(1, options.samples));
+        entry.body(context);
+
+        const QVector<double>& samples = context.sampleNsPerOp();
+        if (samples.isEmpty()) {
+            err << "no measurement\n";
+            continue;
+        }
+
+        double sum = 0.0;
+        for (double value : samples) {
+            sum += value;
+        }
+        const double mean = sum / samples.size();
+
+        double variance = 0.0;
+        for (double value : samples) {
+            variance += (value - mean) * (value - mean);
+        }
+        const double stddev = samples.size() > 1 ? std::sqrt(variance / (samples.size() - 1)) : 0.0;
+        const double medianNs = median(samples);
+
+        QJsonObject result;
+        result["name"] = entry.name;
+        result["iterations"] = context.iterations();
+        result["samples"] = samples.size();
+        result["median_ns"] = medianNs;
+        result["min_ns"] = *std::min_element(samples.begin(), samples.end());
+        result["mean_ns"] = mean;
+        result["stddev_ns"] = stddev;
+        if (context.itemsPerIteration() > 0 && medianNs > 0.0) {
+            result["items_per_second"] = context.itemsPerIteration() * 1e9 / medianNs;
+        }
+        if (!context.parameters().isEmpty()) {
+            result["parameters"] = context.parameters();
+        }
+        results.append(result);
+
+        err << formatNs(medianNs) << " (+/- " << QString::number(mean > 0 ? 100.0 * stddev / mean : 0.0, 'f', 1)
+            << "%)\n" << Qt::flush;
+    }
+
+    QJsonObject environment;
+    environment["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    environment["host"] = QSysInfo::machineHostName();
+    environment["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+    environment["os"] = QSysInfo::prettyProductName();
+    environment["qt_version"] = QString::fromLatin1(qVersion());
+#ifdef NDEBUG
+    environment["build"] = QStringLiteral("release");
+#else
+    environment["build"] = QStringLiteral("debug");
+#endif
+
+    QJsonObject document;
+    document["context"] = environment;
+    document["benchmarks"] = results;
+    return document;
+}
+
+int BenchmarkRunner::compare(const QJsonObject& current, const QJsonObject& baseline,
+                             double thresholdPercent, QString *report)
+{
+    QHash<QString, double> baselineMedians;
+    for (const QJsonValue& value : baseline["benchmarks"].toArray()) {
+        const QJsonObject result = value.toObject();
+        baselineMedians.insert(result["name"].toString(), result["median_ns"].toDouble());
+    }
+
+    QString text;
+    QTextStream out(&text);
+    out << QString("%1 %2 %3 %4\n")
+           .arg("Benchmark", -48).arg("Baseline", 12).arg("Current", 12).arg("Change", 9);
+
+    int regressions = 0;
+
+    for (const QJsonValue& value : current["benchmarks"].toArray()) {
+        const QJsonObject result = value.toObject();
+        const QString name = result["name"].toString();
+        const double currentNs = result["median_ns"].toDouble();
+
+        if (!baselineMedians.contains(name) || baselineMedians.value(name) <= 0.0) {
+            out << QString("%1 %2 %3 %4\n")
+                   .arg(name, -48).arg("-", 12).arg(formatNs(currentNs), 12).arg("new", 9);
+            continue;
+        }
+
+        const double baselineNs = baselineMedians.value(name);
+        const double change = 100.0 * (currentNs - baselineNs) / baselineNs;
+        const bool regressed = change > thresholdPercent;
+        if (regressed) {
+            regressions++;
+        }
+
+        out << QString("%1 %2 %3 %4%5\n")
+               .arg(name, -48)
+               .arg(formatNs(baselineNs), 12)
+               .arg(formatNs(currentNs), 12)
+               .arg(QString("%1%2%").arg(change >= 0 ? "+" : "").arg(change, 0, 'f', 1), 9)
+               .arg(regressed ? "  REGRESSION" : "");
+    }
+
+    out << QString("\n%1 regression(s) above %2%\n").arg(regressions).arg(thresholdPercent);
+    out.flush();
+
+    if (report) {
+        *report = text;
+    }
+    return regressions;
+}
+
+} // namespace Bench
+} // namespace DroneMapper
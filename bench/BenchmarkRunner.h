@@ -0,0 +1,146 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QJsonObject>
+#include <functional>
+
+namespace DroneMapper {
+namespace Bench {
+
+/**
+ * @brief Timing context passed to a benchmark body
+ *
+ * A benchmark builds its inputs, then calls measure() once with the
+ * operation under test. measure() picks an iteration count that fills
+ * the minimum sample time and records several samples; only the
+ * operation itself is timed.
+ */
+class BenchmarkContext {
+public:
+    BenchmarkContext(qint64 minSampleNs, int samples);
+
+    /**
+     * @brief Time an operation
+     * @param operation Called repeatedly; must not depend on earlier calls
+     */
+    void measure(const std::function<void()>& operation);
+
+    /**
+     * @brief Declare how many items one operation processes (for throughput)
+     */
+    void setItemsPerIteration(qint64 items) { m_itemsPerIteration = items; }
+
+    /**
+     * @brief Attach a descriptive value to the result (e.g. input size)
+     */
+    void setParameter(const QString& key, double value) { m_parameters.insert(key, value); }
+
+    const QVector<double>& sampleNsPerOp() const { return m_samples; }
+    qint64 iterations() const { return m_iterations; }
+    qint64 itemsPerIteration() const { return m_itemsPerIteration; }
+    const QJsonObject& parameters() const { return m_parameters; }
+
+private:
+    qint64 m_minSampleNs;
+    int m_sampleCount;
+    qint64 m_iterations;
+    qint64 m_itemsPerIteration;
+    QVector<double> m_samples;          // Nanoseconds per operation
+    QJsonObject m_parameters;
+};
+
+/**
+ * @brief Keep a computed value alive so the optimizer cannot drop it
+ */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Registry and driver for the benchmark suite
+ *
+ * Benchmarks register at static initialization through
+ * DRONEMAPPER_BENCHMARK. run() executes the ones matching a filter and
+ * returns results as JSON; compare() checks them against a baseline
+ * file written by an earlier run.
+ */
+class BenchmarkRunner {
+public:
+    using Body = std::function<void(BenchmarkContext&)>;
+
+    struct Options {
+        QString filter;             // Regular expression on names (empty = all)
+        qint64 minSampleMs;         // Minimum duration of one sample
+        int samples;                // Samples per benchmark
+
+        Options()
+            : minSampleMs(50)
+            , samples(5)
+        {}
+    };
+
+    static void registerBenchmark(const QString& name, const Body& body);
+    static QStringList names();
+
+    /**
+     * @brief Run matching benchmarks, printing progress to stderr
+     * @return JSON document object with a "benchmarks" array
+     */
+    static QJsonObject run(const Options& options);
+
+    /**
+     * @brief Compare results against a baseline
+     * @param current Output of run()
+     * @param baseline Output of an earlier run()
+     * @param thresholdPercent Median slowdown that counts as a regression
+     * @param report Receives a human-readable table
+     * @return Number of regressions
+     */
+    static int compare(const QJsonObject& current, const QJsonObject& baseline,
+                       double thresholdPercent, QString *report);
+
+private:
+    BenchmarkRunner() = delete; // Static class, no instantiation
+};
+
+/**
+ * @brief Registers a benchmark at static initialization
+ */
+struct BenchmarkRegistrar {
+    BenchmarkRegistrar(const char* name, const BenchmarkRunner::Body& body)
+    {
+        BenchmarkRunner::registerBenchmark(QString::fromLatin1(name), body);
+    }
+};
+
+} // namespace Bench
+} // namespace DroneMapper
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+
+/**
+ * Usage:
+ *   DRONEMAPPER_BENCHMARK("GeoUtils/distanceBetween")
+ *   {
+ *       auto coords = SyntheticData::coordinates(1000, 42);
+ *       context.measure([&]() { ... });
+ *   }
+ */
+#define DRONEMAPPER_BENCHMARK(name) \
+    static void BENCH_CONCAT(benchBody_, __LINE__)(DroneMapper::Bench::BenchmarkContext& context); \
+    static const DroneMapper::Bench::BenchmarkRegistrar BENCH_CONCAT(benchRegistrar_, __LINE__)( \
+        name, &BENCH_CONCAT(benchBody_, __LINE__)); \
+    static void BENCH_CONCAT(benchBody_, __LINE__)(DroneMapper::Bench::BenchmarkContext& context)
+
+#endif // BENCHMARKRUNNER_H
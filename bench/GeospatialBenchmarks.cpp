@@ -0,0 +1,98 @@
+#include "BenchmarkRunner.h"
+#include "SyntheticData.h"
+#include "geospatial/CoveragePatternGenerator.h"
+#include "geospatial/GeoUtils.h"
+#include "geospatial/KMZGenerator.h"
+#include <QTemporaryDir>
+
+using namespace DroneMapper;
+using namespace DroneMapper::Bench;
+
+namespace {
+
+constexpr quint64 SEED = 20240601;
+
+} // namespace
+
+DRONEMAPPER_BENCHMARK("GeoUtils/distanceBetween")
+{
+    const QList<Models::Waypoint> waypoints = SyntheticData::scatteredWaypoints(10000, 5000.0, SEED);
+    QVector<Models::GeospatialCoordinate> coords;
+    for (const Models::Waypoint& waypoint : waypoints) {
+        coords.append(waypoint.coordinate());
+    }
+
+    context.setItemsPerIteration(coords.size() - 1);
+    context.measure([&]() {
+        double total = 0.0;
+        for (int i = 1; i < coords.size(); ++i) {
+            total += Geospatial::GeoUtils::distanceBetween(coords[i - 1], coords[i]);
+        }
+        doNotOptimize(total);
+    });
+}
+
+DRONEMAPPER_BENCHMARK("GeoUtils/toCartesianRoundTrip")
+{
+    const QList<Models::Waypoint> waypoints = SyntheticData::scatteredWaypoints(10000, 5000.0, SEED);
+    const Models::GeospatialCoordinate origin = SyntheticData::origin();
+
+    context.setItemsPerIteration(waypoints.size());
+    context.measure([&]() {
+        double sum = 0.0;
+        for (const Models::Waypoint& waypoint : waypoints) {
+            const QPointF local = Geospatial::GeoUtils::toCartesian(waypoint.coordinate(), origin);
+            sum += Geospatial::GeoUtils::fromCartesian(local, origin).latitude();
+        }
+        doNotOptimize(sum);
+    });
+}
+
+DRONEMAPPER_BENCHMARK("GeoUtils/calculateArea")
+{
+    const SurveyArea area = SyntheticData::concavePolygon(2000, 0, 3000.0, SEED);
+
+    context.setParameter("vertices", area.outer.size());
+    context.measure([&]() {
+        doNotOptimize(Geospatial::GeoUtils::calculateArea(area.outer));
+        doNotOptimize(Geospatial::GeoUtils::calculateCentroid(area.outer));
+    });
+}
+
+// The generator has no notion of holes; the outer ring is the workload
+DRONEMAPPER_BENCHMARK("CoveragePatternGenerator/parallelLines/concave200")
+{
+    const SurveyArea area = SyntheticData::concavePolygon(200, 4, 1500.0, SEED);
+    Geospatial::CoveragePatternGenerator generator;
+
+    context.setParameter("vertices", area.outer.size());
+    context.measure([&]() {
+        doNotOptimize(generator.generateParallelLines(area.outer, 100.0, 35.0, 30.0, 70.0));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("CoveragePatternGenerator/grid/concave50")
+{
+    const SurveyArea area = SyntheticData::concavePolygon(50, 0, 800.0, SEED + 1);
+    Geospatial::CoveragePatternGenerator generator;
+
+    context.setParameter("vertices", area.outer.size());
+    context.measure([&]() {
+        doNotOptimize(generator.generateGrid(area.outer, 100.0, 25.0));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("KMZGenerator/generate/2000")
+{
+    const Models::FlightPlan plan = SyntheticData::lawnmowerPlan(2000, 1500.0, SEED);
+    QTemporaryDir directory;
+    const QString outputPath = directory.filePath("mission.kmz");
+    Geospatial::KMZGenerator generator;
+
+    context.setParameter("waypoints", plan.waypointCount());
+    context.setItemsPerIteration(plan.waypointCount());
+    context.measure([&]() {
+        doNotOptimize(generator.generateWithVisualization(plan, outputPath,
+                                                          Geospatial::WPMLWriter::DroneModel::Mavic3, true));
+    });
+}
@@ -0,0 +1,133 @@
+#include "BenchmarkRunner.h"
+#include "SyntheticData.h"
+#include "core/AltitudeSafetyChecker.h"
+#include "core/FlightPathOptimizer.h"
+#include "core/ImageManager.h"
+#include "core/MissionStatistics.h"
+#include "core/NoFlyZoneChecker.h"
+#include "ui/PlanValidationService.h"
+
+using namespace DroneMapper;
+using namespace DroneMapper::Bench;
+
+namespace {
+
+constexpr quint64 SEED = 20240602;
+
+} // namespace
+
+DRONEMAPPER_BENCHMARK("FlightPathOptimizer/nearestNeighbor2opt/300")
+{
+    const QList<Models::Waypoint> waypoints = SyntheticData::scatteredWaypoints(300, 2000.0, SEED);
+    const Core::OptimizationConfig config;
+
+    context.setParameter("waypoints", waypoints.size());
+    context.measure([&]() {
+        doNotOptimize(Core::FlightPathOptimizer::optimizeWaypoints(waypoints, SyntheticData::origin(), config));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("FlightPathOptimizer/windAware/300")
+{
+    const QList<Models::Waypoint> waypoints = SyntheticData::scatteredWaypoints(300, 2000.0, SEED);
+    Core::OptimizationConfig config;
+    config.optimizeForWind = true;
+    config.windSpeed = 8.0;
+    config.windDirection = 270.0;
+
+    context.setParameter("waypoints", waypoints.size());
+    context.measure([&]() {
+        doNotOptimize(Core::FlightPathOptimizer::optimizeWaypoints(waypoints, SyntheticData::origin(), config));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("FlightPathOptimizer/gridAware/lawnmower1000")
+{
+    const Models::FlightPlan plan = SyntheticData::lawnmowerPlan(1000, 1500.0, SEED);
+    Core::OptimizationConfig config;
+    config.strategy = "grid-aware";
+
+    context.setParameter("waypoints", plan.waypointCount());
+    context.measure([&]() {
+        doNotOptimize(Core::FlightPathOptimizer::optimizeFlightPlan(plan, config));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("NoFlyZoneChecker/checkFlightPlan/500zones")
+{
+    const Models::FlightPlan plan = SyntheticData::lawnmowerPlan(1000, 3000.0, SEED);
+    const Core::ZoneDatabase database = SyntheticData::zoneDatabase(500, 20000.0, SEED);
+
+    context.setParameter("waypoints", plan.waypointCount());
+    context.setParameter("zones", database.zones.size());
+    context.measure([&]() {
+        doNotOptimize(Core::NoFlyZoneChecker::checkFlightPlan(plan, database));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("NoFlyZoneChecker/checkPoint/5000zones")
+{
+    const QList<Models::Waypoint> points = SyntheticData::scatteredWaypoints(100, 20000.0, SEED);
+    const Core::ZoneDatabase database = SyntheticData::zoneDatabase(5000, 50000.0, SEED);
+
+    context.setParameter("zones", database.zones.size());
+    context.setItemsPerIteration(points.size());
+    context.measure([&]() {
+        int violations = 0;
+        for (const Models::Waypoint& waypoint : points) {
+            violations += Core::NoFlyZoneChecker::checkPoint(waypoint.coordinate(), 100.0, database).size();
+        }
+        doNotOptimize(violations);
+    });
+}
+
+DRONEMAPPER_BENCHMARK("PlanValidationService/runChecks/10k")
+{
+    // One background validation pass; the budget after an edit is 100 ms
+    const Models::FlightPlan plan = SyntheticData::lawnmowerPlan(10000, 5000.0, SEED);
+    const Core::ZoneDatabase database = SyntheticData::zoneDatabase(5000, 50000.0, SEED);
+    const Core::RegulatoryLimits limits = Core::RegulatoryLimits::getFAA();
+
+    context.setParameter("waypoints", plan.waypointCount());
+    context.setParameter("zones", database.zones.size());
+    context.measure([&]() {
+        doNotOptimize(UI::PlanValidationService::validate(plan, database, limits));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("AltitudeSafetyChecker/checkFlightPlan/2000")
+{
+    const Models::FlightPlan plan = SyntheticData::lawnmowerPlan(2000, 1500.0, SEED);
+    const Core::RegulatoryLimits limits = Core::RegulatoryLimits::getFAA();
+
+    context.setParameter("waypoints", plan.waypointCount());
+    context.measure([&]() {
+        doNotOptimize(Core::AltitudeSafetyChecker::checkFlightPlan(plan, limits));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("MissionStatistics/analyze/2000")
+{
+    const Models::FlightPlan plan = SyntheticData::lawnmowerPlan(2000, 1500.0, SEED);
+
+    context.setParameter("waypoints", plan.waypointCount());
+    context.measure([&]() {
+        doNotOptimize(Core::MissionStatistics::analyze(plan, plan.parameters()));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("ImageMetadata/qualityFilter/100k")
+{
+    const QVector<Core::ImageMetadata> images = SyntheticData::imageMetadata(100000, SEED);
+
+    context.setItemsPerIteration(images.size());
+    context.measure([&]() {
+        int accepted = 0;
+        for (const Core::ImageMetadata& metadata : images) {
+            if (metadata.hasGPS && Core::ImageManager::isAcceptableQuality(metadata)) {
+                accepted++;
+            }
+        }
+        doNotOptimize(accepted);
+    });
+}
@@ -0,0 +1,75 @@
+#include "BenchmarkRunner.h"
+#include "SyntheticData.h"
+#include "geospatial/DEMDifferenceAnalyzer.h"
+#include "ui/PointCloudViewer.h"
+#include "ui/TerrainElevationViewer.h"
+#include "ui/ViewshedAnalyzer.h"
+#include <QTemporaryDir>
+
+using namespace DroneMapper;
+using namespace DroneMapper::Bench;
+
+namespace {
+
+constexpr quint64 SEED = 20240603;
+
+} // namespace
+
+DRONEMAPPER_BENCHMARK("PointCloud/loadFromPLY/200k")
+{
+    UI::PointCloud source;
+    SyntheticData::pointCloud(source, 200000, SEED);
+
+    QTemporaryDir directory;
+    const QString path = directory.filePath("cloud.ply");
+    source.saveToPLY(path);
+
+    context.setItemsPerIteration(source.size());
+    context.measure([&]() {
+        UI::PointCloud cloud;
+        cloud.loadFromPLY(path);
+        doNotOptimize(cloud.size());
+    });
+}
+
+DRONEMAPPER_BENCHMARK("Octree/build/500k")
+{
+    UI::PointCloud cloud;
+    SyntheticData::pointCloud(cloud, 500000, SEED);
+
+    context.setItemsPerIteration(cloud.size());
+    context.measure([&]() {
+        UI::Octree octree;
+        octree.build(cloud, 100);
+        doNotOptimize(octree);
+    });
+}
+
+DRONEMAPPER_BENCHMARK("ViewshedAnalyzer/compute/1024")
+{
+    UI::DEMData dem;
+    SyntheticData::dem(dem, 1024, 1024, 5.0, SEED);
+
+    const UI::ViewshedAnalyzer::Observer observer(SyntheticData::origin(), 1.7);
+
+    context.setItemsPerIteration(qint64(dem.width) * dem.height);
+    context.measure([&]() {
+        doNotOptimize(UI::ViewshedAnalyzer::compute(dem, observer));
+    });
+}
+
+DRONEMAPPER_BENCHMARK("DEMDifferenceAnalyzer/difference/4M")
+{
+    UI::DEMData before;
+    UI::DEMData after;
+    SyntheticData::dem(before, 2048, 2048, 1.0, SEED);
+    SyntheticData::dem(after, 2048, 2048, 1.0, SEED + 1);
+    QVector<float> out(before.elevations.size());
+
+    context.setItemsPerIteration(out.size());
+    context.measure([&]() {
+        Geospatial::DEMDifferenceAnalyzer::difference(before.elevations.constData(), after.elevations.constData(),
+                                                      out.data(), out.size(), 0.05f);
+        doNotOptimize(out.constData()[0]);
+    });
+}
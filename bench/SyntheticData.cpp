@@ -0,0 +1,349 @@
+#include "SyntheticData.h"
+#include "geospatial/GeoUtils.h"
+#include "ui/PointCloudViewer.h"
+#include "ui/TerrainElevationViewer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace DroneMapper {
+namespace Bench {
+
+namespace {
+
+constexpr double ORIGIN_LATITUDE = 47.3769;
+constexpr double ORIGIN_LONGITUDE = 8.5417;
+constexpr double TWO_PI = 6.283185307179586;
+
+/**
+ * @brief SplitMix64: tiny, fast and identical on every platform
+ */
+class Random {
+public:
+    explicit Random(quint64 seed)
+        : m_state(seed)
+    {
+    }
+
+    quint64 next()
+    {
+        quint64 z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+    double uniform(double low, double high) { return low + (high - low) * uniform(); }
+    int integer(int low, int high) { return low + int(next() % quint64(high - low + 1)); }
+
+private:
+    quint64 m_state;
+};
+
+QPointF toLonLat(const QPointF& meters)
+{
+    const Models::GeospatialCoordinate coord = Geospatial::GeoUtils::fromCartesian(meters, SyntheticData::origin());
+    return QPointF(coord.longitude(), coord.latitude());
+}
+
+/**
+ * @brief Star-shaped ring in local meters
+ */
+QPolygonF starRing(Random& random, const QPointF& center, int vertices, double radius, double jaggedness)
+{
+    QPolygonF ring;
+    ring.reserve(vertices);
+
+    for (int i = 0; i < vertices; ++i) {
+        const double angle = TWO_PI * (i + random.uniform(-0.3, 0.3)) / vertices;
+        const double r = radius * (1.0 - jaggedness * random.uniform());
+        ring.append(center + QPointF(r * std::cos(angle), r * std::sin(angle)));
+    }
+    return ring;
+}
+
+/**
+ * @brief Smoothly interpolated lattice noise in [0, 1)
+ */
+double valueNoise(const QVector<double>& lattice, int latticeSize, double x, double y)
+{
+    const int x0 = int(std::floor(x));
+    const int y0 = int(std::floor(y));
+    const double fx = x - x0;
+    const double fy = y - y0;
+    const double sx = fx * fx * (3.0 - 2.0 * fx);
+    const double sy = fy * fy * (3.0 - 2.0 * fy);
+
+    auto at = [&](int ix, int iy) {
+        ix = ((ix % latticeSize) + latticeSize) % latticeSize;
+        iy = ((iy % latticeSize) + latticeSize) % latticeSize;
+        return lattice[iy * latticeSize + ix];
+    };
+
+    const double top = at(x0, y0) + (at(x0 + 1, y0) - at(x0, y0)) * sx;
+    const double bottom = at(x0, y0 + 1) + (at(x0 + 1, y0 + 1) - at(x0, y0 + 1)) * sx;
+    return top + (bottom - top) * sy;
+}
+
+} // namespace
+
+Models::GeospatialCoordinate SyntheticData::origin()
+{
+    return Models::GeospatialCoordinate(ORIGIN_LATITUDE, ORIGIN_LONGITUDE, 400.0);
+}
+
+SurveyArea SyntheticData::concavePolygon(int vertices, int holes, double radiusMeters, quint64 seed)
+{
+    Random random(seed);
+    SurveyArea area;
+
+    // Deep notches make the ring strongly concave
+    const QPolygonF outer = starRing(random, QPointF(0, 0), std::max(3, vertices), radiusMeters, 0.6);
+    for (const QPointF& point : outer) {
+        area.outer.append(toLonLat(point));
+    }
+
+    // Holes sit inside the guaranteed-solid core (40% of the radius)
+    const double holeRadius = radiusMeters * 0.4 / std::max(2.0, std::sqrt(double(holes)) * 2.0);
+    for (int h = 0; h < holes; ++h) {
+        const double angle = random.uniform(0.0, TWO_PI);
+        const double distance = random.uniform(0.0, radiusMeters * 0.4 - holeRadius);
+        const QPointF center(distance * std::cos(angle), distance * std::sin(angle));
+
+        QPolygonF hole;
+        for (const QPointF& point : starRing(random, center, random.integer(5, 12), holeRadius, 0.3)) {
+            hole.append(toLonLat(point));
+        }
+        area.holes.append(hole);
+    }
+
+    return area;
+}
+
+QList<Models::Waypoint> SyntheticData::scatteredWaypoints(int count, double radiusMeters, quint64 seed)
+{
+    Random random(seed);
+    QList<Models::Waypoint> waypoints;
+    waypoints.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        const double angle = random.uniform(0.0, TWO_PI);
+        const double r = radiusMeters * std::sqrt(random.uniform());
+        Models::GeospatialCoordinate coord = Geospatial::GeoUtils::fromCartesian(
+            QPointF(r * std::cos(angle), r * std::sin(angle)), origin());
+        coord.setAltitude(random.uniform(60.0, 120.0));
+
+        Models::Waypoint waypoint(coord);
+        waypoint.setWaypointNumber(i);
+        waypoint.setSpeed(8.0);
+        waypoints.append(waypoint);
+    }
+    return waypoints;
+}
+
+Models::FlightPlan SyntheticData::lawnmowerPlan(int waypoints, double radiusMeters, quint64 seed)
+{
+    Random random(seed);
+
+    Models::FlightPlan plan("Synthetic survey");
+    plan.setPatternType(Models::FlightPlan::PatternType::Polygon);
+    plan.parameters().setFlightAltitude(100.0);
+    plan.parameters().setFlightSpeed(8.0);
+
+    // Square rows x columns grid, boustrophedon order
+    const int columns = std::max(2, int(std::sqrt(double(waypoints))));
+    const int rows = std::max(1, waypoints / columns);
+    const double step = 2.0 * radiusMeters / columns;
+
+    for (int row = 0; row < rows; ++row) {
+        for (int i = 0; i < columns; ++i) {
+            const int column = row % 2 ? columns - 1 - i : i;
+            const QPointF meters(-radiusMeters + column * step, -radiusMeters + row * step);
+
+            Models::GeospatialCoordinate coord = Geospatial::GeoUtils::fromCartesian(meters, origin());
+            coord.setAltitude(100.0 + random.uniform(-5.0, 5.0));
+
+            Models::Waypoint waypoint(coord);
+            waypoint.setWaypointNumber(row * columns + i);
+            waypoint.setSpeed(8.0);
+            waypoint.addAction(Models::Waypoint::Action::TakePhoto);
+            plan.addWaypoint(waypoint);
+        }
+    }
+
+    QPolygonF area;
+    area << toLonLat(QPointF(-radiusMeters, -radiusMeters)) << toLonLat(QPointF(radiusMeters, -radiusMeters))
+         << toLonLat(QPointF(radiusMeters, radiusMeters)) << toLonLat(QPointF(-radiusMeters, radiusMeters));
+    plan.setSurveyArea(area);
+
+    return plan;
+}
+
+Core::ZoneDatabase SyntheticData::zoneDatabase(int zones, double radiusMeters, quint64 seed)
+{
+    Random random(seed);
+    Core::ZoneDatabase database;
+    database.region = "Synthetic";
+
+    for (int i = 0; i < zones; ++i) {
+        const double angle = random.uniform(0.0, TWO_PI);
+        const double distance = radiusMeters * std::sqrt(random.uniform());
+        const QPointF center(distance * std::cos(angle), distance * std::sin(angle));
+        const double zoneRadius = random.uniform(100.0, 1500.0);
+        const QString name = QString("Zone %1").arg(i);
+
+        if (i % 3 == 0) {
+            QList<Models::GeospatialCoordinate> boundary;
+            for (const QPointF& point : starRing(random, center, random.integer(6, 24), zoneRadius, 0.5)) {
+                boundary.append(Geospatial::GeoUtils::fromCartesian(point, origin()));
+            }
+            database.addZone(Core::NoFlyZoneChecker::createPolygonZone(boundary, name));
+        } else {
+            database.addZone(Core::NoFlyZoneChecker::createCircularZone(
+                Geospatial::GeoUtils::fromCartesian(center, origin()), zoneRadius, name));
+        }
+    }
+
+    return database;
+}
+
+void SyntheticData::dem(UI::DEMData& dem, int width, int height, double resolution, quint64 seed)
+{
+    Random random(seed);
+
+    constexpr int LATTICE = 64;
+    QVector<double> lattice(LATTICE * LATTICE);
+    for (double& value : lattice) {
+        value = random.uniform();
+    }
+
+    dem.width = width;
+    dem.height = height;
+    dem.resolution = resolution;
+    dem.elevations.resize(width * height);
+
+    // Five octaves over a 2 km base wavelength
+    const double baseFrequency = resolution / 2000.0;
+    float minElevation = std::numeric_limits<float>::max();
+    float maxElevation = std::numeric_limits<float>::lowest();
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            double elevation = 0.0;
+            double amplitude = 300.0;
+            double frequency = baseFrequency;
+            for (int octave = 0; octave < 5; ++octave) {
+                elevation += amplitude * valueNoise(lattice, LATTICE, x * frequency + octave * 17.0,
+                                                    y * frequency + octave * 31.0);
+                amplitude *= 0.45;
+                frequency *= 2.1;
+            }
+
+            const float value = float(400.0 + elevation);
+            dem.elevations[y * width + x] = value;
+            minElevation = std::min(minElevation, value);
+            maxElevation = std::max(maxElevation, value);
+        }
+    }
+
+    dem.minElevation = minElevation;
+    dem.maxElevation = maxElevation;
+
+    const double halfWidth = width * resolution / 2.0;
+    const double halfHeight = height * resolution / 2.0;
+    dem.topLeft = Geospatial::GeoUtils::fromCartesian(QPointF(-halfWidth, halfHeight), origin());
+    dem.bottomRight = Geospatial::GeoUtils::fromCartesian(QPointF(halfWidth, -halfHeight), origin());
+}
+
+void SyntheticData::pointCloud(UI::PointCloud& cloud, int points, quint64 seed)
+{
+    Random random(seed);
+
+    cloud.clear();
+    cloud.points.reserve(points);
+    cloud.hasColors = true;
+    cloud.hasNormals = false;
+
+    constexpr double EXTENT = 500.0;        // Meters
+    constexpr int BUILDINGS = 40;
+
+    struct Building {
+        double x, y, halfSize, height;
+    };
+    QVector<Building> buildings;
+    for (int i = 0; i < BUILDINGS; ++i) {
+        buildings.append({ random.uniform(-EXTENT, EXTENT), random.uniform(-EXTENT, EXTENT),
+                           random.uniform(5.0, 25.0), random.uniform(4.0, 40.0) });
+    }
+
+    for (int i = 0; i < points; ++i) {
+        const double x = random.uniform(-EXTENT, EXTENT);
+        const double y = random.uniform(-EXTENT, EXTENT);
+        double z = 8.0 * std::sin(x * 0.01) * std::cos(y * 0.013) + random.uniform(-0.05, 0.05);
+        int classification = 2;                 // Ground
+
+        for (const Building& building : buildings) {
+            if (std::abs(x - building.x) < building.halfSize && std::abs(y - building.y) < building.halfSize) {
+                z += building.height;
+                classification = 6;             // Building
+                break;
+            }
+        }
+
+        UI::Point point;
+        point.position = QVector3D(float(x), float(y), float(z));
+        point.classification = classification;
+        point.color = classification == 6 ? QColor(180, 90, 70) : QColor(90, 140, 60);
+        cloud.points.append(point);
+    }
+
+    cloud.calculateBounds();
+    cloud.calculateCentroid();
+}
+
+QVector<Core::ImageMetadata> SyntheticData::imageMetadata(int count, quint64 seed)
+{
+    Random random(seed);
+    QVector<Core::ImageMetadata> images;
+    images.reserve(count);
+
+    const QDateTime start(QDate(2024, 6, 1), QTime(10, 0), Qt::UTC);
+
+    for (int i = 0; i < count; ++i) {
+        Core::ImageMetadata metadata;
+        metadata.fileName = QString("DJI_%1.JPG").arg(i, 4, 10, QChar('0'));
+        metadata.filePath = "/synthetic/" + metadata.fileName;
+        metadata.fileSize = 8000000 + random.integer(0, 4000000);
+        metadata.captureTime = start.addMSecs(qint64(i) * 2000);
+        metadata.dimensions = QSize(5280, 3956);
+        metadata.cameraMake = "DJI";
+        metadata.cameraModel = "FC3582";
+        metadata.focalLength = 6.7;
+        metadata.aperture = 1.7;
+        metadata.iso = "100";
+        metadata.exposureTime = 1.0 / 1000.0;
+
+        // About 5% without a fix, 10% blurry
+        metadata.hasGPS = random.uniform() >= 0.05;
+        if (metadata.hasGPS) {
+            const double angle = random.uniform(0.0, TWO_PI);
+            const double r = 1000.0 * std::sqrt(random.uniform());
+            metadata.coordinate = Geospatial::GeoUtils::fromCartesian(
+                QPointF(r * std::cos(angle), r * std::sin(angle)), origin());
+        }
+        metadata.gimbalPitch = -90.0;
+        metadata.gimbalYaw = random.uniform(0.0, 360.0);
+        metadata.isBlurry = random.uniform() < 0.10;
+        metadata.sharpness = metadata.isBlurry ? random.uniform(5.0, 45.0) : random.uniform(40.0, 95.0);
+        metadata.blurScore = 100.0 - metadata.sharpness;
+        metadata.brightness = random.uniform(60.0, 200.0);
+
+        images.append(metadata);
+    }
+    return images;
+}
+
+} // namespace Bench
+} // namespace DroneMapper
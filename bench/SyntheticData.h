@@ -0,0 +1,95 @@
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+#include <QList>
+#include <QPolygonF>
+#include <QVector>
+#include "models/FlightPlan.h"
+#include "models/GeospatialCoordinate.h"
+#include "models/Waypoint.h"
+#include "core/ImageManager.h"
+#include "core/NoFlyZoneChecker.h"
+
+namespace DroneMapper {
+
+namespace UI {
+struct DEMData;
+struct PointCloud;
+}
+
+namespace Bench {
+
+/**
+ * @brief Survey area with holes (lon/lat, x = longitude)
+ */
+struct SurveyArea {
+    QPolygonF outer;
+    QVector<QPolygonF> holes;
+};
+
+/**
+ * @brief Deterministic generators for benchmark workloads
+ *
+ * Every generator takes a seed and produces the same data on every
+ * platform and standard library (the random source and distributions
+ * are implemented here, not taken from <random>). Geographic data is
+ * centred on origin().
+ */
+class SyntheticData {
+public:
+    /**
+     * @brief Centre of all generated geographic data
+     */
+    static Models::GeospatialCoordinate origin();
+
+    /**
+     * @brief Random concave (star-shaped) polygon with holes
+     * @param vertices Outer ring vertex count
+     * @param holes Number of holes, each well inside the outer ring
+     * @param radiusMeters Mean outer radius
+     * @param seed Random seed
+     */
+    static SurveyArea concavePolygon(int vertices, int holes, double radiusMeters, quint64 seed);
+
+    /**
+     * @brief Waypoints scattered uniformly in a disc
+     */
+    static QList<Models::Waypoint> scatteredWaypoints(int count, double radiusMeters, quint64 seed);
+
+    /**
+     * @brief Lawnmower flight plan with altitude jitter
+     * @param waypoints Approximate waypoint count
+     */
+    static Models::FlightPlan lawnmowerPlan(int waypoints, double radiusMeters, quint64 seed);
+
+    /**
+     * @brief Mixed circular and polygon zones around origin()
+     * @param zones Zone count (about a third are polygons)
+     * @param radiusMeters Zones are spread over this radius
+     */
+    static Core::ZoneDatabase zoneDatabase(int zones, double radiusMeters, quint64 seed);
+
+    /**
+     * @brief Fractal (multi-octave value noise) terrain
+     * @param resolution Ground sample distance in meters
+     */
+    static void dem(UI::DEMData& dem, int width, int height, double resolution, quint64 seed);
+
+    /**
+     * @brief Terrain surface with box "buildings" and noise
+     */
+    static void pointCloud(UI::PointCloud& cloud, int points, quint64 seed);
+
+    /**
+     * @brief Image catalog entries; some lack GPS or are blurry
+     */
+    static QVector<Core::ImageMetadata> imageMetadata(int count, quint64 seed);
+
+private:
+    SyntheticData() = delete; // Static class, no instantiation
+};
+
+} // namespace Bench
+} // namespace DroneMapper
+
+#endif // SYNTHETICDATA_H
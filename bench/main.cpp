@@ -0,0 +1,101 @@
+#include "BenchmarkRunner.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+
+using DroneMapper::Bench::BenchmarkRunner;
+
+namespace {
+
+bool readJson(const QString& path, QJsonObject& object, QString& error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QString("Cannot read %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!document.isObject()) {
+        error = QString("Invalid benchmark JSON in %1: %2").arg(path, parseError.errorString());
+        return false;
+    }
+
+    object = document.object();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dronemapper_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("DroneMapper microbenchmarks on deterministic synthetic workloads.");
+    parser.addHelpOption();
+
+    QCommandLineOption listOption("list", "List benchmark names and exit.");
+    QCommandLineOption filterOption("filter", "Run benchmarks whose name matches <regex>.", "regex");
+    QCommandLineOption jsonOption("json", "Write results as JSON to <file> (default: stdout).", "file");
+    QCommandLineOption baselineOption("baseline", "Compare against results in <file>; exit 1 on regression.", "file");
+    QCommandLineOption thresholdOption("threshold", "Median slowdown in percent that counts as a regression.",
+                                       "percent", "10");
+    QCommandLineOption minTimeOption("min-time", "Minimum duration of one sample in ms.", "ms", "50");
+    QCommandLineOption samplesOption("samples", "Samples per benchmark.", "count", "5");
+    parser.addOptions({ listOption, filterOption, jsonOption, baselineOption,
+                        thresholdOption, minTimeOption, samplesOption });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (parser.isSet(listOption)) {
+        for (const QString& name : BenchmarkRunner::names()) {
+            out << name << '\n';
+        }
+        return 0;
+    }
+
+    // Read the baseline first so a bad path fails before a long run
+    QJsonObject baseline;
+    if (parser.isSet(baselineOption)) {
+        QString error;
+        if (!readJson(parser.value(baselineOption), baseline, error)) {
+            err << error << '\n';
+            return 2;
+        }
+    }
+
+    BenchmarkRunner::Options options;
+    options.filter = parser.value(filterOption);
+    options.minSampleMs = qMax(1, parser.value(minTimeOption).toInt());
+    options.samples = qMax(1, parser.value(samplesOption).toInt());
+
+    const QJsonObject results = BenchmarkRunner::run(options);
+    const QByteArray json = QJsonDocument(results).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(jsonOption)) {
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+            err << "Cannot write " << file.fileName() << ": " << file.errorString() << '\n';
+            return 2;
+        }
+    } else if (!parser.isSet(baselineOption)) {
+        out << json;
+    }
+
+    if (parser.isSet(baselineOption)) {
+        QString report;
+        const int regressions = BenchmarkRunner::compare(results, baseline,
+                                                         parser.value(thresholdOption).toDouble(), &report);
+        out << report;
+        return regressions > 0 ? 1 : 0;
+    }
+
+    return 0;
+}
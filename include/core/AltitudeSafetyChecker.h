@@ -6,6 +6,7 @@
 #include "GeospatialCoordinate.h"
 #include <QList>
 #include <QString>
+#include <atomic>
 
 namespace DroneMapper {
 namespace Core {
@@ -115,13 +116,20 @@ public:
 
     /**
      * @brief Perform comprehensive safety check on flight plan
+     *
+     * Waypoints are walked once; altitude changes come from
+     * plan.geometry().
+     *
      * @param plan Flight plan to check
      * @param limits Regulatory limits to enforce
+     * @param cancelled Polled once per waypoint; when set the check
+     *                  stops and the result is incomplete
      * @return Safety check results with all violations
      */
     static SafetyCheckResult checkFlightPlan(
         const Models::FlightPlan& plan,
-        const RegulatoryLimits& limits = RegulatoryLimits::getDefaults());
+        const RegulatoryLimits& limits = RegulatoryLimits::getDefaults(),
+        const std::atomic<bool>* cancelled = nullptr);
 
     /**
      * @brief Check single waypoint for safety
@@ -3,8 +3,10 @@
 
 #include "FlightPlan.h"
 #include "MissionParameters.h"
+#include "ProjectedPlan.h"
 #include <QList>
 #include <QString>
+#include <atomic>
 
 namespace DroneMapper {
 namespace Core {
@@ -112,6 +114,25 @@ public:
         const BatteryProfile& profile,
         const Models::GeospatialCoordinate& homePoint);
 
+    /**
+     * @brief Split mission into sub-missions using a shared projection
+     *
+     * Return-to-home distances are read from the projection, whose
+     * origin is the launch/landing location.
+     *
+     * @param plan Original flight plan
+     * @param profile Battery profile
+     * @param projection The plan's waypoints projected around the home point
+     * @param cancelled Polled once per waypoint; when set the split
+     *                  stops and the result is incomplete
+     * @return List of sub-missions, one per battery
+     */
+    static QList<SubMission> splitMissionForBatteries(
+        const Models::FlightPlan& plan,
+        const BatteryProfile& profile,
+        const ProjectedPlan& projection,
+        const std::atomic<bool>* cancelled = nullptr);
+
     /**
      * @brief Find optimal RTH (return-to-home) point in waypoint sequence
      * @param waypoints List of waypoints
@@ -163,15 +184,12 @@ public:
         const QList<SubMission>& subMissions);
 
 private:
-    static double calculateSegmentTime(
-        const Models::Waypoint& from,
-        const Models::Waypoint& to,
-        double speed);
-
     static double calculateReturnTime(
         const Models::GeospatialCoordinate& position,
         const Models::GeospatialCoordinate& home,
         double speed);
+
+    static double returnTimeForDistance(double distance, double speed);
 };
 
 } // namespace Core
@@ -6,18 +6,40 @@
 #include <QString>
 #include <QSqlDatabase>
 #include <QList>
+#include <QFuture>
+#include <functional>
 
 namespace DroneMapper {
 namespace Core {
 
 /**
  * @brief Manages SQLite database for projects and flight plans
+ *
+ * initializeAsync() creates the file and schema on a worker thread so
+ * startup does not wait on disk I/O; the connection used by the other
+ * methods is then opened on the calling (GUI) thread, as QSqlDatabase
+ * connections are bound to their thread. Any operation called before
+ * that finishes waits for it.
  */
 class DatabaseManager {
 public:
     static DatabaseManager& instance();
 
     bool initialize(const QString& dbPath);
+
+    /**
+     * @brief Start initialization on a worker thread
+     * @param dbPath Database file (parent directories are created)
+     * @param onReady Called on the calling thread when done, with success
+     */
+    void initializeAsync(const QString& dbPath, std::function<void(bool)> onReady = nullptr);
+
+    /**
+     * @brief Finish a pending asynchronous initialization, blocking if needed
+     * @return True if the database is ready
+     */
+    bool waitForInitialized();
+
     bool isInitialized() const { return m_initialized; }
 
     // Project operations
@@ -44,12 +66,17 @@ private:
     DatabaseManager(const DatabaseManager&) = delete;
     DatabaseManager& operator=(const DatabaseManager&) = delete;
 
-    bool createTables();
-    bool executeSql(const QString& sql);
+    bool openConnection(const QString& dbPath);
+    static bool createTables(QSqlDatabase& database, QString* error);
+    static bool executeSql(QSqlDatabase& database, const QString& sql, QString* error);
 
     QSqlDatabase m_database;
     bool m_initialized;
     QString m_lastError;
+
+    // Pending asynchronous initialization (error text, empty on success)
+    QFuture<QString> m_pendingInit;
+    QString m_pendingPath;
 };
 
 } // namespace Core
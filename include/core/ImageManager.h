@@ -137,6 +137,19 @@ public:
      */
     QVector<ImageMetadata> images() const { return m_images; }
 
+    /**
+     * @brief Get number of images in the collection
+     * @return Image count
+     */
+    int imageCount() const { return m_images.size(); }
+
+    /**
+     * @brief Get image by collection index, without copying
+     * @param index Index in [0, imageCount())
+     * @return Image metadata
+     */
+    const ImageMetadata& imageAt(int index) const { return m_images[index]; }
+
     /**
      * @brief Get image by path
      * @param filePath Image file path
@@ -162,6 +175,13 @@ public:
      */
     ImageCollectionStats statistics() const;
 
+    /**
+     * @brief Check whether an image passes the quality filter
+     * @param metadata Image metadata
+     * @return True if sharp enough and not blurry
+     */
+    static bool isAcceptableQuality(const ImageMetadata& metadata);
+
     /**
      * @brief Assess image quality
      * @param filePath Image file path
@@ -217,6 +237,11 @@ signals:
      */
     void imageRemoved(const QString& filePath);
 
+    /**
+     * @brief Emitted when all images are cleared
+     */
+    void imagesCleared();
+
 private:
     QVector<ImageMetadata> m_images;
     QMap<QString, int> m_imageIndex;  // filePath -> index in m_images
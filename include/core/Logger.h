@@ -1,16 +1,32 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "MpscRingBuffer.h"
 #include <QString>
 #include <QFile>
-#include <QTextStream>
-#include <QMutex>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace DroneMapper {
 namespace Core {
 
 /**
  * @brief Application-wide logging system
+ *
+ * Logging is asynchronous: log() only stamps the time and pushes the
+ * raw message into a lock-free MPSC ring buffer, so worker threads
+ * never wait on each other or on disk. A background writer thread
+ * formats queued records and writes them in batches, with one flush
+ * per batch, rotating the file when it exceeds the size limit.
+ *
+ * When the buffer is full, debug and info messages are dropped (and
+ * counted); warnings and above wait for space. critical() and flush()
+ * block until everything queued is on disk, and installCrashHandler()
+ * makes fatal signals flush before the process dies. The signal handler
+ * itself only formats a record into a preallocated buffer and writes a
+ * byte to a pipe; a watcher thread does the flushing.
  */
 class Logger {
 public:
@@ -34,21 +50,77 @@ public:
     void setLogFile(const QString& filePath);
     void setLogLevel(Level level);
 
+    /**
+     * @brief Configure size-based rotation
+     * @param maxFileSize Rotate when the file would exceed this (bytes)
+     * @param maxBackups Rotated files kept (name.1 is the newest)
+     */
+    void setRotation(qint64 maxFileSize, int maxBackups);
+
+    /**
+     * @brief Block until all queued messages are written and flushed
+     */
+    void flush();
+
+    /**
+     * @brief Flush the log on SIGSEGV, SIGABRT, SIGFPE, SIGILL (and SIGBUS)
+     *
+     * Call once, early in main(); starts the crash watcher thread.
+     */
+    static void installCrashHandler();
+
     QString logFilePath() const { return m_logFilePath; }
 
 private:
+    struct Record {
+        qint64 timestamp;       // ms since epoch
+        Level level;
+        QString message;
+        QString category;
+    };
+
     Logger();
     ~Logger();
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    void writeToFile(const QString& message);
+    void writerLoop();
+    void drainQueue();
+    void writeBatch(const QByteArray& batch);
+    void rotate();
+    void wakeWriter();
+    QByteArray formatRecord(const Record& record);
+    void crashWatcherLoop();
+
+    static void handleCrashSignal(int signal);
 
     QString m_logFilePath;
-    Level m_minimumLevel;
+    std::atomic<Level> m_minimumLevel;
     QFile m_logFile;
-    QTextStream m_logStream;
-    QMutex m_mutex;
+    qint64 m_maxFileSize;
+    int m_maxBackups;
+    std::mutex m_fileMutex;             // Guards the file and rotation settings
+
+    MpscRingBuffer<Record> m_queue;
+    std::atomic<quint64> m_dropped;
+
+    // Writer thread
+    std::thread m_writer;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    std::atomic<bool> m_writerSleeping;
+    std::atomic<bool> m_stopping;
+    quint64 m_flushRequests;            // Guarded by m_wakeMutex
+    quint64 m_flushesDone;
+
+    // Crash watcher, woken through m_crashPipe by the signal handler
+    std::thread m_crashWatcher;
+    int m_crashPipe[2];                 // Read end, write end (-1 until installed)
+
+    // Writer-only timestamp cache (ISO format has second resolution)
+    qint64 m_cachedSecond;
+    QByteArray m_cachedTimestamp;
 };
 
 } // namespace Core
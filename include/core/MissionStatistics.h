@@ -247,12 +247,6 @@ private:
         double frontOverlap,
         double sideOverlap);
 
-    static int calculateTurnCount(
-        const QList<Models::Waypoint>& waypoints);
-
-    static double calculateAvgTurnAngle(
-        const QList<Models::Waypoint>& waypoints);
-
     static double calculateCoverageQuality(
         const Models::FlightPlan& plan,
         const Models::MissionParameters& params);
@@ -0,0 +1,129 @@
+#ifndef MPSCRINGBUFFER_H
+#define MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace DroneMapper {
+namespace Core {
+
+/**
+ * @brief Bounded lock-free multi-producer, single-consumer queue
+ *
+ * Each slot carries a sequence number that tells producers and the
+ * consumer whether it is free or filled, so pushes from any number of
+ * threads only contend on one atomic counter and never block. A full
+ * queue makes tryPush() fail instead of waiting.
+ *
+ * Only one thread may call tryPop().
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    /**
+     * @brief Create a queue
+     * @param capacity Slot count, rounded up to a power of two
+     */
+    explicit MpscRingBuffer(std::size_t capacity)
+        : m_capacity(roundUpToPowerOfTwo(capacity))
+        , m_mask(m_capacity - 1)
+        , m_slots(new Slot[m_capacity])
+        , m_enqueuePos(0)
+        , m_dequeuePos(0)
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * @brief Enqueue an item (any thread)
+     * @return False if the queue is full; the item is left untouched
+     */
+    bool tryPush(T&& item)
+    {
+        std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Slot& slot = m_slots[pos & m_mask];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                // Slot free for this position; claim it
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(item);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // Consumer has not freed it yet: full
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Dequeue an item (consumer thread only)
+     * @return False if the queue is empty
+     */
+    bool tryPop(T& item)
+    {
+        Slot& slot = m_slots[m_dequeuePos & m_mask];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(m_dequeuePos + 1) < 0) {
+            return false;
+        }
+
+        item = std::move(slot.value);
+        slot.value = T();
+        slot.sequence.store(m_dequeuePos + m_capacity, std::memory_order_release);
+        ++m_dequeuePos;
+        return true;
+    }
+
+    /**
+     * @brief Check for queued items (consumer thread only)
+     */
+    bool isEmpty() const
+    {
+        return m_enqueuePos.load(std::memory_order_acquire) == m_dequeuePos;
+    }
+
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+
+    alignas(64) std::atomic<std::size_t> m_enqueuePos;
+    alignas(64) std::size_t m_dequeuePos;       // Consumer only
+};
+
+} // namespace Core
+} // namespace DroneMapper
+
+#endif // MPSCRINGBUFFER_H
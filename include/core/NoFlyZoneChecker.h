@@ -3,10 +3,12 @@
 
 #include "FlightPlan.h"
 #include "GeospatialCoordinate.h"
+#include "ProjectedPlan.h"
 #include <QString>
 #include <QList>
 #include <QPolygonF>
 #include <QRectF>
+#include <atomic>
 
 namespace DroneMapper {
 namespace Core {
@@ -135,6 +137,26 @@ public:
         const Models::FlightPlan& plan,
         const ZoneDatabase& database);
 
+    /**
+     * @brief Check flight plan for zone violations in local meters
+     *
+     * Active zones are projected once around the projection's origin;
+     * waypoints and legs are tested against zones whose extent reaches
+     * them.
+     *
+     * @param plan Flight plan to check
+     * @param database Zone database
+     * @param projection The plan's waypoints projected to local meters
+     * @param cancelled Polled once per waypoint and leg; when set the
+     *                  check stops and the result is incomplete
+     * @return Check result with violations
+     */
+    static NoFlyCheckResult checkFlightPlan(
+        const Models::FlightPlan& plan,
+        const ZoneDatabase& database,
+        const ProjectedPlan& projection,
+        const std::atomic<bool>* cancelled = nullptr);
+
     /**
      * @brief Check single point against zones
      * @param location Location to check
@@ -0,0 +1,60 @@
+#ifndef PROJECTEDPLAN_H
+#define PROJECTEDPLAN_H
+
+#include "FlightPlan.h"
+#include "GeospatialCoordinate.h"
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+namespace DroneMapper {
+namespace Core {
+
+/**
+ * @brief Flight plan waypoints in local meters, projected once
+ *
+ * Features:
+ * - Every waypoint projected around one origin with
+ *   GeoUtils::toCartesian, so distances from the origin are exact
+ * - Projected bounds of the whole plan
+ * - Shared by the validation stages (zone prefilter, no-fly check,
+ *   battery split) instead of each re-projecting the waypoints; leg
+ *   lengths and climbs still come from plan.geometry()
+ *
+ * Usage:
+ *   ProjectedPlan projection(plan, homePoint);
+ *   auto noFly = NoFlyZoneChecker::checkFlightPlan(plan, zones, projection);
+ *   auto batteries = BatteryManager::splitMissionForBatteries(plan, profile, projection);
+ */
+class ProjectedPlan {
+public:
+    ProjectedPlan();
+
+    /**
+     * @brief Project every waypoint of a plan
+     * @param plan Flight plan
+     * @param origin Projection origin (usually the home point)
+     */
+    ProjectedPlan(const Models::FlightPlan& plan, const Models::GeospatialCoordinate& origin);
+
+    /**
+     * @brief Project one more location around the same origin
+     */
+    QPointF project(const Models::GeospatialCoordinate& coordinate) const;
+
+    const Models::GeospatialCoordinate& origin() const { return m_origin; }
+    const QVector<QPointF>& points() const { return m_points; }
+    QRectF bounds() const { return m_bounds; }
+    int count() const { return m_points.size(); }
+    bool isEmpty() const { return m_points.isEmpty(); }
+
+private:
+    Models::GeospatialCoordinate m_origin;
+    QVector<QPointF> m_points;      // One per waypoint (meters east, north of the origin)
+    QRectF m_bounds;
+};
+
+} // namespace Core
+} // namespace DroneMapper
+
+#endif // PROJECTEDPLAN_H
@@ -6,6 +6,7 @@
 #include <QDateTime>
 #include "models/FlightPlan.h"
 #include "models/MissionParameters.h"
+#include "geospatial/DEMDifferenceAnalyzer.h"
 
 namespace DroneMapper {
 namespace Core {
@@ -33,6 +34,7 @@ struct ReportSections {
     bool includeSafetyAnalysis;
     bool includeEquipment;
     bool includePhotogrammetryPlan;
+    bool includeVolumeChange;       // Only rendered when ReportOptions::volumeChange is valid
     bool includeAppendices;
 
     ReportSections();
@@ -57,6 +59,8 @@ struct ReportOptions {
 
     ReportSections sections;
 
+    Geospatial::VolumeChangeSummary volumeChange;  // Earthworks cut/fill between epochs
+
     ReportOptions();
 };
 
@@ -73,6 +77,7 @@ struct ReportOptions {
  * - Safety analysis and risk assessment
  * - Equipment checklist
  * - Photogrammetry quality predictions
+ * - Earthworks volume change (DEM of difference)
  * - Regulatory compliance notes
  *
  * Usage:
@@ -151,6 +156,7 @@ private:
     QString generateSafetyAnalysis(const Models::FlightPlan& plan);
     QString generateEquipmentList(const Models::FlightPlan& plan);
     QString generatePhotogrammetryPlan(const Models::FlightPlan& plan);
+    QString generateVolumeChange(const Geospatial::VolumeChangeSummary& summary);
 
     // Helper methods
     QImage generateMapImage(const Models::FlightPlan& plan, int width, int height);
@@ -0,0 +1,54 @@
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QString>
+
+namespace DroneMapper {
+namespace Core {
+
+/**
+ * @brief Logs the duration of each application startup phase
+ *
+ * Each mark() logs the time since the previous mark and since start().
+ * finish() marks the application interactive and warns if startup
+ * exceeded the budget. Marks after finish() (e.g. deferred WebEngine
+ * start) are logged but do not count against it. GUI thread only.
+ *
+ * Usage:
+ *   StartupProfiler::start();
+ *   ...
+ *   StartupProfiler::mark("Main window constructed");
+ *   ...
+ *   StartupProfiler::finish();
+ */
+class StartupProfiler {
+public:
+    static constexpr qint64 BUDGET_MS = 1000;
+
+    /**
+     * @brief Start timing (first thing in main)
+     */
+    static void start();
+
+    /**
+     * @brief Log the end of a startup phase
+     * @param phase Phase name
+     */
+    static void mark(const QString& phase);
+
+    /**
+     * @brief Mark the application interactive
+     */
+    static void finish();
+
+    static qint64 elapsedMs();
+    static bool isFinished();
+
+private:
+    StartupProfiler() = delete; // Static class, no instantiation
+};
+
+} // namespace Core
+} // namespace DroneMapper
+
+#endif // STARTUPPROFILER_H
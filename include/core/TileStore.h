@@ -0,0 +1,129 @@
+#ifndef TILESTORE_H
+#define TILESTORE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QMutex>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace DroneMapper {
+namespace Core {
+
+/**
+ * @brief Single-file tile cache in MBTiles layout (SQLite)
+ *
+ * Features:
+ * - Standard MBTiles schema (metadata + tiles), readable by GDAL, QGIS
+ *   and MapLibre tooling; tiles addressed in XYZ, stored as TMS rows
+ * - Extra "resources" table for non-tile assets (scripts, styles,
+ *   glyphs) keyed by their upstream URL
+ * - Prepared statements and a memory-mapped database file, so reads
+ *   come straight from the page cache into the returned buffer
+ * - Optional byte budget; least recently read entries are evicted
+ *   once the stored data exceeds it
+ * - Expiry time per entry (from the upstream Cache-Control), so
+ *   callers can refetch stale data and still fall back to it offline
+ * - Safe to use from several threads (one connection, serialized)
+ *
+ * Usage:
+ *   TileStore store;
+ *   store.open(cacheDir + "/satellite.mbtiles");
+ *   store.setByteBudget(512 * 1024 * 1024);
+ *   bool stale = false;
+ *   QByteArray png = store.tile(14, 2620, 6331, &stale);
+ */
+class TileStore {
+public:
+    TileStore();
+    ~TileStore();
+
+    /**
+     * @brief Open or create a tile store
+     * @param filePath MBTiles file path
+     * @return True if opened
+     */
+    bool open(const QString& filePath);
+
+    void close();
+    bool isOpen() const { return m_db != nullptr; }
+
+    /**
+     * @brief Limit the size of stored tile and resource data
+     * @param bytes Maximum bytes kept (0 = unlimited)
+     */
+    void setByteBudget(qint64 bytes);
+    qint64 byteBudget() const;
+
+    /**
+     * @brief Total size of stored tile and resource data
+     */
+    qint64 storedBytes() const;
+
+    /**
+     * @brief Read a tile
+     * @param zoom Zoom level
+     * @param x Tile column (XYZ)
+     * @param y Tile row (XYZ, north at 0)
+     * @param stale Set to true if the tile is past its expiry time, may be null
+     * @return Tile data, empty if not cached
+     */
+    QByteArray tile(int zoom, int x, int y, bool* stale = nullptr) const;
+
+    /**
+     * @brief Insert or replace a tile
+     * @param expires Expiry time (seconds since epoch)
+     * @return True if stored
+     */
+    bool storeTile(int zoom, int x, int y, const QByteArray& data, qint64 expires);
+
+    /**
+     * @brief Read a cached resource
+     * @param key Resource key (usually the upstream URL)
+     * @param mimeType Receives the stored MIME type, may be null
+     * @param stale Set to true if the resource is past its expiry time, may be null
+     * @return Resource data, empty if not cached
+     */
+    QByteArray resource(const QString& key, QByteArray* mimeType = nullptr, bool* stale = nullptr) const;
+
+    /**
+     * @brief Insert or replace a resource
+     * @param expires Expiry time (seconds since epoch)
+     * @return True if stored
+     */
+    bool storeResource(const QString& key, const QByteArray& data, const QByteArray& mimeType,
+                       qint64 expires);
+
+    QString metadata(const QString& name) const;
+    bool setMetadata(const QString& name, const QString& value);
+
+    QString lastError() const;
+
+private:
+    sqlite3* m_db;
+    sqlite3_stmt* m_selectTile;
+    sqlite3_stmt* m_insertTile;
+    sqlite3_stmt* m_selectResource;
+    sqlite3_stmt* m_insertResource;
+    sqlite3_stmt* m_touchTile;
+    sqlite3_stmt* m_touchResource;
+    qint64 m_budget;
+    qint64 m_storedBytes;
+    mutable QMutex m_mutex;
+    mutable QString m_lastError;
+
+    bool execute(const char* sql);
+    sqlite3_stmt* prepare(const char* sql);
+    bool addColumn(const char* table, const char* column, const char* definition);
+    qint64 queryBytes();
+    void evict();
+
+    TileStore(const TileStore&) = delete;
+    TileStore& operator=(const TileStore&) = delete;
+};
+
+} // namespace Core
+} // namespace DroneMapper
+
+#endif // TILESTORE_H
@@ -0,0 +1,151 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+namespace DroneMapper {
+namespace Core {
+
+/**
+ * @brief Low-overhead timeline tracing with Chrome Trace Event export
+ *
+ * Instrumented code records scopes, counters and async spans through
+ * the TRACE_* macros. While tracing is stopped each macro costs one
+ * relaxed atomic load. While recording, every thread appends to its
+ * own event buffer without locks; event names must be string literals
+ * (only the pointer is stored).
+ *
+ * writeChromeTrace() dumps the current session as Chrome Trace Event
+ * JSON, viewable in chrome://tracing or ui.perfetto.dev.
+ *
+ * Usage:
+ *   void CoveragePatternGenerator::generateGrid(...)
+ *   {
+ *       TRACE_SCOPE("coverage", "generateGrid");
+ *       ...
+ *   }
+ *
+ * Define DRONEMAPPER_NO_TRACING to compile all macros out.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Start a new session, discarding previously recorded events
+     */
+    static void start();
+
+    /**
+     * @brief Stop recording (recorded events are kept for export)
+     */
+    static void stop();
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record a finished scope
+     * @param startNs Start time from nowNs()
+     */
+    static void complete(const char* category, const char* name, qint64 startNs);
+
+    /**
+     * @brief Record a counter sample (drawn as a graph)
+     */
+    static void counter(const char* category, const char* name, double value);
+
+    /**
+     * @brief Record a point in time
+     */
+    static void instant(const char* category, const char* name);
+
+    /**
+     * @brief Begin a span that may end on another thread
+     * @param id Identifies the span; must match asyncEnd()
+     */
+    static void asyncBegin(const char* category, const char* name, quint64 id);
+    static void asyncEnd(const char* category, const char* name, quint64 id);
+
+    /**
+     * @brief Write recorded events as Chrome Trace Event JSON
+     * @param filePath Output file
+     * @param error Set on failure (optional)
+     * @return True on success
+     */
+    static bool writeChromeTrace(const QString& filePath, QString *error = nullptr);
+
+    /**
+     * @brief Get events lost to full per-thread buffers this session
+     */
+    static quint64 droppedEvents();
+
+    /**
+     * @brief Get the monotonic trace clock in nanoseconds
+     */
+    static qint64 nowNs();
+
+private:
+    Tracer() = delete; // Static class, no instantiation
+
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief Records the enclosing scope as one complete event
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(category)
+        , m_name(name)
+        , m_startNs(Tracer::isEnabled() ? Tracer::nowNs() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_startNs >= 0) {
+            Tracer::complete(m_category, m_name, m_startNs);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    qint64 m_startNs;       // -1 when tracing was off at entry
+};
+
+} // namespace Core
+} // namespace DroneMapper
+
+// Convenience macros
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifndef DRONEMAPPER_NO_TRACING
+#define TRACE_SCOPE(category, name) \
+    DroneMapper::Core::TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+#define TRACE_COUNTER(category, name, value) \
+    do { if (DroneMapper::Core::Tracer::isEnabled()) \
+        DroneMapper::Core::Tracer::counter(category, name, value); } while (0)
+#define TRACE_INSTANT(category, name) \
+    do { if (DroneMapper::Core::Tracer::isEnabled()) \
+        DroneMapper::Core::Tracer::instant(category, name); } while (0)
+#define TRACE_ASYNC_BEGIN(category, name, id) \
+    do { if (DroneMapper::Core::Tracer::isEnabled()) \
+        DroneMapper::Core::Tracer::asyncBegin(category, name, id); } while (0)
+#define TRACE_ASYNC_END(category, name, id) \
+    do { if (DroneMapper::Core::Tracer::isEnabled()) \
+        DroneMapper::Core::Tracer::asyncEnd(category, name, id); } while (0)
+#else
+#define TRACE_SCOPE(category, name) do { } while (0)
+#define TRACE_COUNTER(category, name, value) do { } while (0)
+#define TRACE_INSTANT(category, name) do { } while (0)
+#define TRACE_ASYNC_BEGIN(category, name, id) do { } while (0)
+#define TRACE_ASYNC_END(category, name, id) do { } while (0)
+#endif
+
+#endif // TRACER_H
@@ -3,6 +3,7 @@
 
 #include "FlightPlan.h"
 #include "GeospatialCoordinate.h"
+#include "PolygonClipper.h"
 #include <QtGui/QPolygonF>
 #include <QList>
 
@@ -39,6 +40,31 @@ public:
         double spacing,
         double overlap);
 
+    /**
+     * @brief Generate parallel line pattern for an area with holes
+     *
+     * Lines stop at every hole edge. The area is split into cells where
+     * a hole splits or merges the lines; each cell is flown as its own
+     * serpentine, visiting the nearest unflown cell next.
+     *
+     * @param area Survey area polygons with holes (lon/lat coordinates)
+     * @param altitude Flight altitude in meters
+     * @param direction Flight line direction in degrees (0-360)
+     * @param spacing Distance between flight lines in meters
+     * @param overshoot Distance each line is extended past the outer boundary for the
+     *                  turn (meters); ends on hole edges are never extended
+     * @param exclusions Outlines no extension may enter (lon/lat, e.g. buffered no-fly
+     *                   zones); an extension stops where it meets one
+     * @return List of waypoints covering the area
+     */
+    QList<Models::Waypoint> generateParallelLines(
+        const MultiPolygon& area,
+        double altitude,
+        double direction,
+        double spacing,
+        double overshoot = 0.0,
+        const QList<QPolygonF>& exclusions = QList<QPolygonF>());
+
     /**
      * @brief Generate grid pattern (perpendicular passes)
      * @param polygon Survey area
@@ -87,6 +113,14 @@ private:
         double direction,
         double spacing);
 
+    QList<QPointF> generateCellLinePoints(
+        const QList<QPolygonF>& rings,
+        const QList<bool>& holeRings,
+        double direction,
+        double spacing,
+        double overshoot,
+        const QList<QPolygonF>& exclusions);
+
     bool pointInPolygon(const QPointF& point, const QPolygonF& polygon);
     QPolygonF rotatePolygon(const QPolygonF& polygon, double angleDegrees);
     QPolygonF translatePolygon(const QPolygonF& polygon, const QPointF& offset);
@@ -0,0 +1,114 @@
+#ifndef INCREMENTALCOVERAGEGENERATOR_H
+#define INCREMENTALCOVERAGEGENERATOR_H
+
+#include "Waypoint.h"
+#include "GeospatialCoordinate.h"
+#include <QtGui/QPolygonF>
+#include <QtGui/QTransform>
+#include <QList>
+#include <QVector>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+/**
+ * @brief Parallel-line coverage that follows survey polygon edits
+ *
+ * Features:
+ * - Initial build matches CoveragePatternGenerator::generateParallelLines
+ * - Keeps the rotated polygon and each transect's inside intervals
+ * - A vertex move recomputes only the transects whose y lies within
+ *   the old or new extent of the two edges at that vertex
+ * - The waypoint list is patched in place; the returned Patch names
+ *   the replaced range so callers can forward it (FlightPlan, map)
+ *
+ * The projection origin and transect grid stay anchored to the initial
+ * build while dragging, so untouched transects keep identical
+ * waypoints. A fresh reset() re-centers both.
+ *
+ * Usage:
+ *   generator.reset(polygon, altitude, direction, spacing);
+ *   plan.addWaypoint(...) for generator.waypoints();
+ *   Patch patch = generator.moveVertex(index, QPointF(lon, lat));
+ *   plan.replaceWaypoints(patch.start, patch.removeCount,
+ *                         generator.waypoints().mid(patch.start, patch.insertCount));
+ */
+class IncrementalCoverageGenerator {
+public:
+    /**
+     * @brief Waypoint range replaced by an edit
+     */
+    struct Patch {
+        int start;          // First replaced waypoint
+        int removeCount;    // Waypoints removed at start
+        int insertCount;    // Waypoints inserted at start
+
+        bool isEmpty() const { return removeCount == 0 && insertCount == 0; }
+    };
+
+    IncrementalCoverageGenerator();
+
+    /**
+     * @brief Build the full pattern
+     * @param polygon Survey area (x = longitude, y = latitude; may repeat the first vertex at the end)
+     * @param altitude Flight altitude in meters
+     * @param direction Flight line direction in degrees (0-360)
+     * @param spacing Distance between flight lines in meters
+     * @param overshoot Distance each line is extended past the boundary for the turn (meters)
+     * @return False if the polygon or spacing is unusable
+     */
+    bool reset(const QPolygonF& polygon, double altitude, double direction, double spacing,
+               double overshoot = 0.0);
+
+    void clear();
+    bool isValid() const { return !m_polygon.isEmpty(); }
+
+    /**
+     * @brief Move one polygon vertex and update the affected transects
+     * @param vertex Vertex index in the open ring
+     * @param position New position (x = longitude, y = latitude)
+     * @return Replaced waypoint range (empty if nothing changed)
+     */
+    Patch moveVertex(int vertex, const QPointF& position);
+
+    const QList<Models::Waypoint>& waypoints() const { return m_waypoints; }
+
+    /**
+     * @brief Current survey area (open ring, x = longitude, y = latitude)
+     */
+    QPolygonF polygon() const { return m_polygon; }
+
+    int vertexCount() const { return m_polygon.size(); }
+    int transectCount() const { return m_transects.size(); }
+    int lastUpdatedTransects() const { return m_lastUpdated; }
+
+private:
+    struct Transect {
+        QVector<double> crossings;  // Sorted x where the line crosses the boundary (rotated frame)
+        int waypointCount;
+    };
+
+    QPolygonF m_polygon;            // Geographic, open ring
+    QPolygonF m_rotated;            // Local meters, rotated so transects are horizontal
+    QTransform m_toRotated;
+    QTransform m_fromRotated;
+    Models::GeospatialCoordinate m_origin;
+    double m_altitude;
+    double m_spacing;
+    double m_overshoot;
+    double m_anchorY;               // y of grid line 0
+    int m_firstLine;                // Grid line of m_transects[0]
+    QVector<Transect> m_transects;
+    QList<Models::Waypoint> m_waypoints;
+    int m_lastUpdated;
+
+    QPointF project(const QPointF& lonLat) const;
+    void computeCrossings(double y, QVector<double>& crossings) const;
+    void appendTransect(int index, QList<Models::Waypoint>& out);
+    void ensureLines(int firstLine, int lastLine);
+};
+
+} // namespace Geospatial
+} // namespace DroneMapper
+
+#endif // INCREMENTALCOVERAGEGENERATOR_H
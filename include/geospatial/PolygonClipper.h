@@ -0,0 +1,85 @@
+#ifndef POLYGONCLIPPER_H
+#define POLYGONCLIPPER_H
+
+#include <QtGui/QPolygonF>
+#include <QList>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+/**
+ * @brief Polygon with holes (rings open, outer counter-clockwise, holes clockwise)
+ */
+struct PolygonWithHoles {
+    QPolygonF outer;
+    QList<QPolygonF> holes;
+
+    double area() const;    // Outer area minus holes
+};
+
+using MultiPolygon = QList<PolygonWithHoles>;
+
+/**
+ * @brief Boolean operations on polygons in projected coordinates
+ *
+ * Features:
+ * - Martinez-Rueda plane sweep: edges are split at every crossing and
+ *   overlap, then kept where exactly one side lies in the result
+ * - Nonzero winding per operand, so any number of overlapping rings
+ *   (e.g. thousands of zone circles) go through a single sweep
+ * - Coincident edges are merged rather than special-cased
+ * - Output assembled into outer rings with their holes
+ * - Difference and intersection drop clip rings clear of the subject's
+ *   bounds and stop the sweep past its right edge
+ *
+ * Coordinates are expected in meters (e.g. GeoUtils::toCartesian) and
+ * are snapped to a 0.1 mm grid. Crossings are snap rounded to grid cells
+ * before the sweep, which then runs on integers with exact orientation
+ * tests, so its ordering and the collinear and touching decisions always
+ * agree and no edge moves once it is in the status line.
+ *
+ * Usage:
+ *   QList<QPolygonF> zones = { PolygonClipper::circle(center, 500.0, 1.0) };
+ *   MultiPolygon area = PolygonClipper::compute({ survey }, zones,
+ *                                               PolygonClipper::Operation::Difference);
+ */
+class PolygonClipper {
+public:
+    enum class Operation {
+        Union,
+        Intersection,
+        Difference      // Subject minus clip
+    };
+
+    /**
+     * @brief Combine two operands
+     * @param subject Subject rings (nonzero winding; holes wound opposite to their outer ring)
+     * @param clip Clip rings (nonzero winding)
+     * @param operation Boolean operation
+     * @return Result polygons, largest first
+     */
+    static MultiPolygon compute(const QList<QPolygonF>& subject, const QList<QPolygonF>& clip,
+                                Operation operation);
+
+    /**
+     * @brief Circle approximated by a polygon that contains it
+     * @param center Center point
+     * @param radius Radius
+     * @param tolerance Maximum distance between polygon and circle
+     * @return Counter-clockwise ring
+     */
+    static QPolygonF circle(const QPointF& center, double radius, double tolerance);
+
+    /**
+     * @brief Signed ring area (positive for counter-clockwise)
+     */
+    static double signedArea(const QPolygonF& ring);
+
+private:
+    PolygonClipper() = delete;  // Static class, no instantiation
+};
+
+} // namespace Geospatial
+} // namespace DroneMapper
+
+#endif // POLYGONCLIPPER_H
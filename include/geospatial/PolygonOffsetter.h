@@ -0,0 +1,93 @@
+#ifndef POLYGONOFFSETTER_H
+#define POLYGONOFFSETTER_H
+
+#include "PolygonClipper.h"
+#include <QtGui/QPolygonF>
+#include <QList>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+/**
+ * @brief Grows or shrinks polygons by a distance in projected coordinates
+ *
+ * Features:
+ * - Miter (with limit), round and square joins
+ * - Outset = ring united with a band outside each edge and a join piece
+ *   at each convex vertex; inset = ring minus the same pieces built
+ *   inside, joined at reflex vertices. PolygonClipper resolves every
+ *   self-intersection, so narrow parts that vanish or split come out
+ *   as separate polygons
+ * - Batches of rings offset in parallel
+ *
+ * Usage:
+ *   PolygonOffsetter::Options options;
+ *   options.join = PolygonOffsetter::JoinType::Miter;
+ *   MultiPolygon inset = PolygonOffsetter::offset(surveyMeters, -10.0, options);
+ */
+class PolygonOffsetter {
+public:
+    enum class JoinType {
+        Miter,      // Edges extended until they meet (bounded by miterLimit)
+        Round,      // Arc around the vertex
+        Square      // Corner cut off at the offset distance from the vertex
+    };
+
+    struct Options {
+        JoinType join;
+        double miterLimit;          // Longest miter as a multiple of the distance (squared off beyond)
+        double arcTolerance;        // Maximum arc approximation error (meters)
+
+        Options()
+            : join(JoinType::Round)
+            , miterLimit(2.0)
+            , arcTolerance(0.25)
+        {}
+    };
+
+    /**
+     * @brief Offset one ring
+     * @param ring Polygon ring (either orientation)
+     * @param delta Offset distance (positive grows, negative shrinks)
+     * @param options Join style
+     * @return Offset polygons, largest first (empty if the ring vanishes)
+     */
+    static MultiPolygon offset(const QPolygonF& ring, double delta, const Options& options = Options());
+
+    /**
+     * @brief Offset rings in parallel
+     * @param rings Polygon rings
+     * @param delta Offset distance (positive grows, negative shrinks)
+     * @param options Join style
+     * @return One result per ring, in input order
+     */
+    static QList<MultiPolygon> offsetAll(const QList<QPolygonF>& rings, double delta,
+                                         const Options& options = Options());
+
+    /**
+     * @brief Pieces whose union is a ring grown outwards by a distance
+     *
+     * The ring itself, a band outside each edge and a join piece at each
+     * convex vertex, all counter-clockwise. Passing them as one operand
+     * of PolygonClipper::compute() avoids a separate union per ring.
+     *
+     * @param ring Polygon ring (either orientation)
+     * @param distance Buffer distance (0 = the ring alone)
+     * @param options Join style
+     * @return Rings whose union is the outset
+     */
+    static QList<QPolygonF> outsetPieces(const QPolygonF& ring, double distance,
+                                         const Options& options = Options());
+
+private:
+    PolygonOffsetter() = delete;  // Static class, no instantiation
+
+    static QPolygonF normalized(const QPolygonF& ring);
+    static void appendEdgePieces(const QPolygonF& ring, double distance, const Options& options,
+                                 QList<QPolygonF>& pieces);
+};
+
+} // namespace Geospatial
+} // namespace DroneMapper
+
+#endif // POLYGONOFFSETTER_H
@@ -0,0 +1,110 @@
+#ifndef RASTERTILEREADER_H
+#define RASTERTILEREADER_H
+
+#include <QString>
+
+typedef void* GDALDatasetH;
+
+namespace DroneMapper {
+namespace Geospatial {
+
+/**
+ * @brief Windowed reader for georeferenced rasters (GDAL)
+ *
+ * Reads arbitrary georeferenced windows resampled onto a caller-defined
+ * grid, so rasters larger than RAM can be processed strip by strip.
+ * GDAL's block cache does the tile I/O; only the requested window is
+ * held in memory.
+ *
+ * Features:
+ * - Any GDAL raster format (GeoTIFF, COG, VRT, HGT, ...)
+ * - Bilinear resampling of fractional source windows
+ * - On-the-fly reprojection through a warped VRT when the CRS differs
+ * - No-data values returned as NaN
+ * - Any band readable (band 1 by default, e.g. elevation)
+ *
+ * Usage:
+ *   RasterTileReader reader;
+ *   if (reader.open("dsm_2024.tif")) {
+ *       reader.readWindow(minX, maxY, 0.5, cols, rows, buffer);
+ *   }
+ */
+class RasterTileReader {
+public:
+    RasterTileReader();
+    ~RasterTileReader();
+
+    /**
+     * @brief Open a raster
+     * @param filePath Raster path
+     * @return True if opened and north-up
+     */
+    bool open(const QString& filePath);
+
+    /**
+     * @brief Reproject on the fly into another CRS
+     * @param wkt Target CRS as WKT
+     * @return True if the CRS already matched or a warped view was created
+     */
+    bool reprojectTo(const QString& wkt);
+
+    /**
+     * @brief WKT of an EPSG coordinate system
+     * @param epsg EPSG code (e.g. 3857)
+     * @return WKT, empty if unknown
+     */
+    static QString wktForEPSG(int epsg);
+
+    void close();
+    bool isOpen() const { return m_dataset != nullptr; }
+    int bandCount() const;
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+
+    // Georeferenced extent (CRS units; pixel edges)
+    double minX() const { return m_geoTransform[0]; }
+    double maxX() const { return m_geoTransform[0] + m_width * m_geoTransform[1]; }
+    double maxY() const { return m_geoTransform[3]; }
+    double minY() const { return m_geoTransform[3] + m_height * m_geoTransform[5]; }
+    double pixelWidth() const { return m_geoTransform[1]; }
+    double pixelHeight() const { return -m_geoTransform[5]; }
+
+    QString projection() const { return m_projection; }
+    bool isGeographic() const { return m_geographic; }
+    QString lastError() const { return m_lastError; }
+
+    /**
+     * @brief Read a window resampled onto a regular grid
+     * @param minX Left edge of the grid (CRS units)
+     * @param maxY Top edge of the grid (CRS units)
+     * @param pixelSize Grid spacing (CRS units)
+     * @param columns Grid columns
+     * @param rows Grid rows
+     * @param out Receives columns * rows values, row-major (NaN = no data)
+     * @param band Band to read (1-based)
+     * @return True if read successfully
+     */
+    bool readWindow(double minX, double maxY, double pixelSize,
+                    int columns, int rows, float* out, int band = 1);
+
+private:
+    GDALDatasetH m_dataset;
+    GDALDatasetH m_source;      // Original dataset when m_dataset is a warped view
+    int m_width;
+    int m_height;
+    double m_geoTransform[6];
+    QString m_projection;
+    bool m_geographic;
+    QString m_lastError;
+
+    bool readMetadata();
+
+    RasterTileReader(const RasterTileReader&) = delete;
+    RasterTileReader& operator=(const RasterTileReader&) = delete;
+};
+
+} // namespace Geospatial
+} // namespace DroneMapper
+
+#endif // RASTERTILEREADER_H
@@ -0,0 +1,97 @@
+#ifndef SURVEYAREACLIPPER_H
+#define SURVEYAREACLIPPER_H
+
+#include "PolygonClipper.h"
+#include "PolygonOffsetter.h"
+#include "core/NoFlyZoneChecker.h"
+#include <QDateTime>
+#include <QtGui/QPolygonF>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+/**
+ * @brief Removes no-fly zones from a survey area
+ *
+ * Features:
+ * - Zones projected around the survey centroid and grown by a safety
+ *   buffer (circles approximated within a tolerance, polygon zones
+ *   offset in parallel with the configured join)
+ * - Optional inset keeping the lines clear of the drawn boundary
+ * - Only zones whose extent reaches the survey (plus the turn
+ *   overshoot) are clipped; the rest of the database never enters the
+ *   sweep. Their buffered outlines are returned so the pattern
+ *   generator can stop line extensions at them
+ * - Zones filtered by restriction level, effective time and altitude
+ *   band, as NoFlyZoneChecker does
+ * - All zones subtracted in one PolygonClipper pass; the result may
+ *   be several polygons with holes
+ *
+ * Usage:
+ *   SurveyAreaClipper::Options options;
+ *   options.altitude = 120.0;
+ *   options.overshootMeters = overshoot;
+ *   auto result = SurveyAreaClipper::subtractZones(survey, database, options);
+ *   if (result.clipped) {
+ *       waypoints = generator.generateParallelLines(result.area, 120.0, 0.0, spacing,
+ *                                                   overshoot, result.zoneOutlines);
+ *   }
+ */
+class SurveyAreaClipper {
+public:
+    struct Options {
+        double bufferMeters;            // Clearance kept around each zone
+        double insetMeters;             // Survey boundary pulled inwards by this much
+        double overshootMeters;         // Lines may run this far past the boundary
+        double toleranceMeters;         // Maximum circle and arc approximation error
+        double altitude;                // Flight altitude (meters; negative = every band applies)
+        Core::RestrictionLevel minimumLevel;    // Least severe level that is excluded
+        QDateTime time;                 // When the survey is flown (invalid = now)
+        PolygonOffsetter::JoinType join;        // Corners of buffered polygon zones and of the inset
+
+        Options()
+            : bufferMeters(30.0)
+            , insetMeters(0.0)
+            , overshootMeters(0.0)
+            , toleranceMeters(1.0)
+            , altitude(-1.0)
+            , minimumLevel(Core::RestrictionLevel::Authorization)
+            , join(PolygonOffsetter::JoinType::Round)
+        {}
+    };
+
+    struct Result {
+        MultiPolygon area;              // Remaining area (lon/lat), largest first
+        QList<QPolygonF> zoneOutlines;  // Buffered outlines of zones within overshoot reach (lon/lat)
+        bool clipped;                   // The inset or some zone removed part of the survey
+        int candidateZones;             // Zones whose extent reached the survey
+        double originalArea;            // Square meters
+        double remainingArea;           // Square meters
+        qint64 elapsedMs;
+
+        Result()
+            : clipped(false), candidateZones(0)
+            , originalArea(0.0), remainingArea(0.0), elapsedMs(0)
+        {}
+    };
+
+    /**
+     * @brief Inset a survey polygon and subtract buffered zones from it
+     * @param survey Survey area polygon (lon/lat coordinates)
+     * @param database Zone database
+     * @param options Buffer, inset, tolerance and zone filters
+     * @return Remaining area; the survey unchanged when nothing removed any of it
+     */
+    static Result subtractZones(const QPolygonF& survey, const Core::ZoneDatabase& database,
+                                const Options& options = Options());
+
+private:
+    SurveyAreaClipper() = delete;  // Static class, no instantiation
+
+    static bool applies(const Core::NoFlyZone& zone, const Options& options, const QDateTime& time);
+};
+
+} // namespace Geospatial
+} // namespace DroneMapper
+
+#endif // SURVEYAREACLIPPER_H
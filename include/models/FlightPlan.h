@@ -4,6 +4,7 @@
 #include "Waypoint.h"
 #include "MissionParameters.h"
 #include "GeospatialCoordinate.h"
+#include "PlanGeometry.h"
 #include <QString>
 #include <QList>
 #include <QtGui/QPolygonF>
@@ -41,10 +42,24 @@ public:
     // Waypoints
     QList<Waypoint> waypoints() const { return m_waypoints; }
     void addWaypoint(const Waypoint& waypoint);
+    void setWaypoint(int index, const Waypoint& waypoint);
+    void replaceWaypoints(int start, int removeCount, const QList<Waypoint>& replacement);
     void removeWaypoint(int index);
     void clearWaypoints();
     int waypointCount() const { return m_waypoints.count(); }
 
+    /**
+     * @brief Per-segment geometry, kept in step with the waypoints
+     *
+     * Edits recompute only the legs adjacent to the changed waypoint.
+     */
+    const PlanGeometry& geometry() const { return m_geometry; }
+
+    /**
+     * @brief Counter bumped on every waypoint change (cache key for derived data)
+     */
+    quint64 revision() const { return m_revision; }
+
     // Mission parameters
     MissionParameters& parameters() { return m_parameters; }
     const MissionParameters& parameters() const { return m_parameters; }
@@ -73,6 +88,8 @@ private:
     QDateTime m_modifiedDate;
 
     QList<Waypoint> m_waypoints;
+    PlanGeometry m_geometry;
+    quint64 m_revision;
     MissionParameters m_parameters;
     PatternType m_patternType;
     QPolygonF m_surveyArea;
@@ -34,6 +34,8 @@ public:
     double pathSpacing() const { return m_pathSpacing; }
     double flightDirection() const { return m_flightDirection; }
     bool reversePath() const { return m_reversePath; }
+    double boundaryInset() const { return m_boundaryInset; }
+    double turnOvershoot() const { return m_turnOvershoot; }
 
     // Camera parameters
     CameraModel cameraModel() const { return m_cameraModel; }
@@ -53,6 +55,8 @@ public:
     void setPathSpacing(double spacing) { m_pathSpacing = spacing; }
     void setFlightDirection(double direction) { m_flightDirection = direction; }
     void setReversePath(bool reverse) { m_reversePath = reverse; }
+    void setBoundaryInset(double inset) { m_boundaryInset = inset; }
+    void setTurnOvershoot(double overshoot) { m_turnOvershoot = overshoot; }
 
     void setCameraModel(CameraModel model) { m_cameraModel = model; }
     void setFrontOverlap(double overlap) { m_frontOverlap = overlap; }
@@ -76,6 +80,8 @@ private:
     double m_pathSpacing;         // Meters between flight lines
     double m_flightDirection;     // Degrees (0-360)
     bool m_reversePath;
+    double m_boundaryInset;       // Meters the lines keep inside the survey boundary
+    double m_turnOvershoot;       // Meters each line runs past the boundary for the turn
 
     // Camera parameters
     CameraModel m_cameraModel;
@@ -0,0 +1,117 @@
+#ifndef PLANGEOMETRY_H
+#define PLANGEOMETRY_H
+
+#include "Waypoint.h"
+#include <QList>
+#include <QVector>
+
+namespace DroneMapper {
+namespace Models {
+
+/**
+ * @brief Geometry of the leg between two consecutive waypoints
+ */
+struct SegmentGeometry {
+    double length;      // Great-circle distance (meters)
+    double bearing;     // Initial bearing (degrees, 0-360)
+    double climb;       // Altitude change (meters, positive = climbing)
+    double turnAngle;   // Heading change entering this leg (degrees, 0-180, 0 for the first leg)
+};
+
+/**
+ * @brief Per-segment geometry of a waypoint sequence, computed once
+ *
+ * Features:
+ * - Length, bearing, climb and turn angle per leg (haversine/bearing
+ *   trigonometry done once per leg instead of once per analyzer)
+ * - Incremental maintenance: appending, moving or removing a waypoint
+ *   recomputes only the adjacent legs and turn angles
+ * - Aggregates (total distance, climb, turns) derived from the cached
+ *   legs without further trigonometry
+ *
+ * Owned by FlightPlan, which keeps it in step with its waypoints; the
+ * analyzers read plan.geometry() instead of re-walking the waypoints.
+ */
+class PlanGeometry {
+public:
+    PlanGeometry();
+
+    /**
+     * @brief Recompute every leg
+     * @param waypoints Current waypoint sequence
+     */
+    void rebuild(const QList<Waypoint>& waypoints);
+
+    /**
+     * @brief Add the leg ending at the last waypoint
+     * @param waypoints Waypoint sequence after the append
+     */
+    void appended(const QList<Waypoint>& waypoints);
+
+    /**
+     * @brief Recompute the legs adjacent to a changed waypoint
+     * @param waypoints Waypoint sequence after the change
+     * @param index Index of the changed waypoint
+     */
+    void changed(const QList<Waypoint>& waypoints, int index);
+
+    /**
+     * @brief Merge the two legs around a removed waypoint
+     * @param waypoints Waypoint sequence after the removal
+     * @param index Index the removed waypoint had
+     */
+    void removed(const QList<Waypoint>& waypoints, int index);
+
+    /**
+     * @brief Recompute the legs touching a replaced waypoint range
+     * @param waypoints Waypoint sequence after the replacement
+     * @param start First replaced waypoint
+     * @param removeCount Waypoints that were removed at start
+     * @param insertCount Waypoints now at start in their place
+     */
+    void replaced(const QList<Waypoint>& waypoints, int start, int removeCount, int insertCount);
+
+    void clear();
+
+    const QVector<SegmentGeometry>& segments() const { return m_segments; }
+    int segmentCount() const { return m_segments.size(); }
+
+    double totalDistance() const;       // Meters
+    double totalClimb() const;          // Meters gained
+    double totalDescent() const;        // Meters lost (positive)
+
+    /**
+     * @brief Distance from the first waypoint to each waypoint
+     * @return One cumulative distance per waypoint (meters)
+     */
+    QVector<double> cumulativeDistances() const;
+
+    /**
+     * @brief Count heading changes sharper than a threshold
+     * @param thresholdDegrees Minimum turn angle to count
+     */
+    int turnCount(double thresholdDegrees) const;
+
+    /**
+     * @brief Mean heading change over the interior waypoints
+     * @return Degrees (0 with fewer than three waypoints)
+     */
+    double averageTurnAngle() const;
+
+    /**
+     * @brief Number of legs recomputed by the last update (for diagnostics)
+     */
+    int lastUpdatedSegments() const { return m_lastUpdated; }
+
+private:
+    QVector<SegmentGeometry> m_segments;
+    int m_lastUpdated;
+
+    static SegmentGeometry computeSegment(const Waypoint& from, const Waypoint& to);
+    void updateTurn(int segment);
+};
+
+} // namespace Models
+} // namespace DroneMapper
+
+#endif // PLANGEOMETRY_H
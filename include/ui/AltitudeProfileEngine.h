@@ -0,0 +1,130 @@
+#ifndef ALTITUDEPROFILEENGINE_H
+#define ALTITUDEPROFILEENGINE_H
+
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include "models/Waypoint.h"
+
+namespace DroneMapper {
+namespace UI {
+
+struct DEMData;
+
+/**
+ * @brief One densified profile sample
+ */
+struct ProfilePoint {
+    double distance;        // Distance from start (meters)
+    double flightAltitude;  // Flight altitude AGL (meters)
+    double terrainElevation;// Terrain elevation MSL (meters, NaN outside the DEM)
+};
+
+/**
+ * @brief Min/max envelope of the profile over one pixel column
+ */
+struct ProfileColumn {
+    double minTerrain;
+    double maxTerrain;
+    double minFlight;       // Flight altitude MSL
+    double maxFlight;
+    double minClearance;    // Lowest AGL in the column
+    bool valid;             // Column contains samples
+};
+
+/**
+ * @brief Incremental altitude profile along a flight plan
+ *
+ * Features:
+ * - Each leg densified at DEM resolution and sampled in one batch
+ *   (direct bilinear lookups, legs sampled in parallel)
+ * - Terrain cached per leg, keyed by the leg's end positions: moving a
+ *   waypoint resamples only its two adjacent legs, altitude-only edits
+ *   resample nothing
+ * - Flight altitude interpolated in MSL between waypoints, so clearance
+ *   between waypoints reflects the straight-line flight path
+ * - Min/max decimation to a pixel width for long missions
+ *
+ * Waypoint altitudes are heights above ground at the waypoint.
+ *
+ * Usage:
+ *   engine.setDEM(&dem);
+ *   engine.setWaypoints(plan.waypoints());
+ *   QVector<ProfileColumn> columns = engine.decimate(plotWidth);
+ */
+class AltitudeProfileEngine {
+public:
+    AltitudeProfileEngine();
+
+    /**
+     * @brief Set DEM used for terrain sampling (resamples every leg)
+     * @param dem DEM data (must outlive the engine or the next setDEM)
+     */
+    void setDEM(const DEMData* dem);
+
+    /**
+     * @brief Update waypoints, resampling only legs that changed
+     * @param waypoints Flight plan waypoints
+     */
+    void setWaypoints(const QList<Models::Waypoint>& waypoints);
+
+    /**
+     * @brief Full-resolution profile (rebuilt lazily after changes)
+     * @return Profile samples in distance order
+     */
+    const QVector<ProfilePoint>& profile();
+
+    /**
+     * @brief Min/max decimated profile
+     * @param columns Number of output columns (e.g. plot width in pixels)
+     * @return One envelope per column
+     */
+    QVector<ProfileColumn> decimate(int columns);
+
+    /**
+     * @brief Distance of each waypoint along the profile
+     * @return Cumulative distances (meters)
+     */
+    QVector<double> waypointDistances() const;
+
+    double totalDistance() const;
+    int legCount() const { return m_legs.size(); }
+    int lastResampledLegs() const { return m_lastResampled; }
+
+private:
+    struct LegKey {
+        double lat0;
+        double lon0;
+        double lat1;
+        double lon1;
+
+        bool operator==(const LegKey& other) const {
+            return lat0 == other.lat0 && lon0 == other.lon0 &&
+                   lat1 == other.lat1 && lon1 == other.lon1;
+        }
+    };
+
+    struct Leg {
+        LegKey key;
+        double length;              // Meters
+        QVector<float> terrain;     // Samples at i * length / (n - 1)
+        double startAltitude;       // AGL at the leg start
+        double endAltitude;         // AGL at the leg end
+    };
+
+    friend size_t qHash(const LegKey& key, size_t seed);
+
+    const DEMData* m_dem;
+    QVector<Leg> m_legs;
+    QVector<ProfilePoint> m_profile;
+    bool m_profileDirty;
+    int m_lastResampled;
+
+    void sampleLeg(Leg& leg) const;
+    float sampleTerrain(double latitude, double longitude) const;
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // ALTITUDEPROFILEENGINE_H
@@ -0,0 +1,108 @@
+#ifndef CLOUDCOMPARATOR_H
+#define CLOUDCOMPARATOR_H
+
+#include <QVector>
+#include <QVector3D>
+#include <QString>
+#include <atomic>
+
+namespace DroneMapper {
+namespace UI {
+
+struct PointCloud;
+class PointCloudKDTree;
+
+/**
+ * @brief Multi-epoch cloud-to-cloud distance computation
+ *
+ * Features:
+ * - KD-tree built once on the reference cloud
+ * - Nearest-neighbour (C2C) distances
+ * - Local-plane (M3C2-style) signed distances along the reference
+ *   surface normal, robust to sampling density differences
+ * - Parallel evaluation of the compared cloud in chunks (QtConcurrent)
+ * - Result stored as a per-point scalar field for colour mapping
+ *
+ * Usage:
+ *   CloudComparator::Options options;
+ *   options.method = CloudComparator::LocalPlane;
+ *   CloudComparator::Result result = CloudComparator::compare(reference, compared, options);
+ *   // compared.scalarField now holds signed distances
+ */
+class CloudComparator {
+public:
+    enum Method {
+        NearestNeighbour,   // Unsigned distance to closest reference point
+        LocalPlane          // Signed distance to plane fitted to k reference neighbours
+    };
+
+    struct Options {
+        Method method;
+        int neighbors;          // Reference neighbours for the local plane
+        float maxDistance;      // Distances beyond this are clamped (0 = no limit)
+        int chunkSize;          // Points per parallel work item
+        QVector3D up;           // Orients local-plane normals (positive = above reference)
+
+        Options()
+            : method(LocalPlane)
+            , neighbors(12)
+            , maxDistance(0.0f)
+            , chunkSize(16384)
+            , up(0, 0, 1)
+        {}
+    };
+
+    struct Result {
+        int pointCount;
+        float minDistance;
+        float maxDistance;
+        double meanDistance;
+        double rmsDistance;
+        qint64 elapsedMs;
+
+        Result()
+            : pointCount(0), minDistance(0.0f), maxDistance(0.0f)
+            , meanDistance(0.0), rmsDistance(0.0), elapsedMs(0)
+        {}
+    };
+
+    /**
+     * @brief Compute distances from compared cloud to reference cloud
+     *
+     * Writes one distance per compared point into compared.scalarField.
+     *
+     * @param reference Reference (earlier epoch) cloud
+     * @param compared Compared (later epoch) cloud, modified in place
+     * @param options Comparison options
+     * @param cancelled Polled per chunk; a set flag returns empty statistics
+     *                  and leaves compared unchanged
+     * @return Distance statistics
+     */
+    static Result compare(const PointCloud& reference, PointCloud& compared,
+                          const Options& options = Options(),
+                          const std::atomic<bool>* cancelled = nullptr);
+
+    /**
+     * @brief Compute distances against a prebuilt reference KD-tree
+     * @param reference Reference cloud the tree was built from
+     * @param tree KD-tree over reference positions
+     * @param compared Compared cloud
+     * @param options Comparison options
+     * @param cancelled Polled per chunk; a set flag skips the remaining chunks
+     * @return One distance per compared point
+     */
+    static QVector<float> computeDistances(
+        const PointCloud& reference,
+        const PointCloudKDTree& tree,
+        const PointCloud& compared,
+        const Options& options = Options(),
+        const std::atomic<bool>* cancelled = nullptr);
+
+private:
+    CloudComparator() = delete;  // Static class, no instantiation
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // CLOUDCOMPARATOR_H
@@ -0,0 +1,105 @@
+#ifndef CONTOURGENERATOR_H
+#define CONTOURGENERATOR_H
+
+#include <QVector>
+#include <QPointF>
+#include <QJsonDocument>
+
+namespace DroneMapper {
+namespace UI {
+
+struct DEMData;
+
+/**
+ * @brief Contour polyline in DEM grid coordinates
+ */
+struct ContourLine {
+    float elevation;            // Contour level (meters)
+    QVector<QPointF> points;    // Grid coordinates (x = column, y = row)
+    bool closed;                // True for rings
+};
+
+/**
+ * @brief Contour extraction from DEMs (marching squares)
+ *
+ * Features:
+ * - Marching squares over square DEM tiles processed in parallel
+ * - Saddle cells disambiguated by the cell-centre average
+ * - Segments stitched into continuous polylines through a hash on
+ *   shared grid-edge keys (per level, levels stitched in parallel)
+ * - Optional Chaikin smoothing and Douglas-Peucker simplification
+ * - GeoJSON export (LineString per contour, elevation property)
+ *
+ * Usage:
+ *   ContourGenerator::Options options;
+ *   options.simplifyTolerance = 0.25;
+ *   QVector<ContourLine> lines = ContourGenerator::generate(dem, 1.0, options);
+ *   ContourGenerator::toGeoJson(lines, dem);
+ */
+class ContourGenerator {
+public:
+    struct Options {
+        int tileSize;               // Tile edge in cells
+        int smoothIterations;       // Chaikin passes (0 = none)
+        double simplifyTolerance;   // Douglas-Peucker tolerance in cells (0 = none)
+
+        Options()
+            : tileSize(256)
+            , smoothIterations(0)
+            , simplifyTolerance(0.0)
+        {}
+    };
+
+    /**
+     * @brief Generate contours at a fixed interval
+     * @param dem DEM data
+     * @param interval Contour interval (meters)
+     * @param options Generation options
+     * @return Stitched contour lines
+     */
+    static QVector<ContourLine> generate(const DEMData& dem, double interval,
+                                         const Options& options = Options());
+
+    /**
+     * @brief Generate contours for explicit levels
+     * @param dem DEM data
+     * @param levels Contour elevations (ascending)
+     * @param options Generation options
+     * @return Stitched contour lines
+     */
+    static QVector<ContourLine> generateLevels(const DEMData& dem, const QVector<float>& levels,
+                                               const Options& options = Options());
+
+    /**
+     * @brief Convert contours to a GeoJSON FeatureCollection
+     * @param lines Contour lines (grid coordinates)
+     * @param dem DEM providing the georeference
+     * @return GeoJSON document
+     */
+    static QJsonDocument toGeoJson(const QVector<ContourLine>& lines, const DEMData& dem);
+
+    /**
+     * @brief Chaikin corner-cutting smoothing
+     * @param points Polyline
+     * @param closed Treat as ring
+     * @param iterations Number of passes
+     * @return Smoothed polyline
+     */
+    static QVector<QPointF> smooth(const QVector<QPointF>& points, bool closed, int iterations);
+
+    /**
+     * @brief Douglas-Peucker simplification
+     * @param points Polyline
+     * @param tolerance Maximum deviation
+     * @return Simplified polyline
+     */
+    static QVector<QPointF> simplify(const QVector<QPointF>& points, double tolerance);
+
+private:
+    ContourGenerator() = delete;  // Static class, no instantiation
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // CONTOURGENERATOR_H
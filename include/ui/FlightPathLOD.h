@@ -0,0 +1,95 @@
+#ifndef FLIGHTPATHLOD_H
+#define FLIGHTPATHLOD_H
+
+#include <QVector>
+#include <QRectF>
+
+namespace DroneMapper {
+namespace UI {
+
+/**
+ * @brief Zoom-dependent level of detail for large flight paths
+ *
+ * Features:
+ * - Visvalingam-Whyatt significance for every waypoint, computed once;
+ *   each zoom level keeps the vertices whose effective area exceeds
+ *   half a screen pixel at that zoom (levels are nested)
+ * - Waypoint clusters per zoom level on a screen-space grid
+ * - Viewport queries return only route runs, waypoints and clusters
+ *   inside the (padded) visible bounds
+ *
+ * Areas and cluster cells are measured in Web Mercator, matching the
+ * map's pixel grid. Zoom levels follow the 256 px tile convention.
+ *
+ * Usage:
+ *   FlightPathLOD lod;
+ *   lod.build(packedLonLatAlt);
+ *   FlightPathLOD::View view = lod.query(zoom, west, south, east, north);
+ */
+class FlightPathLOD {
+public:
+    static constexpr int MAX_ZOOM = 22;
+
+    struct Cluster {
+        double longitude;       // Centroid
+        double latitude;
+        double x;               // Centroid in Web Mercator
+        double y;
+        int count;              // Waypoints in the cluster
+        int firstIndex;         // Lowest waypoint index in the cluster
+    };
+
+    /**
+     * @brief Visible subset of the path at one zoom level
+     */
+    struct View {
+        QVector<double> route;      // lon, lat pairs; a NaN pair separates runs
+        QVector<double> waypoints;  // lon, lat, alt, index per single waypoint
+        QVector<double> clusters;   // lon, lat, count per cluster
+    };
+
+    FlightPathLOD();
+
+    /**
+     * @brief Build the simplification hierarchy and clusters
+     * @param path Packed lon, lat, alt per waypoint
+     */
+    void build(const QVector<double>& path);
+
+    void clear();
+    bool isEmpty() const { return m_path.isEmpty(); }
+    int waypointCount() const { return m_path.size() / 3; }
+
+    /**
+     * @brief Geographic bounds of the path
+     * @return Rectangle with x = longitude, y = latitude
+     */
+    QRectF bounds() const { return m_bounds; }
+
+    /**
+     * @brief Path content visible in a viewport
+     * @param zoom Map zoom level
+     * @param west Western bound (degrees)
+     * @param south Southern bound (degrees)
+     * @param east Eastern bound (degrees)
+     * @param north Northern bound (degrees)
+     * @return Route runs, single waypoints and clusters
+     */
+    View query(double zoom, double west, double south, double east, double north) const;
+
+private:
+    QVector<double> m_path;                 // lon, lat, alt
+    QVector<double> m_x;                    // Web Mercator, 0..1
+    QVector<double> m_y;
+    QVector<QVector<int>> m_levels;         // Kept vertex indices per zoom, ascending
+    QVector<QVector<Cluster>> m_clusters;   // Clusters per zoom
+    QRectF m_bounds;
+
+    QVector<double> significance() const;
+    QVector<Cluster> clusterLevel(int zoom) const;
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // FLIGHTPATHLOD_H
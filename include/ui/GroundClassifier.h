@@ -0,0 +1,91 @@
+#ifndef GROUNDCLASSIFIER_H
+#define GROUNDCLASSIFIER_H
+
+#include <QVector>
+#include <atomic>
+
+namespace DroneMapper {
+namespace UI {
+
+struct PointCloud;
+
+/**
+ * @brief Ground point classification (progressive morphological filter)
+ *
+ * Features:
+ * - Splits the cloud into square XY tiles with overlap buffers
+ * - Runs a progressive morphological filter (Zhang et al., 2003) per tile
+ * - Tiles processed in parallel (QtConcurrent); each tile writes only
+ *   points inside its core, so no locking is needed
+ * - Writes LAS classes: 2 = ground, 1 = unclassified
+ *
+ * Coordinates are assumed to be projected (meters) with Z up.
+ *
+ * Usage:
+ *   GroundClassifier::Options options;
+ *   options.cellSize = 0.5;
+ *   GroundClassifier::Result result = GroundClassifier::classify(cloud, options);
+ */
+class GroundClassifier {
+public:
+    static constexpr int CLASS_UNCLASSIFIED = 1;
+    static constexpr int CLASS_GROUND = 2;
+
+    struct Options {
+        double cellSize;            // Raster cell size (meters)
+        double tileSize;            // Tile core edge length (meters)
+        double maxWindowSize;       // Largest opening window (meters); also the tile buffer
+        double slope;               // Terrain slope (rise/run) used for height thresholds
+        double initialDistance;     // Height threshold for the first window (meters)
+        double maxDistance;         // Height threshold cap (meters)
+        bool exponentialWindows;    // Grow windows 2*2^k+1 instead of 2*k+1 cells
+
+        Options()
+            : cellSize(1.0)
+            , tileSize(100.0)
+            , maxWindowSize(20.0)
+            , slope(1.0)
+            , initialDistance(0.5)
+            , maxDistance(3.0)
+            , exponentialWindows(true)
+        {}
+    };
+
+    struct Result {
+        int groundPoints;
+        int unclassifiedPoints;
+        int tiles;
+        qint64 elapsedMs;
+
+        Result() : groundPoints(0), unclassifiedPoints(0), tiles(0), elapsedMs(0) {}
+    };
+
+    /**
+     * @brief Classify ground points in place
+     * @param cloud Point cloud (classification codes are overwritten)
+     * @param options Filter options
+     * @param cancelled Polled per tile; a set flag returns an empty summary and
+     *                  leaves the cloud partly classified (discard it)
+     * @return Classification summary
+     */
+    static Result classify(PointCloud& cloud, const Options& options = Options(),
+                           const std::atomic<bool>* cancelled = nullptr);
+
+    /**
+     * @brief Morphological opening of a raster with a square window
+     * @param grid Raster values, row-major
+     * @param cols Raster columns
+     * @param rows Raster rows
+     * @param radius Window half-size in cells
+     * @return Opened raster
+     */
+    static QVector<float> open(const QVector<float>& grid, int cols, int rows, int radius);
+
+private:
+    GroundClassifier() = delete;  // Static class, no instantiation
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // GROUNDCLASSIFIER_H
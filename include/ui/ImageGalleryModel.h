@@ -0,0 +1,149 @@
+#ifndef IMAGEGALLERYMODEL_H
+#define IMAGEGALLERYMODEL_H
+
+#include <QAbstractListModel>
+#include <QAbstractProxyModel>
+#include <QCache>
+#include <QPixmap>
+#include <QSet>
+#include <QThreadPool>
+#include <QVector>
+#include "core/ImageManager.h"
+
+namespace DroneMapper {
+namespace UI {
+
+/**
+ * @brief List model over the ImageManager catalog
+ *
+ * Rows are catalog indices; the model keeps no per-row state, so all
+ * metadata stays in ImageManager. Thumbnails are decoded on demand on
+ * worker threads (most recently requested first) and kept in a small
+ * LRU cache; until a thumbnail is ready a placeholder is returned.
+ *
+ * Catalog changes are picked up from ImageManager signals. Additions
+ * are batched into one row insertion per event loop pass, so a scan
+ * of 100k images inserts rows once rather than 100k times.
+ */
+class ImageGalleryModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Role {
+        CatalogIndexRole = Qt::UserRole + 1,
+        HasGPSRole,
+        AcceptableQualityRole
+    };
+
+    /**
+     * @brief Create a model over an image catalog
+     * @param manager Catalog (must outlive the model)
+     * @param thumbnailSize Maximum thumbnail dimension in pixels
+     */
+    explicit ImageGalleryModel(Core::ImageManager *manager, int thumbnailSize = 150,
+                               QObject *parent = nullptr);
+    ~ImageGalleryModel();
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Get metadata for a row, without copying
+     * @param row Row in [0, rowCount())
+     * @return Image metadata
+     */
+    const Core::ImageMetadata& metadataAt(int row) const { return m_manager->imageAt(row); }
+
+    Core::ImageManager* imageManager() const { return m_manager; }
+
+    /**
+     * @brief Re-read the catalog and reset the model
+     */
+    void reload();
+
+private slots:
+    void onImageAdded();
+    void onCatalogChanged();
+    void onThumbnailLoaded(int generation, int row, const QImage& image);
+
+private:
+    void syncRows();
+    void requestThumbnail(int row) const;
+    void startThumbnailJobs() const;
+
+    Core::ImageManager *m_manager;
+    int m_thumbnailSize;
+    int m_rowCount;
+    bool m_syncPending;
+
+    // Thumbnail loading; mutable because data() triggers it
+    mutable QCache<int, QPixmap> m_thumbnails;
+    mutable QSet<int> m_requested;      // Queued or loading
+    mutable QVector<int> m_queue;       // Waiting rows, newest last
+    mutable int m_activeJobs;
+    mutable QThreadPool m_loaderPool;
+    int m_generation;                   // Bumped on reset, drops stale loads
+    QPixmap m_placeholder;
+};
+
+/**
+ * @brief Filters an ImageGalleryModel by geotag and quality
+ *
+ * The accepted source rows are kept as one sorted index vector (four
+ * bytes per visible row), rebuilt in a single pass over the catalog
+ * when the filter changes. Appended source rows are filtered and
+ * appended without a reset. Source to proxy mapping is a binary
+ * search.
+ */
+class ImageFilterProxyModel : public QAbstractProxyModel {
+    Q_OBJECT
+
+public:
+    enum Filter {
+        NoFilter = 0x0,
+        GeotaggedOnly = 0x1,
+        QualityOnly = 0x2
+    };
+    Q_DECLARE_FLAGS(Filters, Filter)
+
+    explicit ImageFilterProxyModel(QObject *parent = nullptr);
+
+    /**
+     * @brief Set the filtered model
+     * @param sourceModel Must be an ImageGalleryModel
+     */
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    /**
+     * @brief Enable or disable one filter (filters combine with AND)
+     */
+    void setFilter(Filter filter, bool enabled);
+    Filters filters() const { return m_filters; }
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex mapToSource(const QModelIndex& proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex& sourceIndex) const override;
+
+private slots:
+    void onSourceRowsInserted(const QModelIndex& parent, int first, int last);
+    void onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight,
+                             const QList<int>& roles);
+    void rebuild();
+
+private:
+    bool accepts(int sourceRow) const;
+
+    ImageGalleryModel *m_gallery;
+    Filters m_filters;
+    QVector<int> m_rows;                // Accepted source rows, ascending
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ImageFilterProxyModel::Filters)
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // IMAGEGALLERYMODEL_H
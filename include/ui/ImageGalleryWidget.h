@@ -2,7 +2,7 @@
 #define IMAGEGALLERYWIDGET_H
 
 #include <QWidget>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QLabel>
 #include <QProgressBar>
@@ -11,23 +11,11 @@
 #include <QGroupBox>
 #include <QCheckBox>
 #include "core/ImageManager.h"
+#include "ImageGalleryModel.h"
 
 namespace DroneMapper {
 namespace UI {
 
-/**
- * @brief Custom list widget item for image thumbnails
- */
-class ImageThumbnailItem : public QListWidgetItem {
-public:
-    ImageThumbnailItem(const Core::ImageMetadata& metadata, QListWidget *parent = nullptr);
-
-    Core::ImageMetadata metadata() const { return m_metadata; }
-
-private:
-    Core::ImageMetadata m_metadata;
-};
-
 /**
  * @brief Image Gallery Widget
  *
@@ -39,6 +27,11 @@ private:
  * - Export capabilities
  * - GPS visualization
  *
+ * The thumbnail grid is a QListView over ImageGalleryModel, filtered
+ * by ImageFilterProxyModel, with uniform item sizes so only visible
+ * rows are laid out and painted. Metadata is read from the catalog
+ * when an image is selected.
+ *
  * Usage:
  *   ImageGalleryWidget *gallery = new ImageGalleryWidget(this);
  *   gallery->loadDirectory("/path/to/images");
@@ -82,15 +75,13 @@ private slots:
     void onClearClicked();
     void onFilterQualityChanged(int state);
     void onFilterGeotaggedChanged(int state);
-    void onImageItemClicked(QListWidgetItem *item);
+    void onImageClicked(const QModelIndex& index);
     void onScanProgress(int current, int total);
-    void onImageAdded(const Core::ImageMetadata& metadata);
     void onExportKMLClicked();
     void onRefreshStatistics();
 
 private:
     void setupUI();
-    void updateThumbnails();
     void updateMetadataPanel(const Core::ImageMetadata& metadata);
     void updateStatisticsPanel();
     QString formatFileSize(qint64 bytes);
@@ -110,7 +101,9 @@ private:
     QCheckBox *m_filterGeotaggedCheckbox;
 
     // Thumbnail view
-    QListWidget *m_thumbnailList;
+    ImageGalleryModel *m_galleryModel;
+    ImageFilterProxyModel *m_filterModel;
+    QListView *m_thumbnailView;
     QProgressBar *m_scanProgress;
 
     // Info panels
@@ -132,10 +125,6 @@ private:
     QLabel *m_totalSizeLabel;
     QLabel *m_avgSharpnessLabel;
     QLabel *m_timeRangeLabel;
-
-    // State
-    bool m_filterQuality;
-    bool m_filterGeotagged;
 };
 
 } // namespace UI
@@ -16,6 +16,9 @@ namespace Models {
 namespace Core {
     class WeatherService;
 }
+namespace Geospatial {
+    class IncrementalCoverageGenerator;
+}
 namespace Photogrammetry {
     class COLMAPIntegration;
 }
@@ -26,8 +29,20 @@ class WeatherWidget;
 class WindOverlayWidget;
 class TerrainElevationViewer;
 class PointCloudViewer;
+class CrossSectionWidget;
+class AltitudeProfileWidget;
 class SimulationPreviewWidget;
-
+class PlanValidationService;
+struct PlanValidationResult;
+
+/**
+ * @brief Application main window
+ *
+ * Startup shows the window with menus, toolbars and light docks only.
+ * The map (and with it QtWebEngine) is created right after the first
+ * frame; the weather dock, altitude profile, 3D viewers and COLMAP
+ * integration are created on first use through their accessors.
+ */
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
@@ -44,6 +59,7 @@ private slots:
 
     // Map interaction slots
     void onAreaSelected(const QString& geojson);
+    void onAreaVertexMoved(int vertex, double lat, double lng);
     void onFlightPlanRequested();
     void onGenerateFlightPlan();
     void onClearMap();
@@ -55,17 +71,40 @@ private slots:
     void onShowPointCloudViewer();
     void onRunCOLMAPReconstruction();
     void onShowWeatherPanel();
+    void onShowAltitudeProfile();
     void onToggle3DViewers();
     void onLoadPointCloud();
+    void onSectionTool(bool enabled);
+    void onExportSection();
+    void onEstimateNormals();
+    void onClassifyGround();
+    void onCompareClouds();
     void onLoadDEM();
+    void onCompareDEMs();
+    void onExportContours();
+    void onShowViewshed(bool visible);
+    void onLoadOrthomosaic();
     void onPreviewMission();
     void onGenerateReport();
 
+    // Map overlay slots
+    void onShowHillshade(bool visible);
+    void onShowOrthoOverlay(bool visible);
+    void onShowCoverageOverlay(bool visible);
+    void onWorkOffline(bool offline);
+
+    // Diagnostics slots
+    void onRecordTrace(bool enabled);
+    void onSaveTrace();
+
     // COLMAP slots
     void onCOLMAPProgress(double progress, const QString& message);
     void onCOLMAPFinished();
     void onCOLMAPError(const QString& error);
 
+    // Deferred startup, after the first frame
+    void onStartupIdle();
+
 private:
     void createActions();
     void createMenus();
@@ -73,8 +112,24 @@ private:
     void createDockWidgets();
     void readSettings();
     void writeSettings();
+    void reclipDraggedArea();
+    void updateCoverageOverlay();
+    void updateAltitudeProfile();
 
     void closeEvent(QCloseEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+
+    // Live validation of the current plan
+    void onValidationFinished(const PlanValidationResult& result);
+
+    // Lazily created subsystems
+    MapWidget* mapWidget();
+    QDockWidget* weatherDock();
+    QDockWidget* viewersDock();
+    QDockWidget* altitudeProfileDock();
+    TerrainElevationViewer* terrainViewer();
+    PointCloudViewer* pointCloudViewer();
+    Photogrammetry::COLMAPIntegration* colmapIntegration();
 
     // Actions
     QAction *m_newProjectAction;
@@ -91,12 +146,32 @@ private:
     QAction *m_showPointCloudViewerAction;
     QAction *m_runCOLMAPAction;
     QAction *m_showWeatherPanelAction;
+    QAction *m_showAltitudeProfileAction;
     QAction *m_toggle3DViewersAction;
     QAction *m_loadPointCloudAction;
+    QAction *m_sectionToolAction;
+    QAction *m_exportSectionAction;
+    QAction *m_estimateNormalsAction;
+    QAction *m_classifyGroundAction;
+    QAction *m_compareCloudsAction;
     QAction *m_loadDEMAction;
+    QAction *m_compareDEMsAction;
+    QAction *m_exportContoursAction;
+    QAction *m_showViewshedAction;
     QAction *m_previewMissionAction;
     QAction *m_generateReportAction;
 
+    // Map overlay actions
+    QAction *m_loadOrthoAction;
+    QAction *m_showHillshadeAction;
+    QAction *m_showOrthoAction;
+    QAction *m_showCoverageAction;
+    QAction *m_workOfflineAction;
+
+    // Diagnostics actions
+    QAction *m_recordTraceAction;
+    QAction *m_saveTraceAction;
+
     // Menus
     QMenu *m_fileMenu;
     QMenu *m_editMenu;
@@ -117,6 +192,7 @@ private:
     QDockWidget *m_propertiesDock;
     QDockWidget *m_weatherDock;
     QDockWidget *m_viewersDock;
+    QDockWidget *m_altitudeProfileDock;
 
     // Central widget
     MapWidget *m_mapWidget;
@@ -127,15 +203,25 @@ private:
     QTabWidget *m_viewersTab;
     TerrainElevationViewer *m_terrainViewer;
     PointCloudViewer *m_pointCloudViewer;
+    CrossSectionWidget *m_crossSectionWidget;
+    AltitudeProfileWidget *m_altitudeProfile;
     SimulationPreviewWidget *m_simulationPreview;
 
     // COLMAP Integration
     Photogrammetry::COLMAPIntegration* m_colmapIntegration;
     QProgressDialog* m_progressDialog;
 
+    // Background validation, re-run on every plan change
+    PlanValidationService *m_validationService;
+
+    // Coverage of the current survey area, patched while its vertices are dragged
+    Geospatial::IncrementalCoverageGenerator *m_coverageEditor;
+
     // Current state
     QString m_currentAreaGeoJson;
     Models::FlightPlan *m_currentFlightPlan;
+    bool m_areaDragged;             // Vertices moved since the coverage was last clipped
+    bool m_startupScheduled;
 };
 
 } // namespace UI
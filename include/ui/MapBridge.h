@@ -12,7 +12,10 @@ namespace UI {
 /**
  * @brief Bridge between Qt C++ and JavaScript map interface
  *
- * Uses Qt WebChannel to communicate with MapLibre GL running in WebEngine
+ * Uses Qt WebChannel to communicate with MapLibre GL running in WebEngine.
+ * Flight paths are pushed as packed coordinate arrays: a full reset, or a
+ * splice replacing one waypoint range. The page requests a resync when a
+ * splice does not match its current waypoint count.
  */
 class MapBridge : public QObject {
     Q_OBJECT
@@ -24,17 +27,30 @@ signals:
     // Signals emitted to notify Qt application
     void mapReady();
     void areaDrawn(const QString& geojson);
+    void areaVertexMoved(int vertex, double latitude, double longitude);
     void flightPlanRequested(const QString& geojson);
     void waypointAdded(double latitude, double longitude);
     void mapClicked(double latitude, double longitude);
 
+    // Flight path transport (coordinates are base64 packed Float64 lon, lat, alt)
+    void flightPathReset(const QString& coordinates);
+    void flightPathSpliced(int start, int removeCount, int previousCount, const QString& coordinates);
+    void flightPathResyncRequested();
+
+    // Level-of-detail transport for large plans (packed Float64, see FlightPathLOD::View)
+    void flightPathViewUpdated(const QString& route, const QString& waypoints, const QString& clusters);
+    void viewportChanged(double zoom, double west, double south, double east, double north);
+
 public slots:
     // Slots called from JavaScript
     void onMapReady();
     void onAreaDrawn(const QString& geojson);
+    void onAreaVertexMoved(int vertex, double lat, double lng);
     void onGenerateFlightPlan(const QString& geojson);
     void onWaypointClick(double lat, double lng);
     void onMapClick(double lat, double lng);
+    void onFlightPathResync();
+    void onViewportChanged(double zoom, double west, double south, double east, double north);
 };
 
 } // namespace UI
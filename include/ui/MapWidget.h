@@ -2,10 +2,14 @@
 #define MAPWIDGET_H
 
 #include "MapBridge.h"
+#include "FlightPathLOD.h"
+#include "TileSchemeHandler.h"
 #include "FlightPlan.h"
 #include <QWidget>
 #include <QWebEngineView>
 #include <QWebChannel>
+#include <QVector>
+#include <QSet>
 
 namespace DroneMapper {
 namespace UI {
@@ -27,6 +31,10 @@ public:
 
     /**
      * @brief Display flight path on map
+     *
+     * Only the changed waypoint range is sent to the page when the plan
+     * differs from the previously displayed one by a single edit. Large
+     * plans are sent per viewport through FlightPathLOD instead.
      */
     void displayFlightPath(const Models::FlightPlan& plan);
 
@@ -45,6 +53,24 @@ public:
      */
     void setBaseMap(const QString& type); // "satellite" or "street"
 
+    /**
+     * @brief Show or hide a locally rendered overlay
+     * @param name "hillshade", "ortho" or "coverage"
+     *
+     * Remembered and applied again once the page has loaded.
+     */
+    void setOverlayVisible(const QString& name, bool visible);
+
+    /**
+     * @brief Reload an overlay after its source data changed
+     */
+    void refreshOverlay(const QString& name);
+
+    /**
+     * @brief Local tile cache and overlay renderer serving this map
+     */
+    TileSchemeHandler* tileHandler() { return m_tileHandler; }
+
     /**
      * @brief Get the map bridge for signal connections
      */
@@ -52,6 +78,7 @@ public:
 
 signals:
     void areaSelected(const QString& geojson);
+    void areaVertexMoved(int vertex, double lat, double lng);  // While dragging, before areaSelected
     void flightPlanRequested();
     void mapClicked(double lat, double lng);
 
@@ -59,17 +86,31 @@ private slots:
     void onMapReady();
     void onAreaDrawn(const QString& geojson);
     void onFlightPlanRequested(const QString& geojson);
+    void onFlightPathResyncRequested();
+    void onViewportChanged(double zoom, double west, double south, double east, double north);
 
 private:
     void setupWebChannel();
     QString loadMapHtml();
-    QString flightPlanToGeoJson(const Models::FlightPlan& plan);
+    void sendFlightPathReset();
+    void sendFlightPathView();
+    void fitToFlightPath();
+    static QString packCoordinates(const double* data, int count);
 
     QWebEngineView* m_webView;
     QWebChannel* m_channel;
     MapBridge* m_bridge;
+    TileSchemeHandler* m_tileHandler;
 
     QString m_currentAreaGeoJson;
+    QSet<QString> m_visibleOverlays;
+
+    QVector<double> m_flightPath;   // lon, lat, alt per waypoint, as shown on the page
+    bool m_mapReady;
+
+    FlightPathLOD m_pathLOD;        // Built only for plans above the LOD threshold
+    double m_viewZoom;
+    QRectF m_viewBounds;            // x = longitude, y = latitude
 };
 
 } // namespace UI
@@ -79,6 +79,8 @@ private:
     QDoubleSpinBox *m_maxSpeedSpinBox;
     QDoubleSpinBox *m_takeoffAltitudeSpinBox;
     QDoubleSpinBox *m_flightDirectionSpinBox;
+    QDoubleSpinBox *m_boundaryInsetSpinBox;
+    QDoubleSpinBox *m_turnOvershootSpinBox;
     QComboBox *m_patternTypeCombo;
     QComboBox *m_finishActionCombo;
     QCheckBox *m_reversePathCheckBox;
@@ -0,0 +1,125 @@
+#ifndef NORMALESTIMATOR_H
+#define NORMALESTIMATOR_H
+
+#include <QVector>
+#include <QVector3D>
+#include <atomic>
+
+namespace DroneMapper {
+namespace UI {
+
+struct PointCloud;
+class PointCloudKDTree;
+
+/**
+ * @brief Surface normal estimation for point clouds without normals
+ *
+ * Features:
+ * - KD-tree built once per cloud
+ * - kNN PCA per point with a closed-form 3x3 symmetric eigen solver
+ * - Parallel processing in fixed-size chunks (QtConcurrent)
+ * - Consistent orientation toward a viewpoint or an up-vector
+ * - Compact 16-bit octahedral normal encoding
+ *
+ * Usage:
+ *   NormalEstimator::Options options;
+ *   options.orientation = NormalEstimator::TowardViewpoint;
+ *   options.viewpoint = camera.position();
+ *   NormalEstimator::estimate(cloud, options);
+ */
+class NormalEstimator {
+public:
+    enum Orientation {
+        TowardViewpoint,    // Flip normals to face the viewpoint (scanner/camera)
+        TowardUp            // Flip normals to face the up-vector (aerial data)
+    };
+
+    struct Options {
+        int neighbors;              // k nearest neighbours used for PCA
+        int chunkSize;              // Points per parallel work item
+        Orientation orientation;
+        QVector3D viewpoint;        // Used with TowardViewpoint
+        QVector3D up;               // Used with TowardUp and as degenerate fallback
+
+        Options()
+            : neighbors(12)
+            , chunkSize(16384)
+            , orientation(TowardUp)
+            , viewpoint(0, 0, 0)
+            , up(0, 0, 1)
+        {}
+    };
+
+    /**
+     * @brief Estimate normals and store them in the cloud
+     *
+     * Fills PointCloud::packedNormals with oct-encoded normals, decodes
+     * them into Point::normal for rendering and sets hasNormals.
+     *
+     * @param cloud Point cloud (modified in place)
+     * @param options Estimation options
+     * @param cancelled Polled per chunk; a set flag leaves the cloud unchanged
+     * @return True if normals were estimated
+     */
+    static bool estimate(PointCloud& cloud, const Options& options = Options(),
+                         const std::atomic<bool>* cancelled = nullptr);
+
+    /**
+     * @brief Estimate oct-encoded normals using a prebuilt KD-tree
+     * @param cloud Point cloud the tree was built from
+     * @param tree KD-tree over cloud positions
+     * @param options Estimation options
+     * @param cancelled Polled per chunk; a set flag skips the remaining chunks
+     * @return One oct-encoded normal per point
+     */
+    static QVector<quint16> estimatePacked(
+        const PointCloud& cloud,
+        const PointCloudKDTree& tree,
+        const Options& options = Options(),
+        const std::atomic<bool>* cancelled = nullptr);
+
+    /**
+     * @brief Fit a plane normal to a neighbourhood
+     * @param points Neighbour positions
+     * @param count Number of positions
+     * @param up Fallback direction for degenerate neighbourhoods
+     * @return Unit normal (unoriented)
+     */
+    static QVector3D fitNormal(const QVector3D* points, int count, const QVector3D& up);
+
+    /**
+     * @brief Smallest-eigenvalue eigenvector of a symmetric 3x3 matrix
+     *
+     * Closed-form trigonometric solution; no iteration.
+     *
+     * @param a00..a22 Upper triangle of the matrix
+     * @param fallback Returned when the matrix is isotropic
+     * @return Unit eigenvector
+     */
+    static QVector3D smallestEigenvector(
+        double a00, double a01, double a02,
+        double a11, double a12, double a22,
+        const QVector3D& fallback);
+
+    /**
+     * @brief Encode a unit normal as two 8-bit octahedral coordinates
+     * @param normal Unit normal
+     * @return Packed normal (x in low byte, y in high byte)
+     */
+    static quint16 encodeOct(const QVector3D& normal);
+
+    /**
+     * @brief Decode an octahedral-packed normal
+     * @param packed Packed normal
+     * @return Unit normal
+     */
+    static QVector3D decodeOct(quint16 packed);
+
+private:
+    NormalEstimator() = delete;  // Static class, no instantiation
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // NORMALESTIMATOR_H
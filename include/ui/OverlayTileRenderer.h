@@ -0,0 +1,125 @@
+#ifndef OVERLAYTILERENDERER_H
+#define OVERLAYTILERENDERER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QPolygonF>
+#include <QCache>
+#include <QMutex>
+#include <memory>
+
+namespace DroneMapper {
+namespace Geospatial {
+class RasterTileReader;
+}
+
+namespace UI {
+
+/**
+ * @brief On-demand PNG tiles for locally generated map overlays
+ *
+ * Features:
+ * - DEM hillshade (Horn gradients, corrected for Mercator scale)
+ * - Quick-look orthomosaic (first three bands, or grey from band 1)
+ * - Photo coverage heatmap from image footprints (overlap count)
+ * - Tiles in the Web Mercator XYZ grid MapLibre requests, 256 px
+ * - Encoded tiles kept in a byte-bounded LRU; empty tiles are cached
+ *   too, so panning over areas without data costs nothing
+ *
+ * Rasters are reprojected to EPSG:3857 on the fly. tile() may be
+ * called from worker threads.
+ *
+ * Usage:
+ *   OverlayTileRenderer renderer;
+ *   renderer.setElevationSource("dsm.tif");
+ *   QByteArray png = renderer.tile(OverlayTileRenderer::Layer::Hillshade, 16, x, y);
+ */
+class OverlayTileRenderer {
+public:
+    enum class Layer {
+        Hillshade,
+        Ortho,
+        Coverage
+    };
+
+    /**
+     * @brief Create a renderer
+     * @param cacheBytes Maximum size of cached encoded tiles
+     */
+    explicit OverlayTileRenderer(int cacheBytes = 64 * 1024 * 1024);
+    ~OverlayTileRenderer();
+
+    /**
+     * @brief Set DEM used for the hillshade layer
+     * @param filePath Elevation raster (empty to clear)
+     * @return True if opened
+     */
+    bool setElevationSource(const QString& filePath);
+
+    /**
+     * @brief Set raster used for the ortho layer
+     * @param filePath Orthomosaic raster (empty to clear)
+     * @return True if opened
+     */
+    bool setOrthoSource(const QString& filePath);
+
+    /**
+     * @brief Set image footprints for the coverage layer
+     * @param footprints Polygons with x = longitude, y = latitude
+     */
+    void setCoverageFootprints(const QVector<QPolygonF>& footprints);
+
+    /**
+     * @brief Render (or fetch from cache) one tile
+     * @param layer Overlay layer
+     * @param zoom Zoom level
+     * @param x Tile column
+     * @param y Tile row (north at 0)
+     * @return PNG data, empty if the layer has no data in the tile
+     */
+    QByteArray tile(Layer layer, int zoom, int x, int y);
+
+    /**
+     * @brief Parse a layer name ("hillshade", "ortho", "coverage")
+     * @return True if the name is known
+     */
+    static bool layerFromName(const QString& name, Layer* layer);
+
+private:
+    struct TileBounds {
+        double minX;            // EPSG:3857 meters
+        double maxY;
+        double pixelSize;
+    };
+
+    struct Footprint {
+        QPolygonF polygon;      // EPSG:3857 meters
+        QRectF bounds;
+    };
+
+    std::unique_ptr<Geospatial::RasterTileReader> m_elevation;
+    std::unique_ptr<Geospatial::RasterTileReader> m_ortho;
+    QVector<Footprint> m_footprints;
+
+    QCache<QString, QByteArray> m_cache;
+    quint64 m_generation;       // Bumped by clearCache; tiles rendered across a bump are not cached
+    QMutex m_cacheMutex;
+    QMutex m_elevationMutex;    // GDAL datasets are not thread-safe
+    QMutex m_orthoMutex;
+    QMutex m_footprintMutex;
+
+    QByteArray renderHillshade(const TileBounds& tile);
+    QByteArray renderOrtho(const TileBounds& tile);
+    QByteArray renderCoverage(const TileBounds& tile);
+    void clearCache();
+
+    static TileBounds tileBounds(int zoom, int x, int y);
+    static bool readTile(Geospatial::RasterTileReader& reader, const TileBounds& tile, int band,
+                         int border, QVector<float>& values, QRect& area);
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // OVERLAYTILERENDERER_H
@@ -0,0 +1,164 @@
+#ifndef PLANVALIDATIONSERVICE_H
+#define PLANVALIDATIONSERVICE_H
+
+#include <QObject>
+#include <QRectF>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include "models/FlightPlan.h"
+#include "core/NoFlyZoneChecker.h"
+#include "core/AltitudeSafetyChecker.h"
+#include "core/BatteryManager.h"
+#include "core/ProjectedPlan.h"
+#include "photogrammetry/QualityEstimator.h"
+
+class QTimer;
+
+namespace DroneMapper {
+namespace UI {
+
+struct DEMData;
+
+/**
+ * @brief Combined outcome of one validation run
+ *
+ * Published as a whole: the UI never sees no-fly results from one
+ * edit next to battery results from another.
+ */
+struct PlanValidationResult {
+    quint64 runId;                          // 0 = nothing validated yet
+    quint64 planRevision;                   // FlightPlan::revision() that was validated
+    int waypointCount;
+    Core::NoFlyCheckResult noFly;
+    Core::SafetyCheckResult altitude;
+    QList<Core::SubMission> batteryPlan;
+    int batteriesRequired;
+    double batteryUsage;                    // Percent of one battery
+    Photogrammetry::QualityEstimate quality;
+    int zonesChecked;                       // Zones left after the bounds prefilter
+    qint64 elapsedMs;                       // Worker time for the run
+
+    PlanValidationResult();
+
+    bool isSafe() const { return noFly.isSafe && altitude.isSafe; }
+    QString summary() const;
+};
+
+/**
+ * @brief Re-validates the flight plan in the background after every edit
+ *
+ * Features:
+ * - No-fly, altitude, battery and quality checks in one pass on a
+ *   worker thread
+ * - Edits debounced (50 ms default); a new edit cancels the run in
+ *   flight, which the checks notice inside their waypoint loops
+ * - One immutable snapshot per run: the plan copy (with its cached
+ *   segment geometry) and its waypoints projected once to local
+ *   meters (Core::ProjectedPlan). The bounds drop zones that cannot
+ *   touch the plan; the no-fly check and battery split then work on
+ *   the projected points
+ * - With a DEM set, terrain line of sight and operator range from the
+ *   launch point (first waypoint); violations join the altitude result
+ * - Results of stale runs are discarded; the current run's result is
+ *   published in a single signal
+ *
+ * Usage:
+ *   service->setZoneDatabase(database);
+ *   connect(service, &PlanValidationService::validationFinished, ...);
+ *   service->submitPlan(plan);   // on every edit
+ */
+class PlanValidationService : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PlanValidationService(QObject *parent = nullptr);
+    ~PlanValidationService() override;
+
+    void setZoneDatabase(const Core::ZoneDatabase& database);
+    void setRegulatoryLimits(const Core::RegulatoryLimits& limits);
+    void setDebounceInterval(int ms);
+
+    /**
+     * @brief Check visual line of sight over this terrain
+     * @param dem DEM data (copied; the line-of-sight pyramid is built here)
+     */
+    void setTerrain(const DEMData& dem);
+
+    /**
+     * @brief Stop checking visual line of sight
+     */
+    void clearTerrain();
+
+    /**
+     * @brief Schedule validation of an edited plan
+     * @param plan Plan after the edit (copied; cheap, implicitly shared)
+     */
+    void submitPlan(const Models::FlightPlan& plan);
+
+    /**
+     * @brief Skip the debounce and validate the last submitted plan now
+     */
+    void validateNow();
+
+    /**
+     * @brief Cancel pending and running validation
+     */
+    void cancel();
+
+    /**
+     * @brief Run every check on the calling thread (benchmarks, tools)
+     * @return Result of one uncancelled run; runId stays 0
+     */
+    static PlanValidationResult validate(const Models::FlightPlan& plan, const Core::ZoneDatabase& zones,
+                                         const Core::RegulatoryLimits& limits);
+
+    const Core::ZoneDatabase& zoneDatabase() const { return m_zones; }
+    bool isRunning() const { return m_running; }
+    const PlanValidationResult& result() const { return m_result; }
+
+signals:
+    void validationStarted(quint64 runId);
+    void validationFinished(const DroneMapper::UI::PlanValidationResult& result);
+
+private:
+    // DEM and its line-of-sight pyramid, shared read-only by runs
+    struct Terrain;
+
+    /**
+     * @brief Everything a run reads; never touched after the run starts
+     */
+    struct Snapshot {
+        Models::FlightPlan plan;
+        Core::ZoneDatabase zones;
+        Core::RegulatoryLimits limits;
+        std::shared_ptr<const Terrain> terrain;     // Null = no VLOS check
+    };
+
+    QTimer *m_debounceTimer;
+    QThreadPool m_pool;
+    std::shared_ptr<std::atomic<bool>> m_cancelled;     // Token of the run in flight
+
+    Models::FlightPlan m_plan;
+    Core::ZoneDatabase m_zones;
+    Core::RegulatoryLimits m_limits;
+    std::shared_ptr<const Terrain> m_terrain;
+    bool m_hasPlan;
+
+    quint64 m_latestRunId;
+    bool m_running;
+    PlanValidationResult m_result;
+
+    void startRun();
+    void onRunFinished(quint64 runId, const PlanValidationResult& result);
+
+    static bool runChecks(const Snapshot& snapshot, const std::atomic<bool>& cancelled,
+                          PlanValidationResult& result);
+    static Core::ZoneDatabase zonesNear(const Core::ZoneDatabase& database, const QRectF& bounds,
+                                        const Models::GeospatialCoordinate& origin);
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // PLANVALIDATIONSERVICE_H
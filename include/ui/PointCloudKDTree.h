@@ -0,0 +1,128 @@
+#ifndef POINTCLOUDKDTREE_H
+#define POINTCLOUDKDTREE_H
+
+#include <QVector>
+#include <QVector3D>
+
+namespace DroneMapper {
+namespace UI {
+
+struct PointCloud;
+
+/**
+ * @brief Static 3D KD-tree for nearest-neighbour queries on point clouds
+ *
+ * The tree is built once over a snapshot of point positions and is
+ * read-only afterwards, so concurrent queries from worker threads are
+ * safe. Positions are copied into tree order (structure-of-arrays) so
+ * leaf scans walk contiguous memory instead of chasing QVector<Point>.
+ *
+ * Usage:
+ *   PointCloudKDTree tree;
+ *   tree.build(cloud);
+ *   int found = tree.knn(query, 12, indices, distancesSq);
+ */
+class PointCloudKDTree {
+public:
+    PointCloudKDTree();
+
+    /**
+     * @brief Build tree from point cloud positions
+     * @param cloud Point cloud
+     * @param leafSize Maximum points per leaf
+     */
+    void build(const PointCloud& cloud, int leafSize = 16);
+
+    /**
+     * @brief Build tree from raw positions
+     * @param positions Point positions
+     * @param leafSize Maximum points per leaf
+     */
+    void build(const QVector<QVector3D>& positions, int leafSize = 16);
+
+    /**
+     * @brief Release all tree memory
+     */
+    void clear();
+
+    /**
+     * @brief Check if the tree holds any points
+     * @return True if empty
+     */
+    bool isEmpty() const { return m_indices.isEmpty(); }
+
+    /**
+     * @brief Get number of indexed points
+     * @return Point count
+     */
+    int size() const { return m_indices.size(); }
+
+    /**
+     * @brief Find the k nearest neighbours of a query position
+     * @param query Query position
+     * @param k Number of neighbours requested
+     * @param outIndices Output buffer of at least k original point indices
+     * @param outDistancesSq Output buffer of at least k squared distances
+     * @return Number of neighbours found, sorted nearest first
+     */
+    int knn(const QVector3D& query, int k, int* outIndices, float* outDistancesSq) const;
+
+    /**
+     * @brief Find the single nearest neighbour
+     * @param query Query position
+     * @param outDistanceSq Squared distance to the neighbour (optional)
+     * @return Original point index (-1 if empty)
+     */
+    int nearest(const QVector3D& query, float* outDistanceSq = nullptr) const;
+
+    /**
+     * @brief Find all points within a radius
+     * @param query Query position
+     * @param radius Search radius
+     * @param outIndices Receives original point indices (appended)
+     */
+    void radiusSearch(const QVector3D& query, float radius, QVector<int>& outIndices) const;
+
+    /**
+     * @brief Get indexed position of an original point index
+     * @param index Original point index
+     * @return Position
+     */
+    QVector3D position(int index) const;
+
+private:
+    struct Node {
+        float split;     // Split coordinate (inner nodes)
+        int axis;        // 0/1/2 for inner nodes, -1 for leaves
+        int begin;       // First slot in tree order (leaves)
+        int end;         // One past last slot (leaves)
+        int left;        // Child node indices (inner nodes)
+        int right;
+    };
+
+    struct KnnHeap {
+        int* indices;
+        float* distancesSq;
+        int capacity;
+        int count;
+        float worst() const;
+        void push(int index, float distanceSq);
+    };
+
+    QVector<Node> m_nodes;
+    QVector<int> m_indices;     // Tree slot -> original point index
+    QVector<int> m_slotOf;      // Original point index -> tree slot
+    QVector<float> m_x;         // Positions in tree order
+    QVector<float> m_y;
+    QVector<float> m_z;
+
+    int buildNode(int begin, int end, int leafSize);
+    void knnNode(int nodeIndex, float qx, float qy, float qz, KnnHeap& heap) const;
+    void radiusNode(int nodeIndex, float qx, float qy, float qz,
+                    float radiusSq, QVector<int>& out) const;
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // POINTCLOUDKDTREE_H
@@ -8,6 +8,11 @@
 #include <QColor>
 #include <QString>
 #include <QVector>
+#include <QPointF>
+#include <QWidget>
+#include "NormalEstimator.h"
+#include "GroundClassifier.h"
+#include "CloudComparator.h"
 
 namespace DroneMapper {
 namespace UI {
@@ -40,6 +45,9 @@ struct PointCloud {
     QVector3D minBounds;
     QVector3D maxBounds;
     QVector3D centroid;
+    QVector<quint16> packedNormals;  // Oct-encoded normals (estimated clouds)
+    QVector<float> scalarField;      // Optional per-point value (e.g. change distance)
+    QString scalarFieldName;
 
     bool hasColors;
     bool hasNormals;
@@ -94,6 +102,13 @@ struct PointCloud {
      */
     bool loadFromXYZ(const QString& filePath);
 
+    /**
+     * @brief Load from PLY, LAS/LAZ or XYZ chosen by file extension
+     * @param filePath Path to point cloud file
+     * @return True if loaded successfully
+     */
+    bool loadFromFile(const QString& filePath);
+
     /**
      * @brief Save to PLY file
      * @param filePath Output path
@@ -151,7 +166,8 @@ public:
         Classification, // Color by LAS classification
         Normal,         // Color by normal direction
         RGB,            // Use point colors
-        Uniform         // Single color
+        Uniform,        // Single color
+        ScalarField     // Color by PointCloud::scalarField (diverging)
     };
 
     /**
@@ -183,6 +199,34 @@ public:
      * @return Color
      */
     static QColor getColorForNormal(const QVector3D& normal);
+
+    /**
+     * @brief Get diverging color for a scalar value
+     *
+     * Blue (negative) → White (zero) → Red (positive), symmetric
+     * around zero so cut and fill read at a glance.
+     *
+     * @param value Scalar value
+     * @param maxAbs Magnitude mapped to full saturation
+     * @return Color
+     */
+    static QColor getColorForScalar(float value, float maxAbs);
+};
+
+/**
+ * @brief Oriented bounding box used for slab queries
+ */
+struct OrientedBox {
+    QVector3D center;
+    QVector3D axes[3];          // Orthonormal box axes
+    QVector3D halfExtents;      // Half-size along each axis
+
+    /**
+     * @brief Check if a position lies inside the box
+     * @param position Position to test
+     * @return True if inside
+     */
+    bool contains(const QVector3D& position) const;
 };
 
 /**
@@ -224,6 +268,17 @@ public:
      */
     QVector<int> queryFrustum(const QVector<QVector4D>& frustumPlanes);
 
+    /**
+     * @brief Query points inside an oriented box
+     *
+     * Nodes are culled with a separating-axis test; nodes entirely
+     * inside the box are collected without per-point tests.
+     *
+     * @param box Oriented box
+     * @return Point indices inside the box
+     */
+    QVector<int> queryOrientedBox(const OrientedBox& box) const;
+
     /**
      * @brief Get LOD level for node
      * @param node Node
@@ -239,6 +294,8 @@ private:
     void buildNode(OctreeNode* node, const QVector<int>& indices, int maxPointsPerNode);
     void queryNode(OctreeNode* node, const QVector<QVector4D>& planes, QVector<int>& result);
     void deleteNode(OctreeNode* node);
+    void queryBoxNode(const OctreeNode* node, const OrientedBox& box, QVector<int>& result) const;
+    void collectNode(const OctreeNode* node, QVector<int>& result) const;
 };
 
 /**
@@ -307,6 +364,95 @@ private:
     double calculateAngle();
 };
 
+/**
+ * @brief Sample of a cross-section through a point cloud
+ */
+struct SectionPoint {
+    double station;     // Distance along the section polyline (meters)
+    double offset;      // Signed distance left (+) / right (-) of the line
+    double elevation;   // Point Z
+    int pointIndex;     // Index into the source cloud
+};
+
+/**
+ * @brief Cross-section / profile extraction from point clouds
+ *
+ * Each polyline segment becomes an oriented slab (segment length x slab
+ * width x cloud height) queried through the octree, so only nodes the
+ * slab touches are visited. Slabs are cut at the bisector planes of
+ * the joints, so at a bend every point belongs to exactly one segment.
+ *
+ * Usage:
+ *   QVector<SectionPoint> section = CrossSection::extract(cloud, octree, line, 2.0);
+ *   CrossSection::exportCSV(section, "profile.csv");
+ */
+class CrossSection {
+public:
+    /**
+     * @brief Extract a section along an XY polyline
+     * @param cloud Point cloud
+     * @param octree Octree built over the cloud
+     * @param polyline Section line vertices (cloud XY coordinates)
+     * @param slabWidth Full slab width (meters)
+     * @return Section points sorted by station
+     */
+    static QVector<SectionPoint> extract(
+        const PointCloud& cloud,
+        const Octree& octree,
+        const QVector<QPointF>& polyline,
+        double slabWidth);
+
+    /**
+     * @brief Export section as CSV (station, offset, elevation, x, y, z)
+     * @param section Section points
+     * @param cloud Source cloud (for XYZ columns)
+     * @param filePath Output path
+     * @return True if written successfully
+     */
+    static bool exportCSV(const QVector<SectionPoint>& section,
+                          const PointCloud& cloud,
+                          const QString& filePath);
+
+    /**
+     * @brief Export section as DXF POINT entities in station/elevation space
+     * @param section Section points
+     * @param filePath Output path
+     * @return True if written successfully
+     */
+    static bool exportDXF(const QVector<SectionPoint>& section, const QString& filePath);
+};
+
+/**
+ * @brief Cross-section profile widget
+ *
+ * Displays section points in station/elevation space, coloured by
+ * offset from the section line.
+ */
+class CrossSectionWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit CrossSectionWidget(QWidget* parent = nullptr);
+
+    /**
+     * @brief Set section to display
+     * @param section Section points
+     * @param slabWidth Slab width used for the offset colour ramp
+     */
+    void setSection(const QVector<SectionPoint>& section, double slabWidth);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QVector<SectionPoint> m_section;
+    double m_slabWidth;
+    double m_minStation;
+    double m_maxStation;
+    double m_minElevation;
+    double m_maxElevation;
+};
+
 /**
  * @brief 3D Point cloud viewer widget
  *
@@ -383,6 +529,41 @@ public:
      */
     PointCloudCamera& camera() { return m_camera; }
 
+    /**
+     * @brief Take over per-point attributes computed on a copy of the cloud
+     *
+     * For processing run off the GUI thread on a copy of pointCloud()
+     * (e.g. estimated normals). Positions must be unchanged, so the
+     * octree and camera are kept.
+     *
+     * @param processed Processed copy of the loaded cloud
+     * @return False if the copy no longer matches the loaded cloud
+     */
+    bool updatePointAttributes(const PointCloud& processed);
+
+    /**
+     * @brief Show a ground classification computed on a copy of the cloud
+     *
+     * Takes over the classification codes (LAS class 2 = ground) and
+     * switches the view to the classification colour scheme.
+     *
+     * @param classified Copy of pointCloud() run through GroundClassifier
+     * @return False if the copy no longer matches the loaded cloud
+     */
+    bool showGroundClassification(const PointCloud& classified);
+
+    /**
+     * @brief Show change distances computed on a copy of the cloud
+     *
+     * Takes over the per-point distances in the scalar field and
+     * switches to the scalar field colour scheme.
+     *
+     * @param compared Copy of pointCloud() run through CloudComparator
+     * @param result Distance statistics, used for the colour range
+     * @return False if the copy no longer matches the loaded cloud
+     */
+    bool showDistances(const PointCloud& compared, const CloudComparator::Result& result);
+
     /**
      * @brief Export point cloud to file
      * @param filePath Output file path
@@ -411,6 +592,31 @@ public:
      */
     void enableMeasurement(bool enabled, MeasurementTool::MeasurementType type);
 
+    /**
+     * @brief Enable interactive section mode
+     *
+     * While enabled, dragging with the left button draws a section line
+     * on the plane through the cloud centroid and re-extracts the section
+     * on every move.
+     *
+     * @param enabled Enable state
+     * @param slabWidth Full slab width (meters)
+     */
+    void enableSectionMode(bool enabled, double slabWidth = 2.0);
+
+    /**
+     * @brief Set section polyline and extract it
+     * @param polyline Section line vertices (cloud XY coordinates)
+     * @param slabWidth Full slab width (meters)
+     */
+    void setSectionLine(const QVector<QPointF>& polyline, double slabWidth);
+
+    /**
+     * @brief Get last extracted section
+     * @return Section points
+     */
+    const QVector<SectionPoint>& section() const { return m_section; }
+
     /**
      * @brief Get statistics
      * @return Point cloud statistics string
@@ -422,6 +628,7 @@ signals:
     void renderingError(const QString& error);
     void pointSelected(int pointIndex);
     void measurementCompleted(double value, const QString& label);
+    void sectionUpdated(const QVector<DroneMapper::UI::SectionPoint>& section, double slabWidth);
 
 protected:
     void initializeGL() override;
@@ -438,12 +645,20 @@ private:
     PointCloudSettings m_settings;
     PointCloudCamera m_camera;
     PointCloudColorMap::Scheme m_colorScheme;
+    float m_scalarRange;    // |value| mapped to full saturation for ScalarField
     Octree m_octree;
     MeasurementTool m_measurement;
 
     bool m_measurementMode;
     MeasurementTool::MeasurementType m_measurementType;
 
+    // Cross-section
+    bool m_sectionMode;
+    bool m_sectionDragging;
+    double m_sectionWidth;
+    QVector<QPointF> m_sectionLine;
+    QVector<SectionPoint> m_section;
+
     // Mouse interaction
     QPoint m_lastMousePos;
     bool m_leftButtonPressed;
@@ -455,13 +670,16 @@ private:
     void renderNormals();
     void renderMeasurements();
     void renderBoundingBox();
+    void renderSectionLine();
 
     // Color mapping
-    QColor getPointColor(const Point& point);
+    QColor getPointColor(const Point& point, int index);
 
     // Point picking
     int pickPoint(const QPoint& screenPos);
     QVector3D screenToWorld(const QPoint& screenPos, float depth);
+    bool screenToSectionPlane(const QPoint& screenPos, QPointF& planePos);
+    void updateSection();
 
     // LOD rendering
     QVector<int> getVisiblePoints();
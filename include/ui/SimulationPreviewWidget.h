@@ -10,12 +10,74 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGroupBox>
+#include <QTimer>
+#include <QPixmap>
+#include <QVector>
 #include "core/MissionSimulator.h"
 #include "models/FlightPlan.h"
 
 namespace DroneMapper {
 namespace UI {
 
+/**
+ * @brief Top-down flight path view with a moving drone marker
+ *
+ * Drawn in two layers:
+ * - Static: grid, flight path and waypoints, rendered once into a
+ *   pixmap and only re-rendered when the plan or the size changes
+ * - Dynamic: drone marker, heading and recent trail, painted on top
+ *
+ * Moving the drone only repaints the area the dynamic layer covered
+ * before and after the move.
+ */
+class SimulationCanvas : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit SimulationCanvas(QWidget *parent = nullptr);
+
+    /**
+     * @brief Set the plan drawn in the static layer (clears the trail)
+     * @param plan Flight plan
+     */
+    void setFlightPlan(const Models::FlightPlan& plan);
+
+    /**
+     * @brief Move the drone marker and extend the trail
+     * @param position Current drone position
+     * @param waypointIndex Waypoint the drone last passed
+     */
+    void setDronePosition(const Models::GeospatialCoordinate& position, int waypointIndex);
+
+    /**
+     * @brief Remove the drone marker and trail
+     */
+    void clearTrail();
+
+    /**
+     * @brief Text shown while no plan is loaded
+     */
+    void setPlaceholderText(const QString& text);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void renderStaticLayer();
+    QPointF toScreen(const QPointF& lonLat) const;
+    QRect dynamicBounds() const;
+
+    QVector<QPointF> m_waypoints;   // x = longitude, y = latitude
+    QRectF m_bounds;                // Padded plan extent
+    QPixmap m_staticLayer;
+    bool m_staticDirty;
+
+    QVector<QPointF> m_trail;       // Recent positions, oldest first
+    int m_droneWaypoint;            // -1 when no drone is shown
+    QString m_placeholder;
+};
+
 /**
  * @brief Simulation Preview Widget
  *
@@ -28,6 +90,10 @@ namespace UI {
  * - Validation warnings
  * - Progress tracking
  *
+ * Simulator signals are coalesced: each one only records the latest
+ * state, and the canvas and labels are refreshed at most once per
+ * display frame, so high playback speeds do not flood the GUI thread.
+ *
  * Usage:
  *   SimulationPreviewWidget *preview = new SimulationPreviewWidget(this);
  *   preview->loadFlightPlan(flightPlan);
@@ -73,6 +139,7 @@ private slots:
     void onBatteryChangeRequired(int batteryNumber);
     void onSimulationCompleted(const Core::SimulationStatistics& statistics);
     void onWarning(const QString& message);
+    void onFrame();
 
 protected:
     void closeEvent(QCloseEvent *event) override;
@@ -81,7 +148,7 @@ private:
     void setupUI();
     void updateStatisticsDisplay();
     void updateStateDisplay(const Core::SimulationState& state);
-    void drawFlightPath();
+    void scheduleFrame();
     QString formatTime(int seconds) const;
     QString formatDistance(double meters) const;
 
@@ -93,8 +160,7 @@ private:
     QVBoxLayout *m_mainLayout;
 
     // Visualization area
-    QLabel *m_visualizationLabel;
-    QPixmap m_flightPathPixmap;
+    SimulationCanvas *m_canvas;
 
     // Control panel
     QGroupBox *m_controlGroup;
@@ -129,6 +195,14 @@ private:
 
     // State
     bool m_isPlaying;
+
+    // Coalesced updates, applied by onFrame()
+    QTimer *m_frameTimer;
+    Core::SimulationState m_pendingState;
+    bool m_statePending;
+    int m_reachedWaypoint;          // -1 when none since the last frame
+    int m_capturedPhoto;            // -1 when none since the last frame
+    int m_batteryLevel;             // Colour bucket currently applied
 };
 
 } // namespace UI
@@ -0,0 +1,202 @@
+#ifndef TERRAINCHUNKRENDERER_H
+#define TERRAINCHUNKRENDERER_H
+
+#include <QOpenGLFunctions>
+#include <QOpenGLBuffer>
+#include <QOpenGLShaderProgram>
+#include <QColor>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+#include <QHash>
+#include <QVector>
+
+namespace DroneMapper {
+namespace UI {
+
+struct DEMData;
+
+/**
+ * @brief Min/max quadtree over a DEM
+ *
+ * Leaves cover a fixed number of DEM cells; every node stores the
+ * elevation range of its footprint so LOD selection and culling can
+ * use tight bounding boxes.
+ */
+class TerrainQuadtree {
+public:
+    struct Node {
+        int x;          // Footprint origin (DEM cells)
+        int y;
+        int size;       // Footprint edge length (DEM cells)
+        int level;      // 0 = leaf
+        float minZ;
+        float maxZ;
+        int parent;     // -1 for root
+        int children[4];// -1 where the child lies outside the DEM
+    };
+
+    TerrainQuadtree();
+
+    /**
+     * @brief Build the quadtree
+     * @param dem DEM data
+     * @param leafCells Leaf footprint in DEM cells (power of two)
+     */
+    void build(const DEMData& dem, int leafCells);
+
+    void clear();
+
+    const QVector<Node>& nodes() const { return m_nodes; }
+    int rootLevel() const { return m_rootLevel; }
+    int leafCells() const { return m_leafCells; }
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+
+private:
+    QVector<Node> m_nodes;
+    int m_rootLevel;
+    int m_leafCells;
+
+    int buildNode(const DEMData& dem, int x, int y, int size, int level, int parent);
+};
+
+/**
+ * @brief Chunked continuous-LOD terrain renderer (CDLOD)
+ *
+ * Features:
+ * - Quadtree LOD selection by camera distance with frustum culling
+ * - Each selected node drawn as a fixed-resolution VBO patch sharing
+ *   one index buffer
+ * - Per-vertex morph targets so vertices blend smoothly into the next
+ *   coarser level before a switch (no popping, no cracks)
+ * - Patches streamed on demand from the DEM into an LRU-bounded GPU
+ *   cache with a per-frame upload budget; missing patches fall back to
+ *   the nearest cached ancestor
+ *
+ * Must be initialized and used with the owning widget's GL context current.
+ *
+ * Usage:
+ *   renderer.initialize();
+ *   renderer.setDEM(&dem, exaggeration, colorScheme, true);
+ *   renderer.render(projection * view, cameraPosition, true);
+ */
+class TerrainChunkRenderer : protected QOpenGLFunctions {
+public:
+    struct Statistics {
+        int selectedNodes;
+        int drawnPatches;
+        int uploadedPatches;
+        int cachedPatches;
+    };
+
+    TerrainChunkRenderer();
+    ~TerrainChunkRenderer();
+
+    /**
+     * @brief Create shaders and the shared index buffer
+     * @return True if GL resources were created
+     */
+    bool initialize();
+
+    /**
+     * @brief Release all GL resources
+     */
+    void cleanup();
+
+    /**
+     * @brief Set DEM and appearance; invalidates all cached patches
+     * @param dem DEM data (must outlive the renderer or the next setDEM)
+     * @param verticalExaggeration Z scale
+     * @param colorScheme ElevationColorScheme::Scheme value
+     * @param colorByElevation Use elevation ramp instead of flat gray
+     */
+    void setDEM(const DEMData* dem, double verticalExaggeration,
+                int colorScheme, bool colorByElevation);
+
+    /**
+     * @brief Colour the terrain by a georeferenced scalar layer (e.g. DEM of difference)
+     * @param overlay Layer sampled by geographic position (null = none; must outlive the renderer)
+     * @param maxAbsValue Value mapped to full colour saturation
+     */
+    void setOverlay(const DEMData* overlay, float maxAbsValue);
+
+    /**
+     * @brief Draw all patches in one unlit colour (e.g. a wireframe pass)
+     * @param color Solid colour; an invalid QColor restores the terrain colours
+     */
+    void setSolidColor(const QColor& color);
+
+    /**
+     * @brief Set LOD distance for the finest level
+     * @param distance World distance covered by level 0 (meters)
+     */
+    void setDetailDistance(float distance) { m_detailDistance = distance; computeLodRanges(); }
+
+    /**
+     * @brief Set GPU patch budget
+     * @param maxPatches Maximum patches kept resident
+     * @param maxUploadsPerFrame Maximum patches built per frame
+     */
+    void setCacheLimits(int maxPatches, int maxUploadsPerFrame);
+
+    /**
+     * @brief Render visible terrain
+     * @param viewProjection Combined projection * view matrix
+     * @param cameraPosition Camera position in world space
+     * @param lighting Apply diffuse lighting
+     * @return True if patches are still streaming (caller should repaint)
+     */
+    bool render(const QMatrix4x4& viewProjection, const QVector3D& cameraPosition, bool lighting);
+
+    const Statistics& statistics() const { return m_stats; }
+
+private:
+    struct Patch {
+        QOpenGLBuffer vertexBuffer;     // Implicitly shared handle; destroy() on eviction
+        qint64 lastUsedFrame;
+    };
+
+    static constexpr int PATCH_CELLS = 32;      // Grid cells per patch edge
+
+    const DEMData* m_dem;
+    double m_verticalExaggeration;
+    int m_colorScheme;
+    bool m_colorByElevation;
+    const DEMData* m_overlay;
+    float m_overlayRange;
+    QVector4D m_solidColor;         // Alpha 0 = terrain colours
+
+    TerrainQuadtree m_quadtree;
+    QVector<float> m_lodRanges;
+    float m_detailDistance;
+
+    QOpenGLShaderProgram m_program;
+    QOpenGLBuffer m_indexBuffer;
+    int m_indexCount;
+    bool m_initialized;
+
+    QHash<int, Patch> m_patches;
+    int m_maxPatches;
+    int m_maxUploadsPerFrame;
+    qint64 m_frame;
+    Statistics m_stats;
+
+    void computeLodRanges();
+    void selectNodes(int nodeIndex, const QVector<QVector4D>& planes,
+                     const QVector3D& cameraPosition, QVector<int>& selected) const;
+    bool aabbInFrustum(const QVector<QVector4D>& planes,
+                       const QVector3D& minCorner, const QVector3D& maxCorner) const;
+    bool aabbInSphere(const QVector3D& center, float radius,
+                      const QVector3D& minCorner, const QVector3D& maxCorner) const;
+    void nodeBounds(const TerrainQuadtree::Node& node, QVector3D& minCorner, QVector3D& maxCorner) const;
+
+    QVector<float> buildPatchVertices(const TerrainQuadtree::Node& node) const;
+    Patch* acquirePatch(int nodeIndex, int& uploadBudget);
+    void releasePatches();
+    void evictPatches();
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // TERRAINCHUNKRENDERER_H
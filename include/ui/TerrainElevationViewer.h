@@ -7,8 +7,17 @@
 #include <QMatrix4x4>
 #include <QVector3D>
 #include <QImage>
+#include <QCache>
 #include "models/GeospatialCoordinate.h"
 #include "models/FlightPlan.h"
+#include "TerrainChunkRenderer.h"
+#include "ContourGenerator.h"
+#include "TerrainRayCaster.h"
+#include "ViewshedAnalyzer.h"
+#include "AltitudeProfileEngine.h"
+#include "geospatial/DEMDifferenceAnalyzer.h"
+
+class QTimer;
 
 namespace DroneMapper {
 namespace UI {
@@ -73,16 +82,6 @@ struct DEMData {
     void generateTestTerrain(int width, int height);
 };
 
-/**
- * @brief Terrain mesh vertex
- */
-struct TerrainVertex {
-    QVector3D position;
-    QVector3D normal;
-    QVector2D texCoord;
-    QVector3D color;
-};
-
 /**
  * @brief Terrain visualization settings
  */
@@ -134,6 +133,14 @@ public:
         float maxElevation,
         Scheme scheme = Terrain);
 
+    /**
+     * @brief Get diverging color for an elevation change
+     * @param change Change in meters (negative = cut, positive = fill)
+     * @param maxAbsChange Change mapped to full saturation
+     * @return RGB color (blue = cut, white = none, red = fill)
+     */
+    static QVector3D getDifferenceColor(float change, float maxAbsChange);
+
 private:
     static QVector3D interpolateColor(
         const QVector3D& color1,
@@ -198,6 +205,9 @@ public:
      */
     void reset();
 
+    QVector3D position() const { return m_position; }
+    QVector3D target() const { return m_target; }
+
 private:
     QVector3D m_position;
     QVector3D m_target;
@@ -301,7 +311,7 @@ public:
     /**
      * @brief Get elevation at screen position
      * @param screenPos Screen position
-     * @return Elevation in meters
+     * @return Elevation in meters, NaN if no terrain under the cursor
      */
     float getElevationAt(const QPoint& screenPos);
 
@@ -309,10 +319,82 @@ public:
      * @brief Measure distance between two points
      * @param start Start screen position
      * @param end End screen position
-     * @return Distance in meters
+     * @return 3D distance in meters, -1 if either point misses the terrain
      */
     double measureDistance(const QPoint& start, const QPoint& end);
 
+    /**
+     * @brief Pick the terrain point under a screen position
+     * @param screenPos Screen position
+     * @param localPoint Receives the hit in DEM-local space (see TerrainRayCaster)
+     * @return True if the terrain was hit
+     */
+    bool pickTerrain(const QPoint& screenPos, QVector3D& localPoint);
+
+    /**
+     * @brief Check line of sight between two positions
+     * @param from Start coordinate
+     * @param fromAltitude Start altitude (meters MSL)
+     * @param to End coordinate
+     * @param toAltitude End altitude (meters MSL)
+     * @return True if the terrain does not block the line
+     */
+    bool hasLineOfSight(const Models::GeospatialCoordinate& from, double fromAltitude,
+                        const Models::GeospatialCoordinate& to, double toAltitude) const;
+
+    /**
+     * @brief Flag flight plan waypoints that lose VLOS from the pilot
+     * @param pilot Pilot position and eye height
+     * @param limits Regulatory limits
+     * @return VLOS and operator-range violations
+     */
+    QList<Core::AltitudeViolation> checkVisualLineOfSight(
+        const ViewshedAnalyzer::Observer& pilot,
+        const Core::RegulatoryLimits& limits = Core::RegulatoryLimits::getDefaults()) const;
+
+    /**
+     * @brief Shade the terrain the pilot cannot see the aircraft over
+     * @param pilot Pilot position and eye height
+     * @param targetHeight Aircraft height above ground (meters)
+     * @return Viewshed (empty, and nothing shaded, if the pilot is off the DEM)
+     */
+    Viewshed showViewshed(const ViewshedAnalyzer::Observer& pilot, double targetHeight);
+
+    /**
+     * @brief Remove the viewshed shading
+     */
+    void clearViewshed();
+
+    /**
+     * @brief Colour the terrain by a DEM-of-difference preview
+     * @param result Difference analysis result
+     */
+    void setDifferenceLayer(const Geospatial::DEMDifferenceAnalyzer::Result& result);
+
+    /**
+     * @brief Remove the difference layer
+     */
+    void clearDifferenceLayer();
+
+    /**
+     * @brief Loaded DEM
+     * @return DEM data (empty before a DEM is loaded)
+     */
+    const DEMData& demData() const { return m_demData; }
+
+    /**
+     * @brief Ray caster over the loaded DEM (for batch queries)
+     * @return Ray caster
+     */
+    const TerrainRayCaster& rayCaster() const { return m_rayCaster; }
+
+    /**
+     * @brief Export contours at the current interval as GeoJSON
+     * @param filePath Output file path
+     * @return True if exported successfully
+     */
+    bool exportContoursGeoJSON(const QString& filePath);
+
 signals:
     void demLoaded(const QString& filePath);
     void renderingError(const QString& error);
@@ -325,6 +407,7 @@ protected:
 
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
 
 private:
@@ -335,17 +418,33 @@ private:
     ElevationColorScheme::Scheme m_colorScheme;
 
     // OpenGL resources
-    QVector<TerrainVertex> m_vertices;
-    QVector<unsigned int> m_indices;
+    TerrainChunkRenderer m_chunkRenderer;
+    bool m_terrainDirty;    // Chunks must be rebuilt on the next paint
+
+    // DEM-of-difference overlay (preview grid stored as a DEM)
+    DEMData m_differenceLayer;
+    float m_differenceRange;
+    bool m_showDifference;
+
+    // Viewshed shading (-1 where hidden, NaN where visible); drawn over the difference layer
+    DEMData m_viewshedLayer;
+    bool m_showViewshed;
+
+    // Max-mip pyramid for picking and line of sight
+    TerrainRayCaster m_rayCaster;
+
+    // Contours (grid-space lines in an LRU keyed by interval in cm, world lines for drawing)
+    QCache<qint64, QVector<ContourLine>> m_contourCache;
+    QVector<QVector<QVector3D>> m_contourPolylines;
+    double m_contourPolylineInterval;   // Interval of m_contourPolylines (<= 0 = stale)
 
     // Mesh generation
     void generateTerrainMesh();
     void generateTerrainGrid();
-    QVector3D calculateNormal(int x, int y);
 
     // Rendering
-    void renderTerrain();
-    void renderWireframe();
+    void renderTerrain(const QMatrix4x4& viewProjection);
+    void renderWireframe(const QMatrix4x4& viewProjection);
     void renderContours();
     void renderFlightPath();
     void renderAltitudeProfile();
@@ -353,6 +452,10 @@ private:
     // Contour generation
     QVector<QVector<QVector3D>> generateContours(float interval);
     QVector<QVector3D> traceContour(float elevation);
+    const QVector<ContourLine>& contoursForInterval(double interval);
+    QVector<QVector3D> contourToWorld(const ContourLine& line) const;
+    void invalidateContours();
+    bool screenRay(const QPoint& screenPos, QVector3D& origin, QVector3D& direction);
 
     // Helper methods
     QVector3D demToWorld(int x, int y, float elevation) const;
@@ -363,12 +466,16 @@ private:
     bool m_leftButtonPressed;
     bool m_middleButtonPressed;
     bool m_rightButtonPressed;
+    QTimer* m_hoverTimer;   // Throttles hover elevation queries
+    QPoint m_hoverPos;      // Latest hover position, picked when the timer fires
 };
 
 /**
  * @brief Altitude profile widget
  *
- * Displays 2D altitude profile along flight path
+ * Displays 2D altitude profile along flight path, with terrain sampled
+ * at DEM resolution between waypoints and min/max decimated to the
+ * plot width.
  */
 class AltitudeProfileWidget : public QWidget {
     Q_OBJECT
@@ -395,13 +502,8 @@ private:
     Models::FlightPlan m_flightPlan;
     DEMData m_demData;
 
-    struct ProfilePoint {
-        double distance;        // Distance from start (meters)
-        double flightAltitude;  // Flight altitude AGL (meters)
-        double terrainElevation;// Terrain elevation MSL (meters)
-    };
-
-    QVector<ProfilePoint> calculateProfile();
+    // Densified per-leg profile; only edited legs are resampled
+    AltitudeProfileEngine m_profileEngine;
 };
 
 } // namespace UI
@@ -0,0 +1,95 @@
+#ifndef TERRAINRAYCASTER_H
+#define TERRAINRAYCASTER_H
+
+#include <QVector>
+#include <QVector3D>
+#include "models/GeospatialCoordinate.h"
+
+namespace DroneMapper {
+namespace UI {
+
+struct DEMData;
+
+/**
+ * @brief Ray-terrain intersection over a max-mip height pyramid
+ *
+ * Features:
+ * - Max-mip pyramid: level 0 holds the highest corner of every DEM
+ *   cell, each coarser level the maximum of a 2x2 block below it
+ * - Hierarchical ray marching: whole blocks the ray passes above are
+ *   skipped in one step, descending only where the ray dips below a
+ *   block's maximum
+ * - Exact hit against the two triangles of the final cell
+ * - Line-of-sight checks between arbitrary 3D points
+ *
+ * All queries use DEM-local space: x = column * resolution,
+ * y = row * resolution (meters), z = elevation in meters (no
+ * vertical exaggeration). The DEM must outlive the caster or the
+ * next build().
+ *
+ * Usage:
+ *   TerrainRayCaster caster;
+ *   caster.build(dem);
+ *   QVector3D hit;
+ *   if (caster.intersect(origin, direction, &hit)) { ... }
+ *   bool visible = caster.lineOfSight(pilot, drone);
+ */
+class TerrainRayCaster {
+public:
+    TerrainRayCaster();
+
+    /**
+     * @brief Build the max-mip pyramid
+     * @param dem DEM data
+     */
+    void build(const DEMData& dem);
+
+    void clear();
+    bool isEmpty() const { return m_levels.isEmpty(); }
+
+    /**
+     * @brief Intersect a ray with the terrain
+     * @param origin Ray origin (DEM-local)
+     * @param direction Ray direction (need not be normalized)
+     * @param hitPoint Receives the first hit (DEM-local), may be null
+     * @param maxDistance Maximum distance along the ray (0 = unlimited)
+     * @return True if the ray hits the terrain
+     */
+    bool intersect(const QVector3D& origin, const QVector3D& direction,
+                   QVector3D* hitPoint = nullptr, double maxDistance = 0.0) const;
+
+    /**
+     * @brief Check whether the segment between two points clears the terrain
+     * @param from Start point (DEM-local)
+     * @param to End point (DEM-local)
+     * @return True if no terrain lies between the points
+     */
+    bool lineOfSight(const QVector3D& from, const QVector3D& to) const;
+
+    /**
+     * @brief Convert a geographic coordinate to DEM-local space
+     * @param coord Geographic coordinate
+     * @param altitude Height in meters (MSL)
+     * @return DEM-local position
+     */
+    QVector3D toLocal(const Models::GeospatialCoordinate& coord, double altitude) const;
+
+private:
+    struct Level {
+        int width;              // Cells in X at this level
+        int height;             // Cells in Y at this level
+        QVector<float> maxZ;
+    };
+
+    const DEMData* m_dem;
+    QVector<Level> m_levels;    // 0 = per-cell maxima
+
+    bool march(const QVector3D& origin, const QVector3D& direction, double tEnd, double& tHit) const;
+    bool intersectCell(int cx, int cy, const double origin[3], const double direction[3],
+                       double tMin, double tMax, double& tHit) const;
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // TERRAINRAYCASTER_H
@@ -0,0 +1,103 @@
+#ifndef TILESCHEMEHANDLER_H
+#define TILESCHEMEHANDLER_H
+
+#include "OverlayTileRenderer.h"
+#include "TileStore.h"
+#include <QWebEngineUrlSchemeHandler>
+#include <QHash>
+#include <QUrl>
+#include <QThreadPool>
+#include <memory>
+
+class QNetworkAccessManager;
+class QWebEngineProfile;
+class QWebEngineUrlRequestJob;
+
+namespace DroneMapper {
+namespace UI {
+
+/**
+ * @brief Serves map tiles and assets to MapLibre from local stores
+ *
+ * URLs (scheme "dmtiles"):
+ * - dmtiles://basemap/<name>/{z}/{x}/{y}   cached basemap tile
+ * - dmtiles://overlay/<layer>/{z}/{x}/{y}  rendered overlay (hillshade, ortho, coverage)
+ * - dmtiles://asset/?url=<upstream URL>    cached script, style or glyph file
+ *                                          (known map library and style hosts only)
+ *
+ * Basemap tiles and assets come from MBTiles files in the cache
+ * directory, each held to a byte budget with least recently used
+ * eviction. On a miss or an expired entry, and only when online
+ * fetching is enabled, the upstream copy is downloaded, stored with
+ * the expiry its Cache-Control allows (never with no-store) and
+ * served; offline, expired entries are still served and a miss fails,
+ * so MapLibre keeps the tile blank. Overlays are rendered on a worker
+ * thread by OverlayTileRenderer.
+ *
+ * registerScheme() must be called before the QApplication is created.
+ */
+class TileSchemeHandler : public QWebEngineUrlSchemeHandler {
+    Q_OBJECT
+
+public:
+    static const QByteArray SCHEME;
+
+    /**
+     * @brief Register the dmtiles scheme with WebEngine
+     */
+    static void registerScheme();
+
+    /**
+     * @brief Install the handler on a profile (once per profile)
+     * @param profile WebEngine profile
+     * @return Handler installed on the profile
+     */
+    static TileSchemeHandler* install(QWebEngineProfile* profile);
+
+    explicit TileSchemeHandler(const QString& cacheDirectory, QObject* parent = nullptr);
+    ~TileSchemeHandler();
+
+    /**
+     * @brief Add an upstream basemap
+     * @param name Basemap name used in dmtiles URLs
+     * @param urlTemplate Upstream URL with {z}, {x}, {y}
+     * @param format Tile format ("png" or "jpg")
+     */
+    void addBasemap(const QString& name, const QString& urlTemplate, const QString& format);
+
+    /**
+     * @brief Allow downloading tiles and assets missing from the cache
+     */
+    void setOnlineFetching(bool enabled) { m_online = enabled; }
+    bool onlineFetching() const { return m_online; }
+
+    OverlayTileRenderer* overlays() { return &m_overlays; }
+
+    void requestStarted(QWebEngineUrlRequestJob* job) override;
+
+private:
+    struct Basemap {
+        QString urlTemplate;
+        QByteArray mimeType;
+        std::shared_ptr<Core::TileStore> store;
+    };
+
+    QString m_cacheDirectory;
+    QHash<QString, Basemap> m_basemaps;
+    Core::TileStore m_assets;
+    OverlayTileRenderer m_overlays;
+    QThreadPool m_renderPool;
+    QNetworkAccessManager* m_network;
+    bool m_online;
+
+    void serveBasemap(QWebEngineUrlRequestJob* job, const QStringList& parts);
+    void serveOverlay(QWebEngineUrlRequestJob* job, const QStringList& parts);
+    void serveAsset(QWebEngineUrlRequestJob* job, const QUrl& url);
+
+    static void reply(QWebEngineUrlRequestJob* job, const QByteArray& mimeType, const QByteArray& data);
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // TILESCHEMEHANDLER_H
@@ -0,0 +1,131 @@
+#ifndef VIEWSHEDANALYZER_H
+#define VIEWSHEDANALYZER_H
+
+#include <QVector>
+#include <QList>
+#include <atomic>
+#include "models/GeospatialCoordinate.h"
+#include "models/FlightPlan.h"
+#include "core/AltitudeSafetyChecker.h"
+
+namespace DroneMapper {
+namespace UI {
+
+struct DEMData;
+class TerrainRayCaster;
+
+/**
+ * @brief Viewshed grid over a DEM
+ */
+struct Viewshed {
+    int width;                  // DEM samples in X
+    int height;                 // DEM samples in Y
+    QVector<quint8> visible;    // 1 where the target height is visible
+    int visibleCells;
+    qint64 elapsedMs;
+
+    Viewshed() : width(0), height(0), visibleCells(0), elapsedMs(0) {}
+
+    bool isVisible(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height && visible[y * width + x] != 0;
+    }
+};
+
+/**
+ * @brief Visibility of one waypoint from the pilot
+ */
+struct WaypointVisibility {
+    int waypointIndex;
+    bool visible;               // Terrain does not block the line of sight
+    double distance;            // Horizontal distance from the pilot (meters)
+    double slantDistance;       // Straight-line distance from the pilot's eye (meters)
+};
+
+/**
+ * @brief Viewshed and visual-line-of-sight (VLOS) analysis
+ *
+ * Features:
+ * - R2 radial sweep: one ray from the observer to every DEM border cell,
+ *   tracking the steepest terrain slope seen so far; rays run in parallel
+ * - Target height above ground (e.g. flight altitude) for "can the pilot
+ *   see the aircraft over this cell" maps
+ * - Exact per-waypoint line of sight via TerrainRayCaster
+ * - VLOS and operator-range violations for AltitudeSafetyChecker reports
+ *
+ * Waypoint altitudes are treated as heights above ground, matching the
+ * terrain viewer's flight path overlay.
+ *
+ * Usage:
+ *   ViewshedAnalyzer::Observer pilot(launchPoint);
+ *   Viewshed shed = ViewshedAnalyzer::compute(dem, pilot, 120.0);
+ *   auto violations = ViewshedAnalyzer::checkVisualLineOfSight(
+ *       dem, rayCaster, pilot, plan, RegulatoryLimits::getFAA());
+ */
+class ViewshedAnalyzer {
+public:
+    struct Observer {
+        Models::GeospatialCoordinate position;
+        double eyeHeight;       // Eye height above ground (meters)
+        double maxRange;        // Horizontal analysis radius (meters, 0 = whole DEM)
+
+        Observer()
+            : eyeHeight(1.7)
+            , maxRange(0.0)
+        {}
+
+        explicit Observer(const Models::GeospatialCoordinate& pos, double eye = 1.7)
+            : position(pos)
+            , eyeHeight(eye)
+            , maxRange(0.0)
+        {}
+    };
+
+    /**
+     * @brief Compute the viewshed from an observer
+     * @param dem DEM data
+     * @param observer Observer position and eye height
+     * @param targetHeight Height above ground of the observed target (meters)
+     * @return Visibility grid (empty if the observer lies outside the DEM)
+     */
+    static Viewshed compute(const DEMData& dem, const Observer& observer, double targetHeight = 0.0);
+
+    /**
+     * @brief Line of sight from the observer to every waypoint
+     * @param dem DEM data
+     * @param caster Ray caster built over the same DEM
+     * @param observer Observer position and eye height
+     * @param plan Flight plan
+     * @param cancelled Polled per waypoint; a set flag returns the waypoints done so far
+     * @return Visibility per waypoint
+     */
+    static QVector<WaypointVisibility> checkWaypoints(const DEMData& dem,
+                                                      const TerrainRayCaster& caster,
+                                                      const Observer& observer,
+                                                      const Models::FlightPlan& plan,
+                                                      const std::atomic<bool>* cancelled = nullptr);
+
+    /**
+     * @brief Flag waypoints that lose VLOS or exceed the operator range
+     * @param dem DEM data
+     * @param caster Ray caster built over the same DEM
+     * @param observer Observer position and eye height
+     * @param plan Flight plan
+     * @param limits Regulatory limits (VLOS requirement, max horizontal distance)
+     * @param cancelled Polled per waypoint; a set flag returns the violations found so far
+     * @return Violations ("VLOS" and "Range" types)
+     */
+    static QList<Core::AltitudeViolation> checkVisualLineOfSight(const DEMData& dem,
+                                                                 const TerrainRayCaster& caster,
+                                                                 const Observer& observer,
+                                                                 const Models::FlightPlan& plan,
+                                                                 const Core::RegulatoryLimits& limits,
+                                                                 const std::atomic<bool>* cancelled = nullptr);
+
+private:
+    ViewshedAnalyzer() = delete;  // Static class, no instantiation
+};
+
+} // namespace UI
+} // namespace DroneMapper
+
+#endif // VIEWSHEDANALYZER_H
@@ -5,6 +5,10 @@
 #include <QPainter>
 #include <QTimer>
 #include <QDateTime>
+#include <QPixmap>
+#include <QVector>
+#include <QRandomGenerator>
+#include <functional>
 #include "models/GeospatialCoordinate.h"
 #include "core/WeatherService.h"
 
@@ -70,6 +74,70 @@ public:
     static QColor getColor(double speedMs, Scheme scheme = Rainbow);
 };
 
+/**
+ * @brief Wind vectors interpolated onto a regular lat/lon grid
+ *
+ * Inverse-distance weighting (power 2) over the data points, computed
+ * once per data refresh. Lookups are bilinear between grid nodes.
+ * Components are the direction the wind blows towards: u eastward,
+ * v northward (m/s).
+ */
+class WindVectorField {
+public:
+    WindVectorField();
+
+    /**
+     * @brief Interpolate the data points onto a grid
+     * @param points Wind observations
+     * @param topLeft North-west corner of the grid
+     * @param bottomRight South-east corner of the grid
+     * @param columns Grid nodes in longitude
+     * @param rows Grid nodes in latitude
+     */
+    void build(const QList<WindDataPoint>& points,
+               const Models::GeospatialCoordinate& topLeft,
+               const Models::GeospatialCoordinate& bottomRight,
+               int columns, int rows);
+
+    void clear();
+    bool isEmpty() const { return m_u.isEmpty(); }
+    int columns() const { return m_columns; }
+    int rows() const { return m_rows; }
+
+    /**
+     * @brief Check whether an area lies inside the grid
+     */
+    bool contains(const Models::GeospatialCoordinate& topLeft,
+                  const Models::GeospatialCoordinate& bottomRight) const;
+
+    Models::GeospatialCoordinate nodeCoordinate(int column, int row) const;
+
+    /**
+     * @brief Sample at fractional grid coordinates
+     * @return False outside the grid
+     */
+    bool sampleGrid(double column, double row, double* u, double* v) const;
+
+    /**
+     * @brief Sample at a geographic location
+     * @return False outside the grid
+     */
+    bool sample(const Models::GeospatialCoordinate& location, double* u, double* v) const;
+
+    double cellWidthMeters() const;
+    double cellHeightMeters() const;
+
+private:
+    int m_columns;
+    int m_rows;
+    double m_north;
+    double m_west;
+    double m_cellLat;           // Degrees between rows
+    double m_cellLon;           // Degrees between columns
+    QVector<float> m_u;
+    QVector<float> m_v;
+};
+
 /**
  * @brief Wind overlay widget for map visualization
  *
@@ -83,6 +151,12 @@ public:
  * - Animation for dynamic visualization
  * - Configurable display options
  *
+ * Rendering is split into a cached layer (arrows, barbs, labels),
+ * redrawn only when data, settings or the view change, and animated
+ * streamline particles advected on a precomputed WindVectorField.
+ * Particles are placed on screen through projected grid nodes, so
+ * animation frames never call the coordinate transform.
+ *
  * Usage:
  *   WindOverlayWidget* overlay = new WindOverlayWidget(parent);
  *   overlay->setWeatherService(weatherService);
@@ -165,8 +239,18 @@ signals:
 protected:
     void paintEvent(QPaintEvent* event) override;
     void timerEvent(QTimerEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
 
 private:
+    struct Particle {
+        float column;           // Fractional grid position
+        float row;
+        int age;
+        int maxAge;
+        int trailLength;
+        QPointF trail[8];       // Recent screen positions, newest first
+    };
+
     Core::WeatherService* m_weatherService;
     QList<WindDataPoint> m_windData;
     WindOverlaySettings m_settings;
@@ -178,7 +262,24 @@ private:
 
     bool m_enabled;
     int m_animationTimerId;
-    double m_animationPhase;
+
+    // Cached rendering state
+    WindVectorField m_field;
+    bool m_fieldDirty;          // Data changed since the field was built
+    QVector<QPointF> m_nodeScreen;  // Screen position of every field node
+    bool m_viewDirty;           // View, size or transform changed
+    QPixmap m_staticLayer;
+    bool m_layerDirty;          // Static layer must be redrawn
+    QVector<Particle> m_particles;
+    QRandomGenerator m_random;
+
+    void ensureField();
+    void ensureProjection();
+    void renderStaticLayer();
+    void advectParticles();
+    void respawnParticle(Particle& particle);
+    QPointF gridToScreen(double column, double row) const;
+    void updateAnimationTimer();
 
     // Rendering methods
     void drawWindArrow(
@@ -198,7 +299,7 @@ private:
         const QPointF& position,
         const WindDataPoint& data);
 
-    void drawStreamlines(QPainter& painter);
+    void drawStreamlines(QPainter& painter);  // Particle trails
 
     // Helper methods
     QList<WindDataPoint> generateGridPoints();
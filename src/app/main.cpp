@@ -1,8 +1,13 @@
 #include "MainWindow.h"
+#include "TileSchemeHandler.h"
 #include "Logger.h"
 #include "DatabaseManager.h"
 #include "Settings.h"
+#include "StartupProfiler.h"
+#include "Tracer.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QMessageBox>
 #include <QStandardPaths>
 #include <QDir>
 #include <QStyleFactory>
@@ -48,7 +53,14 @@ void applyDarkTheme(QApplication& app) {
 
 int main(int argc, char *argv[])
 {
+    using DroneMapper::Core::StartupProfiler;
+    StartupProfiler::start();
+
+    // Custom URL schemes must be known before WebEngine starts
+    DroneMapper::UI::TileSchemeHandler::registerScheme();
+
     QApplication app(argc, argv);
+    StartupProfiler::mark("QApplication created");
 
     // Set application metadata
     QApplication::setOrganizationName("DroneMapper");
@@ -60,24 +72,52 @@ int main(int argc, char *argv[])
 
     // Initialize logging
     DroneMapper::Core::Logger::instance().setLogLevel(DroneMapper::Core::Logger::Level::Info);
+    DroneMapper::Core::Logger::installCrashHandler();
     LOG_INFO("DroneMapper starting...");
 
-    // Initialize database
+    // --trace <file>: record from startup and write a Chrome trace on exit
+    QCommandLineParser parser;
+    QCommandLineOption traceOption("trace", "Record a performance trace and write it to <file> on exit.", "file");
+    parser.addOption(traceOption);
+    parser.parse(QApplication::arguments());
+
+    if (parser.isSet(traceOption)) {
+        const QString tracePath = parser.value(traceOption);
+        DroneMapper::Core::Tracer::start();
+        QObject::connect(&app, &QApplication::aboutToQuit, [tracePath]() {
+            QString error;
+            if (!DroneMapper::Core::Tracer::writeChromeTrace(tracePath, &error)) {
+                LOG_ERROR(error);
+            }
+        });
+    }
+    StartupProfiler::mark("Theme and logging");
+
+    // Initialize database in the background; first use waits for it
     QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir().mkpath(appDataPath);
     QString dbPath = QDir(appDataPath).filePath("dronemapper.db");
 
-    if (!DroneMapper::Core::DatabaseManager::instance().initialize(dbPath)) {
-        LOG_ERROR("Failed to initialize database: " +
-                  DroneMapper::Core::DatabaseManager::instance().lastError());
-        return 1;
-    }
+    DroneMapper::Core::DatabaseManager::instance().initializeAsync(dbPath, [dbPath](bool ready) {
+        if (!ready) {
+            LOG_ERROR("Failed to initialize database: " +
+                      DroneMapper::Core::DatabaseManager::instance().lastError());
+            QMessageBox::critical(nullptr, "DroneMapper",
+                "Failed to initialize database:\n" +
+                DroneMapper::Core::DatabaseManager::instance().lastError());
+            QApplication::exit(1);
+            return;
+        }
 
-    LOG_INFO("Database initialized: " + dbPath);
+        LOG_INFO("Database initialized: " + dbPath);
+        StartupProfiler::mark("Database ready");
+    });
 
     // Create and show main window
     DroneMapper::UI::MainWindow mainWindow;
+    StartupProfiler::mark("Main window constructed");
+
     mainWindow.showMaximized(); // Start maximized for professional feel
+    StartupProfiler::mark("Main window shown");
 
     LOG_INFO("Application ready");
 
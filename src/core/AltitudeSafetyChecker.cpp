@@ -7,6 +7,13 @@
 namespace DroneMapper {
 namespace Core {
 
+namespace {
+
+constexpr double MAX_ALTITUDE_STEP = 50.0;      // Meters between consecutive waypoints
+constexpr double MAX_ALTITUDE_STDDEV = 30.0;    // Meters over the whole plan
+
+} // namespace
+
 QString AltitudeViolation::getSeverityText() const
 {
     switch (severity) {
@@ -161,7 +168,8 @@ AltitudeSafetyChecker::AltitudeSafetyChecker()
 
 SafetyCheckResult AltitudeSafetyChecker::checkFlightPlan(
     const Models::FlightPlan& plan,
-    const RegulatoryLimits& limits)
+    const RegulatoryLimits& limits,
+    const std::atomic<bool>* cancelled)
 {
     SafetyCheckResult result;
     result.isSafe = true;
@@ -180,12 +188,18 @@ SafetyCheckResult AltitudeSafetyChecker::checkFlightPlan(
     }
 
     double totalAltitude = 0.0;
+    double totalSquares = 0.0;
 
     // Check each waypoint
     for (int i = 0; i < waypoints.count(); ++i) {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            return result;
+        }
+
         const auto& wp = waypoints[i];
         double altitude = wp.coordinate().altitude();
         totalAltitude += altitude;
+        totalSquares += altitude * altitude;
 
         // Update statistics
         result.maxAltitude = std::max(result.maxAltitude, altitude);
@@ -223,8 +237,18 @@ SafetyCheckResult AltitudeSafetyChecker::checkFlightPlan(
 
     result.averageAltitude = totalAltitude / waypoints.count();
 
-    // Validate altitude profile
-    if (!validateAltitudeProfile(waypoints)) {
+    // Validate altitude profile (as validateAltitudeProfile, from the sums
+    // above and the cached leg climbs instead of three more passes)
+    double maxChange = 0.0;
+    for (const Models::SegmentGeometry& segment : plan.geometry().segments()) {
+        maxChange = std::max(maxChange, std::abs(segment.climb));
+    }
+    const double variance = std::max(0.0, totalSquares / waypoints.count() -
+                                          result.averageAltitude * result.averageAltitude);
+    const bool erratic = waypoints.count() >= 3 &&
+        (maxChange > MAX_ALTITUDE_STEP || std::sqrt(variance) >= MAX_ALTITUDE_STDDEV);
+
+    if (erratic) {
         AltitudeViolation v;
         v.severity = ViolationSeverity::Warning;
         v.type = "Altitude Profile";
@@ -409,7 +433,7 @@ bool AltitudeSafetyChecker::validateAltitudeProfile(
     }
 
     // Flag if any single change exceeds 50m
-    if (maxChange > 50.0) {
+    if (maxChange > MAX_ALTITUDE_STEP) {
         return false;
     }
 
@@ -429,7 +453,7 @@ bool AltitudeSafetyChecker::validateAltitudeProfile(
     double stddev = std::sqrt(variance);
 
     // Flag if standard deviation is too high (indicates erratic altitude)
-    return stddev < 30.0;
+    return stddev < MAX_ALTITUDE_STDDEV;
 }
 
 QColor AltitudeSafetyChecker::getAltitudeColor(
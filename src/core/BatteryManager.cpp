@@ -96,17 +96,11 @@ double BatteryManager::estimateFlightTime(
         return 0.0;
     }
 
-    const auto& waypoints = plan.waypoints();
-    const auto& params = plan.parameters();
-    double speed = params.flightSpeed();
-
-    // Calculate flight time
-    double totalTime = 0.0;
+    double speed = plan.parameters().flightSpeed();
+    if (speed <= 0.0) speed = 10.0; // Default speed
 
-    // Time between waypoints
-    for (int i = 1; i < waypoints.count(); ++i) {
-        totalTime += calculateSegmentTime(waypoints[i-1], waypoints[i], speed);
-    }
+    // Time between waypoints (minutes), from the plan's cached leg lengths
+    double totalTime = plan.geometry().totalDistance() / speed / 60.0;
 
     // Add takeoff time (30 seconds)
     totalTime += 0.5;
@@ -153,17 +147,31 @@ QList<SubMission> BatteryManager::splitMissionForBatteries(
     const Models::FlightPlan& plan,
     const BatteryProfile& profile,
     const Models::GeospatialCoordinate& homePoint)
+{
+    return splitMissionForBatteries(plan, profile, ProjectedPlan(plan, homePoint));
+}
+
+QList<SubMission> BatteryManager::splitMissionForBatteries(
+    const Models::FlightPlan& plan,
+    const BatteryProfile& profile,
+    const ProjectedPlan& projection,
+    const std::atomic<bool>* cancelled)
 {
     QList<SubMission> subMissions;
+    const Models::GeospatialCoordinate& homePoint = projection.origin();
+    const QVector<QPointF>& points = projection.points();
 
     const auto& waypoints = plan.waypoints();
     const auto& params = plan.parameters();
 
-    if (waypoints.isEmpty()) {
+    // The projection must be of this plan
+    if (waypoints.isEmpty() || points.count() != waypoints.count()) {
         return subMissions;
     }
 
+    const auto& segments = plan.geometry().segments();
     double speed = params.flightSpeed();
+    if (speed <= 0.0) speed = 10.0; // Default speed
     double usableTime = profile.getUsableFlightTime();
 
     int numBatteries = calculateRequiredBatteries(plan, profile);
@@ -207,26 +215,23 @@ QList<SubMission> BatteryManager::splitMissionForBatteries(
         double distanceThisBattery = 0.0;
 
         while (currentWaypoint < waypoints.count()) {
+            if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+                return subMissions;
+            }
+
             // Calculate time to next waypoint
             double nextSegmentTime = 0.0;
             double nextDistance = 0.0;
 
             if (currentWaypoint + 1 < waypoints.count()) {
-                nextSegmentTime = calculateSegmentTime(
-                    waypoints[currentWaypoint],
-                    waypoints[currentWaypoint + 1],
-                    speed);
-                nextDistance = Geospatial::GeoUtils::distanceBetween(
-                    waypoints[currentWaypoint].coordinate(),
-                    waypoints[currentWaypoint + 1].coordinate());
+                nextDistance = segments[currentWaypoint].length;
+                nextSegmentTime = nextDistance / speed / 60.0;
             }
 
-            // Calculate RTH time from next position
-            Models::GeospatialCoordinate nextPos = (currentWaypoint + 1 < waypoints.count()) ?
-                waypoints[currentWaypoint + 1].coordinate() :
-                waypoints[currentWaypoint].coordinate();
-
-            double rthTime = calculateReturnTime(nextPos, homePoint, speed);
+            // Calculate RTH time from next position (the projection origin is home)
+            const QPointF& nextPos = (currentWaypoint + 1 < waypoints.count()) ?
+                points[currentWaypoint + 1] : points[currentWaypoint];
+            double rthTime = returnTimeForDistance(std::hypot(nextPos.x(), nextPos.y()), speed);
 
             // Check if we can do this waypoint and still return home
             if (segmentTime + nextSegmentTime + rthTime + 1.0 > availableTime) {
@@ -391,30 +396,16 @@ QString BatteryManager::getBatterySwapInstructions(
     return instructions;
 }
 
-double BatteryManager::calculateSegmentTime(
-    const Models::Waypoint& from,
-    const Models::Waypoint& to,
-    double speed)
-{
-    double distance = Geospatial::GeoUtils::distanceBetween(
-        from.coordinate(), to.coordinate());
-
-    if (speed <= 0.0) speed = 10.0; // Default speed
-
-    // Time in seconds
-    double timeSeconds = distance / speed;
-
-    // Convert to minutes
-    return timeSeconds / 60.0;
-}
-
 double BatteryManager::calculateReturnTime(
     const Models::GeospatialCoordinate& position,
     const Models::GeospatialCoordinate& home,
     double speed)
 {
-    double distance = Geospatial::GeoUtils::distanceBetween(position, home);
+    return returnTimeForDistance(Geospatial::GeoUtils::distanceBetween(position, home), speed);
+}
 
+double BatteryManager::returnTimeForDistance(double distance, double speed)
+{
     if (speed <= 0.0) speed = 10.0;
 
     // Time in seconds, convert to minutes
@@ -2,6 +2,10 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QFileInfo>
+#include <QDir>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QDebug>
 
 namespace DroneMapper {
@@ -26,6 +30,76 @@ DatabaseManager::~DatabaseManager()
 }
 
 bool DatabaseManager::initialize(const QString& dbPath)
+{
+    if (!openConnection(dbPath)) {
+        return false;
+    }
+
+    if (!createTables(m_database, &m_lastError)) {
+        return false;
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+void DatabaseManager::initializeAsync(const QString& dbPath, std::function<void(bool)> onReady)
+{
+    m_pendingPath = dbPath;
+
+    // File creation and schema setup on a private connection
+    m_pendingInit = QtConcurrent::run([dbPath]() -> QString {
+        QDir().mkpath(QFileInfo(dbPath).absolutePath());
+
+        const QString connectionName = "dronemapper-init";
+        QString error;
+        {
+            QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+            database.setDatabaseName(dbPath);
+
+            if (!database.open()) {
+                error = database.lastError().text();
+            } else {
+                createTables(database, &error);
+                database.close();
+            }
+        }
+        QSqlDatabase::removeDatabase(connectionName);
+        return error;
+    });
+
+    auto* watcher = new QFutureWatcher<QString>();
+    QObject::connect(watcher, &QFutureWatcher<QString>::finished, watcher, [this, watcher, onReady]() {
+        watcher->deleteLater();
+
+        const bool ready = waitForInitialized();
+        if (onReady) {
+            onReady(ready);
+        }
+    });
+    watcher->setFuture(m_pendingInit);
+}
+
+bool DatabaseManager::waitForInitialized()
+{
+    if (!m_pendingInit.isValid()) {
+        return m_initialized;
+    }
+
+    const QString error = m_pendingInit.result();
+    m_pendingInit = QFuture<QString>();
+
+    if (!error.isEmpty()) {
+        m_lastError = error;
+        return false;
+    }
+
+    // Schema exists; opening the GUI-thread connection is cheap
+    m_initialized = openConnection(m_pendingPath);
+    return m_initialized;
+}
+
+bool DatabaseManager::openConnection(const QString& dbPath)
 {
     m_database = QSqlDatabase::addDatabase("QSQLITE");
     m_database.setDatabaseName(dbPath);
@@ -35,15 +109,10 @@ bool DatabaseManager::initialize(const QString& dbPath)
         return false;
     }
 
-    if (!createTables()) {
-        return false;
-    }
-
-    m_initialized = true;
     return true;
 }
 
-bool DatabaseManager::createTables()
+bool DatabaseManager::createTables(QSqlDatabase& database, QString* error)
 {
     QStringList queries;
 
@@ -85,7 +154,7 @@ bool DatabaseManager::createTables()
     )";
 
     for (const QString& queryStr : queries) {
-        if (!executeSql(queryStr)) {
+        if (!executeSql(database, queryStr, error)) {
             return false;
         }
     }
@@ -93,12 +162,12 @@ bool DatabaseManager::createTables()
     return true;
 }
 
-bool DatabaseManager::executeSql(const QString& sql)
+bool DatabaseManager::executeSql(QSqlDatabase& database, const QString& sql, QString* error)
 {
-    QSqlQuery query(m_database);
+    QSqlQuery query(database);
     if (!query.exec(sql)) {
-        m_lastError = query.lastError().text();
-        qWarning() << "SQL Error:" << m_lastError;
+        *error = query.lastError().text();
+        qWarning() << "SQL Error:" << *error;
         return false;
     }
     return true;
@@ -106,6 +175,10 @@ bool DatabaseManager::executeSql(const QString& sql)
 
 bool DatabaseManager::saveProject(const Models::Project& project)
 {
+    if (!waitForInitialized()) {
+        return false;
+    }
+
     QSqlQuery query(m_database);
     query.prepare(R"(
         INSERT OR REPLACE INTO projects
@@ -132,6 +205,10 @@ bool DatabaseManager::saveProject(const Models::Project& project)
 
 bool DatabaseManager::loadProject(const QString& projectId, Models::Project& project)
 {
+    if (!waitForInitialized()) {
+        return false;
+    }
+
     QSqlQuery query(m_database);
     query.prepare("SELECT * FROM projects WHERE id = ?");
     query.addBindValue(projectId);
@@ -152,6 +229,10 @@ QList<Models::Project> DatabaseManager::loadAllProjects()
 {
     QList<Models::Project> projects;
 
+    if (!waitForInitialized()) {
+        return projects;
+    }
+
     QSqlQuery query("SELECT * FROM projects ORDER BY modified_date DESC", m_database);
 
     while (query.next()) {
@@ -166,6 +247,10 @@ QList<Models::Project> DatabaseManager::loadAllProjects()
 
 bool DatabaseManager::deleteProject(const QString& projectId)
 {
+    if (!waitForInitialized()) {
+        return false;
+    }
+
     QSqlQuery query(m_database);
     query.prepare("DELETE FROM projects WHERE id = ?");
     query.addBindValue(projectId);
@@ -180,6 +265,10 @@ bool DatabaseManager::deleteProject(const QString& projectId)
 
 bool DatabaseManager::saveSetting(const QString& key, const QVariant& value)
 {
+    if (!waitForInitialized()) {
+        return false;
+    }
+
     QSqlQuery query(m_database);
     query.prepare("INSERT OR REPLACE INTO settings (key, value) VALUES (?, ?)");
     query.addBindValue(key);
@@ -195,6 +284,10 @@ bool DatabaseManager::saveSetting(const QString& key, const QVariant& value)
 
 QVariant DatabaseManager::loadSetting(const QString& key, const QVariant& defaultValue)
 {
+    if (!waitForInitialized()) {
+        return defaultValue;
+    }
+
     QSqlQuery query(m_database);
     query.prepare("SELECT value FROM settings WHERE key = ?");
     query.addBindValue(key);
@@ -1,5 +1,6 @@
 #include "FlightPathOptimizer.h"
 #include "geospatial/GeoUtils.h"
+#include "Tracer.h"
 #include <cmath>
 #include <algorithm>
 #include <QSet>
@@ -40,6 +41,8 @@ OptimizationResult FlightPathOptimizer::optimizeWaypoints(
     const Models::GeospatialCoordinate& startPoint,
     const OptimizationConfig& config)
 {
+    TRACE_SCOPE("optimizer", "FlightPathOptimizer::optimizeWaypoints");
+
     OptimizationResult result;
 
     if (waypoints.count() < 3) {
@@ -245,6 +248,8 @@ QList<Models::Waypoint> FlightPathOptimizer::greedyNearestNeighbor(
     const Models::GeospatialCoordinate& start,
     const OptimizationConfig& config)
 {
+    TRACE_SCOPE("optimizer", "FlightPathOptimizer::greedyNearestNeighbor");
+
     QList<Models::Waypoint> result;
     QList<bool> visited(waypoints.count(), false);
 
@@ -280,6 +285,8 @@ QList<Models::Waypoint> FlightPathOptimizer::twoOptOptimization(
     const QList<Models::Waypoint>& waypoints,
     const OptimizationConfig& config)
 {
+    TRACE_SCOPE("optimizer", "FlightPathOptimizer::twoOptOptimization");
+
     if (waypoints.count() < 4) {
         return waypoints;
     }
@@ -328,6 +335,8 @@ QList<Models::Waypoint> FlightPathOptimizer::windAwareOptimization(
     const QList<Models::Waypoint>& waypoints,
     const OptimizationConfig& config)
 {
+    TRACE_SCOPE("optimizer", "FlightPathOptimizer::windAwareOptimization");
+
     // Prefer flying into wind on longer segments
     // Use modified nearest neighbor with wind penalty
 
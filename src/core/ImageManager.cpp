@@ -1,4 +1,5 @@
 #include "ImageManager.h"
+#include "Tracer.h"
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
@@ -66,6 +67,8 @@ ImageManager::~ImageManager()
 
 int ImageManager::scanDirectory(const QString& directoryPath, bool recursive)
 {
+    TRACE_SCOPE("ingest", "ImageManager::scanDirectory");
+
     QDir dir(directoryPath);
     if (!dir.exists()) {
         m_lastError = "Directory does not exist: " + directoryPath;
@@ -107,6 +110,8 @@ int ImageManager::scanDirectory(const QString& directoryPath, bool recursive)
 
 bool ImageManager::addImage(const QString& filePath)
 {
+    TRACE_SCOPE("ingest", "ImageManager::addImage");
+
     if (!isSupportedImageFormat(filePath)) {
         return false;
     }
@@ -150,6 +155,8 @@ void ImageManager::clear()
 {
     m_images.clear();
     m_imageIndex.clear();
+
+    emit imagesCleared();
 }
 
 ImageMetadata ImageManager::imageByPath(const QString& filePath) const
@@ -175,13 +182,18 @@ QVector<ImageMetadata> ImageManager::qualityImages() const
 {
     QVector<ImageMetadata> result;
     for (const auto& img : m_images) {
-        if (!img.isBlurry && img.sharpness > 50.0) {
+        if (isAcceptableQuality(img)) {
             result.append(img);
         }
     }
     return result;
 }
 
+bool ImageManager::isAcceptableQuality(const ImageMetadata& metadata)
+{
+    return !metadata.isBlurry && metadata.sharpness > 50.0;
+}
+
 ImageCollectionStats ImageManager::statistics() const
 {
     ImageCollectionStats stats;
@@ -202,7 +214,7 @@ ImageCollectionStats ImageManager::statistics() const
             stats.geotaggedImages++;
         }
 
-        if (!img.isBlurry && img.sharpness > 50.0) {
+        if (isAcceptableQuality(img)) {
             stats.acceptableQuality++;
         } else {
             stats.poorQuality++;
@@ -227,6 +239,8 @@ ImageCollectionStats ImageManager::statistics() const
 
 QualityAssessment ImageManager::assessQuality(const QString& filePath)
 {
+    TRACE_SCOPE("ingest", "ImageManager::assessQuality");
+
     QImage image(filePath);
     if (image.isNull()) {
         m_lastError = "Failed to load image: " + filePath;
@@ -307,6 +321,8 @@ bool ImageManager::exportToKML(const QString& outputPath)
 
 ImageMetadata ImageManager::extractMetadata(const QString& filePath)
 {
+    TRACE_SCOPE("ingest", "ImageManager::extractMetadata");
+
     ImageMetadata metadata;
 
     QFileInfo fileInfo(filePath);
@@ -2,11 +2,198 @@
 #include <QDateTime>
 #include <QStandardPaths>
 #include <QDir>
-#include <QMutexLocker>
+#include <QFileInfo>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+
+#ifdef Q_OS_WIN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <fcntl.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
 
 namespace DroneMapper {
 namespace Core {
 
+namespace {
+
+constexpr std::size_t QUEUE_CAPACITY = 16384;
+constexpr int WRITER_IDLE_MS = 200;                     // Periodic flush when idle
+constexpr int MAX_BATCH_RECORDS = 4096;
+constexpr qint64 DEFAULT_MAX_FILE_SIZE = 10 * 1024 * 1024;
+constexpr int DEFAULT_MAX_BACKUPS = 5;
+constexpr int CRASH_FLUSH_TIMEOUT_MS = 1000;
+constexpr int CRASH_POLL_MS = 10;
+constexpr int CRASH_RECORD_SIZE = 128;
+
+const char* levelName(Logger::Level level)
+{
+    switch (level) {
+        case Logger::Level::Debug:    return "DEBUG";
+        case Logger::Level::Info:     return "INFO";
+        case Logger::Level::Warning:  return "WARN";
+        case Logger::Level::Error:    return "ERROR";
+        case Logger::Level::Critical: return "CRITICAL";
+    }
+    return "";
+}
+
+std::atomic<std::thread::id> writerThreadId;
+
+// Crash state shared with the signal handler: lock-free atomics and a
+// buffer allocated before any signal can arrive
+char crashRecord[CRASH_RECORD_SIZE];
+std::atomic<int> crashRecordLength(0);
+std::atomic<int> crashSignal(0);        // First fatal signal, 0 while none
+std::atomic<bool> crashWritten(false);  // Record and queued messages are on disk
+std::atomic<int> crashPipeWrite(-1);
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_BOOL_LOCK_FREE == 2,
+              "crash handler needs lock-free atomics");
+
+/**
+ * @brief Append to a fixed buffer without allocating (async-signal-safe)
+ */
+struct CrashWriter {
+    char* data;
+    int capacity;
+    int length;
+
+    void append(const char* text)
+    {
+        while (*text && length < capacity) {
+            data[length++] = *text++;
+        }
+    }
+
+    void appendNumber(long long value, int width = 0)
+    {
+        char digits[24];
+        int count = 0;
+        const bool negative = value < 0;
+        unsigned long long magnitude = negative ? 0ULL - static_cast<unsigned long long>(value)
+                                                : static_cast<unsigned long long>(value);
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0 && count < static_cast<int>(sizeof(digits)));
+
+        if (negative && length < capacity) {
+            data[length++] = '-';
+        }
+        for (int pad = count; pad < width && length < capacity; ++pad) {
+            data[length++] = '0';
+        }
+        while (count > 0 && length < capacity) {
+            data[length++] = digits[--count];
+        }
+    }
+};
+
+/**
+ * @brief "[YYYY-MM-DDTHH:MM:SSZ] CRITICAL Fatal signal N" in the log's line format
+ *
+ * UTC, since the local time zone cannot be read safely from a handler.
+ */
+int formatCrashRecord(int signal, char* buffer, int capacity)
+{
+    const long long now = static_cast<long long>(std::time(nullptr));
+    const long long seconds = ((now % 86400) + 86400) % 86400;
+    const long long days = (now - seconds) / 86400;
+
+    // Civil date from days since 1970-01-01 (proleptic Gregorian)
+    const long long z = days + 719468;
+    const long long era = (z >= 0 ? z : z - 146096) / 146097;
+    const long long dayOfEra = z - era * 146097;
+    const long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const long long monthIndex = (5 * dayOfYear + 2) / 153;
+    const long long day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    const long long month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    const long long year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    CrashWriter writer{ buffer, capacity, 0 };
+    writer.append("[");
+    writer.appendNumber(year, 4);
+    writer.append("-");
+    writer.appendNumber(month, 2);
+    writer.append("-");
+    writer.appendNumber(day, 2);
+    writer.append("T");
+    writer.appendNumber(seconds / 3600, 2);
+    writer.append(":");
+    writer.appendNumber(seconds / 60 % 60, 2);
+    writer.append(":");
+    writer.appendNumber(seconds % 60, 2);
+    writer.append("Z] CRITICAL Fatal signal ");
+    writer.appendNumber(signal);
+    writer.append("\n");
+    return writer.length;
+}
+
+void sleepMilliseconds(int ms)
+{
+#ifdef Q_OS_WIN
+    Sleep(static_cast<DWORD>(ms));
+#else
+    struct timespec delay = { 0, ms * 1000000L };
+    nanosleep(&delay, nullptr);
+#endif
+}
+
+bool createPipe(int fds[2])
+{
+#ifdef Q_OS_WIN
+    return _pipe(fds, 256, _O_BINARY) == 0;
+#else
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#endif
+}
+
+int writeByte(int fd)
+{
+    const char byte = 1;
+#ifdef Q_OS_WIN
+    return _write(fd, &byte, 1);
+#else
+    return static_cast<int>(write(fd, &byte, 1));
+#endif
+}
+
+int readByte(int fd)
+{
+    char byte = 0;
+#ifdef Q_OS_WIN
+    return _read(fd, &byte, 1);
+#else
+    return static_cast<int>(read(fd, &byte, 1));
+#endif
+}
+
+void closeDescriptor(int fd)
+{
+#ifdef Q_OS_WIN
+    _close(fd);
+#else
+    close(fd);
+#endif
+}
+
+} // namespace
+
 Logger& Logger::instance()
 {
     static Logger instance;
@@ -15,16 +202,42 @@ Logger& Logger::instance()
 
 Logger::Logger()
     : m_minimumLevel(Level::Info)
+    , m_maxFileSize(DEFAULT_MAX_FILE_SIZE)
+    , m_maxBackups(DEFAULT_MAX_BACKUPS)
+    , m_queue(QUEUE_CAPACITY)
+    , m_dropped(0)
+    , m_writerSleeping(false)
+    , m_stopping(false)
+    , m_flushRequests(0)
+    , m_flushesDone(0)
+    , m_crashPipe{ -1, -1 }
+    , m_cachedSecond(-1)
 {
     QString logDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir().mkpath(logDir);
 
     QString logPath = QDir(logDir).filePath("dronemapper.log");
     setLogFile(logPath);
+
+    m_writer = std::thread(&Logger::writerLoop, this);
 }
 
 Logger::~Logger()
 {
+    m_stopping.store(true);
+    wakeWriter();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+
+    if (m_crashWatcher.joinable()) {
+        crashPipeWrite.store(-1);
+        writeByte(m_crashPipe[1]);
+        m_crashWatcher.join();
+        closeDescriptor(m_crashPipe[0]);
+        closeDescriptor(m_crashPipe[1]);
+    }
+
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
@@ -32,7 +245,12 @@ Logger::~Logger()
 
 void Logger::setLogFile(const QString& filePath)
 {
-    QMutexLocker locker(&m_mutex);
+    // Earlier messages belong to the previous file
+    if (m_writer.joinable()) {
+        flush();
+    }
+
+    std::lock_guard<std::mutex> locker(m_fileMutex);
 
     if (m_logFile.isOpen()) {
         m_logFile.close();
@@ -41,39 +259,45 @@ void Logger::setLogFile(const QString& filePath)
     m_logFilePath = filePath;
     m_logFile.setFileName(filePath);
     m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
-    m_logStream.setDevice(&m_logFile);
 }
 
 void Logger::setLogLevel(Level level)
 {
-    m_minimumLevel = level;
+    m_minimumLevel.store(level, std::memory_order_relaxed);
+}
+
+void Logger::setRotation(qint64 maxFileSize, int maxBackups)
+{
+    std::lock_guard<std::mutex> locker(m_fileMutex);
+    m_maxFileSize = maxFileSize;
+    m_maxBackups = maxBackups;
 }
 
 void Logger::log(Level level, const QString& message, const QString& category)
 {
-    if (level < m_minimumLevel) {
+    if (level < m_minimumLevel.load(std::memory_order_relaxed)) {
         return;
     }
 
-    QString levelStr;
-    switch (level) {
-        case Level::Debug:    levelStr = "DEBUG"; break;
-        case Level::Info:     levelStr = "INFO"; break;
-        case Level::Warning:  levelStr = "WARN"; break;
-        case Level::Error:    levelStr = "ERROR"; break;
-        case Level::Critical: levelStr = "CRITICAL"; break;
-    }
+    // Formatting is deferred to the writer thread
+    Record record{ QDateTime::currentMSecsSinceEpoch(), level, message, category };
 
-    QString timestamp = QDateTime::currentDateTime().toString(Qt::ISODate);
-    QString categoryStr = category.isEmpty() ? "" : QString("[%1] ").arg(category);
+    if (!m_queue.tryPush(std::move(record))) {
+        if (level < Level::Warning || std::this_thread::get_id() == writerThreadId.load()) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
 
-    QString logMessage = QString("[%1] %2 %3%4")
-        .arg(timestamp)
-        .arg(levelStr)
-        .arg(categoryStr)
-        .arg(message);
+        // Never lose warnings and errors: wait for the writer
+        do {
+            wakeWriter();
+            std::this_thread::yield();
+        } while (!m_queue.tryPush(std::move(record)));
+    }
 
-    writeToFile(logMessage);
+    if (m_writerSleeping.load()) {
+        wakeWriter();
+    }
 }
 
 void Logger::debug(const QString& message, const QString& category)
@@ -99,16 +323,257 @@ void Logger::error(const QString& message, const QString& category)
 void Logger::critical(const QString& message, const QString& category)
 {
     log(Level::Critical, message, category);
+
+    // The process may be about to die
+    flush();
 }
 
-void Logger::writeToFile(const QString& message)
+void Logger::flush()
 {
-    QMutexLocker locker(&m_mutex);
+    if (std::this_thread::get_id() == writerThreadId.load()) {
+        return;
+    }
 
-    if (m_logFile.isOpen()) {
-        m_logStream << message << "\n";
-        m_logStream.flush();
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    const quint64 request = ++m_flushRequests;
+    m_wake.notify_one();
+    m_flushed.wait(lock, [this, request] { return m_flushesDone >= request || m_stopping.load(); });
+}
+
+void Logger::wakeWriter()
+{
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wake.notify_one();
+}
+
+void Logger::writerLoop()
+{
+    writerThreadId.store(std::this_thread::get_id());
+
+    for (;;) {
+        quint64 pendingFlush = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            pendingFlush = m_flushRequests;
+        }
+
+        drainQueue();
+
+        {
+            std::lock_guard<std::mutex> locker(m_fileMutex);
+            if (m_logFile.isOpen()) {
+                m_logFile.flush();
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        if (pendingFlush > m_flushesDone) {
+            m_flushesDone = pendingFlush;
+            m_flushed.notify_all();
+        }
+
+        if (m_stopping.load()) {
+            lock.unlock();
+            drainQueue();
+            m_flushed.notify_all();
+            return;
+        }
+
+        if (!m_queue.isEmpty() || m_flushRequests > m_flushesDone) {
+            continue;
+        }
+
+        // Producers wake us only while this flag is set
+        m_writerSleeping.store(true);
+        if (m_queue.isEmpty()) {
+            m_wake.wait_for(lock, std::chrono::milliseconds(WRITER_IDLE_MS));
+        }
+        m_writerSleeping.store(false);
+    }
+}
+
+void Logger::drainQueue()
+{
+    QByteArray batch;
+    Record record;
+    int count = 0;
+
+    const quint64 dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        Record notice{ QDateTime::currentMSecsSinceEpoch(), Level::Warning,
+                       QString("%1 log messages dropped (queue full)").arg(dropped), QString() };
+        batch += formatRecord(notice);
+    }
+
+    while (m_queue.tryPop(record)) {
+        batch += formatRecord(record);
+
+        if (++count >= MAX_BATCH_RECORDS) {
+            writeBatch(batch);
+            batch.clear();
+            count = 0;
+        }
+    }
+
+    if (!batch.isEmpty()) {
+        writeBatch(batch);
+    }
+}
+
+QByteArray Logger::formatRecord(const Record& record)
+{
+    const qint64 second = record.timestamp / 1000;
+    if (second != m_cachedSecond) {
+        m_cachedSecond = second;
+        m_cachedTimestamp = QDateTime::fromMSecsSinceEpoch(record.timestamp).toString(Qt::ISODate).toUtf8();
+    }
+
+    QByteArray line;
+    line.reserve(m_cachedTimestamp.size() + record.message.size() + record.category.size() + 24);
+    line += '[';
+    line += m_cachedTimestamp;
+    line += "] ";
+    line += levelName(record.level);
+    line += ' ';
+    if (!record.category.isEmpty()) {
+        line += '[';
+        line += record.category.toUtf8();
+        line += "] ";
+    }
+    line += record.message.toUtf8();
+    line += '\n';
+    return line;
+}
+
+void Logger::writeBatch(const QByteArray& batch)
+{
+    std::lock_guard<std::mutex> locker(m_fileMutex);
+
+    if (!m_logFile.isOpen()) {
+        return;
+    }
+
+    if (m_maxFileSize > 0 && m_logFile.size() + batch.size() > m_maxFileSize && m_logFile.size() > 0) {
+        rotate();
+    }
+
+    // One write per batch instead of one per line
+    m_logFile.write(batch);
+}
+
+void Logger::rotate()
+{
+    m_logFile.close();
+
+    // name.(n-1) -> name.n, ..., name -> name.1
+    for (int i = m_maxBackups - 1; i >= 1; --i) {
+        const QString from = QString("%1.%2").arg(m_logFilePath).arg(i);
+        const QString to = QString("%1.%2").arg(m_logFilePath).arg(i + 1);
+        QFile::remove(to);
+        QFile::rename(from, to);
+    }
+
+    if (m_maxBackups > 0) {
+        const QString first = m_logFilePath + ".1";
+        QFile::remove(first);
+        QFile::rename(m_logFilePath, first);
+    } else {
+        QFile::remove(m_logFilePath);
     }
+
+    m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+}
+
+void Logger::installCrashHandler()
+{
+    Logger& logger = instance();
+    if (logger.m_crashWatcher.joinable()) {
+        return;
+    }
+
+    if (!createPipe(logger.m_crashPipe)) {
+        logger.warning("Cannot create crash pipe; fatal signals will not flush the log");
+        return;
+    }
+    crashPipeWrite.store(logger.m_crashPipe[1]);
+    logger.m_crashWatcher = std::thread(&Logger::crashWatcherLoop, &logger);
+
+    const int signals[] = {
+        SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#ifdef SIGBUS
+        SIGBUS,
+#endif
+    };
+
+    for (int signal : signals) {
+#ifdef Q_OS_WIN
+        std::signal(signal, &Logger::handleCrashSignal);
+#else
+        // One shot: the default action is back in place when the handler re-raises
+        struct sigaction action = {};
+        action.sa_handler = &Logger::handleCrashSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESETHAND;
+        sigaction(signal, &action, nullptr);
+#endif
+    }
+}
+
+void Logger::crashWatcherLoop()
+{
+    // Blocks until the handler (or the destructor) writes to the pipe
+    while (readByte(m_crashPipe[0]) < 0 && errno == EINTR) {
+    }
+
+    if (crashSignal.load() == 0) {
+        return;     // Shutting down
+    }
+
+    // Leave the handler time to see the record written even if the
+    // writer is the thread that crashed and never answers
+    {
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        const quint64 request = ++m_flushRequests;
+        m_wake.notify_one();
+        m_flushed.wait_for(lock, std::chrono::milliseconds(CRASH_FLUSH_TIMEOUT_MS / 2),
+                           [this, request] { return m_flushesDone >= request; });
+    }
+
+    writeBatch(QByteArray(crashRecord, crashRecordLength.load()));
+    {
+        std::lock_guard<std::mutex> locker(m_fileMutex);
+        if (m_logFile.isOpen()) {
+            m_logFile.flush();
+        }
+    }
+
+    crashWritten.store(true);
+}
+
+void Logger::handleCrashSignal(int signal)
+{
+    // Async-signal-safe only: atomics, the preallocated record, write()
+    // and sleeping. The watcher thread drains the queue and writes the record.
+#ifdef Q_OS_WIN
+    std::signal(signal, SIG_DFL);
+#endif
+
+    const int savedErrno = errno;
+
+    int expected = 0;
+    const int fd = crashPipeWrite.load();
+    if (fd >= 0 && crashSignal.compare_exchange_strong(expected, signal)) {
+        crashRecordLength.store(formatCrashRecord(signal, crashRecord, CRASH_RECORD_SIZE));
+        writeByte(fd);
+    }
+
+    // Bounded wait, also for threads that crash while another one is reporting
+    for (int waited = 0; waited < CRASH_FLUSH_TIMEOUT_MS && !crashWritten.load(); waited += CRASH_POLL_MS) {
+        sleepMilliseconds(CRASH_POLL_MS);
+    }
+
+    errno = savedErrno;
+    std::raise(signal);
 }
 
 } // namespace Core
@@ -1,5 +1,4 @@
 #include "MissionSimulator.h"
-#include "geospatial/GeoUtils.h"
 #include <QtMath>
 #include <QDebug>
 
@@ -122,10 +121,9 @@ void MissionSimulator::jumpToWaypoint(int waypointIndex)
 
     // Calculate accumulated distance and time
     double accumDist = 0.0;
-    for (int i = 0; i < waypointIndex && i < m_flightPlan.waypoints().size() - 1; i++) {
-        accumDist += Geospatial::GeoUtils::distanceBetween(
-            m_flightPlan.waypoints()[i].coordinate(),
-            m_flightPlan.waypoints()[i + 1].coordinate());
+    const auto& segments = m_flightPlan.geometry().segments();
+    for (int i = 0; i < waypointIndex && i < segments.size(); i++) {
+        accumDist += segments[i].length;
     }
 
     m_currentState.distanceTraveled = accumDist;
@@ -173,7 +171,7 @@ void MissionSimulator::updateSimulation()
         const auto& currentWP = waypoints[m_currentState.currentWaypointIndex].coordinate();
         const auto& nextWP = waypoints[m_currentState.currentWaypointIndex + 1].coordinate();
 
-        double segmentDist = Geospatial::GeoUtils::distanceBetween(currentWP, nextWP);
+        double segmentDist = m_flightPlan.geometry().segments()[m_currentState.currentWaypointIndex].length;
         double segmentTime = segmentDist / DEFAULT_CRUISE_SPEED;
 
         // Calculate time into current segment
@@ -244,14 +242,11 @@ void MissionSimulator::calculateStatistics()
     m_statistics.totalWaypoints = waypoints.size();
 
     // Calculate total distance
-    double totalDist = 0.0;
+    const auto& segments = m_flightPlan.geometry().segments();
+    double totalDist = m_flightPlan.geometry().totalDistance();
     double maxAlt = 0.0;
 
     for (int i = 0; i < waypoints.size() - 1; i++) {
-        double segDist = Geospatial::GeoUtils::distanceBetween(
-            waypoints[i].coordinate(),
-            waypoints[i + 1].coordinate());
-        totalDist += segDist;
         maxAlt = qMax(maxAlt, waypoints[i].coordinate().altitude());
     }
     if (!waypoints.isEmpty()) {
@@ -281,10 +276,7 @@ void MissionSimulator::calculateStatistics()
 
     for (int i = 0; i < waypoints.size(); i++) {
         if (i > 0) {
-            double segDist = Geospatial::GeoUtils::distanceBetween(
-                waypoints[i - 1].coordinate(),
-                waypoints[i].coordinate());
-            accumTime += segDist / DEFAULT_CRUISE_SPEED;
+            accumTime += segments[i - 1].length / DEFAULT_CRUISE_SPEED;
         }
 
         double batteryPercent = 100.0 - calculateBatteryUsage(accumTime);
@@ -374,11 +366,10 @@ QStringList MissionSimulator::performSafetyChecks() const
     }
 
     // Check for rapid altitude changes
+    const auto& segments = m_flightPlan.geometry().segments();
     for (int i = 1; i < waypoints.size(); i++) {
-        double altChange = qAbs(waypoints[i].coordinate().altitude() - waypoints[i - 1].coordinate().altitude());
-        double dist = Geospatial::GeoUtils::distanceBetween(
-            waypoints[i - 1].coordinate(),
-            waypoints[i].coordinate());
+        double altChange = qAbs(segments[i - 1].climb);
+        double dist = segments[i - 1].length;
 
         if (altChange > 50.0 && dist < 100.0) {
             warnings << QString("Waypoints %1-%2: Rapid altitude change (%.1f m over %.1f m distance)")
@@ -1,6 +1,5 @@
 #include "MissionStatistics.h"
 #include "geospatial/GeoUtils.h"
-#include "FlightPathOptimizer.h"
 #include <cmath>
 #include <algorithm>
 
@@ -170,8 +169,8 @@ MissionStats MissionStatistics::analyze(
 
     // Efficiency metrics
     stats.flightEfficiency = calculateFlightEfficiency(plan);
-    stats.turnCount = calculateTurnCount(waypoints);
-    stats.avgTurnAngle = calculateAvgTurnAngle(waypoints);
+    stats.turnCount = plan.geometry().turnCount(30.0);
+    stats.avgTurnAngle = plan.geometry().averageTurnAngle();
     stats.pathOptimization = stats.flightEfficiency; // Simplified
 
     // Quality metrics
@@ -447,31 +446,6 @@ double MissionStatistics::calculateEffectiveCoverage(
     return surveyArea * overlapFactor;
 }
 
-int MissionStatistics::calculateTurnCount(
-    const QList<Models::Waypoint>& waypoints)
-{
-    return FlightPathOptimizer::calculateDirectionChanges(waypoints, 30.0);
-}
-
-double MissionStatistics::calculateAvgTurnAngle(
-    const QList<Models::Waypoint>& waypoints)
-{
-    if (waypoints.count() < 3) {
-        return 0.0;
-    }
-
-    double totalAngle = 0.0;
-    int turnCount = 0;
-
-    for (int i = 2; i < waypoints.count(); ++i) {
-        // Calculate bearing change between segments
-        // This is simplified - production would use proper bearing calculations
-        turnCount++;
-    }
-
-    return turnCount > 0 ? totalAngle / turnCount : 0.0;
-}
-
 double MissionStatistics::calculateCoverageQuality(
     const Models::FlightPlan& plan,
     const Models::MissionParameters& params)
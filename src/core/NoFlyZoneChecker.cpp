@@ -4,12 +4,126 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QSet>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 namespace DroneMapper {
 namespace Core {
 
+namespace {
+
+// A zone projected into a plan's local frame
+struct LocalZone {
+    const NoFlyZone* zone;
+    QPointF center;
+    double radius;
+    QPolygonF boundary;     // Meters; empty for circular zones
+    QRectF extent;
+};
+
+LocalZone projectZone(const NoFlyZone& zone, const ProjectedPlan& projection)
+{
+    LocalZone local;
+    local.zone = &zone;
+    local.center = projection.project(zone.center);
+    local.radius = zone.radiusMeters;
+
+    if (zone.isCircular()) {
+        local.extent = QRectF(local.center.x() - local.radius, local.center.y() - local.radius,
+                              2 * local.radius, 2 * local.radius);
+        return local;
+    }
+
+    // Polygon boundaries are (longitude, latitude)
+    for (const QPointF& vertex : zone.boundary) {
+        local.boundary.append(projection.project(Models::GeospatialCoordinate(vertex.y(), vertex.x(), 0.0)));
+    }
+    local.extent = local.boundary.boundingRect();
+    return local;
+}
+
+bool withinAltitudeBand(double altitude, const NoFlyZone& zone)
+{
+    // 0 = unbounded, as isInsideZone
+    if (zone.minAltitude > 0.0 && altitude < zone.minAltitude) {
+        return false;
+    }
+    if (zone.maxAltitude > 0.0 && altitude > zone.maxAltitude) {
+        return false;
+    }
+    return true;
+}
+
+double distanceToSegment(const QPointF& p, const QPointF& a, const QPointF& b)
+{
+    const QPointF ab = b - a;
+    const double lengthSquared = QPointF::dotProduct(ab, ab);
+    double t = lengthSquared > 0.0 ? QPointF::dotProduct(p - a, ab) / lengthSquared : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    const QPointF closest = a + ab * t;
+    return std::hypot(p.x() - closest.x(), p.y() - closest.y());
+}
+
+double orientation(const QPointF& a, const QPointF& b, const QPointF& c)
+{
+    return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+}
+
+bool segmentsIntersect(const QPointF& a, const QPointF& b, const QPointF& c, const QPointF& d)
+{
+    const double d1 = orientation(c, d, a);
+    const double d2 = orientation(c, d, b);
+    const double d3 = orientation(a, b, c);
+    const double d4 = orientation(a, b, d);
+    return ((d1 > 0.0) != (d2 > 0.0)) && ((d3 > 0.0) != (d4 > 0.0));
+}
+
+bool contains(const LocalZone& local, const QPointF& point)
+{
+    if (local.boundary.isEmpty()) {
+        return std::hypot(point.x() - local.center.x(), point.y() - local.center.y()) <= local.radius;
+    }
+    return local.boundary.containsPoint(point, Qt::OddEvenFill);
+}
+
+// Meters from a point inside the zone to its edge
+double depthInside(const LocalZone& local, const QPointF& point)
+{
+    if (local.boundary.isEmpty()) {
+        return local.radius - std::hypot(point.x() - local.center.x(), point.y() - local.center.y());
+    }
+
+    double depth = std::numeric_limits<double>::max();
+    const int n = local.boundary.count();
+    for (int i = 0; i < n; ++i) {
+        depth = std::min(depth, distanceToSegment(point, local.boundary[i], local.boundary[(i + 1) % n]));
+    }
+    return depth;
+}
+
+bool crosses(const LocalZone& local, const QPointF& start, const QPointF& end)
+{
+    if (local.boundary.isEmpty()) {
+        return distanceToSegment(local.center, start, end) <= local.radius;
+    }
+
+    if (contains(local, start) || contains(local, end)) {
+        return true;
+    }
+
+    const int n = local.boundary.count();
+    for (int i = 0; i < n; ++i) {
+        if (segmentsIntersect(start, end, local.boundary[i], local.boundary[(i + 1) % n])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
 bool NoFlyZone::isActive(const QDateTime& time) const
 {
     if (!effectiveStart.isValid() && !effectiveEnd.isValid()) {
@@ -129,6 +243,19 @@ NoFlyZoneChecker::NoFlyZoneChecker()
 NoFlyCheckResult NoFlyZoneChecker::checkFlightPlan(
     const Models::FlightPlan& plan,
     const ZoneDatabase& database)
+{
+    const auto& waypoints = plan.waypoints();
+    const Models::GeospatialCoordinate origin = waypoints.isEmpty()
+        ? Models::GeospatialCoordinate() : waypoints.first().coordinate();
+
+    return checkFlightPlan(plan, database, ProjectedPlan(plan, origin));
+}
+
+NoFlyCheckResult NoFlyZoneChecker::checkFlightPlan(
+    const Models::FlightPlan& plan,
+    const ZoneDatabase& database,
+    const ProjectedPlan& projection,
+    const std::atomic<bool>* cancelled)
 {
     NoFlyCheckResult result;
     result.isSafe = true;
@@ -136,66 +263,97 @@ NoFlyCheckResult NoFlyZoneChecker::checkFlightPlan(
     result.warningViolations = 0;
 
     const auto& waypoints = plan.waypoints();
-    QDateTime checkTime = QDateTime::currentDateTime();
+    const QVector<QPointF>& points = projection.points();
+    const QDateTime checkTime = QDateTime::currentDateTime();
+
+    auto isCancelled = [cancelled]() {
+        return cancelled && cancelled->load(std::memory_order_relaxed);
+    };
+
+    // Active zones in the plan's local frame
+    QList<LocalZone> localZones;
+    for (const auto& zone : database.zones) {
+        if (zone.isActive(checkTime)) {
+            localZones.append(projectZone(zone, projection));
+        }
+    }
+
+    QSet<QString> reported;
 
     // Check each waypoint
-    for (int i = 0; i < waypoints.count(); ++i) {
+    for (int i = 0; i < waypoints.count() && i < points.count(); ++i) {
+        if (isCancelled()) {
+            return result;
+        }
+
         const auto& wp = waypoints[i];
-        auto violations = checkPoint(wp.coordinate(), wp.coordinate().altitude(), database);
+        const double altitude = wp.coordinate().altitude();
 
-        for (auto& v : violations) {
+        for (const LocalZone& local : localZones) {
+            const NoFlyZone& zone = *local.zone;
+            if (!local.extent.contains(points[i]) || !withinAltitudeBand(altitude, zone) ||
+                !contains(local, points[i])) {
+                continue;
+            }
+
+            ZoneViolation v;
+            v.zone = zone;
+            v.violationPoint = wp.coordinate();
             v.waypointIndex = i;
+            v.isPathViolation = false;
+            v.distanceIntoZone = depthInside(local, points[i]);
+            v.message = QString("Location inside %1 restricted area").arg(zone.name);
 
             // Count by severity
-            if (v.zone.level == RestrictionLevel::NoFly ||
-                v.zone.level == RestrictionLevel::Authorization) {
+            if (zone.level == RestrictionLevel::NoFly ||
+                zone.level == RestrictionLevel::Authorization) {
                 result.criticalViolations++;
                 result.isSafe = false;
             } else {
                 result.warningViolations++;
             }
 
+            reported.insert(zone.id);
             result.violations.append(v);
         }
     }
 
     // Check path segments
-    for (int i = 1; i < waypoints.count(); ++i) {
-        const auto& wp1 = waypoints[i-1];
-        const auto& wp2 = waypoints[i];
-
-        for (const auto& zone : database.zones) {
-            if (!zone.isActive(checkTime)) continue;
-
-            if (pathCrossesZone(wp1.coordinate(), wp2.coordinate(), zone)) {
-                // Check if not already reported
-                bool alreadyReported = false;
-                for (const auto& v : result.violations) {
-                    if (v.zone.id == zone.id) {
-                        alreadyReported = true;
-                        break;
-                    }
-                }
-
-                if (!alreadyReported) {
-                    ZoneViolation v;
-                    v.zone = zone;
-                    v.violationPoint = wp1.coordinate();
-                    v.waypointIndex = i;
-                    v.isPathViolation = true;
-                    v.message = "Flight path crosses restricted zone";
-                    v.distanceIntoZone = 0.0;
-
-                    if (zone.level == RestrictionLevel::NoFly) {
-                        result.criticalViolations++;
-                        result.isSafe = false;
-                    } else {
-                        result.warningViolations++;
-                    }
-
-                    result.violations.append(v);
-                }
+    for (int i = 1; i < waypoints.count() && i < points.count(); ++i) {
+        if (isCancelled()) {
+            return result;
+        }
+
+        const QPointF& start = points[i - 1];
+        const QPointF& end = points[i];
+        const QRectF legExtent = QRectF(start, end).normalized();
+
+        for (const LocalZone& local : localZones) {
+            const NoFlyZone& zone = *local.zone;
+
+            // Report each zone once
+            if (reported.contains(zone.id) || !legExtent.intersects(local.extent) ||
+                !crosses(local, start, end)) {
+                continue;
+            }
+
+            ZoneViolation v;
+            v.zone = zone;
+            v.violationPoint = waypoints[i - 1].coordinate();
+            v.waypointIndex = i;
+            v.isPathViolation = true;
+            v.message = "Flight path crosses restricted zone";
+            v.distanceIntoZone = 0.0;
+
+            if (zone.level == RestrictionLevel::NoFly) {
+                result.criticalViolations++;
+                result.isSafe = false;
+            } else {
+                result.warningViolations++;
             }
+
+            reported.insert(zone.id);
+            result.violations.append(v);
         }
     }
 
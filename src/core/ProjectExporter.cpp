@@ -1,4 +1,5 @@
 #include "ProjectExporter.h"
+#include "Tracer.h"
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -88,6 +89,8 @@ ExportResult ProjectExporter::exportProject(
     const QString& filePath,
     ExportFormat format)
 {
+    TRACE_SCOPE("export", "ProjectExporter::exportProject");
+
     QElapsedTimer timer;
     timer.start();
 
@@ -131,6 +134,8 @@ ExportResult ProjectExporter::exportProject(
 
 ImportResult ProjectExporter::importProject(const QString& filePath)
 {
+    TRACE_SCOPE("export", "ProjectExporter::importProject");
+
     QElapsedTimer timer;
     timer.start();
 
@@ -220,6 +225,8 @@ QJsonObject ProjectExporter::exportParametersJson(const Models::MissionParameter
     json["pathSpacing"] = params.pathSpacing();
     json["flightDirection"] = params.flightDirection();
     json["reversePath"] = params.reversePath();
+    json["boundaryInset"] = params.boundaryInset();
+    json["turnOvershoot"] = params.turnOvershoot();
 
     json["cameraModel"] = static_cast<int>(params.cameraModel());
     json["frontOverlap"] = params.frontOverlap();
@@ -240,6 +247,8 @@ Models::MissionParameters ProjectExporter::importParametersJson(const QJsonObjec
     params.setPathSpacing(json["pathSpacing"].toDouble());
     params.setFlightDirection(json["flightDirection"].toDouble());
     params.setReversePath(json["reversePath"].toBool());
+    params.setBoundaryInset(json["boundaryInset"].toDouble());
+    params.setTurnOvershoot(json["turnOvershoot"].toDouble());
 
     params.setCameraModel(
         static_cast<Models::MissionParameters::CameraModel>(json["cameraModel"].toInt()));
@@ -0,0 +1,49 @@
+#include "ProjectedPlan.h"
+#include "geospatial/GeoUtils.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <limits>
+
+namespace DroneMapper {
+namespace Core {
+
+ProjectedPlan::ProjectedPlan()
+{
+}
+
+ProjectedPlan::ProjectedPlan(const Models::FlightPlan& plan, const Models::GeospatialCoordinate& origin)
+    : m_origin(origin)
+{
+    TRACE_SCOPE("validation", "ProjectedPlan");
+
+    const QList<Models::Waypoint>& waypoints = plan.waypoints();
+    if (waypoints.isEmpty()) {
+        return;
+    }
+
+    m_points.reserve(waypoints.count());
+
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+
+    for (const Models::Waypoint& waypoint : waypoints) {
+        const QPointF local = Geospatial::GeoUtils::toCartesian(waypoint.coordinate(), m_origin);
+        m_points.append(local);
+        minX = std::min(minX, local.x());
+        maxX = std::max(maxX, local.x());
+        minY = std::min(minY, local.y());
+        maxY = std::max(maxY, local.y());
+    }
+
+    m_bounds = QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+}
+
+QPointF ProjectedPlan::project(const Models::GeospatialCoordinate& coordinate) const
+{
+    return Geospatial::GeoUtils::toCartesian(coordinate, m_origin);
+}
+
+} // namespace Core
+} // namespace DroneMapper
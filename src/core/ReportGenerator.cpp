@@ -1,5 +1,4 @@
 #include "ReportGenerator.h"
-#include "geospatial/GeoUtils.h"
 #include <QFile>
 #include <QTextStream>
 #include <QFileInfo>
@@ -25,6 +24,7 @@ ReportSections::ReportSections()
     , includeSafetyAnalysis(true)
     , includeEquipment(true)
     , includePhotogrammetryPlan(true)
+    , includeVolumeChange(true)
     , includeAppendices(false)
 {
 }
@@ -194,6 +194,11 @@ bool ReportGenerator::generateHTML(
         out << generatePhotogrammetryPlan(plan);
     }
 
+    // Volume change
+    if (options.sections.includeVolumeChange && options.volumeChange.valid) {
+        out << generateVolumeChange(options.volumeChange);
+    }
+
     // Footer
     out << "<div class=\"footer\">\n";
     if (!options.customFooter.isEmpty()) {
@@ -255,6 +260,17 @@ bool ReportGenerator::generateMarkdown(
     out << "- **Side Overlap:** " << params.sideOverlap() << "%\n";
     out << "- **Gimbal Angle:** " << params.gimbalPitch() << "°\n\n";
 
+    // Volume change
+    const auto& volume = options.volumeChange;
+    if (options.sections.includeVolumeChange && volume.valid) {
+        out << "## Volume Change\n\n";
+        out << "- **Surfaces:** " << volume.beforeLabel << " → " << volume.afterLabel << "\n";
+        out << "- **Cut:** " << QString::number(volume.cutVolume, 'f', 1) << " m³ over " << formatArea(volume.cutArea) << "\n";
+        out << "- **Fill:** " << QString::number(volume.fillVolume, 'f', 1) << " m³ over " << formatArea(volume.fillArea) << "\n";
+        out << "- **Net:** " << QString::number(volume.netVolume, 'f', 1) << " m³\n";
+        out << "- **Analysed Area:** " << formatArea(volume.analysedArea) << "\n\n";
+    }
+
     file.close();
     return true;
 }
@@ -528,17 +544,44 @@ QString ReportGenerator::generatePhotogrammetryPlan(const Models::FlightPlan& pl
     return html;
 }
 
+QString ReportGenerator::generateVolumeChange(const Geospatial::VolumeChangeSummary& summary)
+{
+    QString html;
+    html += "<div class=\"section\">\n";
+    html += "    <h2>Volume Change</h2>\n";
+
+    html += "    <h3>Surfaces Compared</h3>\n";
+    html += "    <table>\n";
+    html += "        <tr><td><strong>Before:</strong></td><td>" + summary.beforeLabel + "</td></tr>\n";
+    html += "        <tr><td><strong>After:</strong></td><td>" + summary.afterLabel + "</td></tr>\n";
+    html += "        <tr><td><strong>Grid:</strong></td><td>" + QString::number(summary.columns) + " × " +
+            QString::number(summary.rows) + " cells</td></tr>\n";
+    html += "        <tr><td><strong>Analysed Area:</strong></td><td>" + formatArea(summary.analysedArea) + "</td></tr>\n";
+    html += "    </table>\n";
+
+    html += "    <h3>Cut and Fill</h3>\n";
+    html += "    <table>\n";
+    html += "        <tr><td><strong>Cut:</strong></td><td>" + QString::number(summary.cutVolume, 'f', 1) +
+            " m³ over " + formatArea(summary.cutArea) + "</td></tr>\n";
+    html += "        <tr><td><strong>Fill:</strong></td><td>" + QString::number(summary.fillVolume, 'f', 1) +
+            " m³ over " + formatArea(summary.fillArea) + "</td></tr>\n";
+    html += "        <tr><td><strong>Net Change:</strong></td><td>" + QString::number(summary.netVolume, 'f', 1) + " m³</td></tr>\n";
+    html += "        <tr><td><strong>Elevation Change:</strong></td><td>" + QString::number(summary.minChange, 'f', 2) +
+            " to " + QString::number(summary.maxChange, 'f', 2) + " m (mean " +
+            QString::number(summary.meanChange, 'f', 2) + " m)</td></tr>\n";
+    html += "    </table>\n";
+
+    html += "</div>\n";
+
+    return html;
+}
+
 ReportGenerator::ReportStatistics ReportGenerator::calculateStatistics(const Models::FlightPlan& plan)
 {
     ReportStatistics stats;
 
-    // Calculate total distance
-    stats.totalDistance = 0.0;
-    for (int i = 1; i < plan.waypoints().count(); ++i) {
-        stats.totalDistance += Geospatial::GeoUtils::distanceBetween(
-            plan.waypoints()[i-1].coordinate(),
-            plan.waypoints()[i].coordinate());
-    }
+    // Total distance from the plan's cached leg lengths
+    stats.totalDistance = plan.totalDistance();
 
     // Estimate flight time (using flight speed from parameters)
     double avgSpeed = plan.parameters().flightSpeed();
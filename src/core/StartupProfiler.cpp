@@ -0,0 +1,64 @@
+#include "StartupProfiler.h"
+#include "Logger.h"
+#include <QElapsedTimer>
+
+namespace DroneMapper {
+namespace Core {
+
+namespace {
+
+QElapsedTimer startupTimer;
+qint64 lastMarkMs = 0;
+bool finished = false;
+
+} // namespace
+
+void StartupProfiler::start()
+{
+    startupTimer.start();
+    lastMarkMs = 0;
+    finished = false;
+}
+
+void StartupProfiler::mark(const QString& phase)
+{
+    if (!startupTimer.isValid()) {
+        return;
+    }
+
+    const qint64 now = startupTimer.elapsed();
+    LOG_INFO(QString("Startup: %1 +%2 ms (%3 ms%4)")
+             .arg(phase)
+             .arg(now - lastMarkMs)
+             .arg(now)
+             .arg(finished ? ", after interactive" : ""));
+    lastMarkMs = now;
+}
+
+void StartupProfiler::finish()
+{
+    if (finished || !startupTimer.isValid()) {
+        return;
+    }
+
+    mark("Interactive");
+    finished = true;
+
+    const qint64 total = startupTimer.elapsed();
+    if (total > BUDGET_MS) {
+        LOG_WARNING(QString("Startup took %1 ms, budget is %2 ms").arg(total).arg(BUDGET_MS));
+    }
+}
+
+qint64 StartupProfiler::elapsedMs()
+{
+    return startupTimer.isValid() ? startupTimer.elapsed() : 0;
+}
+
+bool StartupProfiler::isFinished()
+{
+    return finished;
+}
+
+} // namespace Core
+} // namespace DroneMapper
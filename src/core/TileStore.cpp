@@ -0,0 +1,457 @@
+#include "TileStore.h"
+#include <QMutexLocker>
+#include <QDateTime>
+#include <sqlite3.h>
+
+namespace DroneMapper {
+namespace Core {
+
+namespace {
+
+constexpr qint64 MMAP_SIZE = qint64(1) << 30;   // Map up to 1 GiB of the file
+constexpr qint64 TOUCH_INTERVAL = 3600;         // Seconds; reads refresh last_access at most this often
+constexpr int EVICT_BATCH = 256;                // Entries deleted per eviction query
+
+} // namespace
+
+TileStore::TileStore()
+    : m_db(nullptr)
+    , m_selectTile(nullptr)
+    , m_insertTile(nullptr)
+    , m_selectResource(nullptr)
+    , m_insertResource(nullptr)
+    , m_touchTile(nullptr)
+    , m_touchResource(nullptr)
+    , m_budget(0)
+    , m_storedBytes(0)
+{
+}
+
+TileStore::~TileStore()
+{
+    close();
+}
+
+bool TileStore::open(const QString& filePath)
+{
+    close();
+
+    QMutexLocker locker(&m_mutex);
+
+    // FULLMUTEX is not needed: every call is serialized by m_mutex
+    int rc = sqlite3_open_v2(filePath.toUtf8().constData(), &m_db,
+                             SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX,
+                             nullptr);
+    if (rc != SQLITE_OK) {
+        m_lastError = m_db ? QString::fromUtf8(sqlite3_errmsg(m_db)) : "Cannot open tile store";
+        sqlite3_close(m_db);
+        m_db = nullptr;
+        return false;
+    }
+
+    const QByteArray pragmas = QString("PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL; "
+                                       "PRAGMA mmap_size=%1;").arg(MMAP_SIZE).toUtf8();
+
+    bool ok = execute(pragmas.constData()) &&
+              execute("CREATE TABLE IF NOT EXISTS metadata (name TEXT PRIMARY KEY, value TEXT)") &&
+              execute("CREATE TABLE IF NOT EXISTS tiles (zoom_level INTEGER, tile_column INTEGER, "
+                      "tile_row INTEGER, tile_data BLOB, "
+                      "PRIMARY KEY (zoom_level, tile_column, tile_row)) WITHOUT ROWID") &&
+              execute("CREATE TABLE IF NOT EXISTS resources (key TEXT PRIMARY KEY, "
+                      "mime_type TEXT, data BLOB)");
+
+    // Cache bookkeeping; extra columns leave the MBTiles tables readable by other tools
+    ok = ok &&
+         addColumn("tiles", "last_access", "INTEGER NOT NULL DEFAULT 0") &&
+         addColumn("tiles", "expires", "INTEGER NOT NULL DEFAULT 0") &&
+         addColumn("resources", "last_access", "INTEGER NOT NULL DEFAULT 0") &&
+         addColumn("resources", "expires", "INTEGER NOT NULL DEFAULT 0") &&
+         execute("CREATE INDEX IF NOT EXISTS tiles_last_access ON tiles (last_access)") &&
+         execute("CREATE INDEX IF NOT EXISTS resources_last_access ON resources (last_access)");
+
+    if (ok) {
+        m_selectTile = prepare("SELECT tile_data, expires FROM tiles WHERE zoom_level = ?1 "
+                               "AND tile_column = ?2 AND tile_row = ?3");
+        m_insertTile = prepare("INSERT OR REPLACE INTO tiles (zoom_level, tile_column, tile_row, "
+                               "tile_data, last_access, expires) VALUES (?1, ?2, ?3, ?4, ?5, ?6)");
+        m_selectResource = prepare("SELECT data, mime_type, expires FROM resources WHERE key = ?1");
+        m_insertResource = prepare("INSERT OR REPLACE INTO resources (key, mime_type, data, "
+                                   "last_access, expires) VALUES (?1, ?2, ?3, ?4, ?5)");
+        m_touchTile = prepare("UPDATE tiles SET last_access = ?4 WHERE zoom_level = ?1 "
+                              "AND tile_column = ?2 AND tile_row = ?3 AND last_access < ?5");
+        m_touchResource = prepare("UPDATE resources SET last_access = ?2 WHERE key = ?1 "
+                                  "AND last_access < ?3");
+        ok = m_selectTile && m_insertTile && m_selectResource && m_insertResource &&
+             m_touchTile && m_touchResource;
+    }
+
+    if (ok) {
+        m_storedBytes = queryBytes();
+    }
+
+    if (!ok) {
+        locker.unlock();
+        QString error = m_lastError;
+        close();
+        m_lastError = error;
+        return false;
+    }
+
+    return true;
+}
+
+void TileStore::close()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (sqlite3_stmt** stmt : { &m_selectTile, &m_insertTile, &m_selectResource, &m_insertResource,
+                                 &m_touchTile, &m_touchResource }) {
+        sqlite3_finalize(*stmt);
+        *stmt = nullptr;
+    }
+
+    if (m_db) {
+        sqlite3_close(m_db);
+        m_db = nullptr;
+    }
+    m_storedBytes = 0;
+}
+
+void TileStore::setByteBudget(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_budget = qMax<qint64>(0, bytes);
+    evict();
+}
+
+qint64 TileStore::byteBudget() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_budget;
+}
+
+qint64 TileStore::storedBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_storedBytes;
+}
+
+QByteArray TileStore::tile(int zoom, int x, int y, bool* stale) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_db) {
+        return QByteArray();
+    }
+
+    // MBTiles rows count from the south
+    const int tmsRow = (1 << zoom) - 1 - y;
+
+    sqlite3_bind_int(m_selectTile, 1, zoom);
+    sqlite3_bind_int(m_selectTile, 2, x);
+    sqlite3_bind_int(m_selectTile, 3, tmsRow);
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QByteArray data;
+    if (sqlite3_step(m_selectTile) == SQLITE_ROW) {
+        // Blob points into the mapped file; this is the only copy
+        data = QByteArray(static_cast<const char*>(sqlite3_column_blob(m_selectTile, 0)),
+                          sqlite3_column_bytes(m_selectTile, 0));
+        if (stale) {
+            *stale = sqlite3_column_int64(m_selectTile, 1) <= now;
+        }
+    }
+    sqlite3_reset(m_selectTile);
+
+    if (!data.isEmpty()) {
+        sqlite3_bind_int(m_touchTile, 1, zoom);
+        sqlite3_bind_int(m_touchTile, 2, x);
+        sqlite3_bind_int(m_touchTile, 3, tmsRow);
+        sqlite3_bind_int64(m_touchTile, 4, now);
+        sqlite3_bind_int64(m_touchTile, 5, now - TOUCH_INTERVAL);
+        sqlite3_step(m_touchTile);
+        sqlite3_reset(m_touchTile);
+    }
+
+    return data;
+}
+
+bool TileStore::storeTile(int zoom, int x, int y, const QByteArray& data, qint64 expires)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_db) {
+        return false;
+    }
+
+    const int tmsRow = (1 << zoom) - 1 - y;
+
+    sqlite3_bind_int(m_insertTile, 1, zoom);
+    sqlite3_bind_int(m_insertTile, 2, x);
+    sqlite3_bind_int(m_insertTile, 3, tmsRow);
+    sqlite3_bind_blob(m_insertTile, 4, data.constData(), data.size(), SQLITE_STATIC);
+    sqlite3_bind_int64(m_insertTile, 5, QDateTime::currentSecsSinceEpoch());
+    sqlite3_bind_int64(m_insertTile, 6, expires);
+
+    const bool ok = sqlite3_step(m_insertTile) == SQLITE_DONE;
+    if (!ok) {
+        m_lastError = QString::fromUtf8(sqlite3_errmsg(m_db));
+    }
+    sqlite3_reset(m_insertTile);
+    sqlite3_clear_bindings(m_insertTile);
+
+    if (ok) {
+        // Replaced rows are counted twice until evict() recounts
+        m_storedBytes += data.size();
+        evict();
+    }
+
+    return ok;
+}
+
+QByteArray TileStore::resource(const QString& key, QByteArray* mimeType, bool* stale) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_db) {
+        return QByteArray();
+    }
+
+    const QByteArray utf8 = key.toUtf8();
+    sqlite3_bind_text(m_selectResource, 1, utf8.constData(), utf8.size(), SQLITE_STATIC);
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QByteArray data;
+    if (sqlite3_step(m_selectResource) == SQLITE_ROW) {
+        data = QByteArray(static_cast<const char*>(sqlite3_column_blob(m_selectResource, 0)),
+                          sqlite3_column_bytes(m_selectResource, 0));
+        if (mimeType) {
+            *mimeType = QByteArray(reinterpret_cast<const char*>(sqlite3_column_text(m_selectResource, 1)),
+                                   sqlite3_column_bytes(m_selectResource, 1));
+        }
+        if (stale) {
+            *stale = sqlite3_column_int64(m_selectResource, 2) <= now;
+        }
+    }
+    sqlite3_reset(m_selectResource);
+    sqlite3_clear_bindings(m_selectResource);
+
+    if (!data.isEmpty()) {
+        sqlite3_bind_text(m_touchResource, 1, utf8.constData(), utf8.size(), SQLITE_STATIC);
+        sqlite3_bind_int64(m_touchResource, 2, now);
+        sqlite3_bind_int64(m_touchResource, 3, now - TOUCH_INTERVAL);
+        sqlite3_step(m_touchResource);
+        sqlite3_reset(m_touchResource);
+        sqlite3_clear_bindings(m_touchResource);
+    }
+
+    return data;
+}
+
+bool TileStore::storeResource(const QString& key, const QByteArray& data, const QByteArray& mimeType,
+                              qint64 expires)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_db) {
+        return false;
+    }
+
+    const QByteArray utf8 = key.toUtf8();
+    sqlite3_bind_text(m_insertResource, 1, utf8.constData(), utf8.size(), SQLITE_STATIC);
+    sqlite3_bind_text(m_insertResource, 2, mimeType.constData(), mimeType.size(), SQLITE_STATIC);
+    sqlite3_bind_blob(m_insertResource, 3, data.constData(), data.size(), SQLITE_STATIC);
+    sqlite3_bind_int64(m_insertResource, 4, QDateTime::currentSecsSinceEpoch());
+    sqlite3_bind_int64(m_insertResource, 5, expires);
+
+    const bool ok = sqlite3_step(m_insertResource) == SQLITE_DONE;
+    if (!ok) {
+        m_lastError = QString::fromUtf8(sqlite3_errmsg(m_db));
+    }
+    sqlite3_reset(m_insertResource);
+    sqlite3_clear_bindings(m_insertResource);
+
+    if (ok) {
+        m_storedBytes += data.size();
+        evict();
+    }
+
+    return ok;
+}
+
+QString TileStore::metadata(const QString& name) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_db) {
+        return QString();
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, "SELECT value FROM metadata WHERE name = ?1", -1, &stmt, nullptr) != SQLITE_OK) {
+        return QString();
+    }
+
+    const QByteArray utf8 = name.toUtf8();
+    sqlite3_bind_text(stmt, 1, utf8.constData(), utf8.size(), SQLITE_STATIC);
+
+    QString value;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        value = QString::fromUtf8(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+    }
+    sqlite3_finalize(stmt);
+
+    return value;
+}
+
+bool TileStore::setMetadata(const QString& name, const QString& value)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_db) {
+        return false;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, "INSERT OR REPLACE INTO metadata (name, value) VALUES (?1, ?2)",
+                           -1, &stmt, nullptr) != SQLITE_OK) {
+        m_lastError = QString::fromUtf8(sqlite3_errmsg(m_db));
+        return false;
+    }
+
+    const QByteArray utf8Name = name.toUtf8();
+    const QByteArray utf8Value = value.toUtf8();
+    sqlite3_bind_text(stmt, 1, utf8Name.constData(), utf8Name.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, utf8Value.constData(), utf8Value.size(), SQLITE_STATIC);
+
+    const bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+    if (!ok) {
+        m_lastError = QString::fromUtf8(sqlite3_errmsg(m_db));
+    }
+    sqlite3_finalize(stmt);
+
+    return ok;
+}
+
+QString TileStore::lastError() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lastError;
+}
+
+bool TileStore::execute(const char* sql)
+{
+    char* error = nullptr;
+    if (sqlite3_exec(m_db, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+        m_lastError = QString::fromUtf8(error ? error : "SQL error");
+        sqlite3_free(error);
+        return false;
+    }
+    return true;
+}
+
+sqlite3_stmt* TileStore::prepare(const char* sql)
+{
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        m_lastError = QString::fromUtf8(sqlite3_errmsg(m_db));
+        return nullptr;
+    }
+    return stmt;
+}
+
+bool TileStore::addColumn(const char* table, const char* column, const char* definition)
+{
+    const QByteArray info = QString("PRAGMA table_info(%1)").arg(table).toUtf8();
+    sqlite3_stmt* stmt = prepare(info.constData());
+    if (!stmt) {
+        return false;
+    }
+
+    bool found = false;
+    while (!found && sqlite3_step(stmt) == SQLITE_ROW) {
+        found = qstrcmp(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)), column) == 0;
+    }
+    sqlite3_finalize(stmt);
+
+    if (found) {
+        return true;
+    }
+
+    // Files written before the column existed
+    const QByteArray alter = QString("ALTER TABLE %1 ADD COLUMN %2 %3").arg(table, column, definition).toUtf8();
+    return execute(alter.constData());
+}
+
+qint64 TileStore::queryBytes()
+{
+    sqlite3_stmt* stmt = prepare("SELECT (SELECT COALESCE(SUM(length(tile_data)), 0) FROM tiles) + "
+                                 "(SELECT COALESCE(SUM(length(data)), 0) FROM resources)");
+    if (!stmt) {
+        return 0;
+    }
+
+    qint64 bytes = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        bytes = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return bytes;
+}
+
+void TileStore::evict()
+{
+    if (!m_db || m_budget <= 0 || m_storedBytes <= m_budget) {
+        return;
+    }
+
+    m_storedBytes = queryBytes();
+    if (m_storedBytes <= m_budget) {
+        return;
+    }
+
+    // Down to 90% of the budget, so the next few stores do not evict again
+    const qint64 target = m_budget - m_budget / 10;
+
+    sqlite3_stmt* oldest = prepare("SELECT 0, zoom_level, tile_column, tile_row, NULL, length(tile_data), "
+                                   "last_access FROM tiles UNION ALL "
+                                   "SELECT 1, 0, 0, 0, key, length(data), last_access FROM resources "
+                                   "ORDER BY 7 LIMIT ?1");
+    sqlite3_stmt* deleteTile = prepare("DELETE FROM tiles WHERE zoom_level = ?1 AND tile_column = ?2 "
+                                       "AND tile_row = ?3");
+    sqlite3_stmt* deleteResource = prepare("DELETE FROM resources WHERE key = ?1");
+
+    if (oldest && deleteTile && deleteResource) {
+        execute("BEGIN");
+
+        bool progressed = true;
+        while (m_storedBytes > target && progressed) {
+            progressed = false;
+            sqlite3_bind_int(oldest, 1, EVICT_BATCH);
+
+            while (m_storedBytes > target && sqlite3_step(oldest) == SQLITE_ROW) {
+                sqlite3_stmt* remove = deleteTile;
+                if (sqlite3_column_int(oldest, 0) == 0) {
+                    sqlite3_bind_int(deleteTile, 1, sqlite3_column_int(oldest, 1));
+                    sqlite3_bind_int(deleteTile, 2, sqlite3_column_int(oldest, 2));
+                    sqlite3_bind_int(deleteTile, 3, sqlite3_column_int(oldest, 3));
+                } else {
+                    remove = deleteResource;
+                    sqlite3_bind_text(deleteResource, 1, reinterpret_cast<const char*>(sqlite3_column_text(oldest, 4)),
+                                      sqlite3_column_bytes(oldest, 4), SQLITE_TRANSIENT);
+                }
+
+                if (sqlite3_step(remove) == SQLITE_DONE) {
+                    m_storedBytes -= sqlite3_column_int64(oldest, 5);
+                    progressed = true;
+                }
+                sqlite3_reset(remove);
+                sqlite3_clear_bindings(remove);
+            }
+            sqlite3_reset(oldest);
+        }
+
+        execute("COMMIT");
+    }
+
+    sqlite3_finalize(oldest);
+    sqlite3_finalize(deleteTile);
+    sqlite3_finalize(deleteResource);
+}
+
+} // namespace Core
+} // namespace DroneMapper
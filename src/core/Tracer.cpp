@@ -0,0 +1,335 @@
+#include "Tracer.h"
+#include "Logger.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace DroneMapper {
+namespace Core {
+
+namespace {
+
+constexpr int CHUNK_EVENTS = 4096;
+constexpr int MAX_CHUNKS = 32;                  // 131072 events per thread per session
+
+struct TraceEvent {
+    const char* category;
+    const char* name;
+    qint64 timestampNs;
+    qint64 durationNs;      // Complete events
+    double value;           // Counters
+    quint64 id;             // Async spans
+    char phase;             // Chrome phase: X, C, i, b, e
+};
+
+/**
+ * @brief Events of one thread
+ *
+ * Only the owning thread appends. Chunks are allocated on first use and
+ * reused by later sessions; the exporter reads [0, size) of buffers in
+ * the current generation.
+ */
+struct ThreadBuffer {
+    ThreadBuffer(int tid, const QString& threadName)
+        : tid(tid)
+        , threadName(threadName)
+        , generation(0)
+        , size(0)
+        , dropped(0)
+        , retired(false)
+    {
+        for (auto& chunk : chunks) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~ThreadBuffer()
+    {
+        for (auto& chunk : chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    const int tid;
+    const QString threadName;
+    std::atomic<quint64> generation;
+    std::atomic<int> size;
+    std::atomic<quint64> dropped;
+    std::atomic<bool> retired;          // Owning thread has exited
+    std::atomic<TraceEvent*> chunks[MAX_CHUNKS];
+};
+
+std::mutex registryMutex;               // Guards buffers; serializes start() and export
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+int nextTid = 1;
+
+std::atomic<quint64> sessionGeneration(0);
+std::atomic<qint64> sessionStartNs(0);
+
+/**
+ * @brief Marks the thread's buffer retired when the thread exits
+ */
+struct ThreadBufferHandle {
+    ThreadBufferHandle()
+        : buffer(nullptr)
+    {
+    }
+
+    ~ThreadBufferHandle()
+    {
+        if (buffer) {
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    }
+
+    ThreadBuffer *buffer;
+};
+
+thread_local ThreadBufferHandle threadBuffer;
+
+ThreadBuffer* currentBuffer()
+{
+    if (!threadBuffer.buffer) {
+        QString name;
+        QThread *thread = QThread::currentThread();
+        if (thread && QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+            name = "Main";
+        } else if (thread && !thread->objectName().isEmpty()) {
+            name = thread->objectName();
+        }
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        const int tid = nextTid++;
+        buffers.push_back(std::make_unique<ThreadBuffer>(tid, name.isEmpty() ? QString("Thread %1").arg(tid) : name));
+        threadBuffer.buffer = buffers.back().get();
+    }
+    return threadBuffer.buffer;
+}
+
+void append(const TraceEvent& event)
+{
+    ThreadBuffer *buffer = currentBuffer();
+
+    // A new session started since this thread last recorded
+    const quint64 generation = sessionGeneration.load(std::memory_order_acquire);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        buffer->size.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+
+    const int index = buffer->size.load(std::memory_order_relaxed);
+    const int chunkIndex = index / CHUNK_EVENTS;
+    if (chunkIndex >= MAX_CHUNKS) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TraceEvent *chunk = buffer->chunks[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new TraceEvent[CHUNK_EVENTS];
+        buffer->chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+
+    chunk[index % CHUNK_EVENTS] = event;
+    buffer->size.store(index + 1, std::memory_order_release);
+}
+
+void appendJsonString(QByteArray& out, const char* text)
+{
+    out += '"';
+    for (const char *c = text ? text : ""; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+        }
+        out += *c;
+    }
+    out += '"';
+}
+
+void appendMicroseconds(QByteArray& out, qint64 ns)
+{
+    out += QByteArray::number(ns / 1000.0, 'f', 3);
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+void Tracer::start()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    // Buffers of exited threads only hold the old session
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const std::unique_ptr<ThreadBuffer>& buffer) {
+                                     return buffer->retired.load(std::memory_order_acquire);
+                                 }),
+                  buffers.end());
+
+    sessionStartNs.store(nowNs(), std::memory_order_relaxed);
+    sessionGeneration.fetch_add(1, std::memory_order_release);
+    s_enabled.store(true, std::memory_order_release);
+
+    LOG_INFO("Tracing started");
+}
+
+void Tracer::stop()
+{
+    if (s_enabled.exchange(false)) {
+        LOG_INFO("Tracing stopped");
+    }
+}
+
+void Tracer::complete(const char* category, const char* name, qint64 startNs)
+{
+    append({ category, name, startNs, nowNs() - startNs, 0.0, 0, 'X' });
+}
+
+void Tracer::counter(const char* category, const char* name, double value)
+{
+    append({ category, name, nowNs(), 0, value, 0, 'C' });
+}
+
+void Tracer::instant(const char* category, const char* name)
+{
+    append({ category, name, nowNs(), 0, 0.0, 0, 'i' });
+}
+
+void Tracer::asyncBegin(const char* category, const char* name, quint64 id)
+{
+    append({ category, name, nowNs(), 0, 0.0, id, 'b' });
+}
+
+void Tracer::asyncEnd(const char* category, const char* name, quint64 id)
+{
+    append({ category, name, nowNs(), 0, 0.0, id, 'e' });
+}
+
+qint64 Tracer::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+quint64 Tracer::droppedEvents()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    const quint64 generation = sessionGeneration.load(std::memory_order_acquire);
+    quint64 dropped = 0;
+    for (const auto& buffer : buffers) {
+        if (buffer->generation.load(std::memory_order_acquire) == generation) {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return dropped;
+}
+
+bool Tracer::writeChromeTrace(const QString& filePath, QString *error)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = QString("Cannot write trace file %1: %2").arg(filePath, file.errorString());
+        }
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    const quint64 generation = sessionGeneration.load(std::memory_order_acquire);
+    const qint64 originNs = sessionStartNs.load(std::memory_order_relaxed);
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    int written = 0;
+    quint64 dropped = 0;
+
+    for (const auto& buffer : buffers) {
+        if (buffer->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+
+        // Events appended after this snapshot are left out
+        const int size = buffer->size.load(std::memory_order_acquire);
+        if (size == 0) {
+            continue;
+        }
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+        const QByteArray tid = QByteArray::number(buffer->tid);
+
+        if (!first) {
+            out += ",\n";
+        }
+        first = false;
+        out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid + ",\"tid\":" + tid
+             + ",\"args\":{\"name\":";
+        appendJsonString(out, buffer->threadName.toUtf8().constData());
+        out += "}}";
+
+        for (int i = 0; i < size; ++i) {
+            const TraceEvent *chunk = buffer->chunks[i / CHUNK_EVENTS].load(std::memory_order_acquire);
+            const TraceEvent& event = chunk[i % CHUNK_EVENTS];
+
+            out += ",\n{\"ph\":\"";
+            out += event.phase;
+            out += "\",\"cat\":";
+            appendJsonString(out, event.category);
+            out += ",\"name\":";
+            appendJsonString(out, event.name);
+            out += ",\"pid\":" + pid + ",\"tid\":" + tid + ",\"ts\":";
+            appendMicroseconds(out, event.timestampNs - originNs);
+
+            switch (event.phase) {
+            case 'X':
+                out += ",\"dur\":";
+                appendMicroseconds(out, event.durationNs);
+                break;
+            case 'C':
+                out += ",\"args\":{\"value\":" + QByteArray::number(event.value, 'g', 10) + "}";
+                break;
+            case 'i':
+                out += ",\"s\":\"t\"";
+                break;
+            case 'b':
+            case 'e':
+                out += ",\"id\":\"0x" + QByteArray::number(event.id, 16) + "\"";
+                break;
+            }
+            out += '}';
+            written++;
+
+            if (out.size() > (1 << 20)) {
+                file.write(out);
+                out.clear();
+            }
+        }
+    }
+
+    out += "\n]}\n";
+    file.write(out);
+
+    if (file.error() != QFileDevice::NoError) {
+        if (error) {
+            *error = QString("Failed writing trace file %1: %2").arg(filePath, file.errorString());
+        }
+        return false;
+    }
+
+    LOG_INFO(QString("Trace written to %1: %2 events, %3 dropped").arg(filePath).arg(written).arg(dropped));
+    return true;
+}
+
+} // namespace Core
+} // namespace DroneMapper
@@ -1,12 +1,20 @@
 #include "CoveragePatternGenerator.h"
 #include "GeoUtils.h"
+#include "core/Tracer.h"
 #include <cmath>
 #include <QtGui/QTransform>
 #include <algorithm>
+#include <limits>
 
 namespace DroneMapper {
 namespace Geospatial {
 
+namespace {
+
+constexpr double OVERSHOOT_PROBE_SLACK = 0.05;  // Meters; well above the clipper's snap grid
+
+} // namespace
+
 CoveragePatternGenerator::CoveragePatternGenerator()
 {
 }
@@ -18,6 +26,8 @@ QList<Models::Waypoint> CoveragePatternGenerator::generateParallelLines(
     double spacing,
     double overlap)
 {
+    TRACE_SCOPE("coverage", "CoveragePatternGenerator::generateParallelLines");
+
     QList<Models::Waypoint> waypoints;
 
     if (polygon.count() < 3) {
@@ -141,11 +151,288 @@ QList<QPointF> CoveragePatternGenerator::generateParallelLinePoints(
     return points;
 }
 
+QList<Models::Waypoint> CoveragePatternGenerator::generateParallelLines(
+    const MultiPolygon& area,
+    double altitude,
+    double direction,
+    double spacing,
+    double overshoot,
+    const QList<QPolygonF>& exclusions)
+{
+    TRACE_SCOPE("coverage", "CoveragePatternGenerator::generateParallelLines");
+
+    QList<Models::Waypoint> waypoints;
+
+    if (area.isEmpty() || area.first().outer.count() < 3) {
+        m_lastError = "Invalid area (no polygon with at least 3 points)";
+        return waypoints;
+    }
+    if (spacing <= 0.0) {
+        m_lastError = "Invalid line spacing";
+        return waypoints;
+    }
+
+    // Project every ring around the largest polygon's centroid
+    Models::GeospatialCoordinate origin = GeoUtils::calculateCentroid(area.first().outer);
+
+    QList<QPolygonF> cartesianRings;
+    QList<bool> holeRings;
+    for (const PolygonWithHoles& polygon : area) {
+        QList<QPolygonF> rings = polygon.holes;
+        rings.prepend(polygon.outer);
+        for (int r = 0; r < rings.count(); ++r) {
+            QPolygonF cartesianRing;
+            for (const QPointF& p : rings[r]) {
+                Models::GeospatialCoordinate coord(p.y(), p.x(), 0);
+                cartesianRing.append(GeoUtils::toCartesian(coord, origin));
+            }
+            cartesianRings.append(cartesianRing);
+            holeRings.append(r > 0);
+        }
+    }
+
+    QList<QPolygonF> cartesianExclusions;
+    for (const QPolygonF& outline : exclusions) {
+        QPolygonF cartesianOutline;
+        for (const QPointF& p : outline) {
+            cartesianOutline.append(GeoUtils::toCartesian(Models::GeospatialCoordinate(p.y(), p.x(), 0), origin));
+        }
+        cartesianExclusions.append(cartesianOutline);
+    }
+
+    QList<QPointF> cartesianPoints = generateCellLinePoints(cartesianRings, holeRings, direction,
+                                                            spacing, overshoot, cartesianExclusions);
+
+    for (const QPointF& point : cartesianPoints) {
+        Models::GeospatialCoordinate coord = GeoUtils::fromCartesian(point, origin);
+        coord.setAltitude(altitude);
+
+        Models::Waypoint wp(coord);
+        wp.setSpeed(8.0);
+        wp.addAction(Models::Waypoint::Action::TakePhoto);
+        waypoints.append(wp);
+    }
+
+    for (int i = 0; i < waypoints.count(); ++i) {
+        waypoints[i].setWaypointNumber(i);
+    }
+
+    return waypoints;
+}
+
+QList<QPointF> CoveragePatternGenerator::generateCellLinePoints(
+    const QList<QPolygonF>& rings,
+    const QList<bool>& holeRings,
+    double direction,
+    double spacing,
+    double overshoot,
+    const QList<QPolygonF>& exclusions)
+{
+    // Stretch of one flight line inside the area
+    struct Span {
+        int line;
+        double left;
+        double right;
+        double leftOvershoot;   // Extension past each end (0 on hole edges)
+        double rightOvershoot;
+    };
+
+    // Line crossing and whether its ring is a hole
+    struct Crossing {
+        double x;
+        bool hole;
+        bool operator<(const Crossing& other) const { return x < other.x; }
+    };
+
+    QList<QPointF> points;
+
+    QList<QPolygonF> rotatedRings;
+    QRectF bounds;
+    for (const QPolygonF& ring : rings) {
+        rotatedRings.append(rotatePolygon(ring, -direction));
+        bounds = bounds.united(rotatedRings.last().boundingRect());
+    }
+
+    QList<QPolygonF> rotatedExclusions;
+    for (const QPolygonF& outline : exclusions) {
+        rotatedExclusions.append(rotatePolygon(outline, -direction));
+    }
+
+    // Shortest extension from x along the line (sign = side) that stops at
+    // the first exclusion edge. The probe starts a little inside the span,
+    // so an end snapped just inside a zone outline still meets that edge.
+    auto clampedOvershoot = [&rotatedExclusions, overshoot](double x, double y, double sign) {
+        double reach = overshoot;
+        for (const QPolygonF& outline : rotatedExclusions) {
+            const int n = outline.count();
+            for (int j = 0; j < n; ++j) {
+                const QPointF& p1 = outline[j];
+                const QPointF& p2 = outline[(j + 1) % n];
+                if (((p1.y() <= y && p2.y() > y) || (p2.y() <= y && p1.y() > y))
+                    && std::abs(p2.y() - p1.y()) > 1e-9) {
+                    const double crossing = p1.x() + (y - p1.y()) * (p2.x() - p1.x()) / (p2.y() - p1.y());
+                    const double along = (crossing - x) * sign;
+                    if (along >= -OVERSHOOT_PROBE_SLACK && along < reach) {
+                        reach = std::max(0.0, along);
+                    }
+                }
+            }
+        }
+        return reach;
+    };
+
+    const double startY = bounds.top() + (spacing / 2.0);
+    const int numLines = static_cast<int>(std::floor((bounds.bottom() - startY) / spacing)) + 1;
+
+    // Boustrophedon cells: a cell continues while its span on the previous
+    // line overlaps exactly one span on this line and nothing else does
+    QList<QList<Span>> cells;
+    QList<int> openCells;
+
+    for (int i = 0; i < numLines; ++i) {
+        const double y = startY + i * spacing;
+
+        // Crossings of every ring, so holes cut the line
+        QList<Crossing> intersections;
+        for (int r = 0; r < rotatedRings.count(); ++r) {
+            const QPolygonF& ring = rotatedRings[r];
+            const bool hole = r < holeRings.count() && holeRings[r];
+            const int n = ring.count();
+            for (int j = 0; j < n; ++j) {
+                const QPointF& p1 = ring[j];
+                const QPointF& p2 = ring[(j + 1) % n];
+                if ((p1.y() <= y && p2.y() > y) || (p2.y() <= y && p1.y() > y)) {
+                    if (std::abs(p2.y() - p1.y()) > 1e-9) {
+                        intersections.append({ p1.x() + (y - p1.y()) * (p2.x() - p1.x()) / (p2.y() - p1.y()),
+                                               hole });
+                    }
+                }
+            }
+        }
+        std::sort(intersections.begin(), intersections.end());
+
+        QList<Span> spans;
+        for (int k = 0; k + 1 < intersections.count(); k += 2) {
+            const Crossing& left = intersections[k];
+            const Crossing& right = intersections[k + 1];
+            // Holes are buffered no-fly zones; only the outer boundary gets the turn overshoot
+            const bool extend = overshoot > 0.0;
+            spans.append({ i, left.x, right.x,
+                           extend && !left.hole ? clampedOvershoot(left.x, y, -1.0) : 0.0,
+                           extend && !right.hole ? clampedOvershoot(right.x, y, 1.0) : 0.0 });
+        }
+
+        auto overlaps = [](const Span& a, const Span& b) {
+            return a.left < b.right && b.left < a.right;
+        };
+
+        QList<int> nextOpen;
+        for (const Span& span : spans) {
+            int match = -1;
+            int matches = 0;
+            for (int cell : openCells) {
+                if (overlaps(cells[cell].last(), span)) {
+                    match = cell;
+                    matches++;
+                }
+            }
+
+            bool continues = (matches == 1);
+            if (continues) {
+                for (const Span& other : spans) {
+                    if (&other != &span && overlaps(cells[match].last(), other)) {
+                        continues = false;
+                        break;
+                    }
+                }
+            }
+
+            if (continues) {
+                cells[match].append(span);
+                nextOpen.append(match);
+            } else {
+                cells.append(QList<Span>{ span });
+                nextOpen.append(cells.size() - 1);
+            }
+        }
+        openCells = nextOpen;
+    }
+
+    if (cells.isEmpty()) {
+        return points;
+    }
+
+    // Fly cells nearest-first, each as a serpentine from whichever
+    // corner is closest to where the previous one ended
+    QVector<bool> flown(cells.size(), false);
+    QPointF position(cells.first().first().left, startY + cells.first().first().line * spacing);
+
+    for (int count = 0; count < cells.size(); ++count) {
+        int best = -1;
+        bool bestFromTop = true;
+        bool bestStartLeft = true;
+        double bestDistance = std::numeric_limits<double>::max();
+
+        for (int c = 0; c < cells.size(); ++c) {
+            if (flown[c]) {
+                continue;
+            }
+            for (bool fromTop : { true, false }) {
+                const Span& entry = fromTop ? cells[c].first() : cells[c].last();
+                const double y = startY + entry.line * spacing;
+                for (bool startLeft : { true, false }) {
+                    const QPointF corner(startLeft ? entry.left : entry.right, y);
+                    const double distance = std::hypot(corner.x() - position.x(), corner.y() - position.y());
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = c;
+                        bestFromTop = fromTop;
+                        bestStartLeft = startLeft;
+                    }
+                }
+            }
+        }
+
+        flown[best] = true;
+        QList<Span> spans = cells[best];
+        if (!bestFromTop) {
+            std::reverse(spans.begin(), spans.end());
+        }
+
+        bool goingRight = bestStartLeft;
+        for (const Span& span : spans) {
+            const double y = startY + span.line * spacing;
+            const QPointF left(span.left - span.leftOvershoot, y);
+            const QPointF right(span.right + span.rightOvershoot, y);
+            if (goingRight) {
+                points.append(left);
+                points.append(right);
+            } else {
+                points.append(right);
+                points.append(left);
+            }
+            goingRight = !goingRight;
+        }
+        position = points.last();
+    }
+
+    // Rotate points back
+    QTransform transform;
+    transform.rotate(direction);
+    for (QPointF& point : points) {
+        point = transform.map(point);
+    }
+
+    return points;
+}
+
 QList<Models::Waypoint> CoveragePatternGenerator::generateGrid(
     const QPolygonF& polygon,
     double altitude,
     double spacing)
 {
+    TRACE_SCOPE("coverage", "CoveragePatternGenerator::generateGrid");
+
     QList<Models::Waypoint> waypoints;
 
     // Generate two sets of parallel lines at 90 degrees offset
@@ -172,6 +459,8 @@ QList<Models::Waypoint> CoveragePatternGenerator::generateCircular(
     double altitude,
     int points)
 {
+    TRACE_SCOPE("coverage", "CoveragePatternGenerator::generateCircular");
+
     QList<Models::Waypoint> waypoints;
 
     for (int i = 0; i < points; ++i) {
@@ -0,0 +1,355 @@
+#include "DEMDifferenceAnalyzer.h"
+#include "RasterTileReader.h"
+#include <gdal.h>
+#include <ogr_srs_api.h>
+#include <cpl_string.h>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+namespace {
+
+constexpr qint64 MAX_STRIP_CELLS = 4 * 1024 * 1024;   // Per-buffer cells held per strip
+constexpr double METERS_PER_DEGREE_LAT = 110574.0;
+constexpr double METERS_PER_DEGREE_LON = 111320.0;
+
+/**
+ * @brief Partial cut/fill sums for a set of rows
+ */
+struct Partial {
+    double cutVolume;
+    double fillVolume;
+    double cutArea;
+    double fillArea;
+    double area;
+    double sum;
+    qint64 cells;
+    float minChange;
+    float maxChange;
+
+    Partial()
+        : cutVolume(0.0), fillVolume(0.0), cutArea(0.0), fillArea(0.0), area(0.0), sum(0.0), cells(0)
+        , minChange(std::numeric_limits<float>::infinity())
+        , maxChange(-std::numeric_limits<float>::infinity())
+    {}
+};
+
+void combine(Partial& total, const Partial& part)
+{
+    total.cutVolume += part.cutVolume;
+    total.fillVolume += part.fillVolume;
+    total.cutArea += part.cutArea;
+    total.fillArea += part.fillArea;
+    total.area += part.area;
+    total.sum += part.sum;
+    total.cells += part.cells;
+    total.minChange = std::min(total.minChange, part.minChange);
+    total.maxChange = std::max(total.maxChange, part.maxChange);
+}
+
+/**
+ * @brief Reduce one row of differences (branch-free, vectorizable)
+ */
+Partial reduceRow(const float* d, int count, double cellArea)
+{
+    float cut = 0.0f;
+    float fill = 0.0f;
+    int cutCells = 0;
+    int fillCells = 0;
+    int validCells = 0;
+    float minChange = std::numeric_limits<float>::infinity();
+    float maxChange = -std::numeric_limits<float>::infinity();
+
+    for (int i = 0; i < count; ++i) {
+        const float v = d[i];
+        const bool valid = (v == v);
+        const float z = valid ? v : 0.0f;
+
+        validCells += valid;
+        fill += std::max(z, 0.0f);
+        cut += std::max(-z, 0.0f);
+        fillCells += (z > 0.0f);
+        cutCells += (z < 0.0f);
+        minChange = std::min(minChange, valid ? v : std::numeric_limits<float>::infinity());
+        maxChange = std::max(maxChange, valid ? v : -std::numeric_limits<float>::infinity());
+    }
+
+    Partial p;
+    p.cutVolume = cut * cellArea;
+    p.fillVolume = fill * cellArea;
+    p.cutArea = cutCells * cellArea;
+    p.fillArea = fillCells * cellArea;
+    p.area = validCells * cellArea;
+    p.sum = static_cast<double>(fill) - cut;
+    p.cells = validCells;
+    p.minChange = minChange;
+    p.maxChange = maxChange;
+    return p;
+}
+
+/**
+ * @brief Blank cells whose centres fall outside the polygon (even-odd scanline)
+ */
+void maskRow(float* d, int columns, const QPolygonF& boundary, double minX, double y, double pixelSize)
+{
+    QVector<double> crossings;
+    const int n = boundary.size();
+    for (int i = 0, j = n - 1; i < n; j = i++) {
+        const QPointF& a = boundary[i];
+        const QPointF& b = boundary[j];
+        if ((a.y() > y) != (b.y() > y)) {
+            crossings.append(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+        }
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    int column = 0;
+    for (int k = 0; k + 1 < crossings.size(); k += 2) {
+        int begin = std::clamp(static_cast<int>(std::ceil((crossings[k] - minX) / pixelSize - 0.5)), 0, columns);
+        int end = std::clamp(static_cast<int>(std::ceil((crossings[k + 1] - minX) / pixelSize - 0.5)), 0, columns);
+        std::fill(d + column, d + std::max(begin, column), nan);
+        column = std::max(column, end);
+    }
+    std::fill(d + column, d + columns, nan);
+}
+
+Models::GeospatialCoordinate toWGS84(OGRCoordinateTransformationH transform, double x, double y)
+{
+    if (transform) {
+        OCTTransform(transform, 1, &x, &y, nullptr);
+    }
+    return Models::GeospatialCoordinate(y, x);
+}
+
+} // namespace
+
+void DEMDifferenceAnalyzer::difference(const float* before, const float* after, float* out,
+                                       int count, float threshold)
+{
+    // NaN propagates through the subtraction; the select keeps it branch-free
+    for (int i = 0; i < count; ++i) {
+        const float d = after[i] - before[i];
+        out[i] = (std::abs(d) < threshold) ? 0.0f : d;
+    }
+}
+
+DEMDifferenceAnalyzer::Result DEMDifferenceAnalyzer::compare(
+    const QString& beforePath, const QString& afterPath, const Options& options)
+{
+    Result result;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    RasterTileReader before;
+    RasterTileReader after;
+
+    if (!before.open(beforePath)) {
+        result.errorMessage = before.lastError();
+        return result;
+    }
+    if (!after.open(afterPath) || !after.reprojectTo(before.projection())) {
+        result.errorMessage = after.lastError();
+        return result;
+    }
+
+    // Common grid over the overlap of both extents
+    const double minX = std::max(before.minX(), after.minX());
+    const double maxX = std::min(before.maxX(), after.maxX());
+    const double minY = std::max(before.minY(), after.minY());
+    const double maxY = std::min(before.maxY(), after.maxY());
+
+    const double pixelSize = options.pixelSize > 0.0
+        ? options.pixelSize
+        : std::max(std::max(before.pixelWidth(), before.pixelHeight()),
+                   std::max(after.pixelWidth(), after.pixelHeight()));
+
+    const int columns = static_cast<int>(std::floor((maxX - minX) / pixelSize));
+    const int rows = static_cast<int>(std::floor((maxY - minY) / pixelSize));
+
+    if (columns < 1 || rows < 1) {
+        result.errorMessage = "Rasters do not overlap";
+        return result;
+    }
+
+    const bool geographic = before.isGeographic();
+    const float threshold = static_cast<float>(std::max(options.detectionThreshold, 0.0));
+
+    // Optional full-resolution difference raster, written strip by strip
+    GDALDatasetH output = nullptr;
+    if (!options.differencePath.isEmpty()) {
+        GDALDriverH driver = GDALGetDriverByName("GTiff");
+        char** createOptions = nullptr;
+        createOptions = CSLSetNameValue(createOptions, "TILED", "YES");
+        createOptions = CSLSetNameValue(createOptions, "COMPRESS", "DEFLATE");
+        createOptions = CSLSetNameValue(createOptions, "BIGTIFF", "IF_SAFER");
+
+        output = driver ? GDALCreate(driver, options.differencePath.toUtf8().constData(),
+                                     columns, rows, 1, GDT_Float32, createOptions)
+                        : nullptr;
+        CSLDestroy(createOptions);
+
+        if (!output) {
+            result.errorMessage = "Cannot create difference raster: " + options.differencePath;
+            return result;
+        }
+
+        double geoTransform[6] = { minX, pixelSize, 0.0, maxY, 0.0, -pixelSize };
+        GDALSetGeoTransform(output, geoTransform);
+        GDALSetProjection(output, before.projection().toUtf8().constData());
+        GDALSetRasterNoDataValue(GDALGetRasterBand(output, 1), std::numeric_limits<double>::quiet_NaN());
+    }
+
+    // Preview: block means over factor x factor cells
+    const int factor = std::max(1, static_cast<int>(std::ceil(
+        static_cast<double>(std::max(columns, rows)) / std::max(options.previewMaxSize, 1))));
+    result.previewFactor = factor;
+    result.previewWidth = (columns + factor - 1) / factor;
+    result.previewHeight = (rows + factor - 1) / factor;
+    QVector<double> previewSum(result.previewWidth * result.previewHeight, 0.0);
+    QVector<int> previewCount(result.previewWidth * result.previewHeight, 0);
+
+    // Stream strips of rows; three buffers of at most MAX_STRIP_CELLS each
+    const int stripRows = static_cast<int>(std::clamp<qint64>(
+        MAX_STRIP_CELLS / columns, 1, std::max(options.stripRows, 1)));
+    QVector<float> beforeStrip(columns * stripRows);
+    QVector<float> afterStrip(columns * stripRows);
+    QVector<float> diffStrip(columns * stripRows);
+
+    Partial total;
+    bool ok = true;
+
+    for (int row0 = 0; row0 < rows && ok; row0 += stripRows) {
+        const int count = std::min(stripRows, rows - row0);
+        const double top = maxY - row0 * pixelSize;
+
+        if (!before.readWindow(minX, top, pixelSize, columns, count, beforeStrip.data()) ||
+            !after.readWindow(minX, top, pixelSize, columns, count, afterStrip.data())) {
+            result.errorMessage = before.lastError().isEmpty() ? after.lastError() : before.lastError();
+            ok = false;
+            break;
+        }
+
+        QVector<int> stripRowIds(count);
+        for (int i = 0; i < count; ++i) {
+            stripRowIds[i] = i;
+        }
+
+        const float* beforeData = beforeStrip.constData();
+        const float* afterData = afterStrip.constData();
+        float* diffData = diffStrip.data();
+        const QPolygonF& boundary = options.boundary;
+
+        Partial strip = QtConcurrent::blockingMappedReduced<Partial>(
+            stripRowIds,
+            [=, &boundary](int local) {
+                const qint64 offset = static_cast<qint64>(local) * columns;
+                float* d = diffData + offset;
+                difference(beforeData + offset, afterData + offset, d, columns, threshold);
+
+                const double y = maxY - (row0 + local + 0.5) * pixelSize;
+                if (!boundary.isEmpty()) {
+                    maskRow(d, columns, boundary, minX, y, pixelSize);
+                }
+
+                double cellArea = pixelSize * pixelSize;
+                if (geographic) {
+                    cellArea *= METERS_PER_DEGREE_LAT * METERS_PER_DEGREE_LON *
+                                std::cos(y * M_PI / 180.0);
+                }
+
+                return reduceRow(d, columns, cellArea);
+            },
+            combine,
+            QtConcurrent::OrderedReduce);
+
+        combine(total, strip);
+
+        if (output && GDALRasterIO(GDALGetRasterBand(output, 1), GF_Write, 0, row0, columns, count,
+                                   diffData, columns, count, GDT_Float32, 0, 0) != CE_None) {
+            result.errorMessage = "Failed writing difference raster";
+            ok = false;
+            break;
+        }
+
+        for (int r = 0; r < count; ++r) {
+            const float* d = diffData + static_cast<qint64>(r) * columns;
+            const int pr = (row0 + r) / factor;
+            for (int c = 0; c < columns; ++c) {
+                if (d[c] == d[c]) {
+                    const int index = pr * result.previewWidth + c / factor;
+                    previewSum[index] += d[c];
+                    previewCount[index] += 1;
+                }
+            }
+        }
+    }
+
+    if (output) {
+        GDALClose(output);
+    }
+
+    if (!ok) {
+        return result;
+    }
+
+    result.preview.resize(previewSum.size());
+    for (int i = 0; i < previewSum.size(); ++i) {
+        result.preview[i] = previewCount[i] > 0
+            ? static_cast<float>(previewSum[i] / previewCount[i])
+            : std::numeric_limits<float>::quiet_NaN();
+    }
+
+    // Preview corners in WGS84 for the terrain viewer overlay
+    OGRSpatialReferenceH source = OSRNewSpatialReference(before.projection().toUtf8().constData());
+    OGRSpatialReferenceH wgs84 = OSRNewSpatialReference(nullptr);
+    OSRSetWellKnownGeogCS(wgs84, "WGS84");
+    OSRSetAxisMappingStrategy(source, OAMS_TRADITIONAL_GIS_ORDER);
+    OSRSetAxisMappingStrategy(wgs84, OAMS_TRADITIONAL_GIS_ORDER);
+    OGRCoordinateTransformationH transform = geographic ? nullptr : OCTNewCoordinateTransformation(source, wgs84);
+
+    const double previewRight = minX + columns * pixelSize;
+    const double previewBottom = maxY - rows * pixelSize;
+    result.previewTopLeft = toWGS84(transform, minX, maxY);
+    result.previewBottomRight = toWGS84(transform, previewRight, previewBottom);
+
+    if (transform) {
+        OCTDestroyCoordinateTransformation(transform);
+    }
+    OSRDestroySpatialReference(source);
+    OSRDestroySpatialReference(wgs84);
+
+    VolumeChangeSummary& summary = result.summary;
+    summary.valid = total.cells > 0;
+    summary.beforeLabel = QFileInfo(beforePath).fileName();
+    summary.afterLabel = QFileInfo(afterPath).fileName();
+    summary.cutVolume = total.cutVolume;
+    summary.fillVolume = total.fillVolume;
+    summary.netVolume = total.fillVolume - total.cutVolume;
+    summary.cutArea = total.cutArea;
+    summary.fillArea = total.fillArea;
+    summary.analysedArea = total.area;
+    summary.minChange = total.cells > 0 ? total.minChange : 0.0;
+    summary.maxChange = total.cells > 0 ? total.maxChange : 0.0;
+    summary.meanChange = total.cells > 0 ? total.sum / total.cells : 0.0;
+    summary.pixelSize = pixelSize;
+    summary.columns = columns;
+    summary.rows = rows;
+    summary.elapsedMs = timer.elapsed();
+
+    if (!summary.valid) {
+        result.errorMessage = "No overlapping data between the two surfaces";
+    }
+
+    return result;
+}
+
+} // namespace Geospatial
+} // namespace DroneMapper
@@ -0,0 +1,240 @@
+#include "IncrementalCoverageGenerator.h"
+#include "GeoUtils.h"
+#include "core/Tracer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+namespace {
+
+constexpr double WAYPOINT_SPEED = 8.0;  // m/s, as CoveragePatternGenerator
+
+} // namespace
+
+IncrementalCoverageGenerator::IncrementalCoverageGenerator()
+    : m_altitude(0.0)
+    , m_spacing(0.0)
+    , m_overshoot(0.0)
+    , m_anchorY(0.0)
+    , m_firstLine(0)
+    , m_lastUpdated(0)
+{
+}
+
+bool IncrementalCoverageGenerator::reset(const QPolygonF& polygon, double altitude,
+                                         double direction, double spacing, double overshoot)
+{
+    TRACE_SCOPE("coverage", "IncrementalCoverageGenerator::reset");
+
+    clear();
+
+    if (polygon.count() < 3 || spacing <= 0.0) {
+        return false;
+    }
+
+    // Centroid of the ring as given, like generateParallelLines
+    m_origin = GeoUtils::calculateCentroid(polygon);
+    m_altitude = altitude;
+    m_spacing = spacing;
+    m_overshoot = std::max(0.0, overshoot);
+    m_toRotated.rotate(-direction);
+    m_fromRotated.rotate(direction);
+
+    m_polygon = polygon;
+    if (m_polygon.count() > 3 && m_polygon.first() == m_polygon.last()) {
+        m_polygon.removeLast();
+    }
+
+    m_rotated.reserve(m_polygon.count());
+    for (const QPointF& point : m_polygon) {
+        m_rotated.append(project(point));
+    }
+
+    // Same grid as generateParallelLines: first line half a spacing below the top
+    const QRectF bounds = m_rotated.boundingRect();
+    m_anchorY = bounds.top() + (spacing / 2.0);
+    const int lastLine = static_cast<int>(std::floor((bounds.bottom() - m_anchorY) / spacing));
+
+    if (lastLine >= 0) {
+        ensureLines(0, lastLine);
+        for (int i = 0; i < m_transects.size(); ++i) {
+            Transect& transect = m_transects[i];
+            computeCrossings(m_anchorY + (m_firstLine + i) * m_spacing, transect.crossings);
+            appendTransect(i, m_waypoints);
+        }
+    }
+
+    for (int i = 0; i < m_waypoints.count(); ++i) {
+        m_waypoints[i].setWaypointNumber(i);
+    }
+
+    m_lastUpdated = m_transects.size();
+    return true;
+}
+
+void IncrementalCoverageGenerator::clear()
+{
+    m_polygon.clear();
+    m_rotated.clear();
+    m_toRotated.reset();
+    m_fromRotated.reset();
+    m_transects.clear();
+    m_waypoints.clear();
+    m_firstLine = 0;
+    m_lastUpdated = 0;
+}
+
+IncrementalCoverageGenerator::Patch IncrementalCoverageGenerator::moveVertex(int vertex, const QPointF& position)
+{
+    Patch patch = { 0, 0, 0 };
+    m_lastUpdated = 0;
+
+    const int n = m_polygon.count();
+    if (n == 0 || vertex < 0 || vertex >= n) {
+        return patch;
+    }
+
+    TRACE_SCOPE("coverage", "IncrementalCoverageGenerator::moveVertex");
+
+    const QPointF previous = m_rotated[(vertex + n - 1) % n];
+    const QPointF next = m_rotated[(vertex + 1) % n];
+    const QPointF oldPoint = m_rotated[vertex];
+    const QPointF newPoint = project(position);
+
+    m_polygon[vertex] = position;
+    m_rotated[vertex] = newPoint;
+
+    if (newPoint == oldPoint) {
+        return patch;
+    }
+
+    // Only lines crossing the two edges at the vertex, before or after the move, change
+    const double yMin = std::min({ previous.y(), next.y(), oldPoint.y(), newPoint.y() });
+    const double yMax = std::max({ previous.y(), next.y(), oldPoint.y(), newPoint.y() });
+    const int firstLine = static_cast<int>(std::ceil((yMin - m_anchorY) / m_spacing));
+    const int lastLine = static_cast<int>(std::floor((yMax - m_anchorY) / m_spacing));
+
+    if (firstLine > lastLine) {
+        return patch;
+    }
+
+    ensureLines(firstLine, lastLine);
+    const int first = firstLine - m_firstLine;
+    const int last = lastLine - m_firstLine;
+
+    for (int i = 0; i < first; ++i) {
+        patch.start += m_transects[i].waypointCount;
+    }
+
+    QList<Models::Waypoint> replacement;
+    for (int i = first; i <= last; ++i) {
+        Transect& transect = m_transects[i];
+        patch.removeCount += transect.waypointCount;
+        computeCrossings(m_anchorY + (m_firstLine + i) * m_spacing, transect.crossings);
+        appendTransect(i, replacement);
+    }
+    patch.insertCount = replacement.count();
+    m_lastUpdated = last - first + 1;
+
+    // Splice the affected transects' waypoints in place
+    m_waypoints.remove(patch.start, patch.removeCount);
+    m_waypoints.insert(patch.start, patch.insertCount, Models::Waypoint());
+    std::copy(replacement.cbegin(), replacement.cend(), m_waypoints.begin() + patch.start);
+
+    const int renumberEnd = (patch.insertCount == patch.removeCount)
+        ? patch.start + patch.insertCount
+        : m_waypoints.count();
+    for (int i = patch.start; i < renumberEnd; ++i) {
+        m_waypoints[i].setWaypointNumber(i);
+    }
+
+    return patch;
+}
+
+QPointF IncrementalCoverageGenerator::project(const QPointF& lonLat) const
+{
+    const Models::GeospatialCoordinate coord(lonLat.y(), lonLat.x(), 0);
+    return m_toRotated.map(GeoUtils::toCartesian(coord, m_origin));
+}
+
+void IncrementalCoverageGenerator::computeCrossings(double y, QVector<double>& crossings) const
+{
+    crossings.clear();
+
+    const int n = m_rotated.count();
+    for (int j = 0; j < n; ++j) {
+        const QPointF& p1 = m_rotated[j];
+        const QPointF& p2 = m_rotated[(j + 1) % n];
+
+        // Half-open on y so a vertex on the line counts once
+        if ((p1.y() <= y && p2.y() > y) || (p2.y() <= y && p1.y() > y)) {
+            if (std::abs(p2.y() - p1.y()) > 1e-9) {
+                crossings.append(p1.x() + (y - p1.y()) * (p2.x() - p1.x()) / (p2.y() - p1.y()));
+            }
+        }
+    }
+
+    std::sort(crossings.begin(), crossings.end());
+}
+
+void IncrementalCoverageGenerator::appendTransect(int index, QList<Models::Waypoint>& out)
+{
+    Transect& transect = m_transects[index];
+    const QVector<double>& crossings = transect.crossings;
+    transect.waypointCount = 0;
+
+    if (crossings.count() < 2) {
+        return;
+    }
+
+    const int line = m_firstLine + index;
+    const double y = m_anchorY + line * m_spacing;
+
+    // Serpentine by grid parity, so inserting a transect never flips the others
+    QList<QPointF> points;
+    for (int k = 0; k + 1 < crossings.count(); k += 2) {
+        points.append(QPointF(crossings[k] - m_overshoot, y));
+        points.append(QPointF(crossings[k + 1] + m_overshoot, y));
+    }
+    if ((line & 1) != 0) {
+        std::reverse(points.begin(), points.end());
+    }
+
+    for (const QPointF& point : points) {
+        Models::GeospatialCoordinate coord = GeoUtils::fromCartesian(m_fromRotated.map(point), m_origin);
+        coord.setAltitude(m_altitude);
+
+        Models::Waypoint wp(coord);
+        wp.setSpeed(WAYPOINT_SPEED);
+        wp.addAction(Models::Waypoint::Action::TakePhoto);
+        out.append(wp);
+    }
+
+    transect.waypointCount = points.count();
+}
+
+void IncrementalCoverageGenerator::ensureLines(int firstLine, int lastLine)
+{
+    const Transect empty = { QVector<double>(), 0 };
+
+    if (m_transects.isEmpty()) {
+        m_firstLine = firstLine;
+        m_transects.fill(empty, lastLine - firstLine + 1);
+        return;
+    }
+
+    if (firstLine < m_firstLine) {
+        m_transects.insert(0, m_firstLine - firstLine, empty);
+        m_firstLine = firstLine;
+    }
+
+    const int currentLast = m_firstLine + m_transects.size() - 1;
+    if (lastLine > currentLast) {
+        m_transects.insert(m_transects.size(), lastLine - currentLast, empty);
+    }
+}
+
+} // namespace Geospatial
+} // namespace DroneMapper
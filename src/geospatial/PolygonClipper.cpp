@@ -0,0 +1,1053 @@
+#include "PolygonClipper.h"
+#include "core/Tracer.h"
+#include <QHash>
+#include <QPair>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <queue>
+#include <set>
+#include <vector>
+#if defined(_MSC_VER) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+namespace DroneMapper {
+namespace Geospatial {
+
+namespace {
+
+constexpr double SNAP_GRID = 1e-4;              // Meters
+constexpr double MIN_RING_AREA = 1e-6;          // Square meters; smaller output rings are slivers
+constexpr int MIN_CIRCLE_SEGMENTS = 8;
+constexpr int MAX_CIRCLE_SEGMENTS = 256;
+
+/**
+ * @brief Point on the snap grid, in whole cells
+ */
+struct GridPoint {
+    qint64 x;
+    qint64 y;
+
+    bool operator==(const GridPoint& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const GridPoint& other) const { return !(*this == other); }
+};
+
+GridPoint toGrid(const QPointF& p)
+{
+    return { qRound64(p.x() / SNAP_GRID), qRound64(p.y() / SNAP_GRID) };
+}
+
+QPointF toPoint(const GridPoint& p)
+{
+    return QPointF(p.x * SNAP_GRID, p.y * SNAP_GRID);
+}
+
+QPair<qint64, qint64> gridKey(const GridPoint& p)
+{
+    return qMakePair(p.x, p.y);
+}
+
+double cross(const QPointF& a, const QPointF& b)
+{
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+double dot(const QPointF& a, const QPointF& b)
+{
+    return a.x() * b.x() + a.y() * b.y();
+}
+
+// Sign of a * b - c * d, exact over the full 64-bit range
+int productSign(qint64 a, qint64 b, qint64 c, qint64 d)
+{
+#if defined(__SIZEOF_INT128__)
+    const __int128 lhs = static_cast<__int128>(a) * b;
+    const __int128 rhs = static_cast<__int128>(c) * d;
+    return (lhs > rhs) - (lhs < rhs);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    __int64 lhsHigh;
+    __int64 rhsHigh;
+    const quint64 lhsLow = static_cast<quint64>(_mul128(a, b, &lhsHigh));
+    const quint64 rhsLow = static_cast<quint64>(_mul128(c, d, &rhsHigh));
+    if (lhsHigh != rhsHigh) {
+        return lhsHigh > rhsHigh ? 1 : -1;
+    }
+    return (lhsLow > rhsLow) - (lhsLow < rhsLow);
+#else
+#error "PolygonClipper needs 128-bit integer products"
+#endif
+}
+
+// Orientation of a, b, c: +1 counter-clockwise, -1 clockwise, 0 collinear (exact)
+int turn(const GridPoint& a, const GridPoint& b, const GridPoint& c)
+{
+    return productSign(a.x - c.x, b.y - c.y, b.x - c.x, a.y - c.y);
+}
+
+// Sweep order of points: x, then y
+bool sweptBefore(const GridPoint& a, const GridPoint& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+/**
+ * @brief Input edge between two grid points, in ring order
+ */
+struct InputEdge {
+    GridPoint from;
+    GridPoint to;
+    bool subject;
+};
+
+/**
+ * @brief Uniform bucket grid over the input, for candidate lookups
+ */
+class CellGrid {
+public:
+    CellGrid(const std::vector<InputEdge>& edges)
+    {
+        m_minX = m_minY = std::numeric_limits<qint64>::max();
+        qint64 maxX = std::numeric_limits<qint64>::min();
+        qint64 maxY = std::numeric_limits<qint64>::min();
+        long double extent = 0.0L;
+        for (const InputEdge& edge : edges) {
+            m_minX = std::min({ m_minX, edge.from.x, edge.to.x });
+            m_minY = std::min({ m_minY, edge.from.y, edge.to.y });
+            maxX = std::max({ maxX, edge.from.x, edge.to.x });
+            maxY = std::max({ maxY, edge.from.y, edge.to.y });
+            extent += std::max(std::llabs(edge.to.x - edge.from.x), std::llabs(edge.to.y - edge.from.y));
+        }
+
+        // Cells about one edge long, but no more than a few per edge
+        const long double width = static_cast<long double>(maxX - m_minX) + 1.0L;
+        const long double height = static_cast<long double>(maxY - m_minY) + 1.0L;
+        const long double count = std::max<long double>(edges.size(), 1.0L);
+        const long double size = std::max({ extent / count, std::sqrt(width * height / (4.0L * count)), 1.0L });
+        m_cellSize = static_cast<qint64>(std::ceil(size));
+        m_columns = static_cast<int>((maxX - m_minX) / m_cellSize) + 1;
+        m_rows = static_cast<int>((maxY - m_minY) / m_cellSize) + 1;
+        m_cells.resize(static_cast<size_t>(m_columns) * m_rows);
+    }
+
+    std::vector<int>& cellAt(const GridPoint& p)
+    {
+        return m_cells[index(column(p.x), row(p.y))];
+    }
+
+    // Cells within margin of segment a-b
+    template <typename Visit>
+    void forEachCell(const GridPoint& a, const GridPoint& b, qint64 margin, Visit visit)
+    {
+        const GridPoint& left = (a.x <= b.x) ? a : b;
+        const GridPoint& right = (a.x <= b.x) ? b : a;
+        const int firstColumn = column(left.x - margin);
+        const int lastColumn = column(right.x + margin);
+        const long double slope = (right.x != left.x)
+            ? static_cast<long double>(right.y - left.y) / (right.x - left.x) : 0.0L;
+
+        for (int c = firstColumn; c <= lastColumn; ++c) {
+            // The segment's y span over this column
+            const qint64 x0 = std::max(left.x, m_minX + c * m_cellSize);
+            const qint64 x1 = std::min(right.x, m_minX + (c + 1) * m_cellSize);
+            qint64 y0 = std::min(left.y, right.y);
+            qint64 y1 = std::max(left.y, right.y);
+            if (x0 <= x1 && right.x != left.x) {
+                const long double ya = left.y + slope * (x0 - left.x);
+                const long double yb = left.y + slope * (x1 - left.x);
+                y0 = static_cast<qint64>(std::floor(std::min(ya, yb)));
+                y1 = static_cast<qint64>(std::ceil(std::max(ya, yb)));
+            }
+            const int lastRow = row(y1 + margin);
+            for (int r = row(y0 - margin); r <= lastRow; ++r) {
+                visit(m_cells[index(c, r)]);
+            }
+        }
+    }
+
+private:
+    int column(qint64 x) const { return qBound(0, static_cast<int>((x - m_minX) / m_cellSize), m_columns - 1); }
+    int row(qint64 y) const { return qBound(0, static_cast<int>((y - m_minY) / m_cellSize), m_rows - 1); }
+    size_t index(int c, int r) const { return static_cast<size_t>(r) * m_columns + c; }
+
+    qint64 m_minX;
+    qint64 m_minY;
+    qint64 m_cellSize;
+    int m_columns;
+    int m_rows;
+    std::vector<std::vector<int>> m_cells;
+};
+
+// Segment a-b meets the pixel centred on c, taken as [c - 1/2, c + 1/2) on both axes
+bool passesPixel(const GridPoint& a, const GridPoint& b, const GridPoint& c)
+{
+    // Doubled coordinates put pixel borders on odd integers and edge ends
+    // on even ones, so an edge can touch a border only at a corner
+    const GridPoint a2 = { 2 * a.x, 2 * a.y };
+    const GridPoint b2 = { 2 * b.x, 2 * b.y };
+    const qint64 x0 = 2 * c.x - 1;
+    const qint64 x1 = 2 * c.x + 1;
+    const qint64 y0 = 2 * c.y - 1;
+    const qint64 y1 = 2 * c.y + 1;
+    const qint64 minX = std::min(a2.x, b2.x);
+    const qint64 maxX = std::max(a2.x, b2.x);
+    const qint64 minY = std::min(a2.y, b2.y);
+    const qint64 maxY = std::max(a2.y, b2.y);
+
+    // Open interior: no separating axis among x, y and the edge normal
+    if (minX < x1 && maxX > x0 && minY < y1 && maxY > y0) {
+        bool left = false;
+        bool right = false;
+        for (const GridPoint& corner : { GridPoint{ x0, y0 }, GridPoint{ x1, y0 },
+                                         GridPoint{ x1, y1 }, GridPoint{ x0, y1 } }) {
+            const int side = turn(a2, b2, corner);
+            left = left || side > 0;
+            right = right || side < 0;
+        }
+        if (left && right) {
+            return true;
+        }
+    }
+
+    // Of the border, only the lower left corner belongs to the pixel
+    return minX <= x0 && x0 <= maxX && minY <= y0 && y0 <= maxY && turn(a2, b2, { x0, y0 }) == 0;
+}
+
+// Pixel holding the proper crossing of a0-a1 and b0-b1
+GridPoint crossingPixel(const GridPoint& a0, const GridPoint& a1, const GridPoint& b0, const GridPoint& b1)
+{
+    const long double vax = a1.x - a0.x;
+    const long double vay = a1.y - a0.y;
+    const long double vbx = b1.x - b0.x;
+    const long double vby = b1.y - b0.y;
+    const long double ex = b0.x - a0.x;
+    const long double ey = b0.y - a0.y;
+    const long double s = (ex * vby - ey * vbx) / (vax * vby - vay * vbx);
+    const GridPoint estimate = { a0.x + static_cast<qint64>(std::floor(s * vax + 0.5L)),
+                                 a0.y + static_cast<qint64>(std::floor(s * vay + 0.5L)) };
+
+    // The estimate can land one pixel off when the crossing sits on a
+    // border; the true pixel is the one both edges pass
+    for (const qint64 dx : { 0, -1, 1 }) {
+        for (const qint64 dy : { 0, -1, 1 }) {
+            const GridPoint candidate = { estimate.x + dx, estimate.y + dy };
+            if (passesPixel(a0, a1, candidate) && passesPixel(b0, b1, candidate)) {
+                return candidate;
+            }
+        }
+    }
+    return estimate;
+}
+
+/**
+ * @brief Snap rounding (Hobby): route every edge through the centres of
+ * the hot pixels it passes
+ *
+ * A pixel is hot when it holds an edge end or a crossing. Afterwards edges
+ * meet only at shared grid points or run along each other exactly, so the
+ * sweep never rounds a crossing and never bends an edge it has ordered.
+ */
+std::vector<InputEdge> snapRound(const std::vector<InputEdge>& edges)
+{
+    if (edges.empty()) {
+        return edges;
+    }
+
+    CellGrid edgeCells(edges);
+    for (int i = 0; i < static_cast<int>(edges.size()); ++i) {
+        edgeCells.forEachCell(edges[i].from, edges[i].to, 0,
+                              [i](std::vector<int>& cell) { cell.push_back(i); });
+    }
+
+    QHash<QPair<qint64, qint64>, int> hotIndex;
+    std::vector<GridPoint> hot;
+    auto addHot = [&hotIndex, &hot](const GridPoint& p) {
+        if (!hotIndex.contains(gridKey(p))) {
+            hotIndex.insert(gridKey(p), static_cast<int>(hot.size()));
+            hot.push_back(p);
+        }
+    };
+
+    std::vector<int> seen(edges.size(), -1);
+    for (int i = 0; i < static_cast<int>(edges.size()); ++i) {
+        const InputEdge& a = edges[i];
+        addHot(a.from);
+        addHot(a.to);
+        edgeCells.forEachCell(a.from, a.to, 0, [&](const std::vector<int>& cell) {
+            for (int j : cell) {
+                if (j <= i || seen[j] == i) {
+                    continue;
+                }
+                seen[j] = i;
+                const InputEdge& b = edges[j];
+                // Touching and overlaps happen at edge ends, which are hot already
+                const int b0Side = turn(a.from, a.to, b.from);
+                const int b1Side = turn(a.from, a.to, b.to);
+                if (b0Side * b1Side >= 0) {
+                    continue;
+                }
+                const int a0Side = turn(b.from, b.to, a.from);
+                const int a1Side = turn(b.from, b.to, a.to);
+                if (a0Side * a1Side >= 0) {
+                    continue;
+                }
+                addHot(crossingPixel(a.from, a.to, b.from, b.to));
+            }
+        });
+    }
+
+    CellGrid hotCells(edges);
+    for (int h = 0; h < static_cast<int>(hot.size()); ++h) {
+        hotCells.cellAt(hot[h]).push_back(h);
+    }
+
+    std::vector<InputEdge> rounded;
+    rounded.reserve(edges.size());
+    std::vector<int> visited(hot.size(), -1);
+    std::vector<GridPoint> route;
+    for (int i = 0; i < static_cast<int>(edges.size()); ++i) {
+        const InputEdge& edge = edges[i];
+        route.clear();
+        hotCells.forEachCell(edge.from, edge.to, 1, [&](const std::vector<int>& cell) {
+            for (int h : cell) {
+                if (visited[h] != i) {
+                    visited[h] = i;
+                    if (passesPixel(edge.from, edge.to, hot[h])) {
+                        route.push_back(hot[h]);
+                    }
+                }
+            }
+        });
+
+        // Along the edge: compare projections onto its direction exactly
+        const qint64 dx = edge.to.x - edge.from.x;
+        const qint64 dy = edge.to.y - edge.from.y;
+        std::sort(route.begin(), route.end(), [dx, dy](const GridPoint& p, const GridPoint& q) {
+            return productSign(p.x - q.x, dx, q.y - p.y, dy) < 0;
+        });
+
+        for (size_t k = 1; k < route.size(); ++k) {
+            if (route[k] != route[k - 1]) {
+                rounded.push_back({ route[k - 1], route[k], edge.subject });
+            }
+        }
+    }
+    return rounded;
+}
+
+/**
+ * @brief Intersection of segments a0-a1 and b0-b1
+ *
+ * Collinearity and touching are decided by the exact orientation test,
+ * the same one that orders the sweep, so overlaps and touching points
+ * are existing grid points and splitting there bends no edge.
+ *
+ * @return 0 (none), 1 (single point in ip0) or 2 (overlap ip0-ip1)
+ */
+int findIntersection(const GridPoint& a0, const GridPoint& a1, const GridPoint& b0, const GridPoint& b1,
+                     GridPoint& ip0, GridPoint& ip1)
+{
+    const int b0Side = turn(a0, a1, b0);
+    const int b1Side = turn(a0, a1, b1);
+
+    if (b0Side == 0 && b1Side == 0) {
+        // Same line: the overlap runs between the inner two endpoints
+        const GridPoint aFirst = sweptBefore(a0, a1) ? a0 : a1;
+        const GridPoint aLast = sweptBefore(a0, a1) ? a1 : a0;
+        const GridPoint bFirst = sweptBefore(b0, b1) ? b0 : b1;
+        const GridPoint bLast = sweptBefore(b0, b1) ? b1 : b0;
+        const GridPoint first = sweptBefore(aFirst, bFirst) ? bFirst : aFirst;
+        const GridPoint last = sweptBefore(aLast, bLast) ? aLast : bLast;
+        if (sweptBefore(last, first)) {
+            return 0;
+        }
+        ip0 = first;
+        if (first == last) {
+            return 1;
+        }
+        ip1 = last;
+        return 2;
+    }
+    if (b0Side == b1Side) {
+        return 0;
+    }
+
+    const int a0Side = turn(b0, b1, a0);
+    const int a1Side = turn(b0, b1, a1);
+    if (a0Side == a1Side) {
+        return 0;
+    }
+
+    // An endpoint on the other edge's line lies on the edge itself, since
+    // the other edge's ends straddle this one's line
+    if (b0Side == 0 || b1Side == 0) {
+        ip0 = (b0Side == 0) ? b0 : b1;
+        return 1;
+    }
+    if (a0Side == 0 || a1Side == 0) {
+        ip0 = (a0Side == 0) ? a0 : a1;
+        return 1;
+    }
+
+    // Snap rounding leaves no proper crossings; split at the pixel regardless
+    ip0 = crossingPixel(a0, a1, b0, b1);
+    return 1;
+}
+
+struct SweepEvent;
+
+struct SegmentLess {
+    bool operator()(const SweepEvent* le1, const SweepEvent* le2) const;
+};
+
+using StatusLine = std::set<SweepEvent*, SegmentLess>;
+
+/**
+ * @brief Endpoint of an edge; the left event carries the edge's state
+ */
+struct SweepEvent {
+    GridPoint point;
+    bool left;                      // Processed first of the pair
+    SweepEvent *other;
+    int id;                         // Creation order, for stable ties
+    int subjectWind;                // Winding change crossing the edge upwards
+    int clipWind;
+    int subjectBelow;               // Winding numbers just below the edge (set by the sweep)
+    int clipBelow;
+    bool inResult;
+    bool insideAbove;               // Result region lies above the edge
+    bool inStatus;
+    StatusLine::iterator position;  // Own node while inStatus, end() otherwise
+
+    // Edge passes below p
+    bool below(const GridPoint& p) const
+    {
+        return left ? turn(point, other->point, p) > 0 : turn(other->point, point, p) > 0;
+    }
+
+    bool above(const GridPoint& p) const { return !below(p); }
+};
+
+// Queue order: x, then y, right before left, lower edge first
+bool processedAfter(const SweepEvent* e1, const SweepEvent* e2)
+{
+    if (e1->point.x != e2->point.x) {
+        return e1->point.x > e2->point.x;
+    }
+    if (e1->point.y != e2->point.y) {
+        return e1->point.y > e2->point.y;
+    }
+    if (e1->left != e2->left) {
+        return e1->left;
+    }
+    if (turn(e1->point, e1->other->point, e2->other->point) != 0) {
+        return e1->above(e2->other->point);
+    }
+    return e1->id > e2->id;
+}
+
+struct EventAfter {
+    bool operator()(const SweepEvent* e1, const SweepEvent* e2) const { return processedAfter(e1, e2); }
+};
+
+// Status order: bottom to top at the current sweep position
+bool SegmentLess::operator()(const SweepEvent* le1, const SweepEvent* le2) const
+{
+    if (le1 == le2) {
+        return false;
+    }
+
+    if (turn(le1->point, le1->other->point, le2->point) != 0 ||
+        turn(le1->point, le1->other->point, le2->other->point) != 0) {
+        if (le1->point == le2->point) {
+            return le1->below(le2->other->point);
+        }
+        if (le1->point.x == le2->point.x) {
+            return le1->point.y < le2->point.y;
+        }
+        // Compare against the edge that was in the status line first
+        if (processedAfter(le1, le2)) {
+            return le2->above(le1->point);
+        }
+        return le1->below(le2->point);
+    }
+
+    // Collinear: any consistent order
+    if (le1->point == le2->point) {
+        return le1->id < le2->id;
+    }
+    return processedAfter(le1, le2);
+}
+
+/**
+ * @brief One Martinez-Rueda sweep with winding numbers per operand
+ */
+class Sweep {
+public:
+    explicit Sweep(PolygonClipper::Operation operation)
+        : m_operation(operation)
+    {
+    }
+
+    void addRing(const QPolygonF& ring, bool subject, qint64 maxX);
+    void run(qint64 rightBound);
+    MultiPolygon result() const;
+
+private:
+    void addEdge(const InputEdge& edge);
+    SweepEvent* createEvent(const GridPoint& point, bool left, SweepEvent* other);
+    void insertStatus(SweepEvent* e);
+    void eraseStatus(SweepEvent* e);
+    bool inside(int subjectWinding, int clipWinding) const;
+    void computeFields(SweepEvent* e, const SweepEvent* prev) const;
+    int possibleIntersection(SweepEvent* le1, SweepEvent* le2);
+    void divideSegment(SweepEvent* le, const GridPoint& p);
+    static void merge(SweepEvent* keep, SweepEvent* fold);
+
+    PolygonClipper::Operation m_operation;
+    std::vector<InputEdge> m_input;
+    std::deque<SweepEvent> m_events;    // Stable addresses
+    std::priority_queue<SweepEvent*, std::vector<SweepEvent*>, EventAfter> m_queue;
+    StatusLine m_status;
+    std::vector<SweepEvent*> m_divided;  // Events created while handling the current one
+};
+
+SweepEvent* Sweep::createEvent(const GridPoint& point, bool left, SweepEvent* other)
+{
+    SweepEvent event;
+    event.point = point;
+    event.left = left;
+    event.other = other;
+    event.id = static_cast<int>(m_events.size());
+    event.subjectWind = 0;
+    event.clipWind = 0;
+    event.subjectBelow = 0;
+    event.clipBelow = 0;
+    event.inResult = false;
+    event.insideAbove = false;
+    event.inStatus = false;
+    event.position = m_status.end();
+    m_events.push_back(event);
+    return &m_events.back();
+}
+
+void Sweep::insertStatus(SweepEvent* e)
+{
+    e->position = m_status.insert(e).first;
+    e->inStatus = true;
+}
+
+void Sweep::eraseStatus(SweepEvent* e)
+{
+    m_status.erase(e->position);
+    e->position = m_status.end();
+    e->inStatus = false;
+}
+
+void Sweep::addRing(const QPolygonF& ring, bool subject, qint64 maxX)
+{
+    std::vector<GridPoint> points;
+    points.reserve(ring.count());
+    for (const QPointF& point : ring) {
+        const GridPoint snapped = toGrid(point);
+        if (points.empty() || points.back() != snapped) {
+            points.push_back(snapped);
+        }
+    }
+    if (points.size() > 1 && points.front() == points.back()) {
+        points.pop_back();
+    }
+    if (points.size() < 3) {
+        return;
+    }
+
+    const int n = static_cast<int>(points.size());
+    for (int i = 0; i < n; ++i) {
+        const GridPoint& p = points[i];
+        const GridPoint& q = points[(i + 1) % n];
+
+        // Edges starting past the end of the sweep are never reached
+        if (std::min(p.x, q.x) > maxX) {
+            continue;
+        }
+        m_input.push_back({ p, q, subject });
+    }
+}
+
+void Sweep::addEdge(const InputEdge& edge)
+{
+    SweepEvent* e1 = createEvent(edge.from, true, nullptr);
+    SweepEvent* e2 = createEvent(edge.to, true, e1);
+    e1->other = e2;
+
+    // Winding convention: +1 for edges running in sweep order
+    const bool forward = processedAfter(e2, e1);
+    (forward ? e2 : e1)->left = false;
+    const int wind = forward ? 1 : -1;
+    for (SweepEvent* e : { e1, e2 }) {
+        (edge.subject ? e->subjectWind : e->clipWind) = wind;
+    }
+
+    m_queue.push(e1);
+    m_queue.push(e2);
+}
+
+bool Sweep::inside(int subjectWinding, int clipWinding) const
+{
+    switch (m_operation) {
+    case PolygonClipper::Operation::Union:
+        return subjectWinding != 0 || clipWinding != 0;
+    case PolygonClipper::Operation::Intersection:
+        return subjectWinding != 0 && clipWinding != 0;
+    case PolygonClipper::Operation::Difference:
+        return subjectWinding != 0 && clipWinding == 0;
+    }
+    return false;
+}
+
+void Sweep::computeFields(SweepEvent* e, const SweepEvent* prev) const
+{
+    if (prev) {
+        e->subjectBelow = prev->subjectBelow + prev->subjectWind;
+        e->clipBelow = prev->clipBelow + prev->clipWind;
+    } else {
+        e->subjectBelow = 0;
+        e->clipBelow = 0;
+    }
+
+    const bool below = inside(e->subjectBelow, e->clipBelow);
+    const bool above = inside(e->subjectBelow + e->subjectWind, e->clipBelow + e->clipWind);
+    e->inResult = below != above;
+    e->insideAbove = above;
+}
+
+void Sweep::merge(SweepEvent* keep, SweepEvent* fold)
+{
+    // Identical edges: one carries both windings, the other becomes inert
+    keep->subjectWind += fold->subjectWind;
+    keep->clipWind += fold->clipWind;
+    keep->other->subjectWind = keep->subjectWind;
+    keep->other->clipWind = keep->clipWind;
+
+    fold->subjectWind = 0;
+    fold->clipWind = 0;
+    fold->other->subjectWind = 0;
+    fold->other->clipWind = 0;
+}
+
+void Sweep::divideSegment(SweepEvent* le, const GridPoint& p)
+{
+    if (p == le->point || p == le->other->point) {
+        return;
+    }
+
+    SweepEvent* r = createEvent(p, false, le);
+    SweepEvent* l = createEvent(p, true, le->other);
+    r->subjectWind = l->subjectWind = le->subjectWind;
+    r->clipWind = l->clipWind = le->clipWind;
+
+    // Rounding can put the new left event after its right event; swap roles
+    if (processedAfter(l, le->other)) {
+        le->other->left = true;
+        l->left = false;
+        le->other->subjectWind = l->subjectWind = -le->subjectWind;
+        le->other->clipWind = l->clipWind = -le->clipWind;
+    }
+
+    le->other->other = l;
+    le->other = r;
+    m_queue.push(l);
+    m_queue.push(r);
+    m_divided.push_back(l);
+    m_divided.push_back(r);
+}
+
+int Sweep::possibleIntersection(SweepEvent* le1, SweepEvent* le2)
+{
+    // Edges made identical by earlier splits
+    if (le1->point == le2->point && le1->other->point == le2->other->point) {
+        merge(le1, le2);
+        return 2;
+    }
+
+    GridPoint ip0;
+    GridPoint ip1;
+    const int count = findIntersection(le1->point, le1->other->point, le2->point, le2->other->point, ip0, ip1);
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (count == 1) {
+        // Touching at an endpoint of both needs no split
+        if (le1->point == le2->point || le1->other->point == le2->other->point) {
+            return 0;
+        }
+        // Rounding can move the crossing outside the span both edges cover.
+        // Its x never rounds past a span end, but can land on one; then the
+        // order rests on y, which is far off along a steep edge, and the end
+        // point itself would bend the other edge. Step one cell inside.
+        const SweepEvent* lastLeft = processedAfter(le1, le2) ? le1 : le2;
+        const SweepEvent* firstRight = processedAfter(le1->other, le2->other) ? le2->other : le1->other;
+        if (sweptBefore(ip0, lastLeft->point)) {
+            const GridPoint inside = { ip0.x + 1, ip0.y };
+            ip0 = sweptBefore(inside, firstRight->point) ? inside : lastLeft->point;
+        } else if (sweptBefore(firstRight->point, ip0)) {
+            const GridPoint inside = { ip0.x - 1, ip0.y };
+            ip0 = sweptBefore(lastLeft->point, inside) ? inside : firstRight->point;
+        }
+        divideSegment(le1, ip0);
+        divideSegment(le2, ip0);
+        return 1;
+    }
+
+    // Overlap: order the four endpoints, nullptr marking a shared one
+    SweepEvent* sorted[4];
+    int n = 0;
+    if (le1->point == le2->point) {
+        sorted[n++] = nullptr;
+    } else if (processedAfter(le1, le2)) {
+        sorted[n++] = le2;
+        sorted[n++] = le1;
+    } else {
+        sorted[n++] = le1;
+        sorted[n++] = le2;
+    }
+    if (le1->other->point == le2->other->point) {
+        sorted[n++] = nullptr;
+    } else if (processedAfter(le1->other, le2->other)) {
+        sorted[n++] = le2->other;
+        sorted[n++] = le1->other;
+    } else {
+        sorted[n++] = le1->other;
+        sorted[n++] = le2->other;
+    }
+
+    if (n == 2) {
+        merge(le1, le2);
+        return 2;
+    }
+
+    if (n == 3) {
+        if (!sorted[0]) {
+            // Shared left endpoint: cut the longer edge at the shorter one's end
+            divideSegment(sorted[2]->other, sorted[1]->point);
+            merge(le1, le2);
+            return 2;
+        }
+        // Shared right endpoint: the identical tails meet again later
+        divideSegment(sorted[0], sorted[1]->point);
+        return 3;
+    }
+
+    if (sorted[0] != sorted[3]->other) {
+        // Partial overlap
+        divideSegment(sorted[0], sorted[1]->point);
+        divideSegment(sorted[1], sorted[2]->point);
+        return 3;
+    }
+
+    // One edge contains the other
+    divideSegment(sorted[0], sorted[1]->point);
+    divideSegment(sorted[3]->other, sorted[2]->point);
+    return 3;
+}
+
+void Sweep::run(qint64 rightBound)
+{
+    for (const InputEdge& edge : snapRound(m_input)) {
+        addEdge(edge);
+    }
+
+    while (!m_queue.empty()) {
+        SweepEvent* e = m_queue.top();
+        m_queue.pop();
+
+        if (e->point.x > rightBound) {
+            break;
+        }
+
+        if (e->left) {
+            m_divided.clear();
+            insertStatus(e);
+
+            SweepEvent* prev = (e->position != m_status.begin()) ? *std::prev(e->position) : nullptr;
+            const auto nextIt = std::next(e->position);
+            SweepEvent* next = (nextIt != m_status.end()) ? *nextIt : nullptr;
+
+            computeFields(e, prev);
+
+            if (next && possibleIntersection(e, next) == 2) {
+                computeFields(e, prev);
+                computeFields(next, e);
+            }
+            if (prev && possibleIntersection(prev, e) == 2) {
+                SweepEvent* prevPrev = (prev->position != m_status.begin()) ? *std::prev(prev->position) : nullptr;
+                computeFields(prev, prevPrev);
+                computeFields(e, prev);
+            }
+
+            // A split at or before this point (e.g. a vertical edge cut where
+            // e starts) must be swept first; e's fields are stale until then
+            const bool stale = std::any_of(m_divided.cbegin(), m_divided.cend(),
+                                           [e](const SweepEvent* created) { return processedAfter(e, created); });
+            if (stale) {
+                eraseStatus(e);
+                m_queue.push(e);
+            }
+        } else {
+            SweepEvent* le = e->other;
+            if (!le->inStatus) {
+                continue;
+            }
+
+            const auto it = le->position;
+            SweepEvent* prev = (it != m_status.begin()) ? *std::prev(it) : nullptr;
+            const auto nextIt = std::next(it);
+            SweepEvent* next = (nextIt != m_status.end()) ? *nextIt : nullptr;
+
+            eraseStatus(le);
+
+            if (prev && next) {
+                possibleIntersection(prev, next);
+            }
+        }
+    }
+}
+
+// Drop vertices lying on the line through their neighbours (left by splits)
+QPolygonF removeCollinear(const QPolygonF& ring)
+{
+    QPolygonF simplified;
+    const int n = ring.count();
+    for (int i = 0; i < n; ++i) {
+        const QPointF& prev = ring[(i + n - 1) % n];
+        const QPointF& current = ring[i];
+        const QPointF& next = ring[(i + 1) % n];
+        const QPointF chord = next - prev;
+        if (std::abs(cross(current - prev, chord)) > SNAP_GRID * std::sqrt(dot(chord, chord))) {
+            simplified.append(current);
+        }
+    }
+    return simplified;
+}
+
+MultiPolygon Sweep::result() const
+{
+    // Result edges, directed with the result on their left
+    struct Edge {
+        GridPoint from;
+        GridPoint to;
+    };
+
+    QVector<Edge> edges;
+    for (const SweepEvent& e : m_events) {
+        if (e.left && e.inResult) {
+            edges.append(e.insideAbove ? Edge{ e.point, e.other->point } : Edge{ e.other->point, e.point });
+        }
+    }
+
+    QHash<QPair<qint64, qint64>, QVector<int>> outgoing;
+    for (int i = 0; i < edges.size(); ++i) {
+        outgoing[gridKey(edges[i].from)].append(i);
+    }
+
+    QVector<bool> used(edges.size(), false);
+
+    QList<QPolygonF> rings;
+    for (int start = 0; start < edges.size(); ++start) {
+        if (used[start]) {
+            continue;
+        }
+
+        // Vertices of the open walk, and where each sits on it
+        QVector<GridPoint> path;
+        QHash<QPair<qint64, qint64>, int> pathIndex;
+        int current = start;
+
+        while (true) {
+            used[current] = true;
+            pathIndex.insert(gridKey(edges[current].from), path.count());
+            path.append(edges[current].from);
+
+            // Back at a vertex of the walk: the loop since then is a ring.
+            // Rings pinched together at a vertex come out separately.
+            const GridPoint& end = edges[current].to;
+            const QPair<qint64, qint64> endKey = gridKey(end);
+            const auto revisited = pathIndex.constFind(endKey);
+            if (revisited != pathIndex.constEnd()) {
+                const int first = *revisited;
+                QPolygonF ring;
+                for (int k = first; k < path.count(); ++k) {
+                    ring.append(toPoint(path[k]));
+                    pathIndex.remove(gridKey(path[k]));
+                }
+                rings.append(ring);
+                path.resize(first);
+                if (path.isEmpty()) {
+                    break;
+                }
+            }
+
+            // Sharpest left turn keeps rings touching at a vertex apart
+            const QPointF incoming = toPoint(end) - toPoint(edges[current].from);
+            int best = -1;
+            double bestAngle = -std::numeric_limits<double>::infinity();
+            const auto candidates = outgoing.constFind(endKey);
+            if (candidates != outgoing.constEnd()) {
+                for (int candidate : *candidates) {
+                    if (used[candidate]) {
+                        continue;
+                    }
+                    const QPointF out = toPoint(edges[candidate].to) - toPoint(edges[candidate].from);
+                    const double angle = std::atan2(cross(incoming, out), dot(incoming, out));
+                    if (angle > bestAngle) {
+                        bestAngle = angle;
+                        best = candidate;
+                    }
+                }
+            }
+
+            // An open remainder is dropped
+            if (best < 0) {
+                break;
+            }
+            current = best;
+        }
+    }
+
+    QList<QPolygonF> outers;
+    QList<QPolygonF> holes;
+    for (const QPolygonF& loop : rings) {
+        const QPolygonF ring = removeCollinear(loop);
+        const double area = PolygonClipper::signedArea(ring);
+        if (ring.count() < 3 || std::abs(area) < MIN_RING_AREA) {
+            continue;
+        }
+        (area > 0.0 ? outers : holes).append(ring);
+    }
+
+    MultiPolygon polygons;
+    QVector<double> outerAreas;
+    QVector<QRectF> outerBounds;
+    for (const QPolygonF& outer : outers) {
+        PolygonWithHoles polygon;
+        polygon.outer = outer;
+        polygons.append(polygon);
+        outerAreas.append(PolygonClipper::signedArea(outer));
+        outerBounds.append(outer.boundingRect());
+    }
+
+    // Each hole belongs to the smallest outer ring around it; a point on
+    // a hole edge cannot lie on an outer edge, so the test is unambiguous
+    for (const QPolygonF& hole : holes) {
+        const QPointF probe = (hole[0] + hole[1]) / 2.0;
+        int parent = -1;
+        for (int i = 0; i < polygons.size(); ++i) {
+            if ((parent < 0 || outerAreas[i] < outerAreas[parent]) &&
+                outerBounds[i].contains(probe) &&
+                polygons[i].outer.containsPoint(probe, Qt::OddEvenFill)) {
+                parent = i;
+            }
+        }
+        if (parent >= 0) {
+            polygons[parent].holes.append(hole);
+        }
+    }
+
+    std::stable_sort(polygons.begin(), polygons.end(),
+                     [](const PolygonWithHoles& a, const PolygonWithHoles& b) {
+                         return a.area() > b.area();
+                     });
+    return polygons;
+}
+
+} // namespace
+
+double PolygonWithHoles::area() const
+{
+    double total = std::abs(PolygonClipper::signedArea(outer));
+    for (const QPolygonF& hole : holes) {
+        total -= std::abs(PolygonClipper::signedArea(hole));
+    }
+    return total;
+}
+
+MultiPolygon PolygonClipper::compute(const QList<QPolygonF>& subject, const QList<QPolygonF>& clip,
+                                     Operation operation)
+{
+    TRACE_SCOPE("geometry", "PolygonClipper::compute");
+
+    QRectF subjectBounds;
+    for (const QPolygonF& ring : subject) {
+        subjectBounds = subjectBounds.united(ring.boundingRect());
+    }
+    // A clip ring clear of the subject's bounds winds zero everywhere inside
+    // them, so outside a union it can be dropped whole
+    const QRectF reach = subjectBounds.adjusted(-SNAP_GRID, -SNAP_GRID, SNAP_GRID, SNAP_GRID);
+    QList<QPolygonF> clipRings;
+    QRectF clipBounds;
+    for (const QPolygonF& ring : clip) {
+        const QRectF bounds = ring.boundingRect();
+        if (operation == Operation::Union || bounds.intersects(reach)) {
+            clipRings.append(ring);
+            clipBounds = clipBounds.united(bounds);
+        }
+    }
+
+    // Past the subject (or either operand, for intersection) nothing can be in the result
+    qint64 maxX = std::numeric_limits<qint64>::max();
+    if (operation != Operation::Union) {
+        maxX = qRound64(subjectBounds.right() / SNAP_GRID) + 1;
+        if (operation == Operation::Intersection) {
+            maxX = std::min(maxX, qRound64(clipBounds.right() / SNAP_GRID) + 1);
+        }
+    }
+
+    Sweep sweep(operation);
+    for (const QPolygonF& ring : subject) {
+        sweep.addRing(ring, true, maxX);
+    }
+    for (const QPolygonF& ring : clipRings) {
+        sweep.addRing(ring, false, maxX);
+    }
+
+    sweep.run(maxX);
+    return sweep.result();
+}
+
+QPolygonF PolygonClipper::circle(const QPointF& center, double radius, double tolerance)
+{
+    int segments = MAX_CIRCLE_SEGMENTS;
+    if (tolerance > 0.0 && radius > 0.0) {
+        // Vertices sit radius / cos(pi / n) out; keep that within tolerance
+        segments = static_cast<int>(std::ceil(M_PI / std::acos(radius / (radius + tolerance))));
+    }
+    segments = qBound(MIN_CIRCLE_SEGMENTS, segments, MAX_CIRCLE_SEGMENTS);
+
+    // Edges tangent to the circle, so the polygon contains it
+    const double vertexRadius = radius / std::cos(M_PI / segments);
+
+    QPolygonF ring;
+    ring.reserve(segments);
+    for (int i = 0; i < segments; ++i) {
+        const double angle = 2.0 * M_PI * i / segments;
+        ring.append(center + QPointF(std::cos(angle), std::sin(angle)) * vertexRadius);
+    }
+    return ring;
+}
+
+double PolygonClipper::signedArea(const QPolygonF& ring)
+{
+    double area = 0.0;
+    const int n = ring.count();
+    for (int i = 0; i < n; ++i) {
+        area += cross(ring[i], ring[(i + 1) % n]);
+    }
+    return area / 2.0;
+}
+
+} // namespace Geospatial
+} // namespace DroneMapper
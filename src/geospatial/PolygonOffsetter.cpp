@@ -0,0 +1,173 @@
+#include "PolygonOffsetter.h"
+#include "core/Tracer.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+namespace {
+
+constexpr double MIN_TURN = 1e-9;           // Radians; straighter vertices need no join
+constexpr int MAX_ARC_SEGMENTS = 256;       // Per full turn, as PolygonClipper::circle
+
+double cross(const QPointF& a, const QPointF& b)
+{
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+double dot(const QPointF& a, const QPointF& b)
+{
+    return a.x() * b.x() + a.y() * b.y();
+}
+
+QPointF unit(const QPointF& v)
+{
+    return v / std::sqrt(dot(v, v));
+}
+
+// Right-hand normal, i.e. outwards for a counter-clockwise ring
+QPointF rightNormal(const QPointF& direction)
+{
+    return QPointF(direction.y(), -direction.x());
+}
+
+QPointF rotated(const QPointF& v, double angle)
+{
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    return QPointF(v.x() * c - v.y() * s, v.x() * s + v.y() * c);
+}
+
+} // namespace
+
+MultiPolygon PolygonOffsetter::offset(const QPolygonF& ring, double delta, const Options& options)
+{
+    const QPolygonF base = normalized(ring);
+    if (base.count() < 3) {
+        return MultiPolygon();
+    }
+
+    if (delta >= 0.0) {
+        return PolygonClipper::compute(outsetPieces(base, delta, options), QList<QPolygonF>(),
+                                       PolygonClipper::Operation::Union);
+    }
+
+    // Walked clockwise, the interior is on the right and reflex vertices turn left
+    QPolygonF reversed;
+    std::reverse_copy(base.cbegin(), base.cend(), std::back_inserter(reversed));
+
+    QList<QPolygonF> pieces;
+    appendEdgePieces(reversed, -delta, options, pieces);
+    return PolygonClipper::compute({ base }, pieces, PolygonClipper::Operation::Difference);
+}
+
+QList<MultiPolygon> PolygonOffsetter::offsetAll(const QList<QPolygonF>& rings, double delta,
+                                                const Options& options)
+{
+    TRACE_SCOPE("geometry", "PolygonOffsetter::offsetAll");
+
+    return QtConcurrent::blockingMapped<QList<MultiPolygon>>(
+        rings,
+        [delta, options](const QPolygonF& ring) {
+            return offset(ring, delta, options);
+        });
+}
+
+QList<QPolygonF> PolygonOffsetter::outsetPieces(const QPolygonF& ring, double distance, const Options& options)
+{
+    QList<QPolygonF> pieces;
+
+    const QPolygonF base = normalized(ring);
+    if (base.count() < 3) {
+        return pieces;
+    }
+
+    pieces.append(base);
+    if (distance > 0.0) {
+        appendEdgePieces(base, distance, options, pieces);
+    }
+    return pieces;
+}
+
+QPolygonF PolygonOffsetter::normalized(const QPolygonF& ring)
+{
+    // Repeated points (including a closing one) would leave edges without a direction
+    QPolygonF base;
+    for (const QPointF& point : ring) {
+        if (base.isEmpty() || point != base.last()) {
+            base.append(point);
+        }
+    }
+    while (base.count() > 1 && base.first() == base.last()) {
+        base.removeLast();
+    }
+
+    if (base.count() >= 3 && PolygonClipper::signedArea(base) < 0.0) {
+        std::reverse(base.begin(), base.end());
+    }
+    return base;
+}
+
+void PolygonOffsetter::appendEdgePieces(const QPolygonF& ring, double distance, const Options& options,
+                                        QList<QPolygonF>& pieces)
+{
+    const int n = ring.count();
+    for (int i = 0; i < n; ++i) {
+        const QPointF& a = ring[i];
+        const QPointF& b = ring[(i + 1) % n];
+        const QPointF& c = ring[(i + 2) % n];
+
+        // Band on the right of edge a-b
+        const QPointF e1 = unit(b - a);
+        const QPointF n1 = rightNormal(e1) * distance;
+        QPolygonF band;
+        band << a << a + n1 << b + n1 << b;
+        pieces.append(band);
+
+        // Joins where the offset edges separate (left turns); elsewhere the bands overlap
+        const QPointF e2 = unit(c - b);
+        const QPointF n2 = rightNormal(e2) * distance;
+        const double angle = std::atan2(cross(e1, e2), dot(e1, e2));
+        if (angle <= MIN_TURN) {
+            continue;
+        }
+
+        const QPointF bisector = (angle < M_PI - MIN_TURN) ? unit(n1 + n2) : e1;
+        const double miterLength = distance / std::cos(angle / 2.0);
+
+        QPolygonF join;
+        join << b << b + n1;
+
+        if (options.join == JoinType::Round) {
+            // Points off the arc so every edge is tangent to it and the join contains it
+            int segments = MAX_ARC_SEGMENTS;
+            if (options.arcTolerance > 0.0) {
+                const double step = 2.0 * std::acos(distance / (distance + options.arcTolerance));
+                segments = static_cast<int>(std::ceil(2.0 * M_PI / step));
+            }
+            const int count = qBound(1, static_cast<int>(std::ceil(angle / (2.0 * M_PI) * segments)),
+                                     MAX_ARC_SEGMENTS);
+            const double sweep = angle / count;
+            const QPointF spoke = n1 / std::cos(sweep / 2.0);
+            for (int k = 0; k < count; ++k) {
+                join << b + rotated(spoke, (k + 0.5) * sweep);
+            }
+        } else if (options.join == JoinType::Miter && angle < M_PI - MIN_TURN &&
+                   miterLength <= options.miterLimit * distance) {
+            join << b + bisector * miterLength;
+        } else {
+            // Square, and miters past the limit: cut at the distance along the bisector
+            const double extension = distance * std::tan(angle / 4.0);
+            join << b + n1 + e1 * extension << b + n2 - e2 * extension;
+        }
+
+        join << b + n2;
+        pieces.append(join);
+    }
+}
+
+} // namespace Geospatial
+} // namespace DroneMapper
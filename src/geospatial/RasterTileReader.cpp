@@ -0,0 +1,208 @@
+#include "RasterTileReader.h"
+#include <gdal.h>
+#include <gdalwarper.h>
+#include <ogr_srs_api.h>
+#include <cpl_conv.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+RasterTileReader::RasterTileReader()
+    : m_dataset(nullptr)
+    , m_source(nullptr)
+    , m_width(0)
+    , m_height(0)
+    , m_geoTransform{0, 1, 0, 0, 0, -1}
+    , m_geographic(false)
+{
+}
+
+RasterTileReader::~RasterTileReader()
+{
+    close();
+}
+
+bool RasterTileReader::open(const QString& filePath)
+{
+    close();
+    GDALAllRegister();
+
+    m_dataset = GDALOpen(filePath.toUtf8().constData(), GA_ReadOnly);
+    if (!m_dataset) {
+        m_lastError = "Cannot open raster: " + filePath;
+        return false;
+    }
+
+    if (!readMetadata()) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool RasterTileReader::reprojectTo(const QString& wkt)
+{
+    if (!m_dataset) {
+        m_lastError = "Raster not open";
+        return false;
+    }
+
+    OGRSpatialReferenceH current = OSRNewSpatialReference(m_projection.toUtf8().constData());
+    OGRSpatialReferenceH target = OSRNewSpatialReference(wkt.toUtf8().constData());
+    bool same = current && target && OSRIsSame(current, target);
+    OSRDestroySpatialReference(current);
+    OSRDestroySpatialReference(target);
+
+    if (same) {
+        return true;
+    }
+
+    // Warped VRT reprojects block by block, so memory stays bounded
+    GDALDatasetH warped = GDALAutoCreateWarpedVRT(
+        m_dataset, nullptr, wkt.toUtf8().constData(), GRA_Bilinear, 0.125, nullptr);
+    if (!warped) {
+        m_lastError = "Cannot reproject raster to the reference CRS";
+        return false;
+    }
+
+    if (m_source) {
+        GDALClose(m_dataset);
+    } else {
+        m_source = m_dataset;
+    }
+    m_dataset = warped;
+
+    return readMetadata();
+}
+
+QString RasterTileReader::wktForEPSG(int epsg)
+{
+    OGRSpatialReferenceH srs = OSRNewSpatialReference(nullptr);
+    QString wkt;
+
+    char* text = nullptr;
+    if (OSRImportFromEPSG(srs, epsg) == OGRERR_NONE && OSRExportToWkt(srs, &text) == OGRERR_NONE) {
+        wkt = QString::fromUtf8(text);
+    }
+
+    CPLFree(text);
+    OSRDestroySpatialReference(srs);
+    return wkt;
+}
+
+int RasterTileReader::bandCount() const
+{
+    return m_dataset ? GDALGetRasterCount(m_dataset) : 0;
+}
+
+void RasterTileReader::close()
+{
+    if (m_dataset) {
+        GDALClose(m_dataset);
+        m_dataset = nullptr;
+    }
+    if (m_source) {
+        GDALClose(m_source);
+        m_source = nullptr;
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+bool RasterTileReader::readMetadata()
+{
+    if (GDALGetRasterCount(m_dataset) < 1) {
+        m_lastError = "Raster has no bands";
+        return false;
+    }
+
+    if (GDALGetGeoTransform(m_dataset, m_geoTransform) != CE_None) {
+        m_lastError = "Raster is not georeferenced";
+        return false;
+    }
+
+    if (m_geoTransform[2] != 0.0 || m_geoTransform[4] != 0.0 || m_geoTransform[5] >= 0.0) {
+        m_lastError = "Rotated or south-up rasters are not supported";
+        return false;
+    }
+
+    m_width = GDALGetRasterXSize(m_dataset);
+    m_height = GDALGetRasterYSize(m_dataset);
+    m_projection = QString::fromUtf8(GDALGetProjectionRef(m_dataset));
+
+    OGRSpatialReferenceH srs = OSRNewSpatialReference(m_projection.toUtf8().constData());
+    m_geographic = srs && OSRIsGeographic(srs);
+    OSRDestroySpatialReference(srs);
+
+    return true;
+}
+
+bool RasterTileReader::readWindow(double minX, double maxY, double pixelSize,
+                                  int columns, int rows, float* out, int band)
+{
+    if (!m_dataset || columns <= 0 || rows <= 0 || band < 1 || band > bandCount()) {
+        return false;
+    }
+
+    GDALRasterBandH rasterBand = GDALGetRasterBand(m_dataset, band);
+
+    // Fractional source window covering the target grid
+    double xOff = (minX - m_geoTransform[0]) / m_geoTransform[1];
+    double yOff = (maxY - m_geoTransform[3]) / m_geoTransform[5];
+    double xSize = columns * pixelSize / m_geoTransform[1];
+    double ySize = rows * pixelSize / -m_geoTransform[5];
+
+    // Absorb rounding at the raster edges
+    xOff = std::clamp(xOff, 0.0, static_cast<double>(m_width));
+    yOff = std::clamp(yOff, 0.0, static_cast<double>(m_height));
+    xSize = std::min(xSize, m_width - xOff);
+    ySize = std::min(ySize, m_height - yOff);
+
+    int x0 = static_cast<int>(std::floor(xOff));
+    int y0 = static_cast<int>(std::floor(yOff));
+    int x1 = std::min(static_cast<int>(std::ceil(xOff + xSize)), m_width);
+    int y1 = std::min(static_cast<int>(std::ceil(yOff + ySize)), m_height);
+
+    if (x1 <= x0 || y1 <= y0) {
+        m_lastError = "Window outside raster";
+        return false;
+    }
+
+    GDALRasterIOExtraArg extra;
+    INIT_RASTERIO_EXTRA_ARG(extra);
+    extra.eResampleAlg = GRIORA_Bilinear;
+    extra.bFloatingPointWindowValidity = TRUE;
+    extra.dfXOff = xOff;
+    extra.dfYOff = yOff;
+    extra.dfXSize = xSize;
+    extra.dfYSize = ySize;
+
+    CPLErr err = GDALRasterIOEx(rasterBand, GF_Read,
+                                x0, y0, x1 - x0, y1 - y0,
+                                out, columns, rows, GDT_Float32, 0, 0, &extra);
+    if (err != CE_None) {
+        m_lastError = QString::fromUtf8(CPLGetLastErrorMsg());
+        return false;
+    }
+
+    int hasNoData = 0;
+    const double noDataValue = GDALGetRasterNoDataValue(rasterBand, &hasNoData);
+
+    if (hasNoData) {
+        const float noData = static_cast<float>(noDataValue);
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const qint64 count = static_cast<qint64>(columns) * rows;
+        for (qint64 i = 0; i < count; ++i) {
+            out[i] = (out[i] == noData) ? nan : out[i];
+        }
+    }
+
+    return true;
+}
+
+} // namespace Geospatial
+} // namespace DroneMapper
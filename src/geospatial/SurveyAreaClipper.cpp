@@ -0,0 +1,173 @@
+#include "SurveyAreaClipper.h"
+#include "GeoUtils.h"
+#include "core/Tracer.h"
+#include <QElapsedTimer>
+#include <cmath>
+
+namespace DroneMapper {
+namespace Geospatial {
+
+namespace {
+
+constexpr double MIN_CLIPPED_FRACTION = 1e-6;   // Smaller losses are grid snapping, not a zone
+constexpr double EXTENT_SLACK = 1.0;            // Meters added around extents before testing overlap
+
+} // namespace
+
+SurveyAreaClipper::Result SurveyAreaClipper::subtractZones(const QPolygonF& survey,
+                                                           const Core::ZoneDatabase& database,
+                                                           const Options& options)
+{
+    TRACE_SCOPE("geometry", "SurveyAreaClipper::subtractZones");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Result result;
+    if (survey.count() < 3) {
+        return result;
+    }
+
+    const Models::GeospatialCoordinate origin = GeoUtils::calculateCentroid(survey);
+    const QDateTime time = options.time.isValid() ? options.time : QDateTime::currentDateTime();
+    const double buffer = qMax(0.0, options.bufferMeters);
+
+    // Survey polygons are (longitude, latitude)
+    QPolygonF localSurvey;
+    for (const QPointF& vertex : survey) {
+        localSurvey.append(GeoUtils::toCartesian(Models::GeospatialCoordinate(vertex.y(), vertex.x(), 0.0), origin));
+    }
+    result.originalArea = std::abs(PolygonClipper::signedArea(localSurvey));
+
+    PolygonOffsetter::Options offsetOptions;
+    offsetOptions.join = options.join;
+    offsetOptions.arcTolerance = options.toleranceMeters;
+
+    // Inset rings keep their orientation (holes clockwise), so they form one operand
+    QList<QPolygonF> subject = { localSurvey };
+    if (options.insetMeters > 0.0) {
+        subject.clear();
+        for (const PolygonWithHoles& polygon : PolygonOffsetter::offset(localSurvey, -options.insetMeters,
+                                                                        offsetOptions)) {
+            subject.append(polygon.outer);
+            subject.append(polygon.holes);
+        }
+    }
+
+    // Zones the turn overshoot could reach are outlined for the clamp even if they miss the survey
+    const double slack = EXTENT_SLACK + qMax(0.0, options.overshootMeters);
+    const QRectF reach = localSurvey.boundingRect().adjusted(-slack, -slack, slack, slack);
+
+    QList<QPolygonF> zones;
+    QList<QPolygonF> zoneOutlines;
+    QList<QPolygonF> polygonZones;
+    for (const Core::NoFlyZone& zone : database.zones) {
+        if (!applies(zone, options, time)) {
+            continue;
+        }
+
+        if (zone.isCircular()) {
+            const QPointF center = GeoUtils::toCartesian(zone.center, origin);
+            const double radius = zone.radiusMeters + buffer;
+            const QRectF extent(center.x() - radius, center.y() - radius, 2 * radius, 2 * radius);
+            if (radius > 0.0 && reach.intersects(extent)) {
+                zones.append(PolygonClipper::circle(center, radius, options.toleranceMeters));
+                zoneOutlines.append(zones.last());
+                result.candidateZones++;
+            }
+            continue;
+        }
+
+        QPolygonF boundary;
+        for (const QPointF& vertex : zone.boundary) {
+            boundary.append(GeoUtils::toCartesian(Models::GeospatialCoordinate(vertex.y(), vertex.x(), 0.0), origin));
+        }
+        const QRectF extent = boundary.boundingRect().adjusted(-buffer, -buffer, buffer, buffer);
+        if (boundary.count() >= 3 && reach.intersects(extent)) {
+            polygonZones.append(boundary);
+            result.candidateZones++;
+        }
+    }
+
+    // Resolved outlines are needed for the overshoot clamp anyway; holes stay
+    // clockwise, so every ring still goes into the one subtracted operand
+    for (const MultiPolygon& buffered : PolygonOffsetter::offsetAll(polygonZones, buffer, offsetOptions)) {
+        for (const PolygonWithHoles& polygon : buffered) {
+            zones.append(polygon.outer);
+            zones.append(polygon.holes);
+            zoneOutlines.append(polygon.outer);
+        }
+    }
+
+    MultiPolygon remaining;
+    if (!zones.isEmpty() || options.insetMeters > 0.0) {
+        // An inset wider than the survey leaves nothing to subtract from
+        if (!subject.isEmpty()) {
+            remaining = PolygonClipper::compute(subject, zones, PolygonClipper::Operation::Difference);
+        }
+        for (const PolygonWithHoles& polygon : remaining) {
+            result.remainingArea += polygon.area();
+        }
+        result.clipped = result.remainingArea < result.originalArea * (1.0 - MIN_CLIPPED_FRACTION);
+    }
+
+    auto toGeographic = [&origin](const QPolygonF& ring) {
+        QPolygonF geographic;
+        for (const QPointF& point : ring) {
+            const Models::GeospatialCoordinate coord = GeoUtils::fromCartesian(point, origin);
+            geographic.append(QPointF(coord.longitude(), coord.latitude()));
+        }
+        return geographic;
+    };
+
+    for (const QPolygonF& outline : zoneOutlines) {
+        result.zoneOutlines.append(toGeographic(outline));
+    }
+
+    if (!result.clipped) {
+        PolygonWithHoles whole;
+        whole.outer = survey;
+        result.area.append(whole);
+        result.remainingArea = result.originalArea;
+        result.elapsedMs = timer.elapsed();
+        return result;
+    }
+
+    for (const PolygonWithHoles& polygon : remaining) {
+        PolygonWithHoles geographic;
+        geographic.outer = toGeographic(polygon.outer);
+        for (const QPolygonF& hole : polygon.holes) {
+            geographic.holes.append(toGeographic(hole));
+        }
+        result.area.append(geographic);
+    }
+
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
+
+bool SurveyAreaClipper::applies(const Core::NoFlyZone& zone, const Options& options, const QDateTime& time)
+{
+    // Lower enum values are more severe
+    if (static_cast<int>(zone.level) > static_cast<int>(options.minimumLevel)) {
+        return false;
+    }
+    if (!zone.isActive(time)) {
+        return false;
+    }
+
+    // Altitude band, as NoFlyZoneChecker::isInsideZone (0 = unbounded)
+    if (options.altitude >= 0.0) {
+        if (zone.minAltitude > 0.0 && options.altitude < zone.minAltitude) {
+            return false;
+        }
+        if (zone.maxAltitude > 0.0 && options.altitude > zone.maxAltitude) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace Geospatial
+} // namespace DroneMapper
@@ -1,5 +1,6 @@
 #include "FlightPlan.h"
 #include <QUuid>
+#include <algorithm>
 #include <cmath>
 
 namespace DroneMapper {
@@ -10,6 +11,7 @@ FlightPlan::FlightPlan()
     , m_name("New Flight Plan")
     , m_createdDate(QDateTime::currentDateTime())
     , m_modifiedDate(QDateTime::currentDateTime())
+    , m_revision(0)
     , m_patternType(PatternType::Manual)
 {
 }
@@ -19,6 +21,7 @@ FlightPlan::FlightPlan(const QString& name)
     , m_name(name)
     , m_createdDate(QDateTime::currentDateTime())
     , m_modifiedDate(QDateTime::currentDateTime())
+    , m_revision(0)
     , m_patternType(PatternType::Manual)
 {
 }
@@ -26,6 +29,41 @@ FlightPlan::FlightPlan(const QString& name)
 void FlightPlan::addWaypoint(const Waypoint& waypoint)
 {
     m_waypoints.append(waypoint);
+    m_geometry.appended(m_waypoints);
+    m_revision++;
+    m_modifiedDate = QDateTime::currentDateTime();
+}
+
+void FlightPlan::setWaypoint(int index, const Waypoint& waypoint)
+{
+    if (index >= 0 && index < m_waypoints.count()) {
+        m_waypoints[index] = waypoint;
+        m_geometry.changed(m_waypoints, index);
+        m_revision++;
+        m_modifiedDate = QDateTime::currentDateTime();
+    }
+}
+
+void FlightPlan::replaceWaypoints(int start, int removeCount, const QList<Waypoint>& replacement)
+{
+    if (start < 0 || removeCount < 0 || start + removeCount > m_waypoints.count()) {
+        return;
+    }
+
+    m_waypoints.remove(start, removeCount);
+    m_waypoints.insert(start, replacement.count(), Waypoint());
+    std::copy(replacement.cbegin(), replacement.cend(), m_waypoints.begin() + start);
+
+    // Keep numbering of the tail in step with its new positions
+    const int shift = replacement.count() - removeCount;
+    if (shift != 0) {
+        for (int i = start + replacement.count(); i < m_waypoints.count(); ++i) {
+            m_waypoints[i].setWaypointNumber(m_waypoints[i].waypointNumber() + shift);
+        }
+    }
+
+    m_geometry.replaced(m_waypoints, start, removeCount, replacement.count());
+    m_revision++;
     m_modifiedDate = QDateTime::currentDateTime();
 }
 
@@ -33,6 +71,8 @@ void FlightPlan::removeWaypoint(int index)
 {
     if (index >= 0 && index < m_waypoints.count()) {
         m_waypoints.removeAt(index);
+        m_geometry.removed(m_waypoints, index);
+        m_revision++;
         m_modifiedDate = QDateTime::currentDateTime();
     }
 }
@@ -40,36 +80,14 @@ void FlightPlan::removeWaypoint(int index)
 void FlightPlan::clearWaypoints()
 {
     m_waypoints.clear();
+    m_geometry.clear();
+    m_revision++;
     m_modifiedDate = QDateTime::currentDateTime();
 }
 
 double FlightPlan::totalDistance() const
 {
-    if (m_waypoints.count() < 2) {
-        return 0.0;
-    }
-
-    double totalDist = 0.0;
-    for (int i = 0; i < m_waypoints.count() - 1; ++i) {
-        const auto& wp1 = m_waypoints[i].coordinate();
-        const auto& wp2 = m_waypoints[i + 1].coordinate();
-
-        // Haversine formula for distance calculation
-        double lat1 = wp1.latitude() * M_PI / 180.0;
-        double lat2 = wp2.latitude() * M_PI / 180.0;
-        double dLat = (wp2.latitude() - wp1.latitude()) * M_PI / 180.0;
-        double dLon = (wp2.longitude() - wp1.longitude()) * M_PI / 180.0;
-
-        double a = std::sin(dLat/2) * std::sin(dLat/2) +
-                   std::cos(lat1) * std::cos(lat2) *
-                   std::sin(dLon/2) * std::sin(dLon/2);
-        double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1-a));
-        double distance = 6371000 * c; // Earth radius in meters
-
-        totalDist += distance;
-    }
-
-    return totalDist;
+    return m_geometry.totalDistance();
 }
 
 int FlightPlan::estimatedFlightTime() const
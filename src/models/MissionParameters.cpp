@@ -10,6 +10,8 @@ MissionParameters::MissionParameters()
     , m_pathSpacing(50.0)
     , m_flightDirection(0.0)
     , m_reversePath(false)
+    , m_boundaryInset(0.0)
+    , m_turnOvershoot(0.0)
     , m_cameraModel(CameraModel::DJI_Mini3Pro)
     , m_frontOverlap(75.0)
     , m_sideOverlap(65.0)
@@ -0,0 +1,265 @@
+#include "PlanGeometry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace DroneMapper {
+namespace Models {
+
+namespace {
+
+constexpr double EARTH_RADIUS = 6371000.0;  // Meters
+constexpr double DEG_TO_RAD = M_PI / 180.0;
+
+} // namespace
+
+PlanGeometry::PlanGeometry()
+    : m_lastUpdated(0)
+{
+}
+
+void PlanGeometry::rebuild(const QList<Waypoint>& waypoints)
+{
+    m_segments.clear();
+    if (waypoints.count() < 2) {
+        m_lastUpdated = 0;
+        return;
+    }
+
+    m_segments.reserve(waypoints.count() - 1);
+    for (int i = 1; i < waypoints.count(); ++i) {
+        m_segments.append(computeSegment(waypoints[i - 1], waypoints[i]));
+    }
+    for (int i = 0; i < m_segments.size(); ++i) {
+        updateTurn(i);
+    }
+
+    m_lastUpdated = m_segments.size();
+}
+
+void PlanGeometry::appended(const QList<Waypoint>& waypoints)
+{
+    const int count = waypoints.count();
+    if (count < 2 || m_segments.size() != count - 2) {
+        rebuild(waypoints);
+        return;
+    }
+
+    m_segments.append(computeSegment(waypoints[count - 2], waypoints[count - 1]));
+    updateTurn(m_segments.size() - 1);
+    m_lastUpdated = 1;
+}
+
+void PlanGeometry::changed(const QList<Waypoint>& waypoints, int index)
+{
+    if (m_segments.size() != qMax(0, waypoints.count() - 1)) {
+        rebuild(waypoints);
+        return;
+    }
+
+    m_lastUpdated = 0;
+
+    // Legs ending and starting at the waypoint
+    if (index > 0) {
+        m_segments[index - 1] = computeSegment(waypoints[index - 1], waypoints[index]);
+        m_lastUpdated++;
+    }
+    if (index < m_segments.size()) {
+        m_segments[index] = computeSegment(waypoints[index], waypoints[index + 1]);
+        m_lastUpdated++;
+    }
+
+    // Turns at the waypoint and at its neighbours
+    for (int segment = index - 1; segment <= index + 1; ++segment) {
+        if (segment >= 0 && segment < m_segments.size()) {
+            updateTurn(segment);
+        }
+    }
+}
+
+void PlanGeometry::removed(const QList<Waypoint>& waypoints, int index)
+{
+    const int count = waypoints.count();
+    if (count < 2) {
+        clear();
+        return;
+    }
+    if (m_segments.size() != count) {
+        rebuild(waypoints);
+        return;
+    }
+
+    if (index <= 0) {
+        m_segments.removeFirst();
+        m_lastUpdated = 0;
+    } else if (index >= count) {
+        m_segments.removeLast();
+        m_lastUpdated = 0;
+    } else {
+        // Legs (index - 1 -> index) and (index -> index + 1) become one leg
+        m_segments.remove(index);
+        m_segments[index - 1] = computeSegment(waypoints[index - 1], waypoints[index]);
+        m_lastUpdated = 1;
+    }
+
+    for (int segment = index - 1; segment <= index; ++segment) {
+        if (segment >= 0 && segment < m_segments.size()) {
+            updateTurn(segment);
+        }
+    }
+}
+
+void PlanGeometry::replaced(const QList<Waypoint>& waypoints, int start, int removeCount, int insertCount)
+{
+    const int count = waypoints.count();
+    const int oldCount = count - insertCount + removeCount;
+    if (count < 2 || oldCount < 2 || m_segments.size() != oldCount - 1) {
+        rebuild(waypoints);
+        return;
+    }
+
+    // Legs with an end in the range, plus the leg entering it
+    const int first = qMax(0, start - 1);
+    const int oldLast = qMin(oldCount - 2, start + removeCount - 1);
+    const int newLast = qMin(count - 2, start + insertCount - 1);
+
+    QVector<SegmentGeometry> legs;
+    for (int i = first; i <= newLast; ++i) {
+        legs.append(computeSegment(waypoints[i], waypoints[i + 1]));
+    }
+
+    m_segments.remove(first, qMax(0, oldLast - first + 1));
+    m_segments.insert(first, legs.size(), SegmentGeometry());
+    std::copy(legs.cbegin(), legs.cend(), m_segments.begin() + first);
+    m_lastUpdated = legs.size();
+
+    // Turns inside the range and at the first leg after it
+    for (int segment = first; segment <= newLast + 1 && segment < m_segments.size(); ++segment) {
+        updateTurn(segment);
+    }
+}
+
+void PlanGeometry::clear()
+{
+    m_segments.clear();
+    m_lastUpdated = 0;
+}
+
+double PlanGeometry::totalDistance() const
+{
+    double total = 0.0;
+    for (const SegmentGeometry& segment : m_segments) {
+        total += segment.length;
+    }
+    return total;
+}
+
+double PlanGeometry::totalClimb() const
+{
+    double total = 0.0;
+    for (const SegmentGeometry& segment : m_segments) {
+        if (segment.climb > 0.0) {
+            total += segment.climb;
+        }
+    }
+    return total;
+}
+
+double PlanGeometry::totalDescent() const
+{
+    double total = 0.0;
+    for (const SegmentGeometry& segment : m_segments) {
+        if (segment.climb < 0.0) {
+            total -= segment.climb;
+        }
+    }
+    return total;
+}
+
+QVector<double> PlanGeometry::cumulativeDistances() const
+{
+    QVector<double> distances;
+    distances.reserve(m_segments.size() + 1);
+    distances.append(0.0);
+
+    double accumulated = 0.0;
+    for (const SegmentGeometry& segment : m_segments) {
+        accumulated += segment.length;
+        distances.append(accumulated);
+    }
+
+    return distances;
+}
+
+int PlanGeometry::turnCount(double thresholdDegrees) const
+{
+    int turns = 0;
+    for (int i = 1; i < m_segments.size(); ++i) {
+        if (m_segments[i].turnAngle > thresholdDegrees) {
+            turns++;
+        }
+    }
+    return turns;
+}
+
+double PlanGeometry::averageTurnAngle() const
+{
+    if (m_segments.size() < 2) {
+        return 0.0;
+    }
+
+    double total = 0.0;
+    for (int i = 1; i < m_segments.size(); ++i) {
+        total += m_segments[i].turnAngle;
+    }
+    return total / (m_segments.size() - 1);
+}
+
+SegmentGeometry PlanGeometry::computeSegment(const Waypoint& from, const Waypoint& to)
+{
+    const GeospatialCoordinate a = from.coordinate();
+    const GeospatialCoordinate b = to.coordinate();
+
+    const double lat1 = a.latitude() * DEG_TO_RAD;
+    const double lat2 = b.latitude() * DEG_TO_RAD;
+    const double dLat = (b.latitude() - a.latitude()) * DEG_TO_RAD;
+    const double dLon = (b.longitude() - a.longitude()) * DEG_TO_RAD;
+
+    const double cosLat1 = std::cos(lat1);
+    const double cosLat2 = std::cos(lat2);
+    const double sinLat1 = std::sin(lat1);
+    const double sinLat2 = std::sin(lat2);
+
+    // Haversine distance
+    const double sinHalfLat = std::sin(dLat / 2);
+    const double sinHalfLon = std::sin(dLon / 2);
+    const double h = sinHalfLat * sinHalfLat + cosLat1 * cosLat2 * sinHalfLon * sinHalfLon;
+
+    SegmentGeometry segment;
+    segment.length = EARTH_RADIUS * 2 * std::atan2(std::sqrt(h), std::sqrt(1 - h));
+
+    // Initial bearing
+    const double y = std::sin(dLon) * cosLat2;
+    const double x = cosLat1 * sinLat2 - sinLat1 * cosLat2 * std::cos(dLon);
+    segment.bearing = std::fmod(std::atan2(y, x) / DEG_TO_RAD + 360.0, 360.0);
+
+    segment.climb = b.altitude() - a.altitude();
+    segment.turnAngle = 0.0;
+    return segment;
+}
+
+void PlanGeometry::updateTurn(int segment)
+{
+    if (segment == 0) {
+        m_segments[0].turnAngle = 0.0;
+        return;
+    }
+
+    double diff = std::abs(m_segments[segment].bearing - m_segments[segment - 1].bearing);
+    if (diff > 180.0) {
+        diff = 360.0 - diff;
+    }
+    m_segments[segment].turnAngle = diff;
+}
+
+} // namespace Models
+} // namespace DroneMapper
@@ -1,4 +1,5 @@
 #include "COLMAPIntegration.h"
+#include "core/Tracer.h"
 #include <QDir>
 #include <QFileInfo>
 #include <QStandardPaths>
@@ -179,6 +180,8 @@ QString COLMAPIntegration::getCOLMAPVersion()
 
 COLMAPResults COLMAPIntegration::runFullPipeline(const COLMAPConfig& config)
 {
+    TRACE_SCOPE("colmap", "COLMAPIntegration::runFullPipeline");
+
     m_config = config;
     m_results = COLMAPResults();
 
@@ -225,6 +228,8 @@ COLMAPResults COLMAPIntegration::runFullPipeline(const COLMAPConfig& config)
 
 bool COLMAPIntegration::runStage(COLMAPStage stage, const COLMAPConfig& config)
 {
+    TRACE_SCOPE("colmap", "COLMAPIntegration::runStage");
+
     m_config = config;
     m_status.currentStage = stage;
     m_status.stageDescription = getStageDescription(stage);
@@ -1,4 +1,5 @@
 #include "ProcessingQueue.h"
+#include "core/Tracer.h"
 #include <QUuid>
 #include <QElapsedTimer>
 #include <algorithm>
@@ -118,6 +119,10 @@ void JobWorker::resume()
 
 void JobWorker::run()
 {
+    // One async span per job, so concurrent jobs show as separate tracks
+    const quint64 traceId = qHash(m_currentJob.id);
+    TRACE_ASYNC_BEGIN("jobs", "ProcessingJob", traceId);
+
     emit jobStarted(m_currentJob.id);
 
     try {
@@ -138,6 +143,8 @@ void JobWorker::run()
         m_currentJob.errorMessage = "Unknown error occurred";
         emit jobFailed(m_currentJob.id, m_currentJob.errorMessage);
     }
+
+    TRACE_ASYNC_END("jobs", "ProcessingJob", traceId);
 }
 
 void JobWorker::processJob()
@@ -180,6 +187,7 @@ void JobWorker::processJob()
 bool JobWorker::executeJobStep(const QString& step)
 {
     Q_UNUSED(step);
+    TRACE_SCOPE("jobs", "JobWorker::executeJobStep");
 
     // Simplified - actual implementation would call photogrammetry pipeline
     // For now, just simulate work
@@ -569,6 +577,8 @@ void ProcessingQueue::processNextJobs()
         m_workers.append(worker);
         runningCount++;
     }
+
+    TRACE_COUNTER("jobs", "Running jobs", runningCount);
 }
 
 ProcessingJob* ProcessingQueue::findJob(const QString& jobId)
@@ -258,23 +258,58 @@ double QualityEstimator::calculateOverlapScore(
 
 double QualityEstimator::calculateCoverageScore(const Models::FlightPlan& plan)
 {
-    // Check coverage uniformity
-    // Simplified - would analyze waypoint spacing consistency
-    const auto& waypoints = plan.waypoints();
+    // Check coverage uniformity from the cached leg geometry
+    const auto& segments = plan.geometry().segments();
 
-    if (waypoints.count() < 3) {
+    if (segments.count() < 2) {
         return 50.0;
     }
 
-    // Calculate spacing variance
+    // Connector legs sit between two passes flown in opposite directions,
+    // so their lengths are the realised line spacing
     QList<double> spacings;
-    for (int i = 1; i < waypoints.count(); ++i) {
-        // Calculate spacing (simplified)
-        spacings.append(1.0); // Placeholder
+    for (int i = 1; i + 1 < segments.count(); ++i) {
+        double reversal = std::abs(segments[i + 1].bearing - segments[i - 1].bearing);
+        if (reversal > 180.0) {
+            reversal = 360.0 - reversal;
+        }
+        if (reversal > 120.0 && segments[i].turnAngle > 60.0 && segments[i + 1].turnAngle > 60.0) {
+            spacings.append(segments[i].length);
+        }
+    }
+
+    // Patterns without passes (orbits, free paths): use every leg
+    if (spacings.count() < 2) {
+        spacings.clear();
+        for (const auto& segment : segments) {
+            spacings.append(segment.length);
+        }
     }
 
-    // Low variance = high score
-    return 85.0; // Default good score
+    double sum = 0.0;
+    for (double spacing : spacings) {
+        sum += spacing;
+    }
+    double mean = sum / spacings.count();
+    if (mean <= 0.0) {
+        return 50.0;
+    }
+
+    double variance = 0.0;
+    for (double spacing : spacings) {
+        double diff = spacing - mean;
+        variance += diff * diff;
+    }
+    variance /= spacings.count();
+    double cv = std::sqrt(variance) / mean;
+
+    // Low variation = high score
+    if (cv < 0.05) return 100.0;
+    if (cv < 0.10) return 95.0;
+    if (cv < 0.20) return 85.0;
+    if (cv < 0.35) return 70.0;
+    if (cv < 0.50) return 50.0;
+    return 30.0;
 }
 
 double QualityEstimator::calculateAltitudeScore(const Models::FlightPlan& plan)
@@ -0,0 +1,247 @@
+#include "AltitudeProfileEngine.h"
+#include "TerrainElevationViewer.h"
+#include "geospatial/GeoUtils.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int MAX_SAMPLES_PER_LEG = 1 << 20;
+
+} // namespace
+
+size_t qHash(const AltitudeProfileEngine::LegKey& key, size_t seed)
+{
+    return qHashMulti(seed, key.lat0, key.lon0, key.lat1, key.lon1);
+}
+
+AltitudeProfileEngine::AltitudeProfileEngine()
+    : m_dem(nullptr)
+    , m_profileDirty(true)
+    , m_lastResampled(0)
+{
+}
+
+void AltitudeProfileEngine::setDEM(const DEMData* dem)
+{
+    m_dem = dem;
+
+    // Terrain changed under every leg
+    QVector<int> all(m_legs.size());
+    for (int i = 0; i < all.size(); ++i) {
+        all[i] = i;
+    }
+
+    Leg* legs = m_legs.data();
+    QtConcurrent::blockingMap(all, [this, legs](int i) { sampleLeg(legs[i]); });
+
+    m_lastResampled = m_legs.size();
+    m_profileDirty = true;
+}
+
+void AltitudeProfileEngine::setWaypoints(const QList<Models::Waypoint>& waypoints)
+{
+    // Index cached legs by their end positions
+    QHash<LegKey, int> cached;
+    cached.reserve(m_legs.size());
+    for (int i = 0; i < m_legs.size(); ++i) {
+        cached.insert(m_legs[i].key, i);
+    }
+
+    QVector<Leg> legs;
+    QVector<int> stale;
+    legs.reserve(std::max(static_cast<int>(waypoints.size()) - 1, 0));
+
+    for (int i = 0; i + 1 < waypoints.size(); ++i) {
+        const auto a = waypoints[i].coordinate();
+        const auto b = waypoints[i + 1].coordinate();
+
+        Leg leg;
+        leg.key = LegKey{ a.latitude(), a.longitude(), b.latitude(), b.longitude() };
+        leg.startAltitude = a.altitude();
+        leg.endAltitude = b.altitude();
+
+        auto it = cached.constFind(leg.key);
+        if (it != cached.constEnd()) {
+            leg.length = m_legs[it.value()].length;
+            leg.terrain = m_legs[it.value()].terrain;
+        } else {
+            leg.length = Geospatial::GeoUtils::distanceBetween(a, b);
+            stale.append(legs.size());
+        }
+
+        legs.append(leg);
+    }
+
+    // Resample only new or moved legs
+    Leg* legData = legs.data();
+    QtConcurrent::blockingMap(stale, [this, legData](int i) { sampleLeg(legData[i]); });
+
+    m_legs = legs;
+    m_lastResampled = stale.size();
+    m_profileDirty = true;
+}
+
+const QVector<ProfilePoint>& AltitudeProfileEngine::profile()
+{
+    if (!m_profileDirty) {
+        return m_profile;
+    }
+
+    m_profile.clear();
+
+    int total = 0;
+    for (const auto& leg : m_legs) {
+        total += leg.terrain.size();
+    }
+    m_profile.reserve(total);
+
+    double start = 0.0;
+    for (const auto& leg : m_legs) {
+        const int n = leg.terrain.size();
+        if (n == 0) {
+            start += leg.length;
+            continue;
+        }
+
+        // Straight flight between the waypoints' MSL heights
+        const double startGround = std::isnan(leg.terrain.first()) ? 0.0 : leg.terrain.first();
+        const double endGround = std::isnan(leg.terrain.last()) ? 0.0 : leg.terrain.last();
+        const double startMSL = startGround + leg.startAltitude;
+        const double endMSL = endGround + leg.endAltitude;
+
+        // Skip the first sample of later legs (it repeats the previous end)
+        for (int i = m_profile.isEmpty() ? 0 : 1; i < n; ++i) {
+            const double t = (n > 1) ? static_cast<double>(i) / (n - 1) : 0.0;
+            const double terrain = leg.terrain[i];
+            const double flightMSL = startMSL + (endMSL - startMSL) * t;
+
+            ProfilePoint point;
+            point.distance = start + leg.length * t;
+            point.terrainElevation = terrain;
+            point.flightAltitude = flightMSL - terrain;
+            m_profile.append(point);
+        }
+
+        start += leg.length;
+    }
+
+    m_profileDirty = false;
+    return m_profile;
+}
+
+QVector<ProfileColumn> AltitudeProfileEngine::decimate(int columns)
+{
+    const QVector<ProfilePoint>& points = profile();
+    QVector<ProfileColumn> result;
+
+    if (columns <= 0 || points.isEmpty()) {
+        return result;
+    }
+
+    const double inf = std::numeric_limits<double>::infinity();
+    result.fill(ProfileColumn{ inf, -inf, inf, -inf, inf, false }, columns);
+
+    const double length = std::max(points.last().distance, 1e-9);
+
+    for (const auto& point : points) {
+        if (std::isnan(point.terrainElevation)) {
+            continue;
+        }
+
+        int c = std::min(static_cast<int>(point.distance / length * columns), columns - 1);
+        ProfileColumn& column = result[c];
+        const double flight = point.terrainElevation + point.flightAltitude;
+
+        column.minTerrain = std::min(column.minTerrain, point.terrainElevation);
+        column.maxTerrain = std::max(column.maxTerrain, point.terrainElevation);
+        column.minFlight = std::min(column.minFlight, flight);
+        column.maxFlight = std::max(column.maxFlight, flight);
+        column.minClearance = std::min(column.minClearance, point.flightAltitude);
+        column.valid = true;
+    }
+
+    return result;
+}
+
+QVector<double> AltitudeProfileEngine::waypointDistances() const
+{
+    QVector<double> distances;
+    distances.reserve(m_legs.size() + 1);
+
+    double distance = 0.0;
+    distances.append(distance);
+    for (const auto& leg : m_legs) {
+        distance += leg.length;
+        distances.append(distance);
+    }
+
+    return distances;
+}
+
+double AltitudeProfileEngine::totalDistance() const
+{
+    double distance = 0.0;
+    for (const auto& leg : m_legs) {
+        distance += leg.length;
+    }
+    return distance;
+}
+
+void AltitudeProfileEngine::sampleLeg(Leg& leg) const
+{
+    leg.terrain.clear();
+
+    if (!m_dem || m_dem->width < 2 || m_dem->height < 2 ||
+        m_dem->elevations.size() < m_dem->width * m_dem->height) {
+        // No DEM: flat terrain at sea level, endpoints only
+        leg.terrain.fill(0.0f, 2);
+        return;
+    }
+
+    // One sample per DEM cell along the leg
+    const double spacing = m_dem->resolution > 0.0 ? m_dem->resolution : 1.0;
+    const int n = std::clamp(static_cast<int>(std::ceil(leg.length / spacing)) + 1,
+                             2, MAX_SAMPLES_PER_LEG);
+    leg.terrain.resize(n);
+
+    const LegKey& k = leg.key;
+    for (int i = 0; i < n; ++i) {
+        const double t = static_cast<double>(i) / (n - 1);
+        leg.terrain[i] = sampleTerrain(k.lat0 + (k.lat1 - k.lat0) * t,
+                                       k.lon0 + (k.lon1 - k.lon0) * t);
+    }
+}
+
+float AltitudeProfileEngine::sampleTerrain(double latitude, double longitude) const
+{
+    const DEMData& dem = *m_dem;
+
+    double col = (longitude - dem.topLeft.longitude()) /
+                 (dem.bottomRight.longitude() - dem.topLeft.longitude()) * (dem.width - 1);
+    double row = (dem.topLeft.latitude() - latitude) /
+                 (dem.topLeft.latitude() - dem.bottomRight.latitude()) * (dem.height - 1);
+
+    if (!(col >= 0.0 && row >= 0.0 && col <= dem.width - 1 && row <= dem.height - 1)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    int x0 = std::min(static_cast<int>(col), dem.width - 2);
+    int y0 = std::min(static_cast<int>(row), dem.height - 2);
+    float fx = static_cast<float>(col - x0);
+    float fy = static_cast<float>(row - y0);
+
+    const float* e = dem.elevations.constData() + y0 * dem.width + x0;
+    float top = e[0] + (e[1] - e[0]) * fx;
+    float bottom = e[dem.width] + (e[dem.width + 1] - e[dem.width]) * fx;
+
+    return top + (bottom - top) * fy;
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -0,0 +1,152 @@
+#include "CloudComparator.h"
+#include "NormalEstimator.h"
+#include "PointCloudKDTree.h"
+#include "PointCloudViewer.h"
+#include "Logger.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <QElapsedTimer>
+#include <QPair>
+#include <cmath>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int MAX_NEIGHBORS = 64;
+
+} // namespace
+
+CloudComparator::Result CloudComparator::compare(
+    const PointCloud& reference, PointCloud& compared, const Options& options,
+    const std::atomic<bool>* cancelled)
+{
+    Result result;
+
+    if (reference.isEmpty() || compared.isEmpty()) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    PointCloudKDTree tree;
+    tree.build(reference);
+
+    qint64 buildMs = timer.elapsed();
+
+    QVector<float> computed = computeDistances(reference, tree, compared, options, cancelled);
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+        return result;
+    }
+
+    compared.scalarField = computed;
+    compared.scalarFieldName = (options.method == LocalPlane)
+        ? QStringLiteral("M3C2 distance")
+        : QStringLiteral("C2C distance");
+
+    // Statistics (serial pass, cheap next to the queries)
+    const QVector<float>& distances = compared.scalarField;
+    double sum = 0.0;
+    double sumSq = 0.0;
+    result.minDistance = distances.first();
+    result.maxDistance = distances.first();
+
+    for (float d : distances) {
+        result.minDistance = std::min(result.minDistance, d);
+        result.maxDistance = std::max(result.maxDistance, d);
+        sum += d;
+        sumSq += static_cast<double>(d) * d;
+    }
+
+    result.pointCount = distances.size();
+    result.meanDistance = sum / distances.size();
+    result.rmsDistance = std::sqrt(sumSq / distances.size());
+    result.elapsedMs = timer.elapsed();
+
+    LOG_INFO(QString("Cloud comparison: %1 vs %2 points, mean %3 m, RMS %4 m in %5 ms (KD-tree %6 ms)")
+        .arg(compared.size())
+        .arg(reference.size())
+        .arg(result.meanDistance, 0, 'f', 3)
+        .arg(result.rmsDistance, 0, 'f', 3)
+        .arg(result.elapsedMs)
+        .arg(buildMs));
+
+    return result;
+}
+
+QVector<float> CloudComparator::computeDistances(
+    const PointCloud& reference,
+    const PointCloudKDTree& tree,
+    const PointCloud& compared,
+    const Options& options,
+    const std::atomic<bool>* cancelled)
+{
+    QVector<float> distances(compared.size(), 0.0f);
+
+    if (tree.isEmpty() || compared.isEmpty()) {
+        return distances;
+    }
+
+    const int k = (options.method == LocalPlane)
+        ? std::clamp(options.neighbors, 3, MAX_NEIGHBORS)
+        : 1;
+    const float limit = options.maxDistance;
+    const Point* refPoints = reference.points.constData();
+    const Point* points = compared.points.constData();
+    float* out = distances.data();
+
+    QVector<QPair<int, int>> chunks;
+    const int chunkSize = std::max(options.chunkSize, 1);
+    for (int begin = 0; begin < compared.size(); begin += chunkSize) {
+        chunks.append(qMakePair(begin, std::min(begin + chunkSize, compared.size())));
+    }
+
+    QtConcurrent::blockingMap(chunks, [&, refPoints, points, out, k, limit](const QPair<int, int>& chunk) {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        int indices[MAX_NEIGHBORS];
+        float distancesSq[MAX_NEIGHBORS];
+        QVector3D neighbors[MAX_NEIGHBORS];
+
+        for (int i = chunk.first; i < chunk.second; ++i) {
+            const QVector3D& position = points[i].position;
+            int found = tree.knn(position, k, indices, distancesSq);
+
+            float distance = 0.0f;
+
+            if (found > 0 && k == 1) {
+                distance = std::sqrt(distancesSq[0]);
+            } else if (found > 0) {
+                // Signed distance to the plane through the neighbour centroid
+                QVector3D centroid(0, 0, 0);
+                for (int n = 0; n < found; ++n) {
+                    neighbors[n] = refPoints[indices[n]].position;
+                    centroid += neighbors[n];
+                }
+                centroid /= static_cast<float>(found);
+
+                QVector3D normal = NormalEstimator::fitNormal(neighbors, found, options.up);
+                if (QVector3D::dotProduct(normal, options.up) < 0.0f) {
+                    normal = -normal;
+                }
+
+                distance = QVector3D::dotProduct(position - centroid, normal);
+            }
+
+            if (limit > 0.0f) {
+                distance = std::clamp(distance, -limit, limit);
+            }
+
+            out[i] = distance;
+        }
+    });
+
+    return distances;
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -0,0 +1,426 @@
+#include "ContourGenerator.h"
+#include "TerrainElevationViewer.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <QHash>
+#include <QPair>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <cmath>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+/**
+ * @brief Contour segment between two grid edges
+ *
+ * Only edge keys are stored; crossing points are recomputed from the
+ * key during stitching, which keeps the segment buffer small.
+ * Key = 2 * (row * width + col) + (0 = horizontal edge, 1 = vertical edge).
+ */
+struct Segment {
+    quint64 keyA;
+    quint64 keyB;
+    int level;
+};
+
+inline quint64 horizontalEdge(int x, int y, int width)
+{
+    return 2ULL * (static_cast<quint64>(y) * width + x);
+}
+
+inline quint64 verticalEdge(int x, int y, int width)
+{
+    return 2ULL * (static_cast<quint64>(y) * width + x) + 1ULL;
+}
+
+QPointF edgePoint(const DEMData& dem, quint64 key, float level)
+{
+    quint64 cell = key >> 1;
+    int x = static_cast<int>(cell % dem.width);
+    int y = static_cast<int>(cell / dem.width);
+    const float* e = dem.elevations.constData();
+
+    float va = e[y * dem.width + x];
+    if (key & 1ULL) {
+        float vb = e[(y + 1) * dem.width + x];
+        return QPointF(x, y + (level - va) / (vb - va));
+    }
+
+    float vb = e[y * dem.width + x + 1];
+    return QPointF(x + (level - va) / (vb - va), y);
+}
+
+/**
+ * @brief Marching squares over one tile of cells
+ */
+void marchTile(const DEMData& dem, const QVector<float>& levels,
+               int x0, int y0, int x1, int y1, QVector<Segment>& out)
+{
+    const int w = dem.width;
+    const float* e = dem.elevations.constData();
+
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            float v0 = e[y * w + x];
+            float v1 = e[y * w + x + 1];
+            float v2 = e[(y + 1) * w + x + 1];
+            float v3 = e[(y + 1) * w + x];
+
+            if (std::isnan(v0) || std::isnan(v1) || std::isnan(v2) || std::isnan(v3)) {
+                continue;  // No-data cell
+            }
+
+            float cmin = std::min(std::min(v0, v1), std::min(v2, v3));
+            float cmax = std::max(std::max(v0, v1), std::max(v2, v3));
+
+            // Levels L with cmin < L <= cmax cross this cell
+            auto first = std::upper_bound(levels.cbegin(), levels.cend(), cmin);
+            auto last = std::upper_bound(first, levels.cend(), cmax);
+
+            const quint64 e0 = horizontalEdge(x, y, w);          // v0-v1
+            const quint64 e1 = verticalEdge(x + 1, y, w);        // v1-v2
+            const quint64 e2 = horizontalEdge(x, y + 1, w);      // v3-v2
+            const quint64 e3 = verticalEdge(x, y, w);            // v0-v3
+
+            for (auto it = first; it != last; ++it) {
+                const float level = *it;
+                const int li = static_cast<int>(it - levels.cbegin());
+                int code = (v0 >= level ? 1 : 0) | (v1 >= level ? 2 : 0) |
+                           (v2 >= level ? 4 : 0) | (v3 >= level ? 8 : 0);
+
+                auto addSegment = [&out, li](quint64 a, quint64 b) {
+                    out.append(Segment{a, b, li});
+                };
+
+                switch (code) {
+                case 1: case 14: addSegment(e3, e0); break;
+                case 2: case 13: addSegment(e0, e1); break;
+                case 3: case 12: addSegment(e3, e1); break;
+                case 4: case 11: addSegment(e1, e2); break;
+                case 6: case 9:  addSegment(e0, e2); break;
+                case 7: case 8:  addSegment(e3, e2); break;
+                case 5:
+                case 10: {
+                    // Saddle: the centre value decides which corners connect
+                    bool centreAbove = (v0 + v1 + v2 + v3) * 0.25f >= level;
+                    if ((code == 5) == centreAbove) {
+                        addSegment(e0, e1);
+                        addSegment(e2, e3);
+                    } else {
+                        addSegment(e3, e0);
+                        addSegment(e1, e2);
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Join one level's segments into polylines via shared edge keys
+ */
+QVector<ContourLine> stitchLevel(const DEMData& dem, const QVector<Segment>& segments, float level)
+{
+    QVector<ContourLine> lines;
+
+    // Each interior edge crossing is shared by exactly two segments
+    QHash<quint64, QPair<int, int>> byEdge;
+    byEdge.reserve(segments.size() * 2);
+
+    auto link = [&byEdge](quint64 key, int segment) {
+        auto it = byEdge.find(key);
+        if (it == byEdge.end()) {
+            byEdge.insert(key, qMakePair(segment, -1));
+        } else {
+            it->second = segment;
+        }
+    };
+
+    for (int i = 0; i < segments.size(); ++i) {
+        link(segments[i].keyA, i);
+        link(segments[i].keyB, i);
+    }
+
+    QVector<char> used(segments.size(), 0);
+
+    // Walk from `key` away from `current`, appending crossing keys
+    auto walk = [&](int current, quint64 key, QVector<quint64>& keys) {
+        for (;;) {
+            const QPair<int, int> owners = byEdge.value(key, qMakePair(-1, -1));
+            int next = (owners.first == current) ? owners.second : owners.first;
+            if (next < 0 || used[next]) {
+                return;
+            }
+            used[next] = 1;
+            key = (segments[next].keyA == key) ? segments[next].keyB : segments[next].keyA;
+            keys.append(key);
+            current = next;
+        }
+    };
+
+    for (int i = 0; i < segments.size(); ++i) {
+        if (used[i]) {
+            continue;
+        }
+        used[i] = 1;
+
+        QVector<quint64> forward;
+        QVector<quint64> backward;
+        forward.append(segments[i].keyB);
+        walk(i, segments[i].keyB, forward);
+        walk(i, segments[i].keyA, backward);
+
+        ContourLine line;
+        line.elevation = level;
+        line.points.reserve(backward.size() + forward.size() + 1);
+
+        for (int k = backward.size() - 1; k >= 0; --k) {
+            line.points.append(edgePoint(dem, backward[k], level));
+        }
+        line.points.append(edgePoint(dem, segments[i].keyA, level));
+        for (quint64 key : forward) {
+            line.points.append(edgePoint(dem, key, level));
+        }
+
+        // A ring walks back onto its first crossing; drop the duplicate
+        quint64 startKey = backward.isEmpty() ? segments[i].keyA : backward.last();
+        line.closed = forward.size() > 1 && forward.last() == startKey;
+        if (line.closed) {
+            line.points.removeLast();
+        }
+
+        lines.append(line);
+    }
+
+    return lines;
+}
+
+double perpendicularDistance(const QPointF& p, const QPointF& a, const QPointF& b)
+{
+    double dx = b.x() - a.x();
+    double dy = b.y() - a.y();
+    double lengthSq = dx * dx + dy * dy;
+
+    if (lengthSq <= 0.0) {
+        return std::hypot(p.x() - a.x(), p.y() - a.y());
+    }
+
+    return std::abs(dy * p.x() - dx * p.y() + b.x() * a.y() - b.y() * a.x()) / std::sqrt(lengthSq);
+}
+
+} // namespace
+
+QVector<ContourLine> ContourGenerator::generate(const DEMData& dem, double interval, const Options& options)
+{
+    QVector<float> levels;
+
+    if (interval <= 0.0 || dem.elevations.isEmpty()) {
+        return QVector<ContourLine>();
+    }
+
+    double first = std::ceil(dem.minElevation / interval) * interval;
+    for (double level = first; level <= dem.maxElevation; level += interval) {
+        levels.append(static_cast<float>(level));
+    }
+
+    return generateLevels(dem, levels, options);
+}
+
+QVector<ContourLine> ContourGenerator::generateLevels(const DEMData& dem, const QVector<float>& levels,
+                                                      const Options& options)
+{
+    QVector<ContourLine> result;
+
+    if (levels.isEmpty() || dem.width < 2 || dem.height < 2 ||
+        dem.elevations.size() < dem.width * dem.height) {
+        return result;
+    }
+
+    // Marching squares per tile, in parallel
+    const int tileSize = std::max(options.tileSize, 16);
+    const int cellsX = dem.width - 1;
+    const int cellsY = dem.height - 1;
+    const int tilesX = (cellsX + tileSize - 1) / tileSize;
+    const int tilesY = (cellsY + tileSize - 1) / tileSize;
+
+    QVector<QVector<Segment>> tileSegments(tilesX * tilesY);
+    QVector<int> tileIds(tilesX * tilesY);
+    for (int t = 0; t < tileIds.size(); ++t) {
+        tileIds[t] = t;
+    }
+
+    QVector<Segment>* tileOut = tileSegments.data();
+    QtConcurrent::blockingMap(tileIds, [&, tileOut](int tile) {
+        int tx = tile % tilesX;
+        int ty = tile / tilesX;
+        int x0 = tx * tileSize;
+        int y0 = ty * tileSize;
+        marchTile(dem, levels, x0, y0,
+                  std::min(x0 + tileSize, cellsX), std::min(y0 + tileSize, cellsY),
+                  tileOut[tile]);
+    });
+
+    // Bucket by level, then stitch and post-process levels in parallel
+    QVector<QVector<Segment>> levelSegments(levels.size());
+    for (const auto& segments : tileSegments) {
+        for (const auto& segment : segments) {
+            levelSegments[segment.level].append(segment);
+        }
+    }
+    tileSegments.clear();
+
+    QVector<QVector<ContourLine>> levelLines(levels.size());
+    QVector<int> levelIds(levels.size());
+    for (int i = 0; i < levels.size(); ++i) {
+        levelIds[i] = i;
+    }
+
+    const QVector<Segment>* segmentsIn = levelSegments.constData();
+    QVector<ContourLine>* linesOut = levelLines.data();
+    QtConcurrent::blockingMap(levelIds, [&, segmentsIn, linesOut](int li) {
+        QVector<ContourLine> lines = stitchLevel(dem, segmentsIn[li], levels[li]);
+
+        for (auto& line : lines) {
+            if (options.smoothIterations > 0) {
+                line.points = smooth(line.points, line.closed, options.smoothIterations);
+            }
+            if (options.simplifyTolerance > 0.0) {
+                line.points = simplify(line.points, options.simplifyTolerance);
+            }
+        }
+
+        linesOut[li] = lines;
+    });
+
+    for (const auto& lines : levelLines) {
+        result += lines;
+    }
+
+    return result;
+}
+
+QJsonDocument ContourGenerator::toGeoJson(const QVector<ContourLine>& lines, const DEMData& dem)
+{
+    QJsonObject featureCollection;
+    featureCollection["type"] = "FeatureCollection";
+
+    const double lon0 = dem.topLeft.longitude();
+    const double lat0 = dem.topLeft.latitude();
+    const double dLon = (dem.bottomRight.longitude() - lon0) / std::max(dem.width - 1, 1);
+    const double dLat = (lat0 - dem.bottomRight.latitude()) / std::max(dem.height - 1, 1);
+
+    QJsonArray features;
+    for (const auto& line : lines) {
+        QJsonArray coordinates;
+        for (const auto& p : line.points) {
+            QJsonArray coord;
+            coord.append(lon0 + p.x() * dLon);
+            coord.append(lat0 - p.y() * dLat);
+            coordinates.append(coord);
+        }
+        if (line.closed && !line.points.isEmpty()) {
+            coordinates.append(coordinates.first());
+        }
+
+        QJsonObject geometry;
+        geometry["type"] = "LineString";
+        geometry["coordinates"] = coordinates;
+
+        QJsonObject properties;
+        properties["elevation"] = line.elevation;
+
+        QJsonObject feature;
+        feature["type"] = "Feature";
+        feature["geometry"] = geometry;
+        feature["properties"] = properties;
+        features.append(feature);
+    }
+
+    featureCollection["features"] = features;
+    return QJsonDocument(featureCollection);
+}
+
+QVector<QPointF> ContourGenerator::smooth(const QVector<QPointF>& points, bool closed, int iterations)
+{
+    QVector<QPointF> current = points;
+
+    for (int pass = 0; pass < iterations && current.size() >= 3; ++pass) {
+        QVector<QPointF> next;
+        next.reserve(current.size() * 2);
+
+        int count = current.size();
+        int segments = closed ? count : count - 1;
+
+        if (!closed) {
+            next.append(current.first());
+        }
+
+        for (int i = 0; i < segments; ++i) {
+            const QPointF& a = current[i];
+            const QPointF& b = current[(i + 1) % count];
+            next.append(a * 0.75 + b * 0.25);
+            next.append(a * 0.25 + b * 0.75);
+        }
+
+        if (!closed) {
+            next.append(current.last());
+        }
+
+        current = next;
+    }
+
+    return current;
+}
+
+QVector<QPointF> ContourGenerator::simplify(const QVector<QPointF>& points, double tolerance)
+{
+    if (points.size() < 3) {
+        return points;
+    }
+
+    QVector<char> keep(points.size(), 0);
+    keep[0] = 1;
+    keep[points.size() - 1] = 1;
+
+    // Iterative Douglas-Peucker (long contours would overflow recursion)
+    QVector<QPair<int, int>> stack;
+    stack.append(qMakePair(0, points.size() - 1));
+
+    while (!stack.isEmpty()) {
+        QPair<int, int> range = stack.takeLast();
+        double maxDistance = 0.0;
+        int index = -1;
+
+        for (int i = range.first + 1; i < range.second; ++i) {
+            double d = perpendicularDistance(points[i], points[range.first], points[range.second]);
+            if (d > maxDistance) {
+                maxDistance = d;
+                index = i;
+            }
+        }
+
+        if (index >= 0 && maxDistance > tolerance) {
+            keep[index] = 1;
+            stack.append(qMakePair(range.first, index));
+            stack.append(qMakePair(index, range.second));
+        }
+    }
+
+    QVector<QPointF> result;
+    for (int i = 0; i < points.size(); ++i) {
+        if (keep[i]) {
+            result.append(points[i]);
+        }
+    }
+    return result;
+}
+
+} // namespace UI
+} // namespace DroneMapper
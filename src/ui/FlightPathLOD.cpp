@@ -0,0 +1,299 @@
+#include "FlightPathLOD.h"
+#include <QHash>
+#include <QtConcurrent/QtConcurrentMap>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr double TILE_SIZE = 256.0;
+constexpr double AREA_PIXELS = 0.5;     // Vertices below this area (px^2) are dropped
+constexpr double CLUSTER_PIXELS = 40.0; // Cluster grid cell size (px)
+constexpr double VIEW_PADDING = 0.5;    // Extra viewport fraction on every side
+constexpr double MAX_LATITUDE = 85.05112878;
+
+double pixelSize(int zoom)
+{
+    return 1.0 / (TILE_SIZE * std::ldexp(1.0, zoom));
+}
+
+double mercatorX(double longitude)
+{
+    return (longitude + 180.0) / 360.0;
+}
+
+double mercatorY(double latitude)
+{
+    const double lat = std::clamp(latitude, -MAX_LATITUDE, MAX_LATITUDE) * M_PI / 180.0;
+    return (1.0 - std::log(std::tan(lat) + 1.0 / std::cos(lat)) / M_PI) / 2.0;
+}
+
+} // namespace
+
+FlightPathLOD::FlightPathLOD()
+{
+}
+
+void FlightPathLOD::clear()
+{
+    m_path.clear();
+    m_x.clear();
+    m_y.clear();
+    m_levels.clear();
+    m_clusters.clear();
+    m_bounds = QRectF();
+}
+
+void FlightPathLOD::build(const QVector<double>& path)
+{
+    clear();
+
+    const int n = path.size() / 3;
+    if (n == 0) {
+        return;
+    }
+
+    m_path = path;
+    m_x.resize(n);
+    m_y.resize(n);
+
+    double west = std::numeric_limits<double>::max();
+    double east = std::numeric_limits<double>::lowest();
+    double south = west;
+    double north = east;
+
+    for (int i = 0; i < n; ++i) {
+        const double lon = path[i * 3];
+        const double lat = path[i * 3 + 1];
+        m_x[i] = mercatorX(lon);
+        m_y[i] = mercatorY(lat);
+        west = std::min(west, lon);
+        east = std::max(east, lon);
+        south = std::min(south, lat);
+        north = std::max(north, lat);
+    }
+    m_bounds = QRectF(QPointF(west, south), QPointF(east, north));
+
+    // Route hierarchy: one threshold per zoom, levels share data when nothing is dropped
+    const QVector<double> area = significance();
+
+    QVector<int> all(n);
+    for (int i = 0; i < n; ++i) {
+        all[i] = i;
+    }
+
+    m_levels.resize(MAX_ZOOM + 1);
+    m_clusters.resize(MAX_ZOOM + 1);
+
+    QVector<int> zooms(MAX_ZOOM + 1);
+    for (int z = 0; z <= MAX_ZOOM; ++z) {
+        zooms[z] = z;
+    }
+
+    QVector<int>* levels = m_levels.data();
+    QVector<Cluster>* clusters = m_clusters.data();
+    const double* areas = area.constData();
+
+    QtConcurrent::blockingMap(zooms, [this, n, &all, levels, clusters, areas](int z) {
+        const double pixel = pixelSize(z);
+        const double threshold = AREA_PIXELS * pixel * pixel;
+
+        QVector<int> kept;
+        for (int i = 0; i < n; ++i) {
+            if (areas[i] >= threshold) {
+                kept.append(i);
+            }
+        }
+        levels[z] = (kept.size() == n) ? all : kept;
+
+        clusters[z] = clusterLevel(z);
+    });
+}
+
+QVector<double> FlightPathLOD::significance() const
+{
+    // Visvalingam-Whyatt: repeatedly drop the vertex with the smallest
+    // triangle area; a vertex's significance is the area when it was dropped
+    const int n = m_x.size();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    QVector<double> area(n, inf);
+    if (n < 3) {
+        return area;
+    }
+
+    QVector<int> prev(n);
+    QVector<int> next(n);
+    QVector<double> current(n, inf);
+
+    auto triangle = [this](int a, int b, int c) {
+        return std::abs((m_x[b] - m_x[a]) * (m_y[c] - m_y[a]) -
+                        (m_x[c] - m_x[a]) * (m_y[b] - m_y[a])) * 0.5;
+    };
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+    for (int i = 0; i < n; ++i) {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+    }
+    for (int i = 1; i < n - 1; ++i) {
+        current[i] = triangle(i - 1, i, i + 1);
+        heap.push({ current[i], i });
+    }
+
+    double lastArea = 0.0;
+    while (!heap.empty()) {
+        auto [value, i] = heap.top();
+        heap.pop();
+
+        // Stale entry from before a neighbour was removed
+        if (value != current[i] || area[i] != inf) {
+            continue;
+        }
+
+        // Never let significance decrease, so coarser levels stay nested
+        lastArea = std::max(lastArea, value);
+        area[i] = lastArea;
+
+        const int p = prev[i];
+        const int q = next[i];
+        next[p] = q;
+        prev[q] = p;
+
+        if (p > 0) {
+            current[p] = triangle(prev[p], p, q);
+            heap.push({ current[p], p });
+        }
+        if (q < n - 1) {
+            current[q] = triangle(p, q, next[q]);
+            heap.push({ current[q], q });
+        }
+    }
+
+    return area;
+}
+
+QVector<FlightPathLOD::Cluster> FlightPathLOD::clusterLevel(int zoom) const
+{
+    const double cell = CLUSTER_PIXELS * pixelSize(zoom);
+    const int n = m_x.size();
+
+    QVector<Cluster> clusters;
+    QHash<quint64, int> cells;
+
+    for (int i = 0; i < n; ++i) {
+        const quint64 cx = static_cast<quint32>(m_x[i] / cell);
+        const quint64 cy = static_cast<quint32>(m_y[i] / cell);
+        const quint64 key = (cx << 32) | cy;
+
+        auto it = cells.find(key);
+        if (it == cells.end()) {
+            cells.insert(key, clusters.size());
+            clusters.append(Cluster{ m_path[i * 3], m_path[i * 3 + 1], m_x[i], m_y[i], 1, i });
+        } else {
+            // Running sums, turned into centroids below
+            Cluster& cluster = clusters[it.value()];
+            cluster.longitude += m_path[i * 3];
+            cluster.latitude += m_path[i * 3 + 1];
+            cluster.x += m_x[i];
+            cluster.y += m_y[i];
+            ++cluster.count;
+        }
+    }
+
+    for (auto& cluster : clusters) {
+        cluster.longitude /= cluster.count;
+        cluster.latitude /= cluster.count;
+        cluster.x /= cluster.count;
+        cluster.y /= cluster.count;
+    }
+
+    return clusters;
+}
+
+FlightPathLOD::View FlightPathLOD::query(double zoom, double west, double south,
+                                         double east, double north) const
+{
+    View view;
+    if (m_levels.isEmpty()) {
+        return view;
+    }
+
+    const int z = std::clamp(static_cast<int>(std::floor(zoom)), 0, MAX_ZOOM);
+
+    // Padded viewport in Web Mercator (y grows southwards)
+    double x0 = mercatorX(west);
+    double x1 = mercatorX(east);
+    double y0 = mercatorY(north);
+    double y1 = mercatorY(south);
+    const double padX = (x1 - x0) * VIEW_PADDING;
+    const double padY = (y1 - y0) * VIEW_PADDING;
+    x0 -= padX;
+    x1 += padX;
+    y0 -= padY;
+    y1 += padY;
+
+    auto inside = [&](double x, double y) {
+        return x >= x0 && x <= x1 && y >= y0 && y <= y1;
+    };
+
+    // Route: keep every segment whose bounding box touches the viewport
+    const QVector<int>& level = m_levels[z];
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    bool inRun = false;
+
+    for (int k = 0; k + 1 < level.size(); ++k) {
+        const int a = level[k];
+        const int b = level[k + 1];
+
+        const bool visible = std::max(m_x[a], m_x[b]) >= x0 && std::min(m_x[a], m_x[b]) <= x1 &&
+                             std::max(m_y[a], m_y[b]) >= y0 && std::min(m_y[a], m_y[b]) <= y1;
+        if (!visible) {
+            inRun = false;
+            continue;
+        }
+
+        if (!inRun) {
+            if (!view.route.isEmpty()) {
+                view.route.append(nan);
+                view.route.append(nan);
+            }
+            view.route.append(m_path[a * 3]);
+            view.route.append(m_path[a * 3 + 1]);
+            inRun = true;
+        }
+        view.route.append(m_path[b * 3]);
+        view.route.append(m_path[b * 3 + 1]);
+    }
+
+    // Waypoints: singletons as themselves, the rest as clusters
+    for (const auto& cluster : m_clusters[z]) {
+        if (!inside(cluster.x, cluster.y)) {
+            continue;
+        }
+
+        if (cluster.count == 1) {
+            const int i = cluster.firstIndex;
+            view.waypoints.append(m_path[i * 3]);
+            view.waypoints.append(m_path[i * 3 + 1]);
+            view.waypoints.append(m_path[i * 3 + 2]);
+            view.waypoints.append(i);
+        } else {
+            view.clusters.append(cluster.longitude);
+            view.clusters.append(cluster.latitude);
+            view.clusters.append(cluster.count);
+        }
+    }
+
+    return view;
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -0,0 +1,292 @@
+#include "GroundClassifier.h"
+#include "PointCloudViewer.h"
+#include "Logger.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <QElapsedTimer>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr float EMPTY_CELL = std::numeric_limits<float>::max();
+
+/**
+ * @brief Separable running min/max over rows then columns
+ */
+template <typename Op>
+QVector<float> filterWindow(const QVector<float>& grid, int cols, int rows, int radius, Op op)
+{
+    QVector<float> rowPass(grid.size());
+    QVector<float> result(grid.size());
+
+    for (int r = 0; r < rows; ++r) {
+        const float* in = grid.constData() + r * cols;
+        float* out = rowPass.data() + r * cols;
+        for (int c = 0; c < cols; ++c) {
+            int c0 = std::max(0, c - radius);
+            int c1 = std::min(cols - 1, c + radius);
+            float v = in[c0];
+            for (int k = c0 + 1; k <= c1; ++k) {
+                v = op(v, in[k]);
+            }
+            out[c] = v;
+        }
+    }
+
+    for (int r = 0; r < rows; ++r) {
+        int r0 = std::max(0, r - radius);
+        int r1 = std::min(rows - 1, r + radius);
+        float* out = result.data() + r * cols;
+        for (int c = 0; c < cols; ++c) {
+            float v = rowPass[r0 * cols + c];
+            for (int k = r0 + 1; k <= r1; ++k) {
+                v = op(v, rowPass[k * cols + c]);
+            }
+            out[c] = v;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Fill empty raster cells by linear interpolation along rows,
+ *        then along columns for rows that had no data at all
+ */
+void fillEmptyCells(QVector<float>& grid, int cols, int rows)
+{
+    auto fillLine = [](float* line, int count, int stride) {
+        int previous = -1;
+        for (int i = 0; i < count; ++i) {
+            if (line[i * stride] == EMPTY_CELL) {
+                continue;
+            }
+            if (previous < 0) {
+                for (int j = 0; j < i; ++j) {
+                    line[j * stride] = line[i * stride];
+                }
+            } else if (i - previous > 1) {
+                float a = line[previous * stride];
+                float b = line[i * stride];
+                for (int j = previous + 1; j < i; ++j) {
+                    float t = static_cast<float>(j - previous) / (i - previous);
+                    line[j * stride] = a + (b - a) * t;
+                }
+            }
+            previous = i;
+        }
+        if (previous >= 0) {
+            for (int j = previous + 1; j < count; ++j) {
+                line[j * stride] = line[previous * stride];
+            }
+        }
+    };
+
+    for (int r = 0; r < rows; ++r) {
+        fillLine(grid.data() + r * cols, cols, 1);
+    }
+    for (int c = 0; c < cols; ++c) {
+        fillLine(grid.data() + c, rows, cols);
+    }
+}
+
+} // namespace
+
+QVector<float> GroundClassifier::open(const QVector<float>& grid, int cols, int rows, int radius)
+{
+    auto minOp = [](float a, float b) { return std::min(a, b); };
+    auto maxOp = [](float a, float b) { return std::max(a, b); };
+
+    QVector<float> eroded = filterWindow(grid, cols, rows, radius, minOp);
+    return filterWindow(eroded, cols, rows, radius, maxOp);
+}
+
+GroundClassifier::Result GroundClassifier::classify(PointCloud& cloud, const Options& options,
+                                                    const std::atomic<bool>* cancelled)
+{
+    Result result;
+
+    if (cloud.isEmpty() || options.cellSize <= 0.0 || options.tileSize <= 0.0) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    cloud.calculateBounds();
+
+    const int count = cloud.size();
+    const double cell = options.cellSize;
+    const double tileSize = std::max(options.tileSize, cell);
+    const double buffer = std::min(options.maxWindowSize, tileSize);
+    const double originX = cloud.minBounds.x();
+    const double originY = cloud.minBounds.y();
+
+    const int tilesX = std::max(1, static_cast<int>(std::ceil((cloud.maxBounds.x() - originX) / tileSize)));
+    const int tilesY = std::max(1, static_cast<int>(std::ceil((cloud.maxBounds.y() - originY) / tileSize)));
+    const int tileCount = tilesX * tilesY;
+
+    // Bin points by tile (counting sort into CSR arrays)
+    QVector<int> tileOf(count);
+    QVector<int> tileOffsets(tileCount + 1, 0);
+
+    for (int i = 0; i < count; ++i) {
+        const QVector3D& p = cloud.points[i].position;
+        int tx = std::clamp(static_cast<int>((p.x() - originX) / tileSize), 0, tilesX - 1);
+        int ty = std::clamp(static_cast<int>((p.y() - originY) / tileSize), 0, tilesY - 1);
+        tileOf[i] = ty * tilesX + tx;
+        ++tileOffsets[tileOf[i] + 1];
+    }
+
+    for (int t = 0; t < tileCount; ++t) {
+        tileOffsets[t + 1] += tileOffsets[t];
+    }
+
+    QVector<int> tilePoints(count);
+    {
+        QVector<int> cursor = tileOffsets;
+        for (int i = 0; i < count; ++i) {
+            tilePoints[cursor[tileOf[i]]++] = i;
+        }
+    }
+
+    // Window radii (cells) and matching height thresholds
+    QVector<int> radii;
+    QVector<float> thresholds;
+    {
+        const int maxRadius = std::max(1, static_cast<int>(options.maxWindowSize / (2.0 * cell)));
+        int previousWindow = 1;
+        for (int k = 0; ; ++k) {
+            int radius = options.exponentialWindows ? (1 << k) : (k + 1);
+            if (radius > maxRadius) {
+                break;
+            }
+            int window = 2 * radius + 1;
+            double dh = (k == 0)
+                ? options.initialDistance
+                : std::min(options.maxDistance,
+                           options.initialDistance + options.slope * (window - previousWindow) * cell);
+            radii.append(radius);
+            thresholds.append(static_cast<float>(dh));
+            previousWindow = window;
+        }
+    }
+
+    QVector<int> tileGround(tileCount, 0);
+    QVector<int> tileIds(tileCount);
+    for (int t = 0; t < tileCount; ++t) {
+        tileIds[t] = t;
+    }
+
+    // Raw pointers keep worker threads off QVector's detach path
+    Point* points = cloud.points.data();
+    const int* offsets = tileOffsets.constData();
+    const int* binned = tilePoints.constData();
+    const int* owner = tileOf.constData();
+    int* groundOut = tileGround.data();
+
+    QtConcurrent::blockingMap(tileIds, [&](int tile) {
+        if (offsets[tile] == offsets[tile + 1]) {
+            return;
+        }
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        const int tx = tile % tilesX;
+        const int ty = tile / tilesX;
+        const double x0 = originX + tx * tileSize - buffer;
+        const double y0 = originY + ty * tileSize - buffer;
+        const double extent = tileSize + 2.0 * buffer;
+        const int cols = static_cast<int>(std::ceil(extent / cell));
+        const int rows = cols;
+
+        // Gather core and buffer points from the 3x3 tile neighbourhood
+        QVector<int> local;
+        QVector<int> localCell;
+        for (int ny = std::max(0, ty - 1); ny <= std::min(tilesY - 1, ty + 1); ++ny) {
+            for (int nx = std::max(0, tx - 1); nx <= std::min(tilesX - 1, tx + 1); ++nx) {
+                int neighbour = ny * tilesX + nx;
+                for (int s = offsets[neighbour]; s < offsets[neighbour + 1]; ++s) {
+                    int idx = binned[s];
+                    const QVector3D& p = points[idx].position;
+                    int c = static_cast<int>((p.x() - x0) / cell);
+                    int r = static_cast<int>((p.y() - y0) / cell);
+                    if (c < 0 || c >= cols || r < 0 || r >= rows) {
+                        continue;
+                    }
+                    local.append(idx);
+                    localCell.append(r * cols + c);
+                }
+            }
+        }
+
+        // Minimum-elevation surface
+        QVector<float> surface(cols * rows, EMPTY_CELL);
+        for (int i = 0; i < local.size(); ++i) {
+            float z = points[local[i]].position.z();
+            float& cellZ = surface[localCell[i]];
+            cellZ = std::min(cellZ, z);
+        }
+        fillEmptyCells(surface, cols, rows);
+
+        // Progressive opening; a point is non-ground once it rises above
+        // the opened surface by more than the window's threshold
+        QVector<char> nonGround(local.size(), 0);
+        for (int k = 0; k < radii.size(); ++k) {
+            surface = open(surface, cols, rows, radii.at(k));
+            const float dh = thresholds.at(k);
+            for (int i = 0; i < local.size(); ++i) {
+                if (!nonGround[i] && points[local[i]].position.z() - surface[localCell[i]] > dh) {
+                    nonGround[i] = 1;
+                }
+            }
+        }
+
+        // Write classes for core points only
+        int ground = 0;
+        for (int i = 0; i < local.size(); ++i) {
+            int idx = local[i];
+            if (owner[idx] != tile) {
+                continue;
+            }
+            if (nonGround[i]) {
+                points[idx].classification = CLASS_UNCLASSIFIED;
+            } else {
+                points[idx].classification = CLASS_GROUND;
+                ++ground;
+            }
+        }
+        groundOut[tile] = ground;
+    });
+
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+        return Result();
+    }
+
+    for (int t = 0; t < tileCount; ++t) {
+        result.groundPoints += tileGround[t];
+        if (tileOffsets[t] != tileOffsets[t + 1]) {
+            ++result.tiles;
+        }
+    }
+    result.unclassifiedPoints = count - result.groundPoints;
+    result.elapsedMs = timer.elapsed();
+
+    cloud.hasClassification = true;
+
+    LOG_INFO(QString("Ground classification: %1 ground / %2 unclassified in %3 tiles (%4 ms)")
+        .arg(result.groundPoints)
+        .arg(result.unclassifiedPoints)
+        .arg(result.tiles)
+        .arg(result.elapsedMs));
+
+    return result;
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -0,0 +1,386 @@
+#include "ImageGalleryModel.h"
+#include <QImageReader>
+#include <QPointer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <numeric>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int THUMBNAIL_THREADS = 4;
+constexpr int MAX_QUEUED_THUMBNAILS = 256;          // Older requests are dropped while scrolling
+constexpr int THUMBNAIL_CACHE_KB = 64 * 1024;
+
+/**
+ * @brief Decode a downscaled image (JPEG decoders scale while decoding)
+ */
+QImage loadThumbnail(const QString& filePath, int maxSize)
+{
+    QImageReader reader(filePath);
+    reader.setAutoTransform(true);
+
+    const QSize fullSize = reader.size();
+    if (fullSize.isValid()) {
+        reader.setScaledSize(fullSize.scaled(maxSize, maxSize, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (!image.isNull() && (image.width() > maxSize || image.height() > maxSize)) {
+        image = image.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+} // namespace
+
+// ImageGalleryModel implementation
+
+ImageGalleryModel::ImageGalleryModel(Core::ImageManager *manager, int thumbnailSize, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_manager(manager)
+    , m_thumbnailSize(thumbnailSize)
+    , m_rowCount(manager->imageCount())
+    , m_syncPending(false)
+    , m_thumbnails(THUMBNAIL_CACHE_KB)
+    , m_activeJobs(0)
+    , m_generation(0)
+    , m_placeholder(thumbnailSize, thumbnailSize)
+{
+    m_placeholder.fill(QColor(230, 230, 230));
+    m_loaderPool.setMaxThreadCount(THUMBNAIL_THREADS);
+
+    connect(m_manager, &Core::ImageManager::imageAdded, this, &ImageGalleryModel::onImageAdded);
+    connect(m_manager, &Core::ImageManager::imageRemoved, this, &ImageGalleryModel::onCatalogChanged);
+    connect(m_manager, &Core::ImageManager::imagesCleared, this, &ImageGalleryModel::onCatalogChanged);
+}
+
+ImageGalleryModel::~ImageGalleryModel()
+{
+    m_loaderPool.waitForDone();
+}
+
+int ImageGalleryModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+QVariant ImageGalleryModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+    const Core::ImageMetadata& metadata = m_manager->imageAt(row);
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return metadata.fileName;
+
+    case Qt::DecorationRole:
+        if (const QPixmap *thumbnail = m_thumbnails.object(row)) {
+            return *thumbnail;
+        }
+        requestThumbnail(row);
+        return m_placeholder;
+
+    case Qt::ToolTipRole:
+        return QString("File: %1\nSize: %2x%3\nSharpness: %4")
+            .arg(metadata.fileName)
+            .arg(metadata.dimensions.width())
+            .arg(metadata.dimensions.height())
+            .arg(metadata.sharpness, 0, 'f', 1);
+
+    case CatalogIndexRole:
+        return row;
+
+    case HasGPSRole:
+        return metadata.hasGPS;
+
+    case AcceptableQualityRole:
+        return Core::ImageManager::isAcceptableQuality(metadata);
+
+    default:
+        return QVariant();
+    }
+}
+
+void ImageGalleryModel::reload()
+{
+    beginResetModel();
+    m_rowCount = m_manager->imageCount();
+    m_syncPending = false;
+    m_thumbnails.clear();
+    m_requested.clear();
+    m_queue.clear();
+    m_generation++;
+    endResetModel();
+}
+
+void ImageGalleryModel::onImageAdded()
+{
+    // Coalesce a burst of additions into one insertion
+    if (!m_syncPending) {
+        m_syncPending = true;
+        QMetaObject::invokeMethod(this, &ImageGalleryModel::syncRows, Qt::QueuedConnection);
+    }
+}
+
+void ImageGalleryModel::syncRows()
+{
+    if (!m_syncPending) {
+        return;
+    }
+    m_syncPending = false;
+
+    const int count = m_manager->imageCount();
+    if (count < m_rowCount) {
+        reload();
+        return;
+    }
+
+    if (count > m_rowCount) {
+        beginInsertRows(QModelIndex(), m_rowCount, count - 1);
+        m_rowCount = count;
+        endInsertRows();
+    }
+}
+
+void ImageGalleryModel::onCatalogChanged()
+{
+    // Removal shifts catalog indices, so row caches are invalid
+    reload();
+}
+
+void ImageGalleryModel::requestThumbnail(int row) const
+{
+    if (m_requested.contains(row)) {
+        return;
+    }
+
+    m_requested.insert(row);
+    m_queue.append(row);
+
+    if (m_queue.size() > MAX_QUEUED_THUMBNAILS) {
+        // Scrolled past; re-requested if it becomes visible again
+        m_requested.remove(m_queue.takeFirst());
+    }
+
+    startThumbnailJobs();
+}
+
+void ImageGalleryModel::startThumbnailJobs() const
+{
+    QPointer<ImageGalleryModel> self(const_cast<ImageGalleryModel*>(this));
+
+    while (m_activeJobs < THUMBNAIL_THREADS && !m_queue.isEmpty()) {
+        // Newest request first: that is what the view shows now
+        const int row = m_queue.takeLast();
+        const QString filePath = m_manager->imageAt(row).filePath;
+        const int generation = m_generation;
+        const int maxSize = m_thumbnailSize;
+        m_activeJobs++;
+
+        QtConcurrent::run(&m_loaderPool, [self, generation, row, filePath, maxSize]() {
+            const QImage image = loadThumbnail(filePath, maxSize);
+
+            QMetaObject::invokeMethod(self, [self, generation, row, image]() {
+                if (self) {
+                    self->onThumbnailLoaded(generation, row, image);
+                }
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void ImageGalleryModel::onThumbnailLoaded(int generation, int row, const QImage& image)
+{
+    m_activeJobs--;
+
+    if (generation == m_generation && row < m_rowCount) {
+        m_requested.remove(row);
+
+        if (!image.isNull()) {
+            const int costKB = qMax(1, image.width() * image.height() * 4 / 1024);
+            m_thumbnails.insert(row, new QPixmap(QPixmap::fromImage(image)), costKB);
+
+            const QModelIndex changed = index(row);
+            emit dataChanged(changed, changed, {Qt::DecorationRole});
+        }
+    }
+
+    startThumbnailJobs();
+}
+
+// ImageFilterProxyModel implementation
+
+ImageFilterProxyModel::ImageFilterProxyModel(QObject *parent)
+    : QAbstractProxyModel(parent)
+    , m_gallery(nullptr)
+    , m_filters(NoFilter)
+{
+}
+
+void ImageFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (sourceModel == m_gallery) {
+        return;
+    }
+
+    if (m_gallery) {
+        disconnect(m_gallery, nullptr, this, nullptr);
+    }
+
+    m_gallery = qobject_cast<ImageGalleryModel*>(sourceModel);
+    QAbstractProxyModel::setSourceModel(m_gallery);
+
+    if (m_gallery) {
+        connect(m_gallery, &QAbstractItemModel::rowsInserted,
+                this, &ImageFilterProxyModel::onSourceRowsInserted);
+        connect(m_gallery, &QAbstractItemModel::rowsRemoved, this, &ImageFilterProxyModel::rebuild);
+        connect(m_gallery, &QAbstractItemModel::modelReset, this, &ImageFilterProxyModel::rebuild);
+        connect(m_gallery, &QAbstractItemModel::dataChanged,
+                this, &ImageFilterProxyModel::onSourceDataChanged);
+    }
+
+    rebuild();
+}
+
+void ImageFilterProxyModel::setFilter(Filter filter, bool enabled)
+{
+    if (m_filters.testFlag(filter) == enabled) {
+        return;
+    }
+
+    m_filters.setFlag(filter, enabled);
+    rebuild();
+}
+
+bool ImageFilterProxyModel::accepts(int sourceRow) const
+{
+    const Core::ImageMetadata& metadata = m_gallery->metadataAt(sourceRow);
+
+    if (m_filters.testFlag(GeotaggedOnly) && !metadata.hasGPS) {
+        return false;
+    }
+    if (m_filters.testFlag(QualityOnly) && !Core::ImageManager::isAcceptableQuality(metadata)) {
+        return false;
+    }
+    return true;
+}
+
+void ImageFilterProxyModel::rebuild()
+{
+    beginResetModel();
+
+    m_rows.clear();
+    const int sourceRows = m_gallery ? m_gallery->rowCount() : 0;
+
+    if (m_filters == NoFilter) {
+        m_rows.resize(sourceRows);
+        std::iota(m_rows.begin(), m_rows.end(), 0);
+    } else {
+        m_rows.reserve(sourceRows);
+        for (int row = 0; row < sourceRows; ++row) {
+            if (accepts(row)) {
+                m_rows.append(row);
+            }
+        }
+        m_rows.squeeze();
+    }
+
+    endResetModel();
+}
+
+void ImageFilterProxyModel::onSourceRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    // Only appends keep existing mappings valid
+    if (!m_rows.isEmpty() && first <= m_rows.last()) {
+        rebuild();
+        return;
+    }
+
+    QVector<int> accepted;
+    for (int row = first; row <= last; ++row) {
+        if (accepts(row)) {
+            accepted.append(row);
+        }
+    }
+
+    if (accepted.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + accepted.size() - 1);
+    m_rows += accepted;
+    endInsertRows();
+}
+
+void ImageFilterProxyModel::onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight,
+                                                const QList<int>& roles)
+{
+    // Rows without a proxy row are filtered out and need no update
+    auto first = std::lower_bound(m_rows.cbegin(), m_rows.cend(), topLeft.row());
+    auto last = std::upper_bound(first, m_rows.cend(), bottomRight.row());
+    if (first == last) {
+        return;
+    }
+
+    emit dataChanged(index(static_cast<int>(first - m_rows.cbegin()), 0),
+                     index(static_cast<int>(last - m_rows.cbegin()) - 1, 0), roles);
+}
+
+QModelIndex ImageFilterProxyModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (parent.isValid() || column != 0 || row < 0 || row >= m_rows.size()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex ImageFilterProxyModel::parent(const QModelIndex& child) const
+{
+    Q_UNUSED(child);
+    return QModelIndex();
+}
+
+int ImageFilterProxyModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int ImageFilterProxyModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QModelIndex ImageFilterProxyModel::mapToSource(const QModelIndex& proxyIndex) const
+{
+    if (!m_gallery || !proxyIndex.isValid() || proxyIndex.row() >= m_rows.size()) {
+        return QModelIndex();
+    }
+    return m_gallery->index(m_rows[proxyIndex.row()], 0);
+}
+
+QModelIndex ImageFilterProxyModel::mapFromSource(const QModelIndex& sourceIndex) const
+{
+    if (!sourceIndex.isValid()) {
+        return QModelIndex();
+    }
+
+    auto it = std::lower_bound(m_rows.cbegin(), m_rows.cend(), sourceIndex.row());
+    if (it == m_rows.cend() || *it != sourceIndex.row()) {
+        return QModelIndex();
+    }
+    return createIndex(static_cast<int>(it - m_rows.cbegin()), 0);
+}
+
+} // namespace UI
+} // namespace DroneMapper
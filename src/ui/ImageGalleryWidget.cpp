@@ -7,44 +7,21 @@
 namespace DroneMapper {
 namespace UI {
 
-// ImageThumbnailItem implementation
-
-ImageThumbnailItem::ImageThumbnailItem(const Core::ImageMetadata& metadata, QListWidget *parent)
-    : QListWidgetItem(parent)
-    , m_metadata(metadata)
-{
-    setText(metadata.fileName);
-    
-    // Load and set thumbnail
-    QImage thumbnail = QImage(metadata.filePath).scaled(150, 150, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    if (!thumbnail.isNull()) {
-        setIcon(QIcon(QPixmap::fromImage(thumbnail)));
-    }
-    
-    // Set tooltip with metadata
-    QString tooltip = QString("File: %1\nSize: %2x%3\nSharpness: %4")
-        .arg(metadata.fileName)
-        .arg(metadata.dimensions.width())
-        .arg(metadata.dimensions.height())
-        .arg(metadata.sharpness, 0, 'f', 1);
-    setToolTip(tooltip);
-}
-
 // ImageGalleryWidget implementation
 
 ImageGalleryWidget::ImageGalleryWidget(QWidget *parent)
     : QWidget(parent)
     , m_imageManager(new Core::ImageManager(this))
-    , m_filterQuality(false)
-    , m_filterGeotagged(false)
+    , m_galleryModel(new ImageGalleryModel(m_imageManager, 150, this))
+    , m_filterModel(new ImageFilterProxyModel(this))
 {
+    m_filterModel->setSourceModel(m_galleryModel);
+
     setupUI();
     
     // Connect image manager signals
     connect(m_imageManager, &Core::ImageManager::scanProgress,
             this, &ImageGalleryWidget::onScanProgress);
-    connect(m_imageManager, &Core::ImageManager::imageAdded,
-            this, &ImageGalleryWidget::onImageAdded);
     
     setWindowTitle("Image Gallery");
     resize(1200, 800);
@@ -93,15 +70,20 @@ void ImageGalleryWidget::setupUI()
     // Main content area
     QHBoxLayout *contentLayout = new QHBoxLayout();
     
-    // Thumbnail list
-    m_thumbnailList = new QListWidget(this);
-    m_thumbnailList->setViewMode(QListWidget::IconMode);
-    m_thumbnailList->setIconSize(QSize(150, 150));
-    m_thumbnailList->setResizeMode(QListWidget::Adjust);
-    m_thumbnailList->setSpacing(10);
-    connect(m_thumbnailList, &QListWidget::itemClicked, this, &ImageGalleryWidget::onImageItemClicked);
-    
-    contentLayout->addWidget(m_thumbnailList, 2);
+    // Thumbnail view; uniform sizes skip per-item size hints
+    m_thumbnailView = new QListView(this);
+    m_thumbnailView->setModel(m_filterModel);
+    m_thumbnailView->setViewMode(QListView::IconMode);
+    m_thumbnailView->setIconSize(QSize(150, 150));
+    m_thumbnailView->setGridSize(QSize(170, 190));
+    m_thumbnailView->setResizeMode(QListView::Adjust);
+    m_thumbnailView->setMovement(QListView::Static);
+    m_thumbnailView->setUniformItemSizes(true);
+    m_thumbnailView->setLayoutMode(QListView::Batched);
+    m_thumbnailView->setBatchSize(500);
+    connect(m_thumbnailView, &QListView::clicked, this, &ImageGalleryWidget::onImageClicked);
+    
+    contentLayout->addWidget(m_thumbnailView, 2);
     
     // Info panel
     QVBoxLayout *infoPanelLayout = new QVBoxLayout();
@@ -170,7 +152,6 @@ void ImageGalleryWidget::loadDirectory(const QString& directoryPath, bool recurs
     
     m_scanProgress->setVisible(false);
     
-    updateThumbnails();
     updateStatisticsPanel();
 
     // Note: Status message could be emitted via signal if needed
@@ -191,34 +172,33 @@ void ImageGalleryWidget::onLoadDirectoryClicked()
 void ImageGalleryWidget::onClearClicked()
 {
     m_imageManager->clear();
-    m_thumbnailList->clear();
     updateStatisticsPanel();
 }
 
 void ImageGalleryWidget::onFilterQualityChanged(int state)
 {
-    m_filterQuality = (state == Qt::Checked);
-    updateThumbnails();
+    m_filterModel->setFilter(ImageFilterProxyModel::QualityOnly, state == Qt::Checked);
 }
 
 void ImageGalleryWidget::onFilterGeotaggedChanged(int state)
 {
-    m_filterGeotagged = (state == Qt::Checked);
-    updateThumbnails();
+    m_filterModel->setFilter(ImageFilterProxyModel::GeotaggedOnly, state == Qt::Checked);
 }
 
-void ImageGalleryWidget::onImageItemClicked(QListWidgetItem *item)
+void ImageGalleryWidget::onImageClicked(const QModelIndex& index)
 {
-    ImageThumbnailItem *thumbItem = dynamic_cast<ImageThumbnailItem*>(item);
-    if (!thumbItem) {
+    const QModelIndex sourceIndex = m_filterModel->mapToSource(index);
+    if (!sourceIndex.isValid()) {
         return;
     }
     
-    updateMetadataPanel(thumbItem->metadata());
-    emit imageSelected(thumbItem->metadata());
+    const Core::ImageMetadata& metadata = m_galleryModel->metadataAt(sourceIndex.row());
     
-    if (thumbItem->metadata().hasGPS) {
-        emit showImageLocation(thumbItem->metadata().coordinate);
+    updateMetadataPanel(metadata);
+    emit imageSelected(metadata);
+    
+    if (metadata.hasGPS) {
+        emit showImageLocation(metadata.coordinate);
     }
 }
 
@@ -228,12 +208,6 @@ void ImageGalleryWidget::onScanProgress(int current, int total)
     m_scanProgress->setValue(current);
 }
 
-void ImageGalleryWidget::onImageAdded(const Core::ImageMetadata& metadata)
-{
-    // Update will be done in batch after scan completes
-    Q_UNUSED(metadata);
-}
-
 void ImageGalleryWidget::onExportKMLClicked()
 {
     QString fileName = QFileDialog::getSaveFileName(this,
@@ -259,25 +233,6 @@ void ImageGalleryWidget::onRefreshStatistics()
     updateStatisticsPanel();
 }
 
-void ImageGalleryWidget::updateThumbnails()
-{
-    m_thumbnailList->clear();
-    
-    QVector<Core::ImageMetadata> images = m_imageManager->images();
-    
-    if (m_filterGeotagged) {
-        images = m_imageManager->geotaggedImages();
-    }
-    
-    if (m_filterQuality) {
-        images = m_imageManager->qualityImages();
-    }
-    
-    for (const auto& img : images) {
-        new ImageThumbnailItem(img, m_thumbnailList);
-    }
-}
-
 void ImageGalleryWidget::updateMetadataPanel(const Core::ImageMetadata& metadata)
 {
     m_fileNameLabel->setText("File: " + metadata.fileName);
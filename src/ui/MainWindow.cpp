@@ -6,17 +6,23 @@
 #include "TerrainElevationViewer.h"
 #include "PointCloudViewer.h"
 #include "SimulationPreviewWidget.h"
+#include "PlanValidationService.h"
 #include "Settings.h"
 #include "ReportGenerator.h"
 #include "ProjectManager.h"
 #include "WeatherService.h"
 #include "MissionParameters.h"
 #include "FlightPlan.h"
+#include "IncrementalCoverageGenerator.h"
 #include "CoveragePatternGenerator.h"
+#include "SurveyAreaClipper.h"
 #include "KMZGenerator.h"
 #include "WPMLWriter.h"
 #include "GeoUtils.h"
 #include "COLMAPIntegration.h"
+#include "StartupProfiler.h"
+#include "Tracer.h"
+#include "Logger.h"
 #include <QApplication>
 #include <QMessageBox>
 #include <QFileDialog>
@@ -31,41 +37,114 @@
 #include <QVBoxLayout>
 #include <QDesktopServices>
 #include <QProgressDialog>
+#include <QShowEvent>
+#include <QSignalBlocker>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QTimer>
+#include <atomic>
 #include <cmath>
+#include <memory>
 
 namespace DroneMapper {
 namespace UI {
 
+namespace {
+
+// Object names identify docks in the saved window state
+constexpr const char* WEATHER_DOCK = "WeatherDock";
+constexpr const char* VIEWERS_DOCK = "ViewersDock";
+constexpr const char* ALTITUDE_PROFILE_DOCK = "AltitudeProfileDock";
+
+/**
+ * @brief Planned photo footprints for the coverage overlay
+ *
+ * Photos are spaced by the front overlap along every leg, each one
+ * the camera footprint aligned with its leg.
+ */
+QVector<QPolygonF> photoFootprints(const Models::FlightPlan& plan)
+{
+    QVector<QPolygonF> footprints;
+
+    const QList<Models::Waypoint> waypoints = plan.waypoints();
+    const Models::MissionParameters& params = plan.parameters();
+    const double width = params.imageFootprintWidth();
+    const double height = params.imageFootprintHeight();
+    const double spacing = height * (1.0 - params.frontOverlap() / 100.0);
+    if (waypoints.count() < 2 || width <= 0.0 || spacing <= 0.0) {
+        return footprints;
+    }
+
+    const Models::GeospatialCoordinate origin = waypoints.first().coordinate();
+    auto addFootprint = [&](const QPointF& center, const QPointF& along, const QPointF& across) {
+        QPolygonF footprint;
+        for (const QPointF& corner : { center - along - across, center + along - across,
+                                       center + along + across, center - along + across }) {
+            const Models::GeospatialCoordinate coordinate = Geospatial::GeoUtils::fromCartesian(corner, origin);
+            footprint.append(QPointF(coordinate.longitude(), coordinate.latitude()));
+        }
+        footprints.append(footprint);
+    };
+
+    QPointF previous(0.0, 0.0);
+    QPointF along;
+    QPointF across;
+    for (int i = 1; i < waypoints.count(); ++i) {
+        const QPointF next = Geospatial::GeoUtils::toCartesian(waypoints[i].coordinate(), origin);
+        const QPointF leg = next - previous;
+        const double length = std::hypot(leg.x(), leg.y());
+
+        if (length > 0.0) {
+            along = leg * (height / 2.0 / length);
+            across = QPointF(-leg.y(), leg.x()) * (width / 2.0 / length);
+            for (double distance = 0.0; distance < length; distance += spacing) {
+                addFootprint(previous + leg * (distance / length), along, across);
+            }
+        }
+        previous = next;
+    }
+
+    // Last photo at the final waypoint, aligned with the last leg
+    if (!along.isNull()) {
+        addFootprint(previous, along, across);
+    }
+
+    return footprints;
+}
+
+} // namespace
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
-    , m_mapWidget(new MapWidget(this))
+    , m_projectDock(nullptr)
+    , m_propertiesDock(nullptr)
+    , m_weatherDock(nullptr)
+    , m_viewersDock(nullptr)
+    , m_altitudeProfileDock(nullptr)
+    , m_mapWidget(nullptr)
     , m_weatherWidget(nullptr)
     , m_windOverlay(nullptr)
     , m_viewersTab(nullptr)
     , m_terrainViewer(nullptr)
     , m_pointCloudViewer(nullptr)
+    , m_crossSectionWidget(nullptr)
+    , m_altitudeProfile(nullptr)
     , m_simulationPreview(nullptr)
-    , m_colmapIntegration(new Photogrammetry::COLMAPIntegration(this))
+    , m_colmapIntegration(nullptr)
     , m_progressDialog(nullptr)
+    , m_validationService(nullptr)
+    , m_coverageEditor(new Geospatial::IncrementalCoverageGenerator())
     , m_currentFlightPlan(nullptr)
+    , m_areaDragged(false)
+    , m_startupScheduled(false)
 {
     setWindowTitle("DroneMapper - Professional Flight Planning & Photogrammetry");
     resize(1400, 900);
 
-    // Set map widget as central widget
-    setCentralWidget(m_mapWidget);
-
-    // Connect map widget signals
-    connect(m_mapWidget, &MapWidget::areaSelected, this, &MainWindow::onAreaSelected);
-    connect(m_mapWidget, &MapWidget::flightPlanRequested, this, &MainWindow::onFlightPlanRequested);
-
-    // Connect COLMAP signals
-    connect(m_colmapIntegration, &Photogrammetry::COLMAPIntegration::progressUpdated,
-            this, &MainWindow::onCOLMAPProgress);
-    connect(m_colmapIntegration, &Photogrammetry::COLMAPIntegration::pipelineCompleted,
-            this, &MainWindow::onCOLMAPFinished);
-    connect(m_colmapIntegration, &Photogrammetry::COLMAPIntegration::errorOccurred,
-            this, &MainWindow::onCOLMAPError);
+    // Placeholder until the map is created after the first frame
+    QLabel *placeholder = new QLabel(tr("Loading map..."), this);
+    placeholder->setAlignment(Qt::AlignCenter);
+    setCentralWidget(placeholder);
 
     createActions();
     createMenus();
@@ -73,8 +152,10 @@ MainWindow::MainWindow(QWidget *parent)
     createDockWidgets();
     readSettings();
 
-    // Set default map center (can be changed based on user settings)
-    m_mapWidget->setCenter(37.7749, -122.4194, 12); // San Francisco default
+    m_validationService = new PlanValidationService(this);
+    m_validationService->setZoneDatabase(Core::NoFlyZoneChecker::getDefaultUSDatabase());
+    connect(m_validationService, &PlanValidationService::validationFinished,
+            this, &MainWindow::onValidationFinished);
 
     statusBar()->showMessage("Ready - Draw an area on the map to begin flight planning", 10000);
 }
@@ -82,6 +163,159 @@ MainWindow::MainWindow(QWidget *parent)
 MainWindow::~MainWindow()
 {
     writeSettings();
+    delete m_coverageEditor;
+}
+
+void MainWindow::showEvent(QShowEvent *event)
+{
+    QMainWindow::showEvent(event);
+
+    if (!m_startupScheduled) {
+        m_startupScheduled = true;
+        // Runs once the first frame has been handled
+        QTimer::singleShot(0, this, &MainWindow::onStartupIdle);
+    }
+}
+
+void MainWindow::onStartupIdle()
+{
+    Core::StartupProfiler::finish();
+
+    // Boot WebEngine now that the window is up. It has to be built on
+    // the GUI thread, so this only moves it past the first frame.
+    mapWidget();
+
+    // Recreate the lazy docks that were open at the last shutdown
+    const QStringList openDocks = Core::Settings::instance().value("UI/OpenDocks").toStringList();
+    if (openDocks.contains(WEATHER_DOCK)) {
+        weatherDock();
+        m_showWeatherPanelAction->setChecked(!m_weatherDock->isHidden());
+    }
+    if (openDocks.contains(ALTITUDE_PROFILE_DOCK)) {
+        altitudeProfileDock();
+        m_showAltitudeProfileAction->setChecked(!m_altitudeProfileDock->isHidden());
+    }
+    if (openDocks.contains(VIEWERS_DOCK) && !viewersDock()->isHidden() && m_viewersTab->count() == 0) {
+        terrainViewer();
+    }
+}
+
+MapWidget* MainWindow::mapWidget()
+{
+    if (!m_mapWidget) {
+        m_mapWidget = new MapWidget(this);
+        setCentralWidget(m_mapWidget);
+
+        // Connect map widget signals
+        connect(m_mapWidget, &MapWidget::areaSelected, this, &MainWindow::onAreaSelected);
+        connect(m_mapWidget, &MapWidget::areaVertexMoved, this, &MainWindow::onAreaVertexMoved);
+        connect(m_mapWidget, &MapWidget::flightPlanRequested, this, &MainWindow::onFlightPlanRequested);
+
+        // Set default map center (can be changed based on user settings)
+        m_mapWidget->setCenter(37.7749, -122.4194, 12); // San Francisco default
+
+        Core::StartupProfiler::mark("Map widget created");
+    }
+    return m_mapWidget;
+}
+
+QDockWidget* MainWindow::weatherDock()
+{
+    if (!m_weatherDock) {
+        m_weatherDock = new QDockWidget(tr("Weather"), this);
+        m_weatherDock->setObjectName(WEATHER_DOCK);
+        m_weatherDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea | Qt::BottomDockWidgetArea);
+        m_weatherWidget = new WeatherWidget(this);
+        m_weatherDock->setWidget(m_weatherWidget);
+        addDockWidget(Qt::RightDockWidgetArea, m_weatherDock);
+        m_weatherDock->hide();
+        restoreDockWidget(m_weatherDock);
+        m_viewMenu->addAction(m_weatherDock->toggleViewAction());
+    }
+    return m_weatherDock;
+}
+
+QDockWidget* MainWindow::altitudeProfileDock()
+{
+    if (!m_altitudeProfileDock) {
+        m_altitudeProfileDock = new QDockWidget(tr("Altitude Profile"), this);
+        m_altitudeProfileDock->setObjectName(ALTITUDE_PROFILE_DOCK);
+        m_altitudeProfileDock->setAllowedAreas(Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
+        m_altitudeProfile = new AltitudeProfileWidget(this);
+        m_altitudeProfileDock->setWidget(m_altitudeProfile);
+        addDockWidget(Qt::BottomDockWidgetArea, m_altitudeProfileDock);
+        m_altitudeProfileDock->hide();
+        restoreDockWidget(m_altitudeProfileDock);
+        m_viewMenu->addAction(m_altitudeProfileDock->toggleViewAction());
+
+        if (m_terrainViewer) {
+            m_altitudeProfile->setDEMData(m_terrainViewer->demData());
+        }
+        updateAltitudeProfile();
+    }
+    return m_altitudeProfileDock;
+}
+
+QDockWidget* MainWindow::viewersDock()
+{
+    if (!m_viewersDock) {
+        m_viewersDock = new QDockWidget(tr("3D Viewers"), this);
+        m_viewersDock->setObjectName(VIEWERS_DOCK);
+        m_viewersDock->setAllowedAreas(Qt::AllDockWidgetAreas);
+        m_viewersTab = new QTabWidget(this);
+        m_viewersDock->setWidget(m_viewersTab);
+        addDockWidget(Qt::BottomDockWidgetArea, m_viewersDock);
+        m_viewersDock->hide();
+        restoreDockWidget(m_viewersDock);
+        m_viewMenu->addAction(m_viewersDock->toggleViewAction());
+    }
+    return m_viewersDock;
+}
+
+TerrainElevationViewer* MainWindow::terrainViewer()
+{
+    if (!m_terrainViewer) {
+        viewersDock();
+        m_terrainViewer = new TerrainElevationViewer(this);
+        m_viewersTab->insertTab(0, m_terrainViewer, tr("Terrain"));
+    }
+    return m_terrainViewer;
+}
+
+PointCloudViewer* MainWindow::pointCloudViewer()
+{
+    if (!m_pointCloudViewer) {
+        viewersDock();
+        m_pointCloudViewer = new PointCloudViewer(this);
+        m_crossSectionWidget = new CrossSectionWidget(this);
+
+        connect(m_pointCloudViewer, &PointCloudViewer::sectionUpdated,
+                m_crossSectionWidget, &CrossSectionWidget::setSection);
+        connect(m_pointCloudViewer, &PointCloudViewer::sectionUpdated, this,
+                [this](const QVector<SectionPoint>& section, double) {
+                    m_exportSectionAction->setEnabled(!section.isEmpty());
+                });
+
+        m_viewersTab->addTab(m_pointCloudViewer, tr("Point Cloud"));
+        m_viewersTab->addTab(m_crossSectionWidget, tr("Section"));
+    }
+    return m_pointCloudViewer;
+}
+
+Photogrammetry::COLMAPIntegration* MainWindow::colmapIntegration()
+{
+    if (!m_colmapIntegration) {
+        m_colmapIntegration = new Photogrammetry::COLMAPIntegration(this);
+
+        // Connect COLMAP signals
+        connect(m_colmapIntegration, &Photogrammetry::COLMAPIntegration::progressUpdated,
+                this, &MainWindow::onCOLMAPProgress);
+        connect(m_colmapIntegration, &Photogrammetry::COLMAPIntegration::pipelineCompleted,
+                this, &MainWindow::onCOLMAPFinished);
+        connect(m_colmapIntegration, &Photogrammetry::COLMAPIntegration::errorOccurred,
+                this, &MainWindow::onCOLMAPError);
+    }
+    return m_colmapIntegration;
 }
 
 void MainWindow::createActions()
@@ -138,6 +372,10 @@ void MainWindow::createActions()
     m_showWeatherPanelAction->setCheckable(true);
     connect(m_showWeatherPanelAction, &QAction::triggered, this, &MainWindow::onShowWeatherPanel);
 
+    m_showAltitudeProfileAction = new QAction(tr("Show &Altitude Profile"), this);
+    m_showAltitudeProfileAction->setCheckable(true);
+    connect(m_showAltitudeProfileAction, &QAction::triggered, this, &MainWindow::onShowAltitudeProfile);
+
     m_toggle3DViewersAction = new QAction(tr("Toggle &3D Viewers"), this);
     m_toggle3DViewersAction->setShortcut(QKeySequence(tr("F3")));
     connect(m_toggle3DViewersAction, &QAction::triggered, this, &MainWindow::onToggle3DViewers);
@@ -145,9 +383,49 @@ void MainWindow::createActions()
     m_loadPointCloudAction = new QAction(tr("Load Point &Cloud..."), this);
     connect(m_loadPointCloudAction, &QAction::triggered, this, &MainWindow::onLoadPointCloud);
 
+    m_sectionToolAction = new QAction(tr("Cross &Section Tool"), this);
+    m_sectionToolAction->setCheckable(true);
+    m_sectionToolAction->setEnabled(false);     // Enabled when a point cloud is loaded
+    m_sectionToolAction->setToolTip(tr("Drag across the point cloud to cut a profile"));
+    connect(m_sectionToolAction, &QAction::toggled, this, &MainWindow::onSectionTool);
+
+    m_exportSectionAction = new QAction(tr("&Export Section..."), this);
+    m_exportSectionAction->setEnabled(false);   // Enabled when a section has been cut
+    connect(m_exportSectionAction, &QAction::triggered, this, &MainWindow::onExportSection);
+
+    m_estimateNormalsAction = new QAction(tr("Estimate &Normals"), this);
+    m_estimateNormalsAction->setEnabled(false);  // Enabled when a point cloud is loaded
+    m_estimateNormalsAction->setToolTip(tr("Estimate surface normals for shading"));
+    connect(m_estimateNormalsAction, &QAction::triggered, this, &MainWindow::onEstimateNormals);
+
+    m_classifyGroundAction = new QAction(tr("Classify &Ground"), this);
+    m_classifyGroundAction->setEnabled(false);   // Enabled when a point cloud is loaded
+    m_classifyGroundAction->setToolTip(tr("Separate ground from objects (LAS class 2)"));
+    connect(m_classifyGroundAction, &QAction::triggered, this, &MainWindow::onClassifyGround);
+
+    m_compareCloudsAction = new QAction(tr("Compare with &Earlier Epoch..."), this);
+    m_compareCloudsAction->setEnabled(false);    // Enabled when a point cloud is loaded
+    m_compareCloudsAction->setToolTip(tr("Colour the cloud by its distance to a reference cloud"));
+    connect(m_compareCloudsAction, &QAction::triggered, this, &MainWindow::onCompareClouds);
+
     m_loadDEMAction = new QAction(tr("Load &DEM/Terrain..."), this);
     connect(m_loadDEMAction, &QAction::triggered, this, &MainWindow::onLoadDEM);
 
+    m_compareDEMsAction = new QAction(tr("Compare &Surfaces (Cut/Fill)..."), this);
+    m_compareDEMsAction->setToolTip(tr("Volume change between two DEM/DSM epochs"));
+    connect(m_compareDEMsAction, &QAction::triggered, this, &MainWindow::onCompareDEMs);
+
+    m_exportContoursAction = new QAction(tr("Export &Contours..."), this);
+    m_exportContoursAction->setEnabled(false);  // Enabled when a DEM is loaded
+    m_exportContoursAction->setToolTip(tr("Save contour lines at the terrain viewer's interval as GeoJSON"));
+    connect(m_exportContoursAction, &QAction::triggered, this, &MainWindow::onExportContours);
+
+    m_showViewshedAction = new QAction(tr("Pilot &Viewshed"), this);
+    m_showViewshedAction->setCheckable(true);
+    m_showViewshedAction->setEnabled(false);    // Enabled when a DEM is loaded
+    m_showViewshedAction->setToolTip(tr("Shade terrain the pilot cannot see the aircraft over"));
+    connect(m_showViewshedAction, &QAction::toggled, this, &MainWindow::onShowViewshed);
+
     // Mission actions
     m_previewMissionAction = new QAction(tr("&Preview Mission Simulation"), this);
     m_previewMissionAction->setShortcut(QKeySequence(tr("Ctrl+Shift+P")));
@@ -158,6 +436,38 @@ void MainWindow::createActions()
     m_generateReportAction->setShortcut(QKeySequence(tr("Ctrl+Shift+R")));
     m_generateReportAction->setEnabled(false);  // Enabled when flight plan exists
     connect(m_generateReportAction, &QAction::triggered, this, &MainWindow::onGenerateReport);
+
+    // Diagnostics actions
+    m_recordTraceAction = new QAction(tr("&Record Performance Trace"), this);
+    m_recordTraceAction->setCheckable(true);
+    m_recordTraceAction->setChecked(Core::Tracer::isEnabled());   // May be started by --trace
+    connect(m_recordTraceAction, &QAction::toggled, this, &MainWindow::onRecordTrace);
+
+    m_saveTraceAction = new QAction(tr("&Save Performance Trace..."), this);
+    connect(m_saveTraceAction, &QAction::triggered, this, &MainWindow::onSaveTrace);
+
+    // Map overlays, rendered locally by the map's tile handler
+    m_loadOrthoAction = new QAction(tr("Load &Orthomosaic..."), this);
+    connect(m_loadOrthoAction, &QAction::triggered, this, &MainWindow::onLoadOrthomosaic);
+
+    m_showHillshadeAction = new QAction(tr("DEM &Hillshade"), this);
+    m_showHillshadeAction->setCheckable(true);
+    m_showHillshadeAction->setEnabled(false);   // Enabled when a DEM is loaded
+    connect(m_showHillshadeAction, &QAction::toggled, this, &MainWindow::onShowHillshade);
+
+    m_showOrthoAction = new QAction(tr("&Orthomosaic"), this);
+    m_showOrthoAction->setCheckable(true);
+    m_showOrthoAction->setEnabled(false);       // Enabled when an orthomosaic is loaded
+    connect(m_showOrthoAction, &QAction::toggled, this, &MainWindow::onShowOrthoOverlay);
+
+    m_showCoverageAction = new QAction(tr("Photo &Coverage"), this);
+    m_showCoverageAction->setCheckable(true);
+    connect(m_showCoverageAction, &QAction::toggled, this, &MainWindow::onShowCoverageOverlay);
+
+    m_workOfflineAction = new QAction(tr("Work &Offline"), this);
+    m_workOfflineAction->setCheckable(true);
+    m_workOfflineAction->setToolTip(tr("Use cached map tiles only"));
+    connect(m_workOfflineAction, &QAction::toggled, this, &MainWindow::onWorkOffline);
 }
 
 void MainWindow::createMenus()
@@ -176,6 +486,9 @@ void MainWindow::createMenus()
     m_toolsMenu = menuBar()->addMenu(tr("&Tools"));
     m_toolsMenu->addAction(m_generateFlightPlanAction);
     m_toolsMenu->addAction(m_clearMapAction);
+    m_toolsMenu->addSeparator();
+    m_toolsMenu->addAction(m_recordTraceAction);
+    m_toolsMenu->addAction(m_saveTraceAction);
 
     m_missionMenu = menuBar()->addMenu(tr("&Mission"));
     m_missionMenu->addAction(m_previewMissionAction);
@@ -183,16 +496,35 @@ void MainWindow::createMenus()
 
     m_viewMenu = menuBar()->addMenu(tr("&View"));
     m_viewMenu->addAction(m_showWeatherPanelAction);
+    m_viewMenu->addAction(m_showAltitudeProfileAction);
     m_viewMenu->addAction(m_toggle3DViewersAction);
     m_viewMenu->addSeparator();
+    QMenu *overlayMenu = m_viewMenu->addMenu(tr("Map &Overlays"));
+    overlayMenu->addAction(m_showHillshadeAction);
+    overlayMenu->addAction(m_showOrthoAction);
+    overlayMenu->addAction(m_showCoverageAction);
+    m_viewMenu->addAction(m_workOfflineAction);
+    m_viewMenu->addSeparator();
 
     m_visualizationMenu = menuBar()->addMenu(tr("&Visualization"));
     m_visualizationMenu->addAction(m_showWindOverlayAction);
     m_visualizationMenu->addAction(m_showTerrainViewerAction);
     m_visualizationMenu->addAction(m_showPointCloudViewerAction);
+    m_visualizationMenu->addAction(m_showViewshedAction);
     m_visualizationMenu->addSeparator();
     m_visualizationMenu->addAction(m_loadDEMAction);
+    m_visualizationMenu->addAction(m_compareDEMsAction);
+    m_visualizationMenu->addAction(m_exportContoursAction);
+    m_visualizationMenu->addAction(m_loadOrthoAction);
     m_visualizationMenu->addAction(m_loadPointCloudAction);
+    m_visualizationMenu->addSeparator();
+    QMenu *pointCloudMenu = m_visualizationMenu->addMenu(tr("Point &Cloud Tools"));
+    pointCloudMenu->addAction(m_sectionToolAction);
+    pointCloudMenu->addAction(m_exportSectionAction);
+    pointCloudMenu->addSeparator();
+    pointCloudMenu->addAction(m_estimateNormalsAction);
+    pointCloudMenu->addAction(m_classifyGroundAction);
+    pointCloudMenu->addAction(m_compareCloudsAction);
 
     m_photogrammetryMenu = menuBar()->addMenu(tr("&Photogrammetry"));
     m_photogrammetryMenu->addAction(m_runCOLMAPAction);
@@ -205,19 +537,23 @@ void MainWindow::createMenus()
 void MainWindow::createToolbars()
 {
     m_mainToolBar = addToolBar(tr("Main"));
+    m_mainToolBar->setObjectName("MainToolBar");
     m_mainToolBar->addAction(m_newProjectAction);
     m_mainToolBar->addAction(m_openProjectAction);
     m_mainToolBar->addAction(m_saveProjectAction);
 
     m_mapToolBar = addToolBar(tr("Flight Planning"));
+    m_mapToolBar->setObjectName("FlightPlanningToolBar");
     m_mapToolBar->addAction(m_generateFlightPlanAction);
     m_mapToolBar->addAction(m_exportKMZAction);
     m_mapToolBar->addSeparator();
     m_mapToolBar->addAction(m_clearMapAction);
 
     m_visualizationToolBar = addToolBar(tr("Visualization"));
+    m_visualizationToolBar->setObjectName("VisualizationToolBar");
     m_visualizationToolBar->addAction(m_showTerrainViewerAction);
     m_visualizationToolBar->addAction(m_showPointCloudViewerAction);
+    m_visualizationToolBar->addAction(m_sectionToolAction);
     m_visualizationToolBar->addSeparator();
     m_visualizationToolBar->addAction(m_runCOLMAPAction);
 }
@@ -225,41 +561,21 @@ void MainWindow::createToolbars()
 void MainWindow::createDockWidgets()
 {
     m_projectDock = new QDockWidget(tr("Project Explorer"), this);
+    m_projectDock->setObjectName("ProjectDock");
     m_projectDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
     addDockWidget(Qt::LeftDockWidgetArea, m_projectDock);
 
     m_propertiesDock = new QDockWidget(tr("Properties"), this);
+    m_propertiesDock->setObjectName("PropertiesDock");
     m_propertiesDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
     addDockWidget(Qt::RightDockWidgetArea, m_propertiesDock);
 
-    // Weather dock
-    m_weatherDock = new QDockWidget(tr("Weather"), this);
-    m_weatherDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea | Qt::BottomDockWidgetArea);
-    m_weatherWidget = new WeatherWidget(this);
-    m_weatherDock->setWidget(m_weatherWidget);
-    addDockWidget(Qt::RightDockWidgetArea, m_weatherDock);
-    m_weatherDock->hide(); // Hidden by default
-
-    // 3D Viewers dock
-    m_viewersDock = new QDockWidget(tr("3D Viewers"), this);
-    m_viewersDock->setAllowedAreas(Qt::AllDockWidgetAreas);
-    m_viewersTab = new QTabWidget(this);
-
-    m_terrainViewer = new TerrainElevationViewer(this);
-    m_pointCloudViewer = new PointCloudViewer(this);
-
-    m_viewersTab->addTab(m_terrainViewer, tr("Terrain"));
-    m_viewersTab->addTab(m_pointCloudViewer, tr("Point Cloud"));
-
-    m_viewersDock->setWidget(m_viewersTab);
-    addDockWidget(Qt::BottomDockWidgetArea, m_viewersDock);
-    m_viewersDock->hide(); // Hidden by default
+    // Weather, altitude profile and 3D viewer docks are created on first use
+    // and pick up their saved placement then
 
     // Add dock widgets to view menu
     m_viewMenu->addAction(m_projectDock->toggleViewAction());
     m_viewMenu->addAction(m_propertiesDock->toggleViewAction());
-    m_viewMenu->addAction(m_weatherDock->toggleViewAction());
-    m_viewMenu->addAction(m_viewersDock->toggleViewAction());
 }
 
 void MainWindow::newProject()
@@ -325,6 +641,7 @@ void MainWindow::readSettings()
 {
     auto& settings = Core::Settings::instance();
     restoreGeometry(settings.mainWindowGeometry());
+    // Also keeps the entries of docks not created yet for restoreDockWidget()
     restoreState(settings.mainWindowState());
 }
 
@@ -333,6 +650,14 @@ void MainWindow::writeSettings()
     auto& settings = Core::Settings::instance();
     settings.setMainWindowGeometry(saveGeometry());
     settings.setMainWindowState(saveState());
+
+    QStringList openDocks;
+    for (QDockWidget *dock : { m_weatherDock, m_viewersDock, m_altitudeProfileDock }) {
+        if (dock && !dock->isHidden()) {
+            openDocks << dock->objectName();
+        }
+    }
+    settings.setValue("UI/OpenDocks", openDocks);
 }
 
 void MainWindow::closeEvent(QCloseEvent *event)
@@ -346,9 +671,117 @@ void MainWindow::onAreaSelected(const QString& geojson)
 {
     m_currentAreaGeoJson = geojson;
     m_generateFlightPlanAction->setEnabled(true);
+
+    // Drag released: patched lines may now cross a zone
+    if (m_areaDragged) {
+        m_areaDragged = false;
+        reclipDraggedArea();
+        return;
+    }
+
     statusBar()->showMessage(tr("Area selected - Click 'Generate Flight Plan' or press Ctrl+G"), 0);
 }
 
+void MainWindow::onAreaVertexMoved(int vertex, double lat, double lng)
+{
+    if (!m_currentFlightPlan) {
+        return;
+    }
+
+    TRACE_SCOPE("planning", "MainWindow::onAreaVertexMoved");
+    m_areaDragged = true;
+
+    // Clipped coverage has no incremental path; the release regenerates it
+    if (!m_coverageEditor->isValid()) {
+        QPolygonF area = m_currentFlightPlan->surveyArea();
+        if (vertex >= 0 && vertex < area.count()) {
+            area[vertex] = QPointF(lng, lat);
+            m_currentFlightPlan->setSurveyArea(area);
+        }
+        return;
+    }
+
+    const auto patch = m_coverageEditor->moveVertex(vertex, QPointF(lng, lat));
+    if (patch.isEmpty()) {
+        return;
+    }
+
+    m_currentFlightPlan->replaceWaypoints(patch.start, patch.removeCount,
+        m_coverageEditor->waypoints().mid(patch.start, patch.insertCount));
+    m_currentFlightPlan->setSurveyArea(m_coverageEditor->polygon());
+
+    // The map diffs against the path it shows and sends only the splice
+    const double totalDistance = m_currentFlightPlan->totalDistance();
+    const int flightTime = static_cast<int>(totalDistance / m_currentFlightPlan->parameters().flightSpeed());
+    mapWidget()->displayFlightPath(*m_currentFlightPlan);
+    mapWidget()->updateFlightInfo(totalDistance, flightTime, m_currentFlightPlan->waypointCount() * 3);
+
+    m_validationService->submitPlan(*m_currentFlightPlan);
+    updateAltitudeProfile();
+}
+
+void MainWindow::reclipDraggedArea()
+{
+    if (!m_currentFlightPlan) {
+        return;
+    }
+
+    TRACE_SCOPE("planning", "MainWindow::reclipDraggedArea");
+
+    const QPolygonF polygon = m_currentFlightPlan->surveyArea();
+    const Models::MissionParameters& params = m_currentFlightPlan->parameters();
+
+    Geospatial::SurveyAreaClipper::Options clipOptions;
+    clipOptions.altitude = params.flightAltitude();
+    clipOptions.insetMeters = params.boundaryInset();
+    clipOptions.overshootMeters = params.turnOvershoot();
+    const Geospatial::SurveyAreaClipper::Result clip = Geospatial::SurveyAreaClipper::subtractZones(
+        polygon, m_validationService->zoneDatabase(), clipOptions);
+
+    // Overshoot near a zone needs the clamped generator even when nothing was clipped
+    const bool nearZones = clip.clipped || (params.turnOvershoot() > 0.0 && !clip.zoneOutlines.isEmpty());
+
+    QList<Models::Waypoint> waypoints;
+    if (nearZones) {
+        m_coverageEditor->clear();
+        Geospatial::CoveragePatternGenerator generator;
+        waypoints = generator.generateParallelLines(clip.area, params.flightAltitude(),
+                                                    params.flightDirection(), params.pathSpacing(),
+                                                    params.turnOvershoot(), clip.zoneOutlines);
+    } else if (m_coverageEditor->isValid()) {
+        // The patched lines already cover the moved polygon
+        updateCoverageOverlay();
+        return;
+    } else {
+        // Dragged clear of every zone: patching can resume
+        m_coverageEditor->reset(polygon, params.flightAltitude(), params.flightDirection(),
+                                params.pathSpacing(), params.turnOvershoot());
+        waypoints = m_coverageEditor->waypoints();
+    }
+
+    m_currentFlightPlan->clearWaypoints();
+    for (const auto& waypoint : waypoints) {
+        m_currentFlightPlan->addWaypoint(waypoint);
+    }
+
+    const double totalDistance = m_currentFlightPlan->totalDistance();
+    const int flightTime = static_cast<int>(totalDistance / params.flightSpeed());
+    mapWidget()->displayFlightPath(*m_currentFlightPlan);
+    mapWidget()->updateFlightInfo(totalDistance, flightTime, waypoints.count() * 3);
+
+    m_validationService->submitPlan(*m_currentFlightPlan);
+    updateCoverageOverlay();
+    updateAltitudeProfile();
+
+    if (waypoints.isEmpty()) {
+        statusBar()->showMessage(tr("The survey area lies entirely inside no-fly zones."), 10000);
+    } else if (clip.clipped) {
+        statusBar()->showMessage(tr("Flight plan re-clipped: %1 waypoints (%2% of the area excluded by no-fly zones)")
+            .arg(waypoints.count())
+            .arg(QString::number(100.0 * (1.0 - clip.remainingArea / clip.originalArea), 'f', 0)), 10000);
+    }
+}
+
 void MainWindow::onFlightPlanRequested()
 {
     onGenerateFlightPlan();
@@ -356,6 +789,8 @@ void MainWindow::onFlightPlanRequested()
 
 void MainWindow::onGenerateFlightPlan()
 {
+    TRACE_SCOPE("planning", "MainWindow::onGenerateFlightPlan");
+
     if (m_currentAreaGeoJson.isEmpty()) {
         QMessageBox::warning(this, tr("No Area Selected"),
             tr("Please draw an area on the map first."));
@@ -437,18 +872,43 @@ void MainWindow::onGenerateFlightPlan()
 
     statusBar()->showMessage(tr("Generating flight plan..."), 0);
 
-    // Generate coverage pattern
-    Geospatial::CoveragePatternGenerator generator;
-    auto waypoints = generator.generateParallelLines(
-        polygon,
-        params.flightAltitude(),
-        params.flightDirection(),
-        spacing,
-        params.frontOverlap() / 100.0);
+    // Keep the survey clear of active no-fly zones (with a safety buffer)
+    Geospatial::SurveyAreaClipper::Options clipOptions;
+    clipOptions.altitude = params.flightAltitude();
+    clipOptions.insetMeters = params.boundaryInset();
+    clipOptions.overshootMeters = params.turnOvershoot();
+    const Geospatial::SurveyAreaClipper::Result clip = Geospatial::SurveyAreaClipper::subtractZones(
+        polygon, m_validationService->zoneDatabase(), clipOptions);
+
+    const bool nearZones = clip.clipped || (params.turnOvershoot() > 0.0 && !clip.zoneOutlines.isEmpty());
+
+    QList<Models::Waypoint> waypoints;
+    if (nearZones) {
+        // Lines around holes or clamped at zones have no incremental path; drags stop patching
+        m_coverageEditor->clear();
+        Geospatial::CoveragePatternGenerator generator;
+        waypoints = generator.generateParallelLines(clip.area, params.flightAltitude(),
+                                                    params.flightDirection(), spacing,
+                                                    params.turnOvershoot(), clip.zoneOutlines);
+
+        LOG_INFO(QString("Survey area clipped by %1 zones: %2 of %3 m2 remain in %4 polygons (%5 ms)")
+                 .arg(clip.candidateZones)
+                 .arg(clip.remainingArea, 0, 'f', 0)
+                 .arg(clip.originalArea, 0, 'f', 0)
+                 .arg(clip.area.count())
+                 .arg(clip.elapsedMs));
+    } else {
+        // Generate coverage pattern (kept so vertex drags can patch it)
+        m_coverageEditor->reset(polygon, params.flightAltitude(), params.flightDirection(), spacing,
+                                params.turnOvershoot());
+        waypoints = m_coverageEditor->waypoints();
+    }
 
     if (waypoints.isEmpty()) {
-        QMessageBox::warning(this, tr("Generation Failed"),
-            tr("Failed to generate waypoints. Check polygon validity."));
+        m_coverageEditor->clear();
+        QMessageBox::warning(this, tr("Generation Failed"), clip.clipped && clip.area.isEmpty()
+            ? tr("The survey area lies entirely inside no-fly zones.")
+            : tr("Failed to generate waypoints. Check polygon validity."));
         statusBar()->showMessage(tr("Flight plan generation failed"), 5000);
         return;
     }
@@ -462,48 +922,55 @@ void MainWindow::onGenerateFlightPlan()
     plan.setSurveyArea(polygon);
 
     // Calculate statistics
-    double totalDistance = 0.0;
-    for (int i = 1; i < waypoints.count(); ++i) {
-        totalDistance += Geospatial::GeoUtils::distanceBetween(
-            waypoints[i-1].coordinate(), waypoints[i].coordinate());
-    }
-
+    double totalDistance = plan.totalDistance();
     double avgSpeed = plan.parameters().flightSpeed();
     int flightTime = static_cast<int>(totalDistance / avgSpeed);
     int photoCount = waypoints.count() * 3; // Approximate
 
     // Display on map
-    m_mapWidget->displayFlightPath(plan);
-    m_mapWidget->updateFlightInfo(totalDistance, flightTime, photoCount);
+    mapWidget()->displayFlightPath(plan);
+    mapWidget()->updateFlightInfo(totalDistance, flightTime, photoCount);
 
     // Store flight plan for export
     if (m_currentFlightPlan) {
         delete m_currentFlightPlan;
     }
     m_currentFlightPlan = new Models::FlightPlan(plan);
+    m_areaDragged = false;
+    m_validationService->submitPlan(plan);
+    updateCoverageOverlay();
+    updateAltitudeProfile();
 
     // Enable export and mission actions
     m_exportKMZAction->setEnabled(true);
     m_previewMissionAction->setEnabled(true);
     m_generateReportAction->setEnabled(true);
 
-    statusBar()->showMessage(
-        tr("Flight plan generated: %1 waypoints, %2m distance, %3min flight time")
+    QString message = tr("Flight plan generated: %1 waypoints, %2m distance, %3min flight time")
         .arg(waypoints.count())
         .arg(QString::number(totalDistance, 'f', 0))
-        .arg(flightTime / 60),
-        10000);
+        .arg(flightTime / 60);
+    if (clip.clipped) {
+        message += tr(" (%1% of the area excluded by no-fly zones)")
+            .arg(QString::number(100.0 * (1.0 - clip.remainingArea / clip.originalArea), 'f', 0));
+    }
+    statusBar()->showMessage(message, 10000);
 }
 
 void MainWindow::onClearMap()
 {
-    m_mapWidget->clearMap();
+    mapWidget()->clearMap();
     m_currentAreaGeoJson.clear();
+    m_areaDragged = false;
 
     if (m_currentFlightPlan) {
         delete m_currentFlightPlan;
         m_currentFlightPlan = nullptr;
     }
+    m_coverageEditor->clear();
+    m_validationService->cancel();
+    updateCoverageOverlay();
+    updateAltitudeProfile();
 
     m_generateFlightPlanAction->setEnabled(false);
     m_exportKMZAction->setEnabled(false);
@@ -512,6 +979,20 @@ void MainWindow::onClearMap()
     statusBar()->showMessage(tr("Map cleared"), 3000);
 }
 
+void MainWindow::onValidationFinished(const PlanValidationResult& result)
+{
+    LOG_INFO(QString("Plan validation: %1 waypoints, %2 zones in %3 ms - %4")
+             .arg(result.waypointCount)
+             .arg(result.zonesChecked)
+             .arg(result.elapsedMs)
+             .arg(result.summary()));
+
+    // A clean result leaves the generation summary in place
+    if (!result.isSafe()) {
+        statusBar()->showMessage(result.summary(), 10000);
+    }
+}
+
 void MainWindow::onExportKMZ()
 {
     if (!m_currentFlightPlan) {
@@ -611,9 +1092,9 @@ void MainWindow::onExportKMZ()
 void MainWindow::onShowWindOverlay()
 {
     if (!m_windOverlay) {
-        m_windOverlay = new WindOverlayWidget(m_mapWidget);
+        m_windOverlay = new WindOverlayWidget(mapWidget());
         m_windOverlay->setWeatherService(&Core::WeatherService::instance());
-        m_windOverlay->resize(m_mapWidget->size());
+        m_windOverlay->resize(mapWidget()->size());
         m_windOverlay->show();
 
         // Update wind overlay when flight plan is generated
@@ -634,25 +1115,176 @@ void MainWindow::onShowWindOverlay()
 
 void MainWindow::onShowTerrainViewer()
 {
+    TerrainElevationViewer *viewer = terrainViewer();
     if (m_viewersDock->isHidden()) {
         m_viewersDock->show();
     }
-    m_viewersTab->setCurrentWidget(m_terrainViewer);
+    m_viewersTab->setCurrentWidget(viewer);
 
     // Load flight plan if available
     if (m_currentFlightPlan) {
-        m_terrainViewer->setFlightPlan(*m_currentFlightPlan);
+        viewer->setFlightPlan(*m_currentFlightPlan);
     }
 
     statusBar()->showMessage(tr("Terrain viewer opened"), 3000);
 }
 
+void MainWindow::onCompareDEMs()
+{
+    const QString filter = tr("DEM Files (*.tif *.tiff);;All Files (*.*)");
+
+    QString beforePath = QFileDialog::getOpenFileName(
+        this, tr("Select Earlier Surface (Before)"), QDir::homePath(), filter);
+    if (beforePath.isEmpty()) {
+        return;
+    }
+
+    QString afterPath = QFileDialog::getOpenFileName(
+        this, tr("Select Later Surface (After)"), QFileInfo(beforePath).absolutePath(), filter);
+    if (afterPath.isEmpty()) {
+        return;
+    }
+
+    // Rasters are streamed in strips; keep the GUI responsive meanwhile
+    QProgressDialog *progress = new QProgressDialog(tr("Comparing surfaces..."), QString(), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    progress->show();
+    m_compareDEMsAction->setEnabled(false);
+
+    using DifferenceResult = Geospatial::DEMDifferenceAnalyzer::Result;
+    auto *watcher = new QFutureWatcher<DifferenceResult>(this);
+    connect(watcher, &QFutureWatcher<DifferenceResult>::finished, this,
+            [this, watcher, progress, afterPath]() {
+        watcher->deleteLater();
+        progress->deleteLater();
+        m_compareDEMsAction->setEnabled(true);
+
+        const DifferenceResult result = watcher->result();
+        if (!result.summary.valid) {
+            QMessageBox::critical(this, tr("Comparison Error"),
+                tr("Failed to compare the surfaces:\n\n%1").arg(result.errorMessage));
+            return;
+        }
+
+        // The change is draped over the later surface unless a DEM is already shown
+        TerrainElevationViewer *viewer = terrainViewer();
+        if (viewer->demData().elevations.isEmpty() && viewer->loadDEM(afterPath)) {
+            m_validationService->setTerrain(viewer->demData());
+            m_showViewshedAction->setEnabled(true);
+            m_exportContoursAction->setEnabled(true);
+        }
+        viewer->setDifferenceLayer(result);
+        onShowTerrainViewer();
+
+        const Geospatial::VolumeChangeSummary& summary = result.summary;
+        QMessageBox::information(this, tr("Cut/Fill Analysis"),
+            tr("Cut: %1 m³ over %2 m²\n"
+               "Fill: %3 m³ over %4 m²\n"
+               "Net: %5 m³\n\n"
+               "Change range: %6 m to %7 m (%8 x %9 cells, %10 ms)")
+            .arg(summary.cutVolume, 0, 'f', 1)
+            .arg(summary.cutArea, 0, 'f', 0)
+            .arg(summary.fillVolume, 0, 'f', 1)
+            .arg(summary.fillArea, 0, 'f', 0)
+            .arg(summary.netVolume, 0, 'f', 1)
+            .arg(summary.minChange, 0, 'f', 2)
+            .arg(summary.maxChange, 0, 'f', 2)
+            .arg(summary.columns)
+            .arg(summary.rows)
+            .arg(summary.elapsedMs));
+    });
+
+    watcher->setFuture(QtConcurrent::run([beforePath, afterPath]() {
+        return Geospatial::DEMDifferenceAnalyzer::compare(beforePath, afterPath);
+    }));
+}
+
+void MainWindow::onExportContours()
+{
+    if (!m_terrainViewer || m_terrainViewer->demData().elevations.isEmpty()) {
+        return;
+    }
+
+    const double interval = m_terrainViewer->settings().contourInterval;
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("Export Contours"),
+        QDir::homePath() + QString("/contours_%1m.geojson").arg(interval),
+        tr("GeoJSON Files (*.geojson *.json)"));
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (QFileInfo(fileName).suffix().isEmpty()) {
+        fileName += ".geojson";
+    }
+
+    if (m_terrainViewer->exportContoursGeoJSON(fileName)) {
+        statusBar()->showMessage(
+            tr("Contours exported: %1 (%2 m interval)").arg(QFileInfo(fileName).fileName()).arg(interval),
+            5000);
+    } else {
+        QMessageBox::critical(this, tr("Export Error"),
+            tr("Failed to write contours to:\n%1").arg(fileName));
+    }
+}
+
+void MainWindow::onShowViewshed(bool visible)
+{
+    TerrainElevationViewer *viewer = terrainViewer();
+
+    if (!visible) {
+        viewer->clearViewshed();
+        return;
+    }
+
+    auto uncheck = [this]() {
+        QSignalBlocker blocker(m_showViewshedAction);
+        m_showViewshedAction->setChecked(false);
+    };
+
+    if (!m_currentFlightPlan || m_currentFlightPlan->waypoints().isEmpty()) {
+        QMessageBox::information(this, tr("No Flight Plan"),
+            tr("Generate a flight plan first. The pilot stands at its launch point."));
+        uncheck();
+        return;
+    }
+
+    // Pilot at the launch point, aircraft at the survey altitude
+    const ViewshedAnalyzer::Observer pilot(m_currentFlightPlan->waypoints().first().coordinate());
+    viewer->setFlightPlan(*m_currentFlightPlan);
+    const Viewshed viewshed = viewer->showViewshed(pilot, m_currentFlightPlan->parameters().flightAltitude());
+
+    if (viewshed.width == 0) {
+        QMessageBox::warning(this, tr("Viewshed"),
+            tr("The launch point lies outside the loaded DEM."));
+        uncheck();
+        return;
+    }
+
+    int hidden = 0;
+    for (const Core::AltitudeViolation& v : viewer->checkVisualLineOfSight(pilot)) {
+        if (v.type == "VLOS") {
+            hidden++;
+        }
+    }
+
+    onShowTerrainViewer();
+    statusBar()->showMessage(
+        tr("Viewshed: %1% of the terrain visible from the launch point, %2 waypoints out of sight")
+            .arg(100.0 * viewshed.visibleCells / (viewshed.width * viewshed.height), 0, 'f', 0)
+            .arg(hidden),
+        10000);
+}
+
 void MainWindow::onShowPointCloudViewer()
 {
+    PointCloudViewer *viewer = pointCloudViewer();
     if (m_viewersDock->isHidden()) {
         m_viewersDock->show();
     }
-    m_viewersTab->setCurrentWidget(m_pointCloudViewer);
+    m_viewersTab->setCurrentWidget(viewer);
 
     statusBar()->showMessage(tr("Point cloud viewer opened - Use File → Load Point Cloud to load data"), 5000);
 }
@@ -721,11 +1353,11 @@ void MainWindow::onRunCOLMAPReconstruction()
     m_progressDialog->setWindowModality(Qt::WindowModal);
     m_progressDialog->setMinimumDuration(0);
     m_progressDialog->setValue(0);
-    connect(m_progressDialog, &QProgressDialog::canceled, m_colmapIntegration, &Photogrammetry::COLMAPIntegration::cancel);
+    connect(m_progressDialog, &QProgressDialog::canceled, colmapIntegration(), &Photogrammetry::COLMAPIntegration::cancel);
     m_progressDialog->show();
 
     // Start
-    m_colmapIntegration->runFullPipeline(config);
+    colmapIntegration()->runFullPipeline(config);
 }
 
 void MainWindow::onCOLMAPProgress(double progress, const QString& message)
@@ -774,7 +1406,7 @@ void MainWindow::onCOLMAPError(const QString& error)
 
 void MainWindow::onShowWeatherPanel()
 {
-    if (m_weatherDock->isHidden()) {
+    if (weatherDock()->isHidden()) {
         m_weatherDock->show();
 
         // Set location for weather if we have a flight plan
@@ -792,9 +1424,23 @@ void MainWindow::onShowWeatherPanel()
     m_showWeatherPanelAction->setChecked(!m_weatherDock->isHidden());
 }
 
+void MainWindow::onShowAltitudeProfile()
+{
+    if (altitudeProfileDock()->isHidden()) {
+        m_altitudeProfileDock->show();
+    } else {
+        m_altitudeProfileDock->hide();
+    }
+
+    m_showAltitudeProfileAction->setChecked(!m_altitudeProfileDock->isHidden());
+}
+
 void MainWindow::onToggle3DViewers()
 {
-    if (m_viewersDock->isHidden()) {
+    if (viewersDock()->isHidden()) {
+        if (m_viewersTab->count() == 0) {
+            terrainViewer();
+        }
         m_viewersDock->show();
         statusBar()->showMessage(tr("3D Viewers shown"), 3000);
     } else {
@@ -817,7 +1463,11 @@ void MainWindow::onLoadPointCloud()
 
     statusBar()->showMessage(tr("Loading point cloud..."), 0);
 
-    if (m_pointCloudViewer->loadPointCloud(fileName)) {
+    if (pointCloudViewer()->loadPointCloud(fileName)) {
+        m_sectionToolAction->setEnabled(true);
+        m_estimateNormalsAction->setEnabled(true);
+        m_classifyGroundAction->setEnabled(true);
+        m_compareCloudsAction->setEnabled(true);
         onShowPointCloudViewer();
         statusBar()->showMessage(
             tr("Point cloud loaded: %1").arg(QFileInfo(fileName).fileName()),
@@ -829,6 +1479,269 @@ void MainWindow::onLoadPointCloud()
     }
 }
 
+void MainWindow::onSectionTool(bool enabled)
+{
+    PointCloudViewer *viewer = pointCloudViewer();
+
+    if (!enabled) {
+        viewer->enableSectionMode(false);
+        statusBar()->showMessage(tr("Cross section tool off"), 3000);
+        return;
+    }
+
+    bool ok = false;
+    const double slabWidth = QInputDialog::getDouble(this, tr("Cross Section"),
+        tr("Slab width (m):"), 2.0, 0.1, 100.0, 1, &ok);
+
+    if (!ok) {
+        QSignalBlocker blocker(m_sectionToolAction);
+        m_sectionToolAction->setChecked(false);
+        return;
+    }
+
+    viewer->enableSectionMode(true, slabWidth);
+    onShowPointCloudViewer();
+    statusBar()->showMessage(tr("Drag across the point cloud to cut a section"), 5000);
+}
+
+void MainWindow::onExportSection()
+{
+    if (!m_pointCloudViewer || m_pointCloudViewer->section().isEmpty()) {
+        return;
+    }
+
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("Export Section"),
+        QDir::homePath() + "/section.csv",
+        tr("CSV Files (*.csv);;DXF Files (*.dxf)"),
+        &selectedFilter);
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    const bool dxf = fileName.endsWith(".dxf", Qt::CaseInsensitive) ||
+                     (QFileInfo(fileName).suffix().isEmpty() && selectedFilter.contains("dxf"));
+    if (QFileInfo(fileName).suffix().isEmpty()) {
+        fileName += dxf ? ".dxf" : ".csv";
+    }
+
+    const QVector<SectionPoint>& section = m_pointCloudViewer->section();
+    const bool written = dxf ? CrossSection::exportDXF(section, fileName)
+                             : CrossSection::exportCSV(section, m_pointCloudViewer->pointCloud(), fileName);
+
+    if (written) {
+        statusBar()->showMessage(
+            tr("Section exported: %1 (%2 points)").arg(QFileInfo(fileName).fileName()).arg(section.size()),
+            5000);
+    } else {
+        QMessageBox::critical(this, tr("Export Error"),
+            tr("Failed to write section to:\n%1").arg(fileName));
+    }
+}
+
+void MainWindow::onEstimateNormals()
+{
+    if (!m_pointCloudViewer) {
+        return;
+    }
+
+    if (m_pointCloudViewer->pointCloud().size() < 3) {
+        QMessageBox::warning(this, tr("Estimate Normals"), tr("Not enough points to estimate normals."));
+        return;
+    }
+
+    // Aerial clouds: orient toward the up-vector so the result does not depend on the view
+    NormalEstimator::Options options;
+    options.orientation = NormalEstimator::TowardUp;
+
+    // Processed on a copy; the viewer keeps drawing the loaded cloud meanwhile
+    PointCloud cloud = m_pointCloudViewer->pointCloud();
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+
+    QProgressDialog *progress = new QProgressDialog(tr("Estimating normals..."), tr("Cancel"), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    connect(progress, &QProgressDialog::canceled, this, [cancelled]() {
+        cancelled->store(true, std::memory_order_relaxed);
+    });
+    progress->show();
+    m_estimateNormalsAction->setEnabled(false);
+
+    auto *watcher = new QFutureWatcher<PointCloud>(this);
+    connect(watcher, &QFutureWatcher<PointCloud>::finished, this,
+            [this, watcher, progress, cancelled]() {
+        watcher->deleteLater();
+        progress->deleteLater();
+        m_estimateNormalsAction->setEnabled(true);
+
+        if (cancelled->load(std::memory_order_relaxed)) {
+            statusBar()->showMessage(tr("Normal estimation cancelled"), 3000);
+            return;
+        }
+
+        const PointCloud result = watcher->result();
+        if (m_pointCloudViewer->updatePointAttributes(result)) {
+            statusBar()->showMessage(tr("Estimated normals for %1 points").arg(result.size()), 5000);
+        }
+    });
+
+    watcher->setFuture(QtConcurrent::run([cloud, options, cancelled]() mutable {
+        NormalEstimator::estimate(cloud, options, cancelled.get());
+        return cloud;
+    }));
+}
+
+void MainWindow::onClassifyGround()
+{
+    if (!m_pointCloudViewer || m_pointCloudViewer->pointCloud().isEmpty()) {
+        return;
+    }
+
+    bool ok = false;
+    const double cellSize = QInputDialog::getDouble(this, tr("Classify Ground"),
+        tr("Cell size (m):"), 1.0, 0.1, 10.0, 1, &ok);
+    if (!ok) {
+        return;
+    }
+
+    GroundClassifier::Options options;
+    options.cellSize = cellSize;
+
+    // Classified on a copy; the viewer keeps drawing the loaded cloud meanwhile
+    PointCloud cloud = m_pointCloudViewer->pointCloud();
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+
+    QProgressDialog *progress = new QProgressDialog(tr("Classifying ground..."), tr("Cancel"), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    connect(progress, &QProgressDialog::canceled, this, [cancelled]() {
+        cancelled->store(true, std::memory_order_relaxed);
+    });
+    progress->show();
+    m_classifyGroundAction->setEnabled(false);
+
+    using Classified = QPair<PointCloud, GroundClassifier::Result>;
+    auto *watcher = new QFutureWatcher<Classified>(this);
+    connect(watcher, &QFutureWatcher<Classified>::finished, this,
+            [this, watcher, progress, cancelled]() {
+        watcher->deleteLater();
+        progress->deleteLater();
+        m_classifyGroundAction->setEnabled(true);
+
+        if (cancelled->load(std::memory_order_relaxed)) {
+            statusBar()->showMessage(tr("Ground classification cancelled"), 3000);
+            return;
+        }
+
+        const Classified classified = watcher->result();
+        const GroundClassifier::Result& result = classified.second;
+        if (m_pointCloudViewer->showGroundClassification(classified.first)) {
+            statusBar()->showMessage(
+                tr("Ground: %1 points, other: %2 points (%3 tiles, %4 ms)")
+                    .arg(result.groundPoints)
+                    .arg(result.unclassifiedPoints)
+                    .arg(result.tiles)
+                    .arg(result.elapsedMs),
+                5000);
+        }
+    });
+
+    watcher->setFuture(QtConcurrent::run([cloud, options, cancelled]() mutable {
+        GroundClassifier::Result result = GroundClassifier::classify(cloud, options, cancelled.get());
+        return qMakePair(cloud, result);
+    }));
+}
+
+void MainWindow::onCompareClouds()
+{
+    if (!m_pointCloudViewer || m_pointCloudViewer->pointCloud().isEmpty()) {
+        return;
+    }
+
+    QString referencePath = QFileDialog::getOpenFileName(
+        this,
+        tr("Select Reference Point Cloud (Earlier Epoch)"),
+        QFileInfo(m_pointCloudViewer->pointCloud().fileName).absolutePath(),
+        tr("Point Cloud Files (*.ply *.las *.laz *.xyz *.txt);;All Files (*.*)"));
+    if (referencePath.isEmpty()) {
+        return;
+    }
+
+    const QStringList methods = { tr("Local plane (signed, M3C2-style)"), tr("Nearest neighbour (unsigned)") };
+    bool ok = false;
+    const QString method = QInputDialog::getItem(this, tr("Compare Point Clouds"),
+        tr("Distance:"), methods, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+
+    CloudComparator::Options options;
+    options.method = (method == methods.first()) ? CloudComparator::LocalPlane
+                                                 : CloudComparator::NearestNeighbour;
+
+    // Distances go into a copy; the viewer keeps drawing the loaded cloud meanwhile
+    PointCloud cloud = m_pointCloudViewer->pointCloud();
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+
+    QProgressDialog *progress = new QProgressDialog(tr("Comparing point clouds..."), tr("Cancel"), 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(0);
+    connect(progress, &QProgressDialog::canceled, this, [cancelled]() {
+        cancelled->store(true, std::memory_order_relaxed);
+    });
+    progress->show();
+    m_compareCloudsAction->setEnabled(false);
+
+    using Compared = QPair<PointCloud, CloudComparator::Result>;
+    auto *watcher = new QFutureWatcher<Compared>(this);
+    connect(watcher, &QFutureWatcher<Compared>::finished, this,
+            [this, watcher, progress, cancelled, referencePath]() {
+        watcher->deleteLater();
+        progress->deleteLater();
+        m_compareCloudsAction->setEnabled(true);
+
+        if (cancelled->load(std::memory_order_relaxed)) {
+            statusBar()->showMessage(tr("Point cloud comparison cancelled"), 3000);
+            return;
+        }
+
+        const Compared compared = watcher->result();
+        const CloudComparator::Result& result = compared.second;
+        if (result.pointCount == 0) {
+            QMessageBox::critical(this, tr("Comparison Error"),
+                tr("Failed to compare against:\n%1").arg(referencePath));
+            return;
+        }
+
+        if (m_pointCloudViewer->showDistances(compared.first, result)) {
+            QMessageBox::information(this, tr("Point Cloud Comparison"),
+                tr("%1 points compared against %2\n\n"
+                   "Mean distance: %3 m\n"
+                   "RMS distance: %4 m\n"
+                   "Range: %5 m to %6 m (%7 ms)")
+                .arg(result.pointCount)
+                .arg(QFileInfo(referencePath).fileName())
+                .arg(result.meanDistance, 0, 'f', 3)
+                .arg(result.rmsDistance, 0, 'f', 3)
+                .arg(result.minDistance, 0, 'f', 3)
+                .arg(result.maxDistance, 0, 'f', 3)
+                .arg(result.elapsedMs));
+        }
+    });
+
+    watcher->setFuture(QtConcurrent::run([cloud, referencePath, options, cancelled]() mutable {
+        PointCloud reference;
+        CloudComparator::Result result;
+        if (reference.loadFromFile(referencePath)) {
+            result = CloudComparator::compare(reference, cloud, options, cancelled.get());
+        }
+        return qMakePair(cloud, result);
+    }));
+}
+
 void MainWindow::onLoadDEM()
 {
     QString fileName = QFileDialog::getOpenFileName(
@@ -843,8 +1756,27 @@ void MainWindow::onLoadDEM()
 
     statusBar()->showMessage(tr("Loading DEM..."), 0);
 
-    if (m_terrainViewer->loadDEM(fileName)) {
+    if (terrainViewer()->loadDEM(fileName)) {
         onShowTerrainViewer();
+
+        // Plans are checked for line of sight over the same terrain
+        m_validationService->setTerrain(m_terrainViewer->demData());
+        if (m_altitudeProfile) {
+            m_altitudeProfile->setDEMData(m_terrainViewer->demData());
+        }
+        m_showViewshedAction->setEnabled(true);
+        m_exportContoursAction->setEnabled(true);
+        if (m_showViewshedAction->isChecked()) {
+            onShowViewshed(true);
+        }
+
+        // Same DEM drives the map's hillshade overlay
+        if (mapWidget()->tileHandler()->overlays()->setElevationSource(fileName)) {
+            mapWidget()->refreshOverlay("hillshade");
+            m_showHillshadeAction->setEnabled(true);
+            m_showHillshadeAction->setChecked(true);
+        }
+
         statusBar()->showMessage(
             tr("DEM loaded: %1").arg(QFileInfo(fileName).fileName()),
             5000);
@@ -855,6 +1787,80 @@ void MainWindow::onLoadDEM()
     }
 }
 
+void MainWindow::onLoadOrthomosaic()
+{
+    QString fileName = QFileDialog::getOpenFileName(
+        this,
+        tr("Load Orthomosaic"),
+        QDir::homePath(),
+        tr("GeoTIFF (*.tif *.tiff);;All Files (*.*)"));
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (mapWidget()->tileHandler()->overlays()->setOrthoSource(fileName)) {
+        mapWidget()->refreshOverlay("ortho");
+        m_showOrthoAction->setEnabled(true);
+        m_showOrthoAction->setChecked(true);
+        statusBar()->showMessage(
+            tr("Orthomosaic loaded: %1").arg(QFileInfo(fileName).fileName()),
+            5000);
+    } else {
+        QMessageBox::critical(this, tr("Load Error"),
+            tr("Failed to load orthomosaic from:\n%1").arg(fileName));
+        statusBar()->showMessage(tr("Failed to load orthomosaic"), 5000);
+    }
+}
+
+void MainWindow::onShowHillshade(bool visible)
+{
+    mapWidget()->setOverlayVisible("hillshade", visible);
+}
+
+void MainWindow::onShowOrthoOverlay(bool visible)
+{
+    mapWidget()->setOverlayVisible("ortho", visible);
+}
+
+void MainWindow::onShowCoverageOverlay(bool visible)
+{
+    // Footprints are only computed while the layer is shown
+    updateCoverageOverlay();
+    mapWidget()->setOverlayVisible("coverage", visible);
+}
+
+void MainWindow::onWorkOffline(bool offline)
+{
+    mapWidget()->tileHandler()->setOnlineFetching(!offline);
+    statusBar()->showMessage(offline ? tr("Working offline: cached map tiles only")
+                                     : tr("Working online: missing map tiles are downloaded"), 3000);
+}
+
+void MainWindow::updateCoverageOverlay()
+{
+    if (!m_showCoverageAction->isChecked()) {
+        return;
+    }
+
+    TRACE_SCOPE("planning", "MainWindow::updateCoverageOverlay");
+
+    const QVector<QPolygonF> footprints = m_currentFlightPlan ? photoFootprints(*m_currentFlightPlan)
+                                                              : QVector<QPolygonF>();
+    mapWidget()->tileHandler()->overlays()->setCoverageFootprints(footprints);
+    mapWidget()->refreshOverlay("coverage");
+}
+
+void MainWindow::updateAltitudeProfile()
+{
+    if (!m_altitudeProfile) {
+        return;
+    }
+
+    // Legs the edit did not touch keep their sampled terrain
+    m_altitudeProfile->setFlightPlan(m_currentFlightPlan ? *m_currentFlightPlan : Models::FlightPlan());
+}
+
 void MainWindow::onPreviewMission()
 {
     if (!m_currentFlightPlan) {
@@ -964,5 +1970,41 @@ void MainWindow::onGenerateReport()
     }
 }
 
+void MainWindow::onRecordTrace(bool enabled)
+{
+    if (enabled == Core::Tracer::isEnabled()) {
+        return;
+    }
+
+    if (enabled) {
+        Core::Tracer::start();
+        statusBar()->showMessage(tr("Recording performance trace..."), 5000);
+    } else {
+        Core::Tracer::stop();
+        statusBar()->showMessage(tr("Performance trace stopped"), 5000);
+    }
+}
+
+void MainWindow::onSaveTrace()
+{
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("Save Performance Trace"),
+        QDir::homePath() + "/dronemapper_trace.json",
+        tr("Chrome Trace Files (*.json)"));
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QString error;
+    if (Core::Tracer::writeChromeTrace(fileName, &error)) {
+        statusBar()->showMessage(tr("Trace saved: %1 (open in ui.perfetto.dev or chrome://tracing)")
+                                 .arg(QFileInfo(fileName).fileName()), 5000);
+    } else {
+        QMessageBox::critical(this, tr("Trace Error"), error);
+    }
+}
+
 } // namespace UI
 } // namespace DroneMapper
@@ -23,6 +23,11 @@ void MapBridge::onAreaDrawn(const QString& geojson)
     emit areaDrawn(geojson);
 }
 
+void MapBridge::onAreaVertexMoved(int vertex, double lat, double lng)
+{
+    emit areaVertexMoved(vertex, lat, lng);
+}
+
 void MapBridge::onGenerateFlightPlan(const QString& geojson)
 {
     LOG_INFO("Flight plan generation requested");
@@ -40,5 +45,16 @@ void MapBridge::onMapClick(double lat, double lng)
     emit mapClicked(lat, lng);
 }
 
+void MapBridge::onFlightPathResync()
+{
+    LOG_DEBUG("Flight path resync requested by map");
+    emit flightPathResyncRequested();
+}
+
+void MapBridge::onViewportChanged(double zoom, double west, double south, double east, double north)
+{
+    emit viewportChanged(zoom, west, south, east, north);
+}
+
 } // namespace UI
 } // namespace DroneMapper
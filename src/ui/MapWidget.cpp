@@ -3,21 +3,35 @@
 #include <QVBoxLayout>
 #include <QWebEnginePage>
 #include <QWebEngineSettings>
+#include <QWebEngineProfile>
 #include <QFile>
 #include <QDir>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QStandardPaths>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
 
 namespace DroneMapper {
 namespace UI {
 
+namespace {
+
+constexpr int PATH_STRIDE = 3;  // lon, lat, alt
+constexpr int LOD_WAYPOINT_THRESHOLD = 2000;
+
+} // namespace
+
 MapWidget::MapWidget(QWidget *parent)
     : QWidget(parent)
     , m_webView(new QWebEngineView(this))
     , m_channel(new QWebChannel(this))
     , m_bridge(new MapBridge(this))
+    , m_tileHandler(TileSchemeHandler::install(m_webView->page()->profile()))
+    , m_mapReady(false)
+    , m_viewZoom(0.0)
 {
     // Setup layout
     QVBoxLayout* layout = new QVBoxLayout(this);
@@ -35,7 +49,10 @@ MapWidget::MapWidget(QWidget *parent)
     // Connect bridge signals
     connect(m_bridge, &MapBridge::mapReady, this, &MapWidget::onMapReady);
     connect(m_bridge, &MapBridge::areaDrawn, this, &MapWidget::onAreaDrawn);
+    connect(m_bridge, &MapBridge::areaVertexMoved, this, &MapWidget::areaVertexMoved);
     connect(m_bridge, &MapBridge::flightPlanRequested, this, &MapWidget::onFlightPlanRequested);
+    connect(m_bridge, &MapBridge::flightPathResyncRequested, this, &MapWidget::onFlightPathResyncRequested);
+    connect(m_bridge, &MapBridge::viewportChanged, this, &MapWidget::onViewportChanged);
 
     // Load map
     QString html = loadMapHtml();
@@ -123,10 +140,83 @@ void MapWidget::setCenter(double latitude, double longitude, int zoom)
 
 void MapWidget::displayFlightPath(const Models::FlightPlan& plan)
 {
-    QString geojson = flightPlanToGeoJson(plan);
-    QString js = QString("if (typeof displayFlightPath === 'function') { displayFlightPath('%1'); }")
-                .arg(geojson.replace("'", "\\'"));
-    m_webView->page()->runJavaScript(js);
+    const auto& waypoints = plan.waypoints();
+
+    QVector<double> path;
+    path.reserve(waypoints.size() * PATH_STRIDE);
+    for (const auto& wp : waypoints) {
+        const auto& coord = wp.coordinate();
+        path.append(coord.longitude());
+        path.append(coord.latitude());
+        path.append(coord.altitude());
+    }
+
+    const QVector<double> previous = m_flightPath;
+    m_flightPath = path;
+
+    const int oldCount = previous.size() / PATH_STRIDE;
+    const int newCount = path.size() / PATH_STRIDE;
+    const bool lodWasActive = !m_pathLOD.isEmpty();
+
+    if (newCount > LOD_WAYPOINT_THRESHOLD) {
+        // Too many features for the page, send only what is visible
+        m_pathLOD.build(path);
+        if (m_mapReady) {
+            if (!lodWasActive) {
+                fitToFlightPath();
+            }
+            sendFlightPathView();
+        }
+        return;
+    }
+
+    m_pathLOD.clear();
+
+    if (!m_mapReady) {
+        // Sent as a reset once the page connects
+        return;
+    }
+
+    if (lodWasActive) {
+        // Page holds a viewport subset, not the full path
+        sendFlightPathReset();
+        return;
+    }
+
+    auto sameWaypoint = [&](int oldIndex, int newIndex) {
+        return std::equal(previous.constData() + oldIndex * PATH_STRIDE,
+                          previous.constData() + (oldIndex + 1) * PATH_STRIDE,
+                          path.constData() + newIndex * PATH_STRIDE);
+    };
+
+    // Single splice covering everything between the common prefix and suffix
+    const int shared = std::min(oldCount, newCount);
+    int prefix = 0;
+    while (prefix < shared && sameWaypoint(prefix, prefix)) {
+        ++prefix;
+    }
+    int suffix = 0;
+    while (suffix < shared - prefix &&
+           sameWaypoint(oldCount - 1 - suffix, newCount - 1 - suffix)) {
+        ++suffix;
+    }
+
+    const int removeCount = oldCount - prefix - suffix;
+    const int insertCount = newCount - prefix - suffix;
+
+    if (removeCount == 0 && insertCount == 0) {
+        return;
+    }
+
+    if (oldCount == 0 || insertCount > newCount / 2) {
+        // Mostly new plan, replacing is cheaper than patching
+        sendFlightPathReset();
+        return;
+    }
+
+    emit m_bridge->flightPathSpliced(prefix, removeCount, oldCount,
+                                     packCoordinates(path.constData() + prefix * PATH_STRIDE,
+                                                     insertCount * PATH_STRIDE));
 }
 
 void MapWidget::updateFlightInfo(double distance, int timeSeconds, int photoCount)
@@ -144,10 +234,34 @@ void MapWidget::updateFlightInfo(double distance, int timeSeconds, int photoCoun
 
 void MapWidget::clearMap()
 {
+    m_flightPath.clear();
+    m_pathLOD.clear();
+
     QString js = "if (typeof clearFlightPath === 'function') { clearFlightPath(); }";
     m_webView->page()->runJavaScript(js);
 }
 
+void MapWidget::setOverlayVisible(const QString& name, bool visible)
+{
+    if (visible) {
+        m_visibleOverlays.insert(name);
+    } else {
+        m_visibleOverlays.remove(name);
+    }
+
+    QString js = QString("if (typeof setOverlayVisible === 'function') { setOverlayVisible('%1', %2); }")
+                .arg(name)
+                .arg(visible ? "true" : "false");
+    m_webView->page()->runJavaScript(js);
+}
+
+void MapWidget::refreshOverlay(const QString& name)
+{
+    QString js = QString("if (typeof refreshOverlay === 'function') { refreshOverlay('%1'); }")
+                .arg(name);
+    m_webView->page()->runJavaScript(js);
+}
+
 void MapWidget::setBaseMap(const QString& type)
 {
     QString js = QString("if (typeof switchBaseMap === 'function') { switchBaseMap('%1'); }")
@@ -155,72 +269,68 @@ void MapWidget::setBaseMap(const QString& type)
     m_webView->page()->runJavaScript(js);
 }
 
-QString MapWidget::flightPlanToGeoJson(const Models::FlightPlan& plan)
+void MapWidget::sendFlightPathReset()
 {
-    QJsonObject geojson;
-    geojson["type"] = "FeatureCollection";
-
-    QJsonArray features;
-
-    // Add waypoints as Point features
-    const auto& waypoints = plan.waypoints();
-    for (int i = 0; i < waypoints.count(); ++i) {
-        const auto& wp = waypoints[i];
-        const auto& coord = wp.coordinate();
-
-        QJsonObject feature;
-        feature["type"] = "Feature";
-
-        QJsonObject geometry;
-        geometry["type"] = "Point";
-        QJsonArray coordinates;
-        coordinates.append(coord.longitude());
-        coordinates.append(coord.latitude());
-        geometry["coordinates"] = coordinates;
-        feature["geometry"] = geometry;
-
-        QJsonObject properties;
-        properties["number"] = i + 1;
-        properties["altitude"] = coord.altitude();
-        feature["properties"] = properties;
+    emit m_bridge->flightPathReset(packCoordinates(m_flightPath.constData(), m_flightPath.size()));
+}
 
-        features.append(feature);
+void MapWidget::sendFlightPathView()
+{
+    FlightPathLOD::View view;
+    if (m_viewBounds.isValid()) {
+        view = m_pathLOD.query(m_viewZoom, m_viewBounds.left(), m_viewBounds.top(),
+                               m_viewBounds.right(), m_viewBounds.bottom());
+    } else {
+        // Viewport not reported yet: whole path at the coarsest level
+        const QRectF bounds = m_pathLOD.bounds();
+        view = m_pathLOD.query(0.0, bounds.left(), bounds.top(), bounds.right(), bounds.bottom());
     }
 
-    // Add flight path as LineString
-    if (waypoints.count() > 1) {
-        QJsonObject lineFeature;
-        lineFeature["type"] = "Feature";
-
-        QJsonObject geometry;
-        geometry["type"] = "LineString";
-
-        QJsonArray coordinates;
-        for (const auto& wp : waypoints) {
-            const auto& coord = wp.coordinate();
-            QJsonArray point;
-            point.append(coord.longitude());
-            point.append(coord.latitude());
-            coordinates.append(point);
-        }
-        geometry["coordinates"] = coordinates;
-        lineFeature["geometry"] = geometry;
+    emit m_bridge->flightPathViewUpdated(packCoordinates(view.route.constData(), view.route.size()),
+                                         packCoordinates(view.waypoints.constData(), view.waypoints.size()),
+                                         packCoordinates(view.clusters.constData(), view.clusters.size()));
+}
 
-        QJsonObject properties;
-        properties["type"] = "flight-path";
-        lineFeature["properties"] = properties;
+void MapWidget::fitToFlightPath()
+{
+    const QRectF bounds = m_pathLOD.bounds();
+    QString js = QString("if (typeof fitToBounds === 'function') { fitToBounds(%1, %2, %3, %4); }")
+                .arg(bounds.left(), 0, 'f', 8)
+                .arg(bounds.top(), 0, 'f', 8)
+                .arg(bounds.right(), 0, 'f', 8)
+                .arg(bounds.bottom(), 0, 'f', 8);
+    m_webView->page()->runJavaScript(js);
+}
 
-        features.append(lineFeature);
+QString MapWidget::packCoordinates(const double* data, int count)
+{
+    // Little-endian doubles regardless of host order, decoded into a Float64Array by the page
+    QByteArray bytes(count * static_cast<int>(sizeof(double)), Qt::Uninitialized);
+    char* out = bytes.data();
+    for (int i = 0; i < count; ++i) {
+        quint64 bits;
+        std::memcpy(&bits, data + i, sizeof(bits));
+        qToLittleEndian(bits, out + i * sizeof(bits));
     }
-
-    geojson["features"] = features;
-
-    return QString::fromUtf8(QJsonDocument(geojson).toJson(QJsonDocument::Compact));
+    return QString::fromLatin1(bytes.toBase64());
 }
 
 void MapWidget::onMapReady()
 {
     LOG_INFO("Map ready signal received");
+
+    m_mapReady = true;
+    const QSet<QString> overlays = m_visibleOverlays;   // Enabled before the page had its layers
+    for (const QString& name : overlays) {
+        setOverlayVisible(name, true);
+    }
+
+    if (!m_pathLOD.isEmpty()) {
+        fitToFlightPath();
+        sendFlightPathView();
+    } else if (!m_flightPath.isEmpty()) {
+        sendFlightPathReset();
+    }
 }
 
 void MapWidget::onAreaDrawn(const QString& geojson)
@@ -235,5 +345,24 @@ void MapWidget::onFlightPlanRequested(const QString& geojson)
     emit flightPlanRequested();
 }
 
+void MapWidget::onFlightPathResyncRequested()
+{
+    if (!m_pathLOD.isEmpty()) {
+        sendFlightPathView();
+    } else {
+        sendFlightPathReset();
+    }
+}
+
+void MapWidget::onViewportChanged(double zoom, double west, double south, double east, double north)
+{
+    m_viewZoom = zoom;
+    m_viewBounds = QRectF(QPointF(west, south), QPointF(east, north));
+
+    if (!m_pathLOD.isEmpty()) {
+        sendFlightPathView();
+    }
+}
+
 } // namespace UI
 } // namespace DroneMapper
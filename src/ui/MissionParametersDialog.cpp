@@ -278,6 +278,25 @@ QWidget* MissionParametersDialog::createAdvancedTab()
     m_maxSpeedSpinBox->setSuffix(" m/s");
     layout->addRow(tr("Maximum Speed:"), m_maxSpeedSpinBox);
 
+    // Boundary inset
+    m_boundaryInsetSpinBox = new QDoubleSpinBox();
+    m_boundaryInsetSpinBox->setRange(0.0, 100.0);
+    m_boundaryInsetSpinBox->setSingleStep(1.0);
+    m_boundaryInsetSpinBox->setValue(0.0);
+    m_boundaryInsetSpinBox->setSuffix(" m");
+    m_boundaryInsetSpinBox->setToolTip(tr("Keep flight lines this far inside the survey boundary"));
+    layout->addRow(tr("Boundary Inset:"), m_boundaryInsetSpinBox);
+
+    // Turn overshoot
+    m_turnOvershootSpinBox = new QDoubleSpinBox();
+    m_turnOvershootSpinBox->setRange(0.0, 100.0);
+    m_turnOvershootSpinBox->setSingleStep(1.0);
+    m_turnOvershootSpinBox->setValue(0.0);
+    m_turnOvershootSpinBox->setSuffix(" m");
+    m_turnOvershootSpinBox->setToolTip(tr("Extend each line past the boundary so turns happen "
+                                          "outside the survey (never into a no-fly zone)"));
+    layout->addRow(tr("Turn Overshoot:"), m_turnOvershootSpinBox);
+
     layout->addRow(new QLabel(tr("\nNote: Advanced settings affect mission behavior.\n"
                                   "Modify only if you understand the implications."), this));
 
@@ -514,6 +533,8 @@ void MissionParametersDialog::loadDefaults()
     m_patternTypeCombo->setCurrentIndex(1);
     m_finishActionCombo->setCurrentIndex(0);
     m_reversePathCheckBox->setChecked(false);
+    m_boundaryInsetSpinBox->setValue(0.0);
+    m_turnOvershootSpinBox->setValue(0.0);
 
     updateCameraInfo();
     updateEstimates();
@@ -553,6 +574,8 @@ Models::MissionParameters MissionParametersDialog::parameters() const
     params.setFlightSpeed(m_speedSpinBox->value());
     params.setFlightDirection(m_flightDirectionSpinBox->value());
     params.setReversePath(m_reversePathCheckBox->isChecked());
+    params.setBoundaryInset(m_boundaryInsetSpinBox->value());
+    params.setTurnOvershoot(m_turnOvershootSpinBox->value());
 
     params.setCameraModel(static_cast<Models::MissionParameters::CameraModel>(
         m_cameraModelCombo->currentData().toInt()));
@@ -585,6 +608,8 @@ void MissionParametersDialog::setParameters(const Models::MissionParameters& par
     m_speedSpinBox->setValue(params.flightSpeed());
     m_flightDirectionSpinBox->setValue(params.flightDirection());
     m_reversePathCheckBox->setChecked(params.reversePath());
+    m_boundaryInsetSpinBox->setValue(params.boundaryInset());
+    m_turnOvershootSpinBox->setValue(params.turnOvershoot());
 
     // Set camera model by finding matching index
     for (int i = 0; i < m_cameraModelCombo->count(); ++i) {
@@ -0,0 +1,263 @@
+#include "NormalEstimator.h"
+#include "PointCloudKDTree.h"
+#include "PointCloudViewer.h"
+#include "Logger.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <QElapsedTimer>
+#include <QPair>
+#include <cmath>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int MAX_NEIGHBORS = 64;
+
+inline float signNotZero(float v)
+{
+    return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+QVector<QPair<int, int>> makeChunks(int count, int chunkSize)
+{
+    QVector<QPair<int, int>> chunks;
+    chunkSize = std::max(chunkSize, 1);
+    chunks.reserve(count / chunkSize + 1);
+    for (int begin = 0; begin < count; begin += chunkSize) {
+        chunks.append(qMakePair(begin, std::min(begin + chunkSize, count)));
+    }
+    return chunks;
+}
+
+} // namespace
+
+bool NormalEstimator::estimate(PointCloud& cloud, const Options& options,
+                               const std::atomic<bool>* cancelled)
+{
+    if (cloud.size() < 3) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    PointCloudKDTree tree;
+    tree.build(cloud);
+
+    qint64 buildMs = timer.elapsed();
+
+    QVector<quint16> estimated = estimatePacked(cloud, tree, options, cancelled);
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+        return false;
+    }
+    cloud.packedNormals = estimated;
+
+    // Decode into Point::normal so the existing renderers see them
+    const quint16* packed = cloud.packedNormals.constData();
+    Point* points = cloud.points.data();
+    QVector<QPair<int, int>> chunks = makeChunks(cloud.size(), options.chunkSize);
+
+    QtConcurrent::blockingMap(chunks, [packed, points](const QPair<int, int>& chunk) {
+        for (int i = chunk.first; i < chunk.second; ++i) {
+            points[i].normal = decodeOct(packed[i]);
+        }
+    });
+
+    cloud.hasNormals = true;
+
+    LOG_INFO(QString("Estimated %1 normals (k=%2) in %3 ms (KD-tree %4 ms)")
+        .arg(cloud.size())
+        .arg(options.neighbors)
+        .arg(timer.elapsed())
+        .arg(buildMs));
+
+    return true;
+}
+
+QVector<quint16> NormalEstimator::estimatePacked(
+    const PointCloud& cloud,
+    const PointCloudKDTree& tree,
+    const Options& options,
+    const std::atomic<bool>* cancelled)
+{
+    QVector<quint16> packed(cloud.size());
+
+    if (cloud.isEmpty() || tree.isEmpty()) {
+        return packed;
+    }
+
+    const int k = std::clamp(options.neighbors, 3, MAX_NEIGHBORS);
+    const Point* points = cloud.points.constData();
+    quint16* out = packed.data();
+    QVector<QPair<int, int>> chunks = makeChunks(cloud.size(), options.chunkSize);
+
+    QtConcurrent::blockingMap(chunks, [&, points, out, k](const QPair<int, int>& chunk) {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        int indices[MAX_NEIGHBORS];
+        float distancesSq[MAX_NEIGHBORS];
+        QVector3D neighbors[MAX_NEIGHBORS];
+
+        for (int i = chunk.first; i < chunk.second; ++i) {
+            const QVector3D& position = points[i].position;
+
+            int found = tree.knn(position, k, indices, distancesSq);
+            for (int n = 0; n < found; ++n) {
+                neighbors[n] = points[indices[n]].position;
+            }
+
+            QVector3D normal = fitNormal(neighbors, found, options.up);
+
+            // Orient consistently
+            QVector3D reference = (options.orientation == TowardViewpoint)
+                ? options.viewpoint - position
+                : options.up;
+
+            if (QVector3D::dotProduct(normal, reference) < 0.0f) {
+                normal = -normal;
+            }
+
+            out[i] = encodeOct(normal);
+        }
+    });
+
+    return packed;
+}
+
+QVector3D NormalEstimator::fitNormal(const QVector3D* points, int count, const QVector3D& up)
+{
+    if (count < 3) {
+        return up.normalized();
+    }
+
+    // Mean-centred covariance in double precision; positions may be
+    // large projected coordinates
+    double mx = 0.0, my = 0.0, mz = 0.0;
+    for (int i = 0; i < count; ++i) {
+        mx += points[i].x();
+        my += points[i].y();
+        mz += points[i].z();
+    }
+    mx /= count;
+    my /= count;
+    mz /= count;
+
+    double cxx = 0.0, cxy = 0.0, cxz = 0.0, cyy = 0.0, cyz = 0.0, czz = 0.0;
+    for (int i = 0; i < count; ++i) {
+        double dx = points[i].x() - mx;
+        double dy = points[i].y() - my;
+        double dz = points[i].z() - mz;
+        cxx += dx * dx;
+        cxy += dx * dy;
+        cxz += dx * dz;
+        cyy += dy * dy;
+        cyz += dy * dz;
+        czz += dz * dz;
+    }
+
+    return smallestEigenvector(cxx, cxy, cxz, cyy, cyz, czz, up.normalized());
+}
+
+QVector3D NormalEstimator::smallestEigenvector(
+    double a00, double a01, double a02,
+    double a11, double a12, double a22,
+    const QVector3D& fallback)
+{
+    // Trigonometric solution of the characteristic cubic (Smith, 1961)
+    double p1 = a01 * a01 + a02 * a02 + a12 * a12;
+    double q = (a00 + a11 + a22) / 3.0;
+    double b00 = a00 - q;
+    double b11 = a11 - q;
+    double b22 = a22 - q;
+    double p2 = b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * p1;
+
+    if (p2 <= 1e-30) {
+        return fallback;  // Isotropic neighbourhood
+    }
+
+    double p = std::sqrt(p2 / 6.0);
+    double det = b00 * (b11 * b22 - a12 * a12)
+               - a01 * (a01 * b22 - a12 * a02)
+               + a02 * (a01 * a12 - b11 * a02);
+    double r = std::clamp(det / (2.0 * p * p * p), -1.0, 1.0);
+    double phi = std::acos(r) / 3.0;
+
+    // Smallest of the three roots
+    double lambda = q + 2.0 * p * std::cos(phi + 2.0 * M_PI / 3.0);
+
+    // Eigenvector is orthogonal to the rows of (A - lambda*I); take the
+    // best-conditioned cross product of row pairs
+    double r0x = a00 - lambda, r0y = a01, r0z = a02;
+    double r1x = a01, r1y = a11 - lambda, r1z = a12;
+    double r2x = a02, r2y = a12, r2z = a22 - lambda;
+
+    double c0x = r0y * r1z - r0z * r1y, c0y = r0z * r1x - r0x * r1z, c0z = r0x * r1y - r0y * r1x;
+    double c1x = r0y * r2z - r0z * r2y, c1y = r0z * r2x - r0x * r2z, c1z = r0x * r2y - r0y * r2x;
+    double c2x = r1y * r2z - r1z * r2y, c2y = r1z * r2x - r1x * r2z, c2z = r1x * r2y - r1y * r2x;
+
+    double d0 = c0x * c0x + c0y * c0y + c0z * c0z;
+    double d1 = c1x * c1x + c1y * c1y + c1z * c1z;
+    double d2 = c2x * c2x + c2y * c2y + c2z * c2z;
+
+    double ex = c0x, ey = c0y, ez = c0z, dmax = d0;
+    if (d1 > dmax) { ex = c1x; ey = c1y; ez = c1z; dmax = d1; }
+    if (d2 > dmax) { ex = c2x; ey = c2y; ez = c2z; dmax = d2; }
+
+    if (dmax <= 1e-30) {
+        return fallback;  // Collinear neighbourhood, normal undefined
+    }
+
+    double inv = 1.0 / std::sqrt(dmax);
+    return QVector3D(static_cast<float>(ex * inv),
+                     static_cast<float>(ey * inv),
+                     static_cast<float>(ez * inv));
+}
+
+quint16 NormalEstimator::encodeOct(const QVector3D& normal)
+{
+    float l1 = std::abs(normal.x()) + std::abs(normal.y()) + std::abs(normal.z());
+    if (l1 <= 0.0f) {
+        return encodeOct(QVector3D(0, 0, 1));
+    }
+
+    float px = normal.x() / l1;
+    float py = normal.y() / l1;
+
+    // Fold the lower hemisphere over the diagonals
+    if (normal.z() < 0.0f) {
+        float ox = (1.0f - std::abs(py)) * signNotZero(px);
+        float oy = (1.0f - std::abs(px)) * signNotZero(py);
+        px = ox;
+        py = oy;
+    }
+
+    auto quantize = [](float v) -> quint8 {
+        int q = static_cast<int>(std::lround(std::clamp(v, -1.0f, 1.0f) * 127.0f));
+        return static_cast<quint8>(static_cast<qint8>(q));
+    };
+
+    return static_cast<quint16>(quantize(px) | (quantize(py) << 8));
+}
+
+QVector3D NormalEstimator::decodeOct(quint16 packed)
+{
+    float px = static_cast<qint8>(packed & 0xFF) / 127.0f;
+    float py = static_cast<qint8>(packed >> 8) / 127.0f;
+    float pz = 1.0f - std::abs(px) - std::abs(py);
+
+    if (pz < 0.0f) {
+        float ox = (1.0f - std::abs(py)) * signNotZero(px);
+        float oy = (1.0f - std::abs(px)) * signNotZero(py);
+        px = ox;
+        py = oy;
+    }
+
+    return QVector3D(px, py, pz).normalized();
+}
+
+} // namespace UI
+} // namespace DroneMapper
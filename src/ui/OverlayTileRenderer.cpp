@@ -0,0 +1,395 @@
+#include "OverlayTileRenderer.h"
+#include "geospatial/RasterTileReader.h"
+#include "Logger.h"
+#include <QImage>
+#include <QPainter>
+#include <QBuffer>
+#include <QMutexLocker>
+#include <cmath>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int TILE_PIXELS = 256;
+constexpr double EARTH_RADIUS = 6378137.0;
+constexpr double WORLD_HALF = M_PI * EARTH_RADIUS;  // Web Mercator half extent (meters)
+constexpr double MAX_DOWNSAMPLE = 64.0;              // Coarsest tile pixel per raster pixel
+
+// Hillshade light: sun from the north-west, 45 degrees up
+constexpr double LIGHT_AZIMUTH = 315.0;
+constexpr double LIGHT_ALTITUDE = 45.0;
+
+QByteArray encodePng(const QImage& image)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return data;
+}
+
+QPointF toMercator(const QPointF& lonLat)
+{
+    const double lat = std::clamp(lonLat.y(), -85.05112878, 85.05112878) * M_PI / 180.0;
+    return QPointF(lonLat.x() * M_PI / 180.0 * EARTH_RADIUS,
+                   EARTH_RADIUS * std::log(std::tan(M_PI / 4.0 + lat / 2.0)));
+}
+
+} // namespace
+
+OverlayTileRenderer::OverlayTileRenderer(int cacheBytes)
+    : m_cache(cacheBytes)
+    , m_generation(0)
+{
+}
+
+OverlayTileRenderer::~OverlayTileRenderer()
+{
+}
+
+bool OverlayTileRenderer::layerFromName(const QString& name, Layer* layer)
+{
+    if (name == "hillshade") {
+        *layer = Layer::Hillshade;
+    } else if (name == "ortho") {
+        *layer = Layer::Ortho;
+    } else if (name == "coverage") {
+        *layer = Layer::Coverage;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool OverlayTileRenderer::setElevationSource(const QString& filePath)
+{
+    QMutexLocker locker(&m_elevationMutex);
+    m_elevation.reset();
+
+    if (!filePath.isEmpty()) {
+        auto reader = std::make_unique<Geospatial::RasterTileReader>();
+        if (!reader->open(filePath) || !reader->reprojectTo(Geospatial::RasterTileReader::wktForEPSG(3857))) {
+            LOG_ERROR("Hillshade overlay: " + reader->lastError());
+            return false;
+        }
+        m_elevation = std::move(reader);
+    }
+
+    locker.unlock();
+    clearCache();
+    return true;
+}
+
+bool OverlayTileRenderer::setOrthoSource(const QString& filePath)
+{
+    QMutexLocker locker(&m_orthoMutex);
+    m_ortho.reset();
+
+    if (!filePath.isEmpty()) {
+        auto reader = std::make_unique<Geospatial::RasterTileReader>();
+        if (!reader->open(filePath) || !reader->reprojectTo(Geospatial::RasterTileReader::wktForEPSG(3857))) {
+            LOG_ERROR("Ortho overlay: " + reader->lastError());
+            return false;
+        }
+        m_ortho = std::move(reader);
+    }
+
+    locker.unlock();
+    clearCache();
+    return true;
+}
+
+void OverlayTileRenderer::setCoverageFootprints(const QVector<QPolygonF>& footprints)
+{
+    QVector<Footprint> projected;
+    projected.reserve(footprints.size());
+
+    for (const auto& polygon : footprints) {
+        Footprint footprint;
+        for (const auto& point : polygon) {
+            footprint.polygon.append(toMercator(point));
+        }
+        footprint.bounds = footprint.polygon.boundingRect();
+        projected.append(footprint);
+    }
+
+    {
+        QMutexLocker locker(&m_footprintMutex);
+        m_footprints = projected;
+    }
+    clearCache();
+}
+
+QByteArray OverlayTileRenderer::tile(Layer layer, int zoom, int x, int y)
+{
+    const int tiles = 1 << std::clamp(zoom, 0, 30);
+    if (zoom < 0 || zoom > 30 || x < 0 || y < 0 || x >= tiles || y >= tiles) {
+        return QByteArray();
+    }
+
+    const QString key = QString("%1/%2/%3/%4").arg(static_cast<int>(layer)).arg(zoom).arg(x).arg(y);
+
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        if (QByteArray* cached = m_cache.object(key)) {
+            return *cached;
+        }
+        generation = m_generation;
+    }
+
+    const TileBounds bounds = tileBounds(zoom, x, y);
+    QByteArray png;
+
+    switch (layer) {
+    case Layer::Hillshade:
+        png = renderHillshade(bounds);
+        break;
+    case Layer::Ortho:
+        png = renderOrtho(bounds);
+        break;
+    case Layer::Coverage:
+        png = renderCoverage(bounds);
+        break;
+    }
+
+    {
+        // Empty tiles are cached too (cost 1); a source change while rendering makes this one stale
+        QMutexLocker locker(&m_cacheMutex);
+        if (generation == m_generation) {
+            m_cache.insert(key, new QByteArray(png), std::max(static_cast<int>(png.size()), 1));
+        }
+    }
+
+    return png;
+}
+
+void OverlayTileRenderer::clearCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_cache.clear();
+    m_generation++;
+}
+
+OverlayTileRenderer::TileBounds OverlayTileRenderer::tileBounds(int zoom, int x, int y)
+{
+    const double span = 2.0 * WORLD_HALF / (1 << zoom);
+    return TileBounds{ -WORLD_HALF + x * span, WORLD_HALF - y * span, span / TILE_PIXELS };
+}
+
+bool OverlayTileRenderer::readTile(Geospatial::RasterTileReader& reader, const TileBounds& tile,
+                                   int band, int border, QVector<float>& values, QRect& area)
+{
+    if (tile.pixelSize > reader.pixelWidth() * MAX_DOWNSAMPLE) {
+        // Too far out to be useful, and would read the whole raster
+        return false;
+    }
+
+    // Raster extent in tile pixels, plus a border for neighbourhood operators
+    auto clampPixel = [border](double value) {
+        return static_cast<int>(std::clamp(value, -static_cast<double>(border),
+                                           static_cast<double>(TILE_PIXELS + border)));
+    };
+
+    const int c0 = clampPixel(std::floor((reader.minX() - tile.minX) / tile.pixelSize));
+    const int c1 = clampPixel(std::ceil((reader.maxX() - tile.minX) / tile.pixelSize));
+    const int r0 = clampPixel(std::floor((tile.maxY - reader.maxY()) / tile.pixelSize));
+    const int r1 = clampPixel(std::ceil((tile.maxY - reader.minY()) / tile.pixelSize));
+
+    if (c1 <= std::max(c0, 0) || std::min(c1, TILE_PIXELS) <= c0 ||
+        r1 <= std::max(r0, 0) || std::min(r1, TILE_PIXELS) <= r0) {
+        return false;
+    }
+
+    area = QRect(c0, r0, c1 - c0, r1 - r0);
+    values.resize(area.width() * area.height());
+
+    return reader.readWindow(tile.minX + c0 * tile.pixelSize, tile.maxY - r0 * tile.pixelSize,
+                             tile.pixelSize, area.width(), area.height(), values.data(), band);
+}
+
+QByteArray OverlayTileRenderer::renderHillshade(const TileBounds& tile)
+{
+    QVector<float> z;
+    QRect area;
+    {
+        QMutexLocker locker(&m_elevationMutex);
+        if (!m_elevation || !readTile(*m_elevation, tile, 1, 1, z, area)) {
+            return QByteArray();
+        }
+    }
+
+    // Ground size of a tile pixel: Mercator stretches by 1 / cos(latitude)
+    const double centerY = tile.maxY - TILE_PIXELS * tile.pixelSize / 2.0;
+    const double cell = tile.pixelSize / std::cosh(centerY / EARTH_RADIUS);
+
+    const double zenith = (90.0 - LIGHT_ALTITUDE) * M_PI / 180.0;
+    const double azimuth = (360.0 - LIGHT_AZIMUTH + 90.0) * M_PI / 180.0;
+    const double cosZenith = std::cos(zenith);
+    const double sinZenith = std::sin(zenith);
+
+    const int w = area.width();
+    const int h = area.height();
+    auto at = [&](int col, int row, float fallback) {
+        col = std::clamp(col, 0, w - 1);
+        row = std::clamp(row, 0, h - 1);
+        const float value = z[row * w + col];
+        return std::isnan(value) ? fallback : value;
+    };
+
+    QImage image(TILE_PIXELS, TILE_PIXELS, QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    bool any = false;
+
+    const int ty0 = std::max(area.top(), 0);
+    const int ty1 = std::min(area.top() + h, TILE_PIXELS);
+    const int tx0 = std::max(area.left(), 0);
+    const int tx1 = std::min(area.left() + w, TILE_PIXELS);
+
+    for (int ty = ty0; ty < ty1; ++ty) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(ty));
+        const int row = ty - area.top();
+
+        for (int tx = tx0; tx < tx1; ++tx) {
+            const int col = tx - area.left();
+            const float e = z[row * w + col];
+            if (std::isnan(e)) {
+                continue;
+            }
+
+            // Horn's 3x3 gradients
+            const double a = at(col - 1, row - 1, e), b = at(col, row - 1, e), c = at(col + 1, row - 1, e);
+            const double d = at(col - 1, row, e),                               f = at(col + 1, row, e);
+            const double g = at(col - 1, row + 1, e), hh = at(col, row + 1, e), i = at(col + 1, row + 1, e);
+
+            const double dzdx = ((c + 2.0 * f + i) - (a + 2.0 * d + g)) / (8.0 * cell);
+            const double dzdy = ((g + 2.0 * hh + i) - (a + 2.0 * b + c)) / (8.0 * cell);
+
+            const double slope = std::atan(std::sqrt(dzdx * dzdx + dzdy * dzdy));
+            const double aspect = std::atan2(dzdy, -dzdx);
+            const double shade = cosZenith * std::cos(slope) +
+                                 sinZenith * std::sin(slope) * std::cos(azimuth - aspect);
+
+            const int grey = std::clamp(static_cast<int>(shade * 255.0), 0, 255);
+            line[tx] = qRgba(grey, grey, grey, 255);
+            any = true;
+        }
+    }
+
+    return any ? encodePng(image) : QByteArray();
+}
+
+QByteArray OverlayTileRenderer::renderOrtho(const TileBounds& tile)
+{
+    QVector<float> bands[4];
+    QRect area;
+    int colorBands = 0;
+    bool hasAlpha = false;
+    {
+        QMutexLocker locker(&m_orthoMutex);
+        if (!m_ortho) {
+            return QByteArray();
+        }
+
+        const int count = m_ortho->bandCount();
+        colorBands = (count >= 3) ? 3 : 1;
+        hasAlpha = count >= 4;
+
+        for (int band = 0; band < colorBands + (hasAlpha ? 1 : 0); ++band) {
+            if (!readTile(*m_ortho, tile, band + 1, 0, bands[band], area)) {
+                return QByteArray();
+            }
+        }
+    }
+
+    QImage image(TILE_PIXELS, TILE_PIXELS, QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    bool any = false;
+
+    auto channel = [](float value) {
+        return std::clamp(static_cast<int>(value + 0.5f), 0, 255);
+    };
+
+    const int w = area.width();
+    for (int row = 0; row < area.height(); ++row) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(area.top() + row));
+
+        for (int col = 0; col < w; ++col) {
+            const int k = row * w + col;
+            const float r = bands[0][k];
+            const float g = bands[colorBands == 3 ? 1 : 0][k];
+            const float b = bands[colorBands == 3 ? 2 : 0][k];
+            const int alpha = hasAlpha ? channel(bands[3][k]) : 255;
+
+            if (std::isnan(r) || std::isnan(g) || std::isnan(b) || alpha == 0) {
+                continue;
+            }
+
+            line[area.left() + col] = qRgba(channel(r), channel(g), channel(b), alpha);
+            any = true;
+        }
+    }
+
+    return any ? encodePng(image) : QByteArray();
+}
+
+QByteArray OverlayTileRenderer::renderCoverage(const TileBounds& tile)
+{
+    const double extent = TILE_PIXELS * tile.pixelSize;
+    const QRectF tileRect(tile.minX, tile.maxY - extent, extent, extent);
+
+    // Overlap count accumulated in the alpha channel (one unit per footprint)
+    QImage counts(TILE_PIXELS, TILE_PIXELS, QImage::Format_ARGB32_Premultiplied);
+    counts.fill(Qt::transparent);
+    bool any = false;
+
+    {
+        QMutexLocker locker(&m_footprintMutex);
+
+        QPainter painter(&counts);
+        painter.setCompositionMode(QPainter::CompositionMode_Plus);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(0, 0, 0, 1));
+        painter.setTransform(QTransform(1.0 / tile.pixelSize, 0.0, 0.0, -1.0 / tile.pixelSize,
+                                        -tile.minX / tile.pixelSize, tile.maxY / tile.pixelSize));
+
+        for (const auto& footprint : m_footprints) {
+            if (footprint.bounds.intersects(tileRect)) {
+                painter.drawPolygon(footprint.polygon);
+                any = true;
+            }
+        }
+    }
+
+    if (!any) {
+        return QByteArray();
+    }
+
+    // Colour by overlap: red below 3, amber below 5, green otherwise
+    QImage image(TILE_PIXELS, TILE_PIXELS, QImage::Format_ARGB32);
+    for (int ty = 0; ty < TILE_PIXELS; ++ty) {
+        const QRgb* in = reinterpret_cast<const QRgb*>(counts.constScanLine(ty));
+        QRgb* out = reinterpret_cast<QRgb*>(image.scanLine(ty));
+
+        for (int tx = 0; tx < TILE_PIXELS; ++tx) {
+            const int count = qAlpha(in[tx]);
+            if (count == 0) {
+                out[tx] = qRgba(0, 0, 0, 0);
+            } else if (count < 3) {
+                out[tx] = qRgba(220, 50, 40, 150);
+            } else if (count < 5) {
+                out[tx] = qRgba(240, 170, 30, 150);
+            } else {
+                out[tx] = qRgba(40, 170, 70, 150);
+            }
+        }
+    }
+
+    return encodePng(image);
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -0,0 +1,352 @@
+#include "PlanValidationService.h"
+#include "TerrainElevationViewer.h"
+#include "TerrainRayCaster.h"
+#include "ViewshedAnalyzer.h"
+#include "geospatial/GeoUtils.h"
+#include "core/Tracer.h"
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QtConcurrent>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int DEFAULT_DEBOUNCE_MS = 50;     // Leaves ~50 ms of the 100 ms budget for the run
+constexpr int VALIDATION_THREADS = 2;       // A new run need not wait for a cancelled one
+constexpr double NEARBY_ZONE_MARGIN = 500.0;    // Meters; matches NoFlyZoneChecker's nearby radius
+constexpr double PROJECTION_TOLERANCE = 0.01;   // Relative slack for local projection error
+
+void addViolations(Core::SafetyCheckResult& result, const QList<Core::AltitudeViolation>& violations)
+{
+    for (const Core::AltitudeViolation& v : violations) {
+        result.violations.append(v);
+
+        switch (v.severity) {
+        case Core::ViolationSeverity::Critical:
+        case Core::ViolationSeverity::Illegal:
+            result.criticalCount++;
+            result.isSafe = false;
+            break;
+        case Core::ViolationSeverity::Caution:
+            result.cautionCount++;
+            break;
+        case Core::ViolationSeverity::Warning:
+            result.warningCount++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!result.isSafe) {
+        result.summary = QString("UNSAFE - %1 critical violations found, DO NOT FLY")
+            .arg(result.criticalCount);
+    }
+}
+
+} // namespace
+
+struct PlanValidationService::Terrain {
+    DEMData dem;
+    TerrainRayCaster caster;    // Built over dem; both live and die together
+};
+
+PlanValidationResult::PlanValidationResult()
+    : runId(0)
+    , planRevision(0)
+    , waypointCount(0)
+    , batteriesRequired(0)
+    , batteryUsage(0.0)
+    , zonesChecked(0)
+    , elapsedMs(0)
+{
+    noFly.isSafe = true;
+    noFly.criticalViolations = 0;
+    noFly.warningViolations = 0;
+    altitude.isSafe = true;
+    altitude.criticalCount = 0;
+    altitude.cautionCount = 0;
+    altitude.warningCount = 0;
+    quality.overallScore = 0.0;
+}
+
+QString PlanValidationResult::summary() const
+{
+    if (waypointCount == 0) {
+        return QString("No waypoints to validate");
+    }
+
+    return QString("%1 - %2 no-fly, %3 altitude issues, %4 batteries (%5%), quality %6%")
+        .arg(isSafe() ? "Plan valid" : "Plan UNSAFE")
+        .arg(noFly.violations.count())
+        .arg(altitude.violations.count())
+        .arg(batteriesRequired)
+        .arg(batteryUsage, 0, 'f', 0)
+        .arg(quality.overallScore, 0, 'f', 0);
+}
+
+PlanValidationService::PlanValidationService(QObject *parent)
+    : QObject(parent)
+    , m_debounceTimer(new QTimer(this))
+    , m_limits(Core::RegulatoryLimits::getDefaults())
+    , m_hasPlan(false)
+    , m_latestRunId(0)
+    , m_running(false)
+{
+    m_pool.setMaxThreadCount(VALIDATION_THREADS);
+
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(DEFAULT_DEBOUNCE_MS);
+    connect(m_debounceTimer, &QTimer::timeout, this, &PlanValidationService::startRun);
+}
+
+PlanValidationService::~PlanValidationService()
+{
+    // Runs capture this; they must be gone before the members are
+    cancel();
+    m_pool.waitForDone();
+}
+
+void PlanValidationService::setZoneDatabase(const Core::ZoneDatabase& database)
+{
+    m_zones = database;
+    if (m_hasPlan) {
+        m_debounceTimer->start();
+    }
+}
+
+void PlanValidationService::setRegulatoryLimits(const Core::RegulatoryLimits& limits)
+{
+    m_limits = limits;
+    if (m_hasPlan) {
+        m_debounceTimer->start();
+    }
+}
+
+void PlanValidationService::setTerrain(const DEMData& dem)
+{
+    auto terrain = std::make_shared<Terrain>();
+    terrain->dem = dem;
+    terrain->caster.build(terrain->dem);
+    m_terrain = terrain;
+
+    if (m_hasPlan) {
+        m_debounceTimer->start();
+    }
+}
+
+void PlanValidationService::clearTerrain()
+{
+    m_terrain.reset();
+    if (m_hasPlan) {
+        m_debounceTimer->start();
+    }
+}
+
+void PlanValidationService::setDebounceInterval(int ms)
+{
+    m_debounceTimer->setInterval(qMax(0, ms));
+}
+
+void PlanValidationService::submitPlan(const Models::FlightPlan& plan)
+{
+    m_plan = plan;
+    m_hasPlan = true;
+
+    // The run in flight validates a plan that no longer exists
+    if (m_cancelled) {
+        m_cancelled->store(true, std::memory_order_relaxed);
+    }
+
+    m_debounceTimer->start();
+}
+
+void PlanValidationService::validateNow()
+{
+    m_debounceTimer->stop();
+    startRun();
+}
+
+void PlanValidationService::cancel()
+{
+    m_debounceTimer->stop();
+    if (m_cancelled) {
+        m_cancelled->store(true, std::memory_order_relaxed);
+        m_cancelled.reset();
+    }
+
+    // Results already queued by a finishing run are dropped by id
+    m_latestRunId++;
+    m_running = false;
+}
+
+void PlanValidationService::startRun()
+{
+    if (!m_hasPlan) {
+        return;
+    }
+
+    if (m_cancelled) {
+        m_cancelled->store(true, std::memory_order_relaxed);
+    }
+
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    m_cancelled = cancelled;
+
+    const quint64 runId = ++m_latestRunId;
+    const Snapshot snapshot{ m_plan, m_zones, m_limits, m_terrain };
+    m_running = true;
+    emit validationStarted(runId);
+
+    QtConcurrent::run(&m_pool, [this, runId, cancelled, snapshot]() {
+        PlanValidationResult result;
+        result.runId = runId;
+
+        if (!runChecks(snapshot, *cancelled, result)) {
+            return;
+        }
+
+        QMetaObject::invokeMethod(this, [this, runId, result]() {
+            onRunFinished(runId, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void PlanValidationService::onRunFinished(quint64 runId, const PlanValidationResult& result)
+{
+    if (runId != m_latestRunId) {
+        return; // Superseded while queued
+    }
+
+    m_running = false;
+    m_result = result;
+    emit validationFinished(m_result);
+}
+
+PlanValidationResult PlanValidationService::validate(const Models::FlightPlan& plan,
+                                                    const Core::ZoneDatabase& zones,
+                                                    const Core::RegulatoryLimits& limits)
+{
+    const Snapshot snapshot{ plan, zones, limits, nullptr };
+    const std::atomic<bool> cancelled(false);
+
+    PlanValidationResult result;
+    runChecks(snapshot, cancelled, result);
+    return result;
+}
+
+bool PlanValidationService::runChecks(const Snapshot& snapshot, const std::atomic<bool>& cancelled,
+                                      PlanValidationResult& result)
+{
+    TRACE_SCOPE("validation", "PlanValidationService::runChecks");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const Models::FlightPlan& plan = snapshot.plan;
+    const QList<Models::Waypoint> waypoints = plan.waypoints();
+    result.planRevision = plan.revision();
+    result.waypointCount = waypoints.count();
+
+    if (waypoints.isEmpty()) {
+        result.elapsedMs = timer.elapsed();
+        return true;
+    }
+
+    // Shared geometry: every waypoint projected once around the home
+    // point, and only the zones the plan's bounds can reach. Segment
+    // lengths and climbs come from plan.geometry().
+    const Core::ProjectedPlan projection(plan, waypoints.first().coordinate());
+    const Core::ZoneDatabase zones = zonesNear(snapshot.zones, projection.bounds(), projection.origin());
+    result.zonesChecked = zones.zones.count();
+
+    if (cancelled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    {
+        TRACE_SCOPE("validation", "NoFlyZoneChecker::checkFlightPlan");
+        result.noFly = Core::NoFlyZoneChecker::checkFlightPlan(plan, zones, projection, &cancelled);
+    }
+
+    if (cancelled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    {
+        TRACE_SCOPE("validation", "AltitudeSafetyChecker::checkFlightPlan");
+        result.altitude = Core::AltitudeSafetyChecker::checkFlightPlan(plan, snapshot.limits, &cancelled);
+    }
+
+    // The pilot stands at the launch point
+    const ViewshedAnalyzer::Observer pilot(waypoints.first().coordinate());
+    if (snapshot.terrain && snapshot.terrain->dem.contains(pilot.position)) {
+        TRACE_SCOPE("validation", "ViewshedAnalyzer::checkVisualLineOfSight");
+        addViolations(result.altitude, ViewshedAnalyzer::checkVisualLineOfSight(
+            snapshot.terrain->dem, snapshot.terrain->caster, pilot, plan, snapshot.limits, &cancelled));
+    }
+
+    if (cancelled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    {
+        TRACE_SCOPE("validation", "BatteryManager");
+        const Core::BatteryProfile profile =
+            Core::BatteryManager::getBatteryProfile(plan.parameters().cameraModel());
+        result.batteryUsage = Core::BatteryManager::calculateBatteryUsage(plan, profile);
+        result.batteriesRequired = Core::BatteryManager::calculateRequiredBatteries(plan, profile);
+        result.batteryPlan = Core::BatteryManager::splitMissionForBatteries(plan, profile, projection,
+                                                                            &cancelled);
+    }
+
+    if (cancelled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    {
+        TRACE_SCOPE("validation", "QualityEstimator::estimateQuality");
+        result.quality = Photogrammetry::QualityEstimator::estimateQuality(plan, plan.parameters());
+    }
+
+    result.elapsedMs = timer.elapsed();
+    return !cancelled.load(std::memory_order_relaxed);
+}
+
+Core::ZoneDatabase PlanValidationService::zonesNear(const Core::ZoneDatabase& database, const QRectF& bounds,
+                                                    const Models::GeospatialCoordinate& origin)
+{
+    Core::ZoneDatabase nearby;
+    nearby.region = database.region;
+    nearby.lastUpdated = database.lastUpdated;
+
+    // Conservative: anything the checker could report (inside, crossing
+    // or within the nearby radius) has an extent overlapping this rect
+    const double slack = NEARBY_ZONE_MARGIN +
+                         PROJECTION_TOLERANCE * (bounds.width() + bounds.height());
+    const QRectF reach = bounds.adjusted(-slack, -slack, slack, slack);
+
+    for (const Core::NoFlyZone& zone : database.zones) {
+        const QPointF center = Geospatial::GeoUtils::toCartesian(zone.center, origin);
+        const double radius = qMax(1.0, zone.radiusMeters * (1.0 + PROJECTION_TOLERANCE));
+        QRectF extent(center.x() - radius, center.y() - radius, 2 * radius, 2 * radius);
+
+        // Polygon boundaries are (longitude, latitude)
+        for (const QPointF& vertex : zone.boundary) {
+            const Models::GeospatialCoordinate corner(vertex.y(), vertex.x(), 0.0);
+            const QPointF local = Geospatial::GeoUtils::toCartesian(corner, origin);
+            extent = extent.united(QRectF(local, QSizeF(0.0, 0.0)).adjusted(-1.0, -1.0, 1.0, 1.0));
+        }
+
+        if (reach.intersects(extent)) {
+            nearby.zones.append(zone);
+        }
+    }
+
+    return nearby;
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -0,0 +1,285 @@
+#include "PointCloudKDTree.h"
+#include "PointCloudViewer.h"
+#include <algorithm>
+#include <limits>
+
+namespace DroneMapper {
+namespace UI {
+
+// KnnHeap implementation
+//
+// k is small (8-32) in practice, so a sorted insertion array beats a
+// binary heap and leaves the result already ordered nearest first.
+
+float PointCloudKDTree::KnnHeap::worst() const
+{
+    if (count < capacity) {
+        return std::numeric_limits<float>::max();
+    }
+    return distancesSq[count - 1];
+}
+
+void PointCloudKDTree::KnnHeap::push(int index, float distanceSq)
+{
+    if (count == capacity && distanceSq >= distancesSq[count - 1]) {
+        return;
+    }
+
+    int slot = (count < capacity) ? count++ : count - 1;
+    while (slot > 0 && distancesSq[slot - 1] > distanceSq) {
+        distancesSq[slot] = distancesSq[slot - 1];
+        indices[slot] = indices[slot - 1];
+        --slot;
+    }
+
+    distancesSq[slot] = distanceSq;
+    indices[slot] = index;
+}
+
+// PointCloudKDTree implementation
+
+PointCloudKDTree::PointCloudKDTree()
+{
+}
+
+void PointCloudKDTree::build(const PointCloud& cloud, int leafSize)
+{
+    QVector<QVector3D> positions;
+    positions.reserve(cloud.size());
+    for (const auto& point : cloud.points) {
+        positions.append(point.position);
+    }
+
+    build(positions, leafSize);
+}
+
+void PointCloudKDTree::build(const QVector<QVector3D>& positions, int leafSize)
+{
+    clear();
+
+    const int count = positions.size();
+    if (count == 0) {
+        return;
+    }
+
+    leafSize = std::max(leafSize, 1);
+
+    // Positions in original order while partitioning
+    m_x.resize(count);
+    m_y.resize(count);
+    m_z.resize(count);
+    m_indices.resize(count);
+
+    for (int i = 0; i < count; ++i) {
+        m_x[i] = positions[i].x();
+        m_y[i] = positions[i].y();
+        m_z[i] = positions[i].z();
+        m_indices[i] = i;
+    }
+
+    m_nodes.reserve(2 * (count / leafSize + 1));
+    buildNode(0, count, leafSize);
+
+    // Reorder positions into tree order so leaf scans are contiguous
+    QVector<float> x(count), y(count), z(count);
+    m_slotOf.resize(count);
+
+    for (int slot = 0; slot < count; ++slot) {
+        int original = m_indices[slot];
+        x[slot] = m_x[original];
+        y[slot] = m_y[original];
+        z[slot] = m_z[original];
+        m_slotOf[original] = slot;
+    }
+
+    m_x = std::move(x);
+    m_y = std::move(y);
+    m_z = std::move(z);
+}
+
+void PointCloudKDTree::clear()
+{
+    m_nodes.clear();
+    m_indices.clear();
+    m_slotOf.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+}
+
+int PointCloudKDTree::buildNode(int begin, int end, int leafSize)
+{
+    int nodeIndex = m_nodes.size();
+    m_nodes.append(Node());
+
+    if (end - begin <= leafSize) {
+        Node& leaf = m_nodes[nodeIndex];
+        leaf.axis = -1;
+        leaf.split = 0.0f;
+        leaf.begin = begin;
+        leaf.end = end;
+        leaf.left = -1;
+        leaf.right = -1;
+        return nodeIndex;
+    }
+
+    // Split along the axis of largest extent
+    float minX = std::numeric_limits<float>::max(), maxX = -minX;
+    float minY = minX, maxY = -minX;
+    float minZ = minX, maxZ = -minX;
+
+    for (int i = begin; i < end; ++i) {
+        int idx = m_indices[i];
+        minX = std::min(minX, m_x[idx]); maxX = std::max(maxX, m_x[idx]);
+        minY = std::min(minY, m_y[idx]); maxY = std::max(maxY, m_y[idx]);
+        minZ = std::min(minZ, m_z[idx]); maxZ = std::max(maxZ, m_z[idx]);
+    }
+
+    float extentX = maxX - minX;
+    float extentY = maxY - minY;
+    float extentZ = maxZ - minZ;
+
+    int axis = 0;
+    if (extentY > extentX && extentY >= extentZ) {
+        axis = 1;
+    } else if (extentZ > extentX && extentZ > extentY) {
+        axis = 2;
+    }
+
+    const QVector<float>& coords = (axis == 0) ? m_x : (axis == 1) ? m_y : m_z;
+
+    int mid = begin + (end - begin) / 2;
+    int* data = m_indices.data();
+    std::nth_element(data + begin, data + mid, data + end,
+        [&coords](int a, int b) { return coords[a] < coords[b]; });
+
+    float split = coords[m_indices[mid]];
+
+    int left = buildNode(begin, mid, leafSize);
+    int right = buildNode(mid, end, leafSize);
+
+    // m_nodes may have reallocated during recursion
+    Node& node = m_nodes[nodeIndex];
+    node.axis = axis;
+    node.split = split;
+    node.begin = begin;
+    node.end = end;
+    node.left = left;
+    node.right = right;
+
+    return nodeIndex;
+}
+
+int PointCloudKDTree::knn(const QVector3D& query, int k, int* outIndices, float* outDistancesSq) const
+{
+    if (m_nodes.isEmpty() || k <= 0) {
+        return 0;
+    }
+
+    KnnHeap heap;
+    heap.indices = outIndices;
+    heap.distancesSq = outDistancesSq;
+    heap.capacity = k;
+    heap.count = 0;
+
+    knnNode(0, query.x(), query.y(), query.z(), heap);
+
+    // Translate tree slots back to original point indices
+    for (int i = 0; i < heap.count; ++i) {
+        outIndices[i] = m_indices[outIndices[i]];
+    }
+
+    return heap.count;
+}
+
+int PointCloudKDTree::nearest(const QVector3D& query, float* outDistanceSq) const
+{
+    int index = -1;
+    float distanceSq = std::numeric_limits<float>::max();
+
+    if (knn(query, 1, &index, &distanceSq) == 0) {
+        return -1;
+    }
+
+    if (outDistanceSq) {
+        *outDistanceSq = distanceSq;
+    }
+    return index;
+}
+
+void PointCloudKDTree::radiusSearch(const QVector3D& query, float radius, QVector<int>& outIndices) const
+{
+    if (m_nodes.isEmpty()) {
+        return;
+    }
+
+    radiusNode(0, query.x(), query.y(), query.z(), radius * radius, outIndices);
+}
+
+QVector3D PointCloudKDTree::position(int index) const
+{
+    int slot = m_slotOf[index];
+    return QVector3D(m_x[slot], m_y[slot], m_z[slot]);
+}
+
+void PointCloudKDTree::knnNode(int nodeIndex, float qx, float qy, float qz, KnnHeap& heap) const
+{
+    const Node& node = m_nodes[nodeIndex];
+
+    if (node.axis < 0) {
+        const float* xs = m_x.constData();
+        const float* ys = m_y.constData();
+        const float* zs = m_z.constData();
+
+        for (int slot = node.begin; slot < node.end; ++slot) {
+            float dx = xs[slot] - qx;
+            float dy = ys[slot] - qy;
+            float dz = zs[slot] - qz;
+            heap.push(slot, dx * dx + dy * dy + dz * dz);
+        }
+        return;
+    }
+
+    float q = (node.axis == 0) ? qx : (node.axis == 1) ? qy : qz;
+    float diff = q - node.split;
+
+    int nearChild = diff < 0.0f ? node.left : node.right;
+    int farChild = diff < 0.0f ? node.right : node.left;
+
+    knnNode(nearChild, qx, qy, qz, heap);
+
+    if (diff * diff < heap.worst()) {
+        knnNode(farChild, qx, qy, qz, heap);
+    }
+}
+
+void PointCloudKDTree::radiusNode(int nodeIndex, float qx, float qy, float qz,
+                                  float radiusSq, QVector<int>& out) const
+{
+    const Node& node = m_nodes[nodeIndex];
+
+    if (node.axis < 0) {
+        for (int slot = node.begin; slot < node.end; ++slot) {
+            float dx = m_x[slot] - qx;
+            float dy = m_y[slot] - qy;
+            float dz = m_z[slot] - qz;
+            if (dx * dx + dy * dy + dz * dz <= radiusSq) {
+                out.append(m_indices[slot]);
+            }
+        }
+        return;
+    }
+
+    float q = (node.axis == 0) ? qx : (node.axis == 1) ? qy : qz;
+    float diff = q - node.split;
+
+    if (diff < 0.0f || diff * diff <= radiusSq) {
+        radiusNode(node.left, qx, qy, qz, radiusSq, out);
+    }
+    if (diff >= 0.0f || diff * diff <= radiusSq) {
+        radiusNode(node.right, qx, qy, qz, radiusSq, out);
+    }
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -1,10 +1,12 @@
 #include "PointCloudViewer.h"
+#include "Tracer.h"
 #include <QFile>
 #include <QTextStream>
 #include <QDataStream>
 #include <QFileInfo>
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QPainter>
 #include <QtMath>
 #include <cmath>
 #include <algorithm>
@@ -17,6 +19,9 @@ namespace UI {
 void PointCloud::clear()
 {
     points.clear();
+    packedNormals.clear();
+    scalarField.clear();
+    scalarFieldName.clear();
     fileName.clear();
     hasColors = false;
     hasNormals = false;
@@ -203,6 +208,20 @@ bool PointCloud::loadFromXYZ(const QString& filePath)
     return true;
 }
 
+bool PointCloud::loadFromFile(const QString& filePath)
+{
+    const QString extension = QFileInfo(filePath).suffix().toLower();
+
+    if (extension == "ply") {
+        return loadFromPLY(filePath);
+    } else if (extension == "las" || extension == "laz") {
+        return loadFromLAS(filePath);
+    } else if (extension == "xyz" || extension == "txt") {
+        return loadFromXYZ(filePath);
+    }
+    return false;
+}
+
 bool PointCloud::saveToPLY(const QString& filePath) const
 {
     QFile file(filePath);
@@ -384,6 +403,31 @@ QColor PointCloudColorMap::getColorForNormal(const QVector3D& normal)
     return QColor(r, g, b);
 }
 
+// OrientedBox implementation
+
+bool OrientedBox::contains(const QVector3D& position) const
+{
+    QVector3D d = position - center;
+    return std::abs(QVector3D::dotProduct(d, axes[0])) <= halfExtents.x() &&
+           std::abs(QVector3D::dotProduct(d, axes[1])) <= halfExtents.y() &&
+           std::abs(QVector3D::dotProduct(d, axes[2])) <= halfExtents.z();
+}
+
+QColor PointCloudColorMap::getColorForScalar(float value, float maxAbs)
+{
+    if (maxAbs <= 0.0f) {
+        return QColor(255, 255, 255);
+    }
+
+    float t = std::clamp(value / maxAbs, -1.0f, 1.0f);
+    int fade = static_cast<int>((1.0f - std::abs(t)) * 255);
+
+    if (t < 0.0f) {
+        return QColor(fade, fade, 255);
+    }
+    return QColor(255, fade, fade);
+}
+
 // Octree implementation
 
 Octree::Octree()
@@ -517,6 +561,84 @@ void Octree::queryNode(OctreeNode* node, const QVector<QVector4D>& planes, QVect
     }
 }
 
+QVector<int> Octree::queryOrientedBox(const OrientedBox& box) const
+{
+    QVector<int> result;
+
+    if (!m_root || !m_cloud) {
+        return result;
+    }
+
+    queryBoxNode(m_root, box, result);
+    return result;
+}
+
+void Octree::queryBoxNode(const OctreeNode* node, const OrientedBox& box, QVector<int>& result) const
+{
+    const QVector3D d = box.center - node->center;
+    const float h = node->halfSize;
+    const float extents[3] = { box.halfExtents.x(), box.halfExtents.y(), box.halfExtents.z() };
+
+    // Separating axis test on the node's world axes
+    for (int k = 0; k < 3; ++k) {
+        float boxRadius = 0.0f;
+        for (int i = 0; i < 3; ++i) {
+            boxRadius += extents[i] * std::abs(box.axes[i][k]);
+        }
+        if (std::abs(d[k]) > h + boxRadius) {
+            return;
+        }
+    }
+
+    // ... and on the box axes; also detect full containment
+    bool inside = true;
+    for (int i = 0; i < 3; ++i) {
+        const QVector3D& axis = box.axes[i];
+        float nodeRadius = h * (std::abs(axis.x()) + std::abs(axis.y()) + std::abs(axis.z()));
+        float distance = std::abs(QVector3D::dotProduct(d, axis));
+        if (distance > extents[i] + nodeRadius) {
+            return;
+        }
+        if (distance + nodeRadius > extents[i]) {
+            inside = false;
+        }
+    }
+
+    if (inside) {
+        collectNode(node, result);
+        return;
+    }
+
+    if (node->isLeaf()) {
+        for (int idx : node->pointIndices) {
+            if (box.contains(m_cloud->points[idx].position)) {
+                result.append(idx);
+            }
+        }
+        return;
+    }
+
+    for (const auto* child : node->children) {
+        if (child) {
+            queryBoxNode(child, box, result);
+        }
+    }
+}
+
+void Octree::collectNode(const OctreeNode* node, QVector<int>& result) const
+{
+    if (node->isLeaf()) {
+        result.append(node->pointIndices);
+        return;
+    }
+
+    for (const auto* child : node->children) {
+        if (child) {
+            collectNode(child, result);
+        }
+    }
+}
+
 void Octree::deleteNode(OctreeNode* node)
 {
     if (!node) {
@@ -698,13 +820,278 @@ double MeasurementTool::calculateAngle()
     return qRadiansToDegrees(acos(std::clamp(dotProduct, -1.0f, 1.0f)));
 }
 
+// CrossSection implementation
+
+namespace {
+
+// Mitre joints sharper than this (relative to the half width) are cut
+// back, as a stroked line's miter limit would be
+constexpr double SECTION_MITER_LIMIT = 4.0;
+
+/**
+ * @brief Normal of the bisector plane between two unit directions
+ */
+QVector3D bisectorNormal(const QVector3D& incoming, const QVector3D& outgoing)
+{
+    const QVector3D sum = incoming + outgoing;
+
+    // A full reversal has no bisector; fall back to the outgoing segment
+    if (sum.lengthSquared() < 1e-8f) {
+        return outgoing;
+    }
+    return sum.normalized();
+}
+
+/**
+ * @brief How far a bisector plane reaches past the joint along a segment
+ */
+double miterReach(const QVector3D& normal, const QVector3D& dir, const QVector3D& left, double halfWidth)
+{
+    const double along = QVector3D::dotProduct(normal, dir);
+    const double across = std::abs(QVector3D::dotProduct(normal, left));
+
+    if (along * SECTION_MITER_LIMIT <= across) {
+        return halfWidth * SECTION_MITER_LIMIT;
+    }
+    return halfWidth * across / along;
+}
+
+} // namespace
+
+QVector<SectionPoint> CrossSection::extract(
+    const PointCloud& cloud,
+    const Octree& octree,
+    const QVector<QPointF>& polyline,
+    double slabWidth)
+{
+    QVector<SectionPoint> section;
+
+    if (cloud.isEmpty() || polyline.size() < 2 || slabWidth <= 0.0) {
+        return section;
+    }
+
+    // Drop repeated vertices so every segment has a direction
+    QVector<QPointF> vertices;
+    vertices.reserve(polyline.size());
+    for (const QPointF& vertex : polyline) {
+        if (vertices.isEmpty() || vertex != vertices.last()) {
+            vertices.append(vertex);
+        }
+    }
+
+    const int segmentCount = vertices.size() - 1;
+    if (segmentCount < 1) {
+        return section;
+    }
+
+    QVector<QVector3D> directions(segmentCount);
+    for (int s = 0; s < segmentCount; ++s) {
+        const QPointF delta = vertices[s + 1] - vertices[s];
+        directions[s] = QVector3D(delta.x(), delta.y(), 0.0f).normalized();
+    }
+
+    const float zCenter = (cloud.minBounds.z() + cloud.maxBounds.z()) * 0.5f;
+    const float zHalf = (cloud.maxBounds.z() - cloud.minBounds.z()) * 0.5f + 1.0f;
+    const double halfWidth = slabWidth * 0.5;
+
+    double stationStart = 0.0;
+
+    for (int s = 0; s < segmentCount; ++s) {
+        const QPointF a = vertices[s];
+        const QPointF b = vertices[s + 1];
+        const double length = std::hypot(b.x() - a.x(), b.y() - a.y());
+
+        const QVector3D& dir = directions[s];
+        const QVector3D left(-dir.y(), dir.x(), 0.0f);
+
+        // Each segment owns the slab between the bisector planes at its
+        // joints, so neighbouring slabs meet without overlap or gap
+        const bool lastSegment = (s + 1 == segmentCount);
+        const QVector3D startNormal = s > 0 ? bisectorNormal(directions[s - 1], dir) : dir;
+        const QVector3D endNormal = !lastSegment ? bisectorNormal(dir, directions[s + 1]) : dir;
+        const double startReach = miterReach(startNormal, dir, left, halfWidth);
+        const double endReach = miterReach(endNormal, dir, left, halfWidth);
+
+        const double alongMin = -startReach;
+        const double alongMax = length + endReach;
+        const QPointF mid = a + QPointF(dir.x(), dir.y()) * ((alongMin + alongMax) * 0.5);
+
+        OrientedBox box;
+        box.center = QVector3D(mid.x(), mid.y(), zCenter);
+        box.axes[0] = dir;
+        box.axes[1] = left;
+        box.axes[2] = QVector3D(0, 0, 1);
+        box.halfExtents = QVector3D((alongMax - alongMin) * 0.5, halfWidth, zHalf);
+
+        const QVector<int> indices = octree.queryOrientedBox(box);
+
+        for (int idx : indices) {
+            const QVector3D& p = cloud.points[idx].position;
+            const double dx = p.x() - a.x();
+            const double dy = p.y() - a.y();
+
+            // Half-open between the planes so joint points are not duplicated
+            const double fromStart = dx * startNormal.x() + dy * startNormal.y();
+            const double toEnd = (p.x() - b.x()) * endNormal.x() + (p.y() - b.y()) * endNormal.y();
+            if (fromStart < 0.0 || toEnd > 0.0 || (toEnd == 0.0 && !lastSegment)) {
+                continue;
+            }
+
+            // Points in the mitre wedge past a joint sit at the joint's station
+            const double along = std::clamp(dx * dir.x() + dy * dir.y(), 0.0, length);
+
+            SectionPoint sample;
+            sample.station = stationStart + along;
+            sample.offset = dx * left.x() + dy * left.y();
+            sample.elevation = p.z();
+            sample.pointIndex = idx;
+            section.append(sample);
+        }
+
+        stationStart += length;
+    }
+
+    std::sort(section.begin(), section.end(),
+        [](const SectionPoint& a, const SectionPoint& b) { return a.station < b.station; });
+
+    return section;
+}
+
+bool CrossSection::exportCSV(const QVector<SectionPoint>& section,
+                             const PointCloud& cloud,
+                             const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberPrecision(3);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+
+    out << "station,offset,elevation,x,y,z\n";
+
+    for (const auto& sample : section) {
+        const QVector3D& p = cloud.points[sample.pointIndex].position;
+        out << sample.station << "," << sample.offset << "," << sample.elevation << ","
+            << p.x() << "," << p.y() << "," << p.z() << "\n";
+    }
+
+    file.close();
+    return true;
+}
+
+bool CrossSection::exportDXF(const QVector<SectionPoint>& section, const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setRealNumberPrecision(3);
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+
+    // Minimal R12 DXF: one POINT per sample, X = station, Y = elevation
+    out << "0\nSECTION\n2\nENTITIES\n";
+
+    for (const auto& sample : section) {
+        out << "0\nPOINT\n8\nSECTION\n"
+            << "10\n" << sample.station << "\n"
+            << "20\n" << sample.elevation << "\n"
+            << "30\n0.0\n";
+    }
+
+    out << "0\nENDSEC\n0\nEOF\n";
+
+    file.close();
+    return true;
+}
+
+// CrossSectionWidget implementation
+
+CrossSectionWidget::CrossSectionWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_slabWidth(2.0)
+    , m_minStation(0.0)
+    , m_maxStation(0.0)
+    , m_minElevation(0.0)
+    , m_maxElevation(0.0)
+{
+    setMinimumHeight(150);
+}
+
+void CrossSectionWidget::setSection(const QVector<SectionPoint>& section, double slabWidth)
+{
+    m_section = section;
+    m_slabWidth = slabWidth;
+
+    // Extents are computed once here rather than on every paint
+    if (!m_section.isEmpty()) {
+        m_minStation = m_section.first().station;
+        m_maxStation = m_section.last().station;
+        m_minElevation = m_section.first().elevation;
+        m_maxElevation = m_section.first().elevation;
+
+        for (const auto& sample : m_section) {
+            m_minElevation = std::min(m_minElevation, sample.elevation);
+            m_maxElevation = std::max(m_maxElevation, sample.elevation);
+        }
+    }
+
+    update();
+}
+
+void CrossSectionWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+
+    if (m_section.isEmpty()) {
+        painter.drawText(rect(), Qt::AlignCenter, "No section defined");
+        return;
+    }
+
+    QRectF plotArea = rect().adjusted(40, 20, -20, -40);
+
+    double stationRange = std::max(m_maxStation - m_minStation, 1e-6);
+    double elevationRange = std::max(m_maxElevation - m_minElevation, 1e-6);
+    float halfWidth = static_cast<float>(m_slabWidth * 0.5);
+
+    for (const auto& sample : m_section) {
+        double x = plotArea.left() + ((sample.station - m_minStation) / stationRange) * plotArea.width();
+        double y = plotArea.bottom() - ((sample.elevation - m_minElevation) / elevationRange) * plotArea.height();
+
+        painter.setPen(PointCloudColorMap::getColorForHeight(
+            static_cast<float>(sample.offset), -halfWidth, halfWidth));
+        painter.drawPoint(QPointF(x, y));
+    }
+
+    // Draw axes
+    painter.setPen(Qt::black);
+    painter.drawRect(plotArea);
+    painter.drawText(plotArea.adjusted(0, plotArea.height() + 5, 0, 0),
+                    Qt::AlignCenter,
+                    QString("Station: %1 m, Elevation: %2-%3 m, %4 points")
+                        .arg(m_maxStation - m_minStation, 0, 'f', 1)
+                        .arg(m_minElevation, 0, 'f', 1)
+                        .arg(m_maxElevation, 0, 'f', 1)
+                        .arg(m_section.size()));
+}
+
 // PointCloudViewer implementation
 
 PointCloudViewer::PointCloudViewer(QWidget* parent)
     : QOpenGLWidget(parent)
     , m_colorScheme(PointCloudColorMap::RGB)
+    , m_scalarRange(1.0f)
     , m_measurementMode(false)
     , m_measurementType(MeasurementTool::Distance)
+    , m_sectionMode(false)
+    , m_sectionDragging(false)
+    , m_sectionWidth(2.0)
     , m_leftButtonPressed(false)
     , m_middleButtonPressed(false)
     , m_rightButtonPressed(false)
@@ -730,18 +1117,14 @@ bool PointCloudViewer::loadPointCloud(const QString& filePath)
 
     QString extension = fileInfo.suffix().toLower();
 
-    bool success = false;
-    if (extension == "ply") {
-        success = m_cloud.loadFromPLY(filePath);
-    } else if (extension == "las" || extension == "laz") {
-        success = m_cloud.loadFromLAS(filePath);
-    } else if (extension == "xyz" || extension == "txt") {
-        success = m_cloud.loadFromXYZ(filePath);
-    } else {
+    if (extension != "ply" && extension != "las" && extension != "laz" &&
+        extension != "xyz" && extension != "txt") {
         emit renderingError("Unsupported file format: " + extension);
         return false;
     }
 
+    bool success = m_cloud.loadFromFile(filePath);
+
     if (success) {
         // Build octree for efficient rendering
         m_octree.build(m_cloud, 100);
@@ -776,6 +1159,46 @@ void PointCloudViewer::setColorScheme(PointCloudColorMap::Scheme scheme)
     update();
 }
 
+bool PointCloudViewer::updatePointAttributes(const PointCloud& processed)
+{
+    if (processed.size() != m_cloud.size() || processed.fileName != m_cloud.fileName) {
+        emit renderingError("Processed point cloud does not match the loaded cloud");
+        return false;
+    }
+
+    // The octree refers to m_cloud by address and point index, both unchanged
+    m_cloud = processed;
+    update();
+    return true;
+}
+
+bool PointCloudViewer::showGroundClassification(const PointCloud& classified)
+{
+    if (!updatePointAttributes(classified)) {
+        return false;
+    }
+
+    m_settings.usePointColor = false;
+    m_settings.useColorMap = true;
+    m_colorScheme = PointCloudColorMap::Classification;
+    update();
+    return true;
+}
+
+bool PointCloudViewer::showDistances(const PointCloud& compared, const CloudComparator::Result& result)
+{
+    if (!updatePointAttributes(compared)) {
+        return false;
+    }
+
+    m_scalarRange = std::max(std::abs(result.minDistance), std::abs(result.maxDistance));
+    m_settings.usePointColor = false;
+    m_settings.useColorMap = true;
+    m_colorScheme = PointCloudColorMap::ScalarField;
+    update();
+    return true;
+}
+
 bool PointCloudViewer::exportPointCloud(const QString& filePath)
 {
     return m_cloud.saveToPLY(filePath);
@@ -802,6 +1225,28 @@ void PointCloudViewer::enableMeasurement(bool enabled, MeasurementTool::Measurem
     }
 }
 
+void PointCloudViewer::enableSectionMode(bool enabled, double slabWidth)
+{
+    m_sectionMode = enabled;
+    m_sectionWidth = slabWidth;
+    m_sectionDragging = false;
+    update();
+}
+
+void PointCloudViewer::setSectionLine(const QVector<QPointF>& polyline, double slabWidth)
+{
+    m_sectionLine = polyline;
+    m_sectionWidth = slabWidth;
+    updateSection();
+    update();
+}
+
+void PointCloudViewer::updateSection()
+{
+    m_section = CrossSection::extract(m_cloud, m_octree, m_sectionLine, m_sectionWidth);
+    emit sectionUpdated(m_section, m_sectionWidth);
+}
+
 QString PointCloudViewer::getStatistics() const
 {
     QString stats;
@@ -846,6 +1291,8 @@ void PointCloudViewer::resizeGL(int w, int h)
 
 void PointCloudViewer::paintGL()
 {
+    TRACE_SCOPE("render", "PointCloudViewer::paintGL");
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     if (m_cloud.isEmpty()) {
@@ -871,6 +1318,11 @@ void PointCloudViewer::paintGL()
     if (m_measurementMode) {
         renderMeasurements();
     }
+
+    // Render section line
+    if (m_sectionLine.size() >= 2) {
+        renderSectionLine();
+    }
 }
 
 void PointCloudViewer::mousePressEvent(QMouseEvent* event)
@@ -878,7 +1330,11 @@ void PointCloudViewer::mousePressEvent(QMouseEvent* event)
     m_lastMousePos = event->pos();
 
     if (event->button() == Qt::LeftButton) {
-        if (m_measurementMode) {
+        QPointF planePos;
+        if (m_sectionMode && screenToSectionPlane(event->pos(), planePos)) {
+            m_sectionLine = { planePos, planePos };
+            m_sectionDragging = true;
+        } else if (m_measurementMode) {
             int pointIdx = pickPoint(event->pos());
             if (pointIdx >= 0) {
                 m_measurement.addPoint(m_cloud.points[pointIdx].position);
@@ -898,7 +1354,12 @@ void PointCloudViewer::mouseMoveEvent(QMouseEvent* event)
 {
     QPoint delta = event->pos() - m_lastMousePos;
 
-    if (m_leftButtonPressed) {
+    QPointF planePos;
+    if (m_sectionDragging && screenToSectionPlane(event->pos(), planePos)) {
+        m_sectionLine.last() = planePos;
+        updateSection();
+        update();
+    } else if (m_leftButtonPressed) {
         m_camera.orbit(delta.x() * 0.5f, -delta.y() * 0.5f);
         update();
     } else if (m_middleButtonPressed || m_rightButtonPressed) {
@@ -913,6 +1374,7 @@ void PointCloudViewer::mouseReleaseEvent(QMouseEvent* event)
 {
     if (event->button() == Qt::LeftButton) {
         m_leftButtonPressed = false;
+        m_sectionDragging = false;
     } else if (event->button() == Qt::MiddleButton) {
         m_middleButtonPressed = false;
     } else if (event->button() == Qt::RightButton) {
@@ -934,8 +1396,9 @@ void PointCloudViewer::renderPoints()
     glBegin(GL_POINTS);
 
     // Get visible points (simplified - would use octree in production)
-    for (const auto& point : m_cloud.points) {
-        QColor color = getPointColor(point);
+    for (int i = 0; i < m_cloud.size(); ++i) {
+        const Point& point = m_cloud.points[i];
+        QColor color = getPointColor(point, i);
 
         glColor4f(
             color.redF(),
@@ -981,7 +1444,22 @@ void PointCloudViewer::renderBoundingBox()
     // Render bounding box
 }
 
-QColor PointCloudViewer::getPointColor(const Point& point)
+void PointCloudViewer::renderSectionLine()
+{
+    float z = m_cloud.centroid.z();
+
+    glColor3f(0.0f, 1.0f, 1.0f);
+    glLineWidth(2.0f);
+    glBegin(GL_LINE_STRIP);
+
+    for (const auto& vertex : m_sectionLine) {
+        glVertex3f(vertex.x(), vertex.y(), z);
+    }
+
+    glEnd();
+}
+
+QColor PointCloudViewer::getPointColor(const Point& point, int index)
 {
     if (m_settings.usePointColor && m_cloud.hasColors) {
         return point.color;
@@ -1002,6 +1480,11 @@ QColor PointCloudViewer::getPointColor(const Point& point)
             return PointCloudColorMap::getColorForNormal(point.normal);
         case PointCloudColorMap::RGB:
             return point.color;
+        case PointCloudColorMap::ScalarField:
+            if (index < m_cloud.scalarField.size()) {
+                return PointCloudColorMap::getColorForScalar(m_cloud.scalarField[index], m_scalarRange);
+            }
+            return m_settings.defaultColor;
         default:
             return m_settings.defaultColor;
         }
@@ -1019,9 +1502,41 @@ int PointCloudViewer::pickPoint(const QPoint& screenPos)
 
 QVector3D PointCloudViewer::screenToWorld(const QPoint& screenPos, float depth)
 {
-    Q_UNUSED(screenPos);
-    Q_UNUSED(depth);
-    return QVector3D(0, 0, 0);
+    if (width() <= 0 || height() <= 0) {
+        return QVector3D(0, 0, 0);
+    }
+
+    float aspect = static_cast<float>(width()) / height();
+    QMatrix4x4 inverse = (m_camera.projectionMatrix(aspect) * m_camera.viewMatrix()).inverted();
+
+    // Window depth (0 = near, 1 = far) to normalized device coordinates
+    QVector4D ndc(
+        2.0f * screenPos.x() / width() - 1.0f,
+        1.0f - 2.0f * screenPos.y() / height(),
+        2.0f * depth - 1.0f,
+        1.0f);
+
+    return (inverse * ndc).toVector3DAffine();
+}
+
+bool PointCloudViewer::screenToSectionPlane(const QPoint& screenPos, QPointF& planePos)
+{
+    QVector3D nearPoint = screenToWorld(screenPos, 0.0f);
+    QVector3D farPoint = screenToWorld(screenPos, 1.0f);
+    QVector3D ray = farPoint - nearPoint;
+
+    if (std::abs(ray.z()) < 1e-6f) {
+        return false;
+    }
+
+    float t = (m_cloud.centroid.z() - nearPoint.z()) / ray.z();
+    if (t < 0.0f) {
+        return false;
+    }
+
+    QVector3D hit = nearPoint + ray * t;
+    planePos = QPointF(hit.x(), hit.y());
+    return true;
 }
 
 QVector<int> PointCloudViewer::getVisiblePoints()
@@ -1,21 +1,267 @@
 #include "SimulationPreviewWidget.h"
+#include "Tracer.h"
 #include <QGridLayout>
 #include <QCloseEvent>
+#include <QPaintEvent>
+#include <QResizeEvent>
 #include <QPainter>
 #include <QPen>
 #include <QBrush>
+#include <QScreen>
 #include <QtMath>
 
 namespace DroneMapper {
 namespace UI {
 
+namespace {
+
+constexpr int MAX_TRAIL_POINTS = 256;
+constexpr double PLAN_PADDING = 0.1;        // Fraction of the plan extent
+constexpr int MARKER_RADIUS = 8;
+constexpr int HEADING_LENGTH = 20;
+constexpr int DETAILED_WAYPOINTS = 2000;    // Above this, waypoints are drawn as dots
+
+} // namespace
+
+// SimulationCanvas implementation
+
+SimulationCanvas::SimulationCanvas(QWidget *parent)
+    : QWidget(parent)
+    , m_staticDirty(true)
+    , m_droneWaypoint(-1)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void SimulationCanvas::setFlightPlan(const Models::FlightPlan& plan)
+{
+    const auto& waypoints = plan.waypoints();
+
+    m_waypoints.clear();
+    m_waypoints.reserve(waypoints.size());
+    for (const auto& wp : waypoints) {
+        m_waypoints.append(QPointF(wp.coordinate().longitude(), wp.coordinate().latitude()));
+    }
+
+    if (!m_waypoints.isEmpty()) {
+        double minLon = m_waypoints[0].x();
+        double maxLon = minLon;
+        double minLat = m_waypoints[0].y();
+        double maxLat = minLat;
+        for (const auto& point : m_waypoints) {
+            minLon = qMin(minLon, point.x());
+            maxLon = qMax(maxLon, point.x());
+            minLat = qMin(minLat, point.y());
+            maxLat = qMax(maxLat, point.y());
+        }
+
+        // Padding, and a minimum extent for single-point plans
+        const double lonPad = qMax((maxLon - minLon) * PLAN_PADDING, 1e-5);
+        const double latPad = qMax((maxLat - minLat) * PLAN_PADDING, 1e-5);
+        m_bounds = QRectF(QPointF(minLon - lonPad, minLat - latPad),
+                          QPointF(maxLon + lonPad, maxLat + latPad));
+    }
+
+    m_trail.clear();
+    m_droneWaypoint = -1;
+    m_staticDirty = true;
+    update();
+}
+
+void SimulationCanvas::setDronePosition(const Models::GeospatialCoordinate& position, int waypointIndex)
+{
+    if (m_waypoints.isEmpty()) {
+        return;
+    }
+
+    const QRect before = dynamicBounds();
+
+    const QPointF point(position.longitude(), position.latitude());
+    if (m_trail.isEmpty() || m_trail.last() != point) {
+        if (m_trail.size() >= MAX_TRAIL_POINTS) {
+            m_trail.removeFirst();
+        }
+        m_trail.append(point);
+    }
+    m_droneWaypoint = waypointIndex;
+
+    // Only the area under the old and new dynamic layer changes
+    update(before.united(dynamicBounds()));
+}
+
+void SimulationCanvas::clearTrail()
+{
+    const QRect before = dynamicBounds();
+    m_trail.clear();
+    m_droneWaypoint = -1;
+    update(before);
+}
+
+void SimulationCanvas::setPlaceholderText(const QString& text)
+{
+    m_placeholder = text;
+    update();
+}
+
+QPointF SimulationCanvas::toScreen(const QPointF& lonLat) const
+{
+    return QPointF((lonLat.x() - m_bounds.left()) / m_bounds.width() * width(),
+                   height() - (lonLat.y() - m_bounds.top()) / m_bounds.height() * height());
+}
+
+QRect SimulationCanvas::dynamicBounds() const
+{
+    if (m_trail.isEmpty() || m_droneWaypoint < 0) {
+        return QRect();
+    }
+
+    QPointF head = toScreen(m_trail.last());
+    double minX = head.x();
+    double maxX = head.x();
+    double minY = head.y();
+    double maxY = head.y();
+    for (const auto& point : m_trail) {
+        const QPointF screen = toScreen(point);
+        minX = qMin(minX, screen.x());
+        maxX = qMax(maxX, screen.x());
+        minY = qMin(minY, screen.y());
+        maxY = qMax(maxY, screen.y());
+    }
+
+    // Marker and heading extend around the head
+    const int margin = MARKER_RADIUS + HEADING_LENGTH + 2;
+    QRect rect(QPoint(qFloor(minX), qFloor(minY)), QPoint(qCeil(maxX), qCeil(maxY)));
+    return rect.adjusted(-margin, -margin, margin, margin);
+}
+
+void SimulationCanvas::renderStaticLayer()
+{
+    m_staticDirty = false;
+
+    const qreal dpr = devicePixelRatioF();
+    m_staticLayer = QPixmap(size() * dpr);
+    m_staticLayer.setDevicePixelRatio(dpr);
+    m_staticLayer.fill(Qt::white);
+
+    QPainter painter(&m_staticLayer);
+
+    const int w = width();
+    const int h = height();
+
+    if (m_waypoints.isEmpty()) {
+        painter.drawText(rect(), Qt::AlignCenter, m_placeholder);
+        return;
+    }
+
+    // Draw grid
+    painter.setPen(QPen(QColor(200, 200, 200), 1, Qt::DotLine));
+    for (int i = 0; i <= 10; i++) {
+        int x = static_cast<int>(i * w / 10);
+        int y = static_cast<int>(i * h / 10);
+        painter.drawLine(x, 0, x, h);
+        painter.drawLine(0, y, w, y);
+    }
+
+    QPolygonF path;
+    path.reserve(m_waypoints.size());
+    for (const auto& point : m_waypoints) {
+        path.append(toScreen(point));
+    }
+
+    // Draw flight path
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(QColor(100, 100, 255), 2));
+    painter.drawPolyline(path);
+
+    // Draw waypoints
+    if (path.size() <= DETAILED_WAYPOINTS) {
+        painter.setPen(QPen(Qt::black, 1));
+        painter.setBrush(QBrush(QColor(100, 200, 100)));
+        for (const auto& point : path) {
+            painter.drawEllipse(point, 4, 4);
+        }
+    } else {
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        painter.setPen(QPen(QColor(60, 160, 60), 3, Qt::SolidLine, Qt::SquareCap));
+        painter.drawPoints(path);
+    }
+}
+
+void SimulationCanvas::paintEvent(QPaintEvent *event)
+{
+    TRACE_SCOPE("render", "SimulationCanvas::paintEvent");
+
+    if (m_staticDirty || m_staticLayer.size() != size() * devicePixelRatioF()) {
+        renderStaticLayer();
+    }
+
+    QPainter painter(this);
+
+    // Static layer, only the exposed part
+    const QRect exposed = event->rect();
+    const qreal dpr = m_staticLayer.devicePixelRatio();
+    painter.drawPixmap(exposed, m_staticLayer,
+                       QRectF(exposed.topLeft() * dpr, exposed.size() * dpr));
+
+    if (m_trail.isEmpty() || m_droneWaypoint < 0) {
+        return;
+    }
+
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Trail
+    QPolygonF trail;
+    trail.reserve(m_trail.size());
+    for (const auto& point : m_trail) {
+        trail.append(toScreen(point));
+    }
+    painter.setPen(QPen(QColor(255, 120, 120), 2));
+    painter.drawPolyline(trail);
+
+    // Draw current position
+    const QPointF head = trail.last();
+    painter.setPen(QPen(Qt::red, 2));
+    painter.setBrush(QBrush(Qt::red));
+    painter.drawEllipse(head, MARKER_RADIUS, MARKER_RADIUS);
+
+    // Draw direction arrow
+    if (m_droneWaypoint < m_waypoints.size() - 1) {
+        const QPointF next = toScreen(m_waypoints[m_droneWaypoint + 1]);
+        double dx = next.x() - head.x();
+        double dy = next.y() - head.y();
+        double len = qSqrt(dx * dx + dy * dy);
+
+        if (len > 0) {
+            dx /= len;
+            dy /= len;
+            painter.drawLine(head, QPointF(head.x() + dx * HEADING_LENGTH, head.y() + dy * HEADING_LENGTH));
+        }
+    }
+}
+
+void SimulationCanvas::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_staticDirty = true;
+}
+
+// SimulationPreviewWidget implementation
+
 SimulationPreviewWidget::SimulationPreviewWidget(QWidget *parent)
     : QWidget(parent)
     , m_simulator(new Core::MissionSimulator(this))
     , m_isPlaying(false)
+    , m_frameTimer(new QTimer(this))
+    , m_statePending(false)
+    , m_reachedWaypoint(-1)
+    , m_capturedPhoto(-1)
+    , m_batteryLevel(-1)
 {
     setupUI();
 
+    m_frameTimer->setSingleShot(true);
+    connect(m_frameTimer, &QTimer::timeout, this, &SimulationPreviewWidget::onFrame);
+
     // Connect simulator signals
     connect(m_simulator, &Core::MissionSimulator::stateUpdated,
             this, &SimulationPreviewWidget::onSimulationStateUpdated);
@@ -43,12 +289,10 @@ void SimulationPreviewWidget::setupUI()
     m_mainLayout = new QVBoxLayout(this);
 
     // Visualization area
-    m_visualizationLabel = new QLabel(this);
-    m_visualizationLabel->setMinimumSize(800, 400);
-    m_visualizationLabel->setFrameStyle(QFrame::Box | QFrame::Sunken);
-    m_visualizationLabel->setAlignment(Qt::AlignCenter);
-    m_visualizationLabel->setText("Load a flight plan to begin simulation");
-    m_mainLayout->addWidget(m_visualizationLabel);
+    m_canvas = new SimulationCanvas(this);
+    m_canvas->setMinimumSize(800, 400);
+    m_canvas->setPlaceholderText("Load a flight plan to begin simulation");
+    m_mainLayout->addWidget(m_canvas);
 
     // Control panel
     m_controlGroup = new QGroupBox("Playback Controls", this);
@@ -65,10 +309,10 @@ void SimulationPreviewWidget::setupUI()
     m_speedLabel = new QLabel("Speed: 1.0x", this);
     m_speedSlider = new QSlider(Qt::Horizontal, this);
     m_speedSlider->setMinimum(1);
-    m_speedSlider->setMaximum(100);  // 0.1x to 10.0x
+    m_speedSlider->setMaximum(1000);  // 0.1x to 100.0x
     m_speedSlider->setValue(10);  // 1.0x
     m_speedSlider->setTickPosition(QSlider::TicksBelow);
-    m_speedSlider->setTickInterval(10);
+    m_speedSlider->setTickInterval(100);
     connect(m_speedSlider, &QSlider::valueChanged, this, &SimulationPreviewWidget::onSpeedChanged);
 
     m_progressBar = new QProgressBar(this);
@@ -163,7 +407,7 @@ void SimulationPreviewWidget::loadFlightPlan(const Models::FlightPlan& plan)
         m_stopButton->setEnabled(true);
 
         updateStatisticsDisplay();
-        drawFlightPath();
+        m_canvas->setFlightPlan(plan);
 
         // Display initial state
         onSimulationStateUpdated(m_simulator->currentState());
@@ -189,39 +433,75 @@ void SimulationPreviewWidget::onStopClicked()
     m_playPauseButton->setText("Play");
     m_isPlaying = false;
     m_progressBar->setValue(0);
+    m_canvas->clearTrail();
 }
 
 void SimulationPreviewWidget::onSpeedChanged(int value)
 {
-    double speed = value / 10.0;  // 1-100 -> 0.1x-10.0x
+    double speed = value / 10.0;  // 1-1000 -> 0.1x-100.0x
     m_simulator->setSimulationSpeed(speed);
     m_speedLabel->setText(QString("Speed: %1x").arg(speed, 0, 'f', 1));
 }
 
 void SimulationPreviewWidget::onSimulationStateUpdated(const Core::SimulationState& state)
 {
-    updateStateDisplay(state);
-
-    // Update progress bar
-    int progress = static_cast<int>(m_simulator->progress() * 100.0);
-    m_progressBar->setValue(progress);
-
-    // Redraw flight path with current position
-    drawFlightPath();
+    // Keep only the latest state; onFrame() applies it
+    m_pendingState = state;
+    m_statePending = true;
+    scheduleFrame();
 }
 
 void SimulationPreviewWidget::onWaypointReached(int waypointIndex)
 {
-    // Update waypoint label with highlight
-    const auto& stats = m_simulator->statistics();
-    m_currentWaypointLabel->setText(
-        QString("<b>Waypoint: %1/%2</b>").arg(waypointIndex + 1).arg(stats.totalWaypoints));
+    m_reachedWaypoint = waypointIndex;
+    scheduleFrame();
 }
 
 void SimulationPreviewWidget::onPhotoCaptured(int photoNumber, const Models::GeospatialCoordinate& position)
 {
-    // Flash photo indicator
-    m_photosTakenLabel->setText(QString("<b style='color: green;'>Photo #%1 captured</b>").arg(photoNumber));
+    Q_UNUSED(position);
+    m_capturedPhoto = photoNumber;
+    scheduleFrame();
+}
+
+void SimulationPreviewWidget::scheduleFrame()
+{
+    if (m_frameTimer->isActive()) {
+        return;
+    }
+
+    // One refresh per display frame at most
+    const QScreen *display = screen();
+    const double refreshRate = display ? display->refreshRate() : 60.0;
+    m_frameTimer->start(qMax(1, qRound(1000.0 / qMax(refreshRate, 1.0))));
+}
+
+void SimulationPreviewWidget::onFrame()
+{
+    if (m_statePending) {
+        m_statePending = false;
+        updateStateDisplay(m_pendingState);
+
+        // Update progress bar
+        int progress = static_cast<int>(m_simulator->progress() * 100.0);
+        m_progressBar->setValue(progress);
+
+        m_canvas->setDronePosition(m_pendingState.currentPosition, m_pendingState.currentWaypointIndex);
+    }
+
+    if (m_reachedWaypoint >= 0) {
+        // Update waypoint label with highlight
+        const auto& stats = m_simulator->statistics();
+        m_currentWaypointLabel->setText(
+            QString("<b>Waypoint: %1/%2</b>").arg(m_reachedWaypoint + 1).arg(stats.totalWaypoints));
+        m_reachedWaypoint = -1;
+    }
+
+    if (m_capturedPhoto >= 0) {
+        // Flash photo indicator
+        m_photosTakenLabel->setText(QString("<b style='color: green;'>Photo #%1 captured</b>").arg(m_capturedPhoto));
+        m_capturedPhoto = -1;
+    }
 }
 
 void SimulationPreviewWidget::onBatteryChangeRequired(int batteryNumber)
@@ -279,130 +559,23 @@ void SimulationPreviewWidget::updateStateDisplay(const Core::SimulationState& st
     int batteryPercent = static_cast<int>(state.currentBatteryPercent);
     m_batteryBar->setValue(batteryPercent);
 
-    // Color code battery level
-    if (batteryPercent > 50) {
-        m_batteryBar->setStyleSheet("QProgressBar::chunk { background-color: green; }");
-    } else if (batteryPercent > 20) {
-        m_batteryBar->setStyleSheet("QProgressBar::chunk { background-color: orange; }");
-    } else {
-        m_batteryBar->setStyleSheet("QProgressBar::chunk { background-color: red; }");
+    // Color code battery level; restyling is costly, so only on change
+    int level = batteryPercent > 50 ? 2 : (batteryPercent > 20 ? 1 : 0);
+    if (level != m_batteryLevel) {
+        m_batteryLevel = level;
+        if (level == 2) {
+            m_batteryBar->setStyleSheet("QProgressBar::chunk { background-color: green; }");
+        } else if (level == 1) {
+            m_batteryBar->setStyleSheet("QProgressBar::chunk { background-color: orange; }");
+        } else {
+            m_batteryBar->setStyleSheet("QProgressBar::chunk { background-color: red; }");
+        }
     }
 
     m_photosTakenLabel->setText(QString("Photos: %1").arg(state.photosTaken));
     m_elapsedTimeLabel->setText(QString("Time: %1").arg(formatTime(state.elapsedTime)));
 }
 
-void SimulationPreviewWidget::drawFlightPath()
-{
-    const auto& waypoints = m_flightPlan.waypoints();
-    if (waypoints.isEmpty()) {
-        return;
-    }
-
-    int width = m_visualizationLabel->width();
-    int height = m_visualizationLabel->height();
-
-    if (width < 100 || height < 100) {
-        return;
-    }
-
-    QPixmap pixmap(width, height);
-    pixmap.fill(Qt::white);
-
-    QPainter painter(&pixmap);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    // Find bounds
-    double minLat = waypoints[0].coordinate().latitude();
-    double maxLat = waypoints[0].coordinate().latitude();
-    double minLon = waypoints[0].coordinate().longitude();
-    double maxLon = waypoints[0].coordinate().longitude();
-
-    for (const auto& wp : waypoints) {
-        minLat = qMin(minLat, wp.coordinate().latitude());
-        maxLat = qMax(maxLat, wp.coordinate().latitude());
-        minLon = qMin(minLon, wp.coordinate().longitude());
-        maxLon = qMax(maxLon, wp.coordinate().longitude());
-    }
-
-    // Add padding
-    double latRange = maxLat - minLat;
-    double lonRange = maxLon - minLon;
-    double padding = 0.1;
-
-    minLat -= latRange * padding;
-    maxLat += latRange * padding;
-    minLon -= lonRange * padding;
-    maxLon += lonRange * padding;
-
-    latRange = maxLat - minLat;
-    lonRange = maxLon - minLon;
-
-    // Draw grid
-    painter.setPen(QPen(QColor(200, 200, 200), 1, Qt::DotLine));
-    for (int i = 0; i <= 10; i++) {
-        int x = static_cast<int>(i * width / 10);
-        int y = static_cast<int>(i * height / 10);
-        painter.drawLine(x, 0, x, height);
-        painter.drawLine(0, y, width, y);
-    }
-
-    // Draw flight path
-    painter.setPen(QPen(QColor(100, 100, 255), 2));
-
-    for (int i = 0; i < waypoints.size() - 1; i++) {
-        double x1 = (waypoints[i].coordinate().longitude() - minLon) / lonRange * width;
-        double y1 = height - (waypoints[i].coordinate().latitude() - minLat) / latRange * height;
-        double x2 = (waypoints[i + 1].coordinate().longitude() - minLon) / lonRange * width;
-        double y2 = height - (waypoints[i + 1].coordinate().latitude() - minLat) / latRange * height;
-
-        painter.drawLine(QPointF(x1, y1), QPointF(x2, y2));
-    }
-
-    // Draw waypoints
-    painter.setPen(QPen(Qt::black, 1));
-    painter.setBrush(QBrush(QColor(100, 200, 100)));
-
-    for (int i = 0; i < waypoints.size(); i++) {
-        double x = (waypoints[i].coordinate().longitude() - minLon) / lonRange * width;
-        double y = height - (waypoints[i].coordinate().latitude() - minLat) / latRange * height;
-
-        painter.drawEllipse(QPointF(x, y), 4, 4);
-    }
-
-    // Draw current position
-    const auto& state = m_simulator->currentState();
-    if (state.currentWaypointIndex < waypoints.size()) {
-        double x = (state.currentPosition.longitude() - minLon) / lonRange * width;
-        double y = height - (state.currentPosition.latitude() - minLat) / latRange * height;
-
-        painter.setPen(QPen(Qt::red, 2));
-        painter.setBrush(QBrush(Qt::red));
-        painter.drawEllipse(QPointF(x, y), 8, 8);
-
-        // Draw direction arrow
-        if (state.currentWaypointIndex < waypoints.size() - 1) {
-            const auto& nextWP = waypoints[state.currentWaypointIndex + 1].coordinate();
-            double x2 = (nextWP.longitude() - minLon) / lonRange * width;
-            double y2 = height - (nextWP.latitude() - minLat) / latRange * height;
-
-            double dx = x2 - x;
-            double dy = y2 - y;
-            double len = qSqrt(dx * dx + dy * dy);
-
-            if (len > 0) {
-                dx /= len;
-                dy /= len;
-                painter.drawLine(QPointF(x, y), QPointF(x + dx * 20, y + dy * 20));
-            }
-        }
-    }
-
-    painter.end();
-
-    m_visualizationLabel->setPixmap(pixmap);
-}
-
 QString SimulationPreviewWidget::formatTime(int seconds) const
 {
     int mins = seconds / 60;
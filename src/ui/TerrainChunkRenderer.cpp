@@ -0,0 +1,597 @@
+#include "TerrainChunkRenderer.h"
+#include "TerrainElevationViewer.h"
+#include <QSet>
+#include <QVector2D>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+// Vertex layout: position(3), morph delta(3), normal(3), color(3)
+constexpr int FLOATS_PER_VERTEX = 12;
+
+const char* VERTEX_SHADER = R"(
+    #version 120
+    attribute vec3 position;
+    attribute vec3 morphDelta;
+    attribute vec3 normal;
+    attribute vec3 color;
+
+    uniform mat4 viewProjection;
+    uniform vec3 cameraPosition;
+    uniform vec2 morphRange;
+
+    varying vec3 vColor;
+    varying vec3 vNormal;
+
+    void main()
+    {
+        float distanceToCamera = distance(position, cameraPosition);
+        float k = clamp((distanceToCamera - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+        vColor = color;
+        vNormal = normal;
+        gl_Position = viewProjection * vec4(position + morphDelta * k, 1.0);
+    }
+)";
+
+const char* FRAGMENT_SHADER = R"(
+    #version 120
+    uniform vec3 lightDirection;
+    uniform float lighting;
+    uniform vec4 solidColor;    // Alpha 1 replaces the vertex colours, unlit
+
+    varying vec3 vColor;
+    varying vec3 vNormal;
+
+    void main()
+    {
+        float diffuse = 0.3 + 0.7 * max(dot(normalize(vNormal), lightDirection), 0.0);
+        vec3 shaded = vColor * mix(1.0, diffuse, lighting);
+        gl_FragColor = vec4(mix(shaded, solidColor.rgb, solidColor.a), 1.0);
+    }
+)";
+
+inline float sampleClamped(const DEMData& dem, int x, int y)
+{
+    x = std::clamp(x, 0, dem.width - 1);
+    y = std::clamp(y, 0, dem.height - 1);
+    return dem.elevations[y * dem.width + x];
+}
+
+} // namespace
+
+// TerrainQuadtree implementation
+
+TerrainQuadtree::TerrainQuadtree()
+    : m_rootLevel(0)
+    , m_leafCells(32)
+{
+}
+
+void TerrainQuadtree::build(const DEMData& dem, int leafCells)
+{
+    clear();
+
+    if (dem.width < 2 || dem.height < 2 || dem.elevations.size() < dem.width * dem.height) {
+        return;
+    }
+
+    m_leafCells = leafCells;
+
+    // Smallest power-of-two multiple of the leaf size covering the DEM
+    int cells = std::max(dem.width - 1, dem.height - 1);
+    int rootSize = leafCells;
+    m_rootLevel = 0;
+    while (rootSize < cells) {
+        rootSize *= 2;
+        ++m_rootLevel;
+    }
+
+    int leavesPerSide = rootSize / leafCells;
+    m_nodes.reserve(leavesPerSide * leavesPerSide * 4 / 3 + 1);
+
+    buildNode(dem, 0, 0, rootSize, m_rootLevel, -1);
+}
+
+void TerrainQuadtree::clear()
+{
+    m_nodes.clear();
+    m_rootLevel = 0;
+}
+
+int TerrainQuadtree::buildNode(const DEMData& dem, int x, int y, int size, int level, int parent)
+{
+    int index = m_nodes.size();
+
+    Node node;
+    node.x = x;
+    node.y = y;
+    node.size = size;
+    node.level = level;
+    node.minZ = std::numeric_limits<float>::max();
+    node.maxZ = std::numeric_limits<float>::lowest();
+    node.parent = parent;
+    std::fill(std::begin(node.children), std::end(node.children), -1);
+    m_nodes.append(node);
+
+    if (level == 0) {
+        // Leaf: scan its samples (edges included so neighbours agree)
+        int x1 = std::min(x + size, dem.width - 1);
+        int y1 = std::min(y + size, dem.height - 1);
+        float minZ = node.minZ;
+        float maxZ = node.maxZ;
+
+        for (int sy = y; sy <= y1; ++sy) {
+            const float* row = dem.elevations.constData() + sy * dem.width;
+            for (int sx = x; sx <= x1; ++sx) {
+                minZ = std::min(minZ, row[sx]);
+                maxZ = std::max(maxZ, row[sx]);
+            }
+        }
+
+        m_nodes[index].minZ = minZ;
+        m_nodes[index].maxZ = maxZ;
+        return index;
+    }
+
+    int half = size / 2;
+    int children[4] = { -1, -1, -1, -1 };
+
+    for (int c = 0; c < 4; ++c) {
+        int cx = x + (c & 1) * half;
+        int cy = y + (c >> 1) * half;
+        if (cx >= dem.width - 1 || cy >= dem.height - 1) {
+            continue;  // Entirely outside the DEM
+        }
+        children[c] = buildNode(dem, cx, cy, half, level - 1, index);
+    }
+
+    // Parent range from children (m_nodes may have reallocated)
+    Node& built = m_nodes[index];
+    for (int c = 0; c < 4; ++c) {
+        built.children[c] = children[c];
+        if (children[c] >= 0) {
+            built.minZ = std::min(built.minZ, m_nodes[children[c]].minZ);
+            built.maxZ = std::max(built.maxZ, m_nodes[children[c]].maxZ);
+        }
+    }
+
+    return index;
+}
+
+// TerrainChunkRenderer implementation
+
+TerrainChunkRenderer::TerrainChunkRenderer()
+    : m_dem(nullptr)
+    , m_verticalExaggeration(1.0)
+    , m_colorScheme(ElevationColorScheme::Terrain)
+    , m_colorByElevation(true)
+    , m_overlay(nullptr)
+    , m_overlayRange(1.0f)
+    , m_solidColor(0.0f, 0.0f, 0.0f, 0.0f)
+    , m_detailDistance(500.0f)
+    , m_indexBuffer(QOpenGLBuffer::IndexBuffer)
+    , m_indexCount(0)
+    , m_initialized(false)
+    , m_maxPatches(1024)
+    , m_maxUploadsPerFrame(16)
+    , m_frame(0)
+    , m_stats{0, 0, 0, 0}
+{
+}
+
+TerrainChunkRenderer::~TerrainChunkRenderer()
+{
+    // GL resources must be released via cleanup() with the context current
+}
+
+bool TerrainChunkRenderer::initialize()
+{
+    initializeOpenGLFunctions();
+
+    if (!m_program.addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+        !m_program.addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER) ||
+        !m_program.link()) {
+        return false;
+    }
+
+    // Shared patch topology: (PATCH_CELLS + 1)^2 vertices, two triangles per cell
+    const int side = PATCH_CELLS + 1;
+    QVector<GLushort> indices;
+    indices.reserve(PATCH_CELLS * PATCH_CELLS * 6);
+
+    for (int y = 0; y < PATCH_CELLS; ++y) {
+        for (int x = 0; x < PATCH_CELLS; ++x) {
+            GLushort i0 = static_cast<GLushort>(y * side + x);
+            GLushort i1 = static_cast<GLushort>(y * side + x + 1);
+            GLushort i2 = static_cast<GLushort>((y + 1) * side + x);
+            GLushort i3 = static_cast<GLushort>((y + 1) * side + x + 1);
+
+            indices << i0 << i2 << i1;
+            indices << i1 << i2 << i3;
+        }
+    }
+
+    m_indexBuffer.create();
+    m_indexBuffer.bind();
+    m_indexBuffer.allocate(indices.constData(), indices.size() * sizeof(GLushort));
+    m_indexBuffer.release();
+    m_indexCount = indices.size();
+
+    m_initialized = true;
+    return true;
+}
+
+void TerrainChunkRenderer::cleanup()
+{
+    releasePatches();
+
+    if (m_indexBuffer.isCreated()) {
+        m_indexBuffer.destroy();
+    }
+    m_program.removeAllShaders();
+    m_initialized = false;
+}
+
+void TerrainChunkRenderer::setDEM(const DEMData* dem, double verticalExaggeration,
+                                  int colorScheme, bool colorByElevation)
+{
+    releasePatches();
+
+    m_dem = dem;
+    m_verticalExaggeration = verticalExaggeration;
+    m_colorScheme = colorScheme;
+    m_colorByElevation = colorByElevation;
+
+    if (m_dem) {
+        m_quadtree.build(*m_dem, PATCH_CELLS);
+    } else {
+        m_quadtree.clear();
+    }
+
+    computeLodRanges();
+}
+
+void TerrainChunkRenderer::setOverlay(const DEMData* overlay, float maxAbsValue)
+{
+    // Colours are baked into the patches
+    releasePatches();
+
+    m_overlay = overlay;
+    m_overlayRange = std::max(maxAbsValue, 1e-3f);
+}
+
+void TerrainChunkRenderer::setSolidColor(const QColor& color)
+{
+    m_solidColor = color.isValid()
+        ? QVector4D(color.redF(), color.greenF(), color.blueF(), 1.0f)
+        : QVector4D(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void TerrainChunkRenderer::releasePatches()
+{
+    for (auto it = m_patches.begin(); it != m_patches.end(); ++it) {
+        it->vertexBuffer.destroy();
+    }
+    m_patches.clear();
+}
+
+void TerrainChunkRenderer::setCacheLimits(int maxPatches, int maxUploadsPerFrame)
+{
+    m_maxPatches = std::max(maxPatches, 16);
+    m_maxUploadsPerFrame = std::max(maxUploadsPerFrame, 1);
+}
+
+void TerrainChunkRenderer::computeLodRanges()
+{
+    m_lodRanges.clear();
+
+    for (int level = 0; level <= m_quadtree.rootLevel(); ++level) {
+        m_lodRanges.append(m_detailDistance * static_cast<float>(1 << level));
+    }
+}
+
+bool TerrainChunkRenderer::render(const QMatrix4x4& viewProjection, const QVector3D& cameraPosition, bool lighting)
+{
+    m_stats = Statistics{0, 0, 0, static_cast<int>(m_patches.size())};
+
+    if (!m_initialized || !m_dem || m_quadtree.isEmpty()) {
+        return false;
+    }
+
+    ++m_frame;
+
+    // Frustum planes (Gribb-Hartmann); inside where dot(plane, p) >= 0
+    QVector<QVector4D> planes;
+    QVector4D r0 = viewProjection.row(0);
+    QVector4D r1 = viewProjection.row(1);
+    QVector4D r2 = viewProjection.row(2);
+    QVector4D r3 = viewProjection.row(3);
+    planes << (r3 + r0) << (r3 - r0) << (r3 + r1) << (r3 - r1) << (r3 + r2) << (r3 - r2);
+
+    QVector<int> selected;
+    selectNodes(0, planes, cameraPosition, selected);
+    m_stats.selectedNodes = selected.size();
+
+    // The root patch is always resident so streaming never leaves holes
+    int rootBudget = 1;
+    acquirePatch(0, rootBudget);
+
+    // Resolve patches; fall back to cached ancestors while streaming
+    int uploadBudget = m_maxUploadsPerFrame;
+    bool streaming = false;
+    QVector<int> drawList;
+    QSet<int> drawn;
+    const auto& nodes = m_quadtree.nodes();
+
+    for (int nodeIndex : selected) {
+        int candidate = nodeIndex;
+        Patch* patch = acquirePatch(candidate, uploadBudget);
+
+        while (!patch && nodes[candidate].parent >= 0) {
+            streaming = true;
+            candidate = nodes[candidate].parent;
+            auto it = m_patches.find(candidate);
+            if (it != m_patches.end()) {
+                patch = &it.value();
+            }
+        }
+
+        if (patch && !drawn.contains(candidate)) {
+            patch->lastUsedFrame = m_frame;
+            drawn.insert(candidate);
+            drawList.append(candidate);
+        }
+    }
+
+    m_program.bind();
+    m_program.setUniformValue("viewProjection", viewProjection);
+    m_program.setUniformValue("cameraPosition", cameraPosition);
+    m_program.setUniformValue("lightDirection", QVector3D(0.4f, 0.3f, 0.866f).normalized());
+    m_program.setUniformValue("lighting", lighting ? 1.0f : 0.0f);
+    m_program.setUniformValue("solidColor", m_solidColor);
+
+    const int stride = FLOATS_PER_VERTEX * sizeof(float);
+    const int positionLoc = m_program.attributeLocation("position");
+    const int morphLoc = m_program.attributeLocation("morphDelta");
+    const int normalLoc = m_program.attributeLocation("normal");
+    const int colorLoc = m_program.attributeLocation("color");
+
+    m_indexBuffer.bind();
+    m_program.enableAttributeArray(positionLoc);
+    m_program.enableAttributeArray(morphLoc);
+    m_program.enableAttributeArray(normalLoc);
+    m_program.enableAttributeArray(colorLoc);
+
+    for (int nodeIndex : drawList) {
+        const TerrainQuadtree::Node& node = nodes[nodeIndex];
+        Patch& patch = m_patches[nodeIndex];
+
+        // Morph into the next coarser level over the last quarter of the range
+        float rangeEnd = m_lodRanges[node.level];
+        m_program.setUniformValue("morphRange", QVector2D(rangeEnd * 0.75f, rangeEnd));
+
+        patch.vertexBuffer.bind();
+        m_program.setAttributeBuffer(positionLoc, GL_FLOAT, 0, 3, stride);
+        m_program.setAttributeBuffer(morphLoc, GL_FLOAT, 3 * sizeof(float), 3, stride);
+        m_program.setAttributeBuffer(normalLoc, GL_FLOAT, 6 * sizeof(float), 3, stride);
+        m_program.setAttributeBuffer(colorLoc, GL_FLOAT, 9 * sizeof(float), 3, stride);
+
+        glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_SHORT, nullptr);
+        patch.vertexBuffer.release();
+    }
+
+    m_program.disableAttributeArray(positionLoc);
+    m_program.disableAttributeArray(morphLoc);
+    m_program.disableAttributeArray(normalLoc);
+    m_program.disableAttributeArray(colorLoc);
+    m_indexBuffer.release();
+    m_program.release();
+
+    m_stats.drawnPatches = drawList.size();
+    m_stats.uploadedPatches = m_maxUploadsPerFrame - uploadBudget;
+
+    evictPatches();
+    m_stats.cachedPatches = m_patches.size();
+
+    return streaming;
+}
+
+void TerrainChunkRenderer::selectNodes(int nodeIndex, const QVector<QVector4D>& planes,
+                                       const QVector3D& cameraPosition, QVector<int>& selected) const
+{
+    const TerrainQuadtree::Node& node = m_quadtree.nodes()[nodeIndex];
+
+    QVector3D minCorner, maxCorner;
+    nodeBounds(node, minCorner, maxCorner);
+
+    if (!aabbInFrustum(planes, minCorner, maxCorner)) {
+        return;
+    }
+
+    // Split while the finer level's range still reaches this node
+    bool split = node.level > 0 &&
+                 aabbInSphere(cameraPosition, m_lodRanges[node.level - 1], minCorner, maxCorner);
+
+    if (!split) {
+        selected.append(nodeIndex);
+        return;
+    }
+
+    for (int child : node.children) {
+        if (child >= 0) {
+            selectNodes(child, planes, cameraPosition, selected);
+        }
+    }
+}
+
+bool TerrainChunkRenderer::aabbInFrustum(const QVector<QVector4D>& planes,
+                                         const QVector3D& minCorner, const QVector3D& maxCorner) const
+{
+    for (const QVector4D& plane : planes) {
+        // Corner furthest along the plane normal
+        QVector3D p(
+            plane.x() >= 0.0f ? maxCorner.x() : minCorner.x(),
+            plane.y() >= 0.0f ? maxCorner.y() : minCorner.y(),
+            plane.z() >= 0.0f ? maxCorner.z() : minCorner.z());
+
+        if (plane.x() * p.x() + plane.y() * p.y() + plane.z() * p.z() + plane.w() < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TerrainChunkRenderer::aabbInSphere(const QVector3D& center, float radius,
+                                        const QVector3D& minCorner, const QVector3D& maxCorner) const
+{
+    float distanceSq = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+        float v = center[k];
+        if (v < minCorner[k]) {
+            distanceSq += (minCorner[k] - v) * (minCorner[k] - v);
+        } else if (v > maxCorner[k]) {
+            distanceSq += (v - maxCorner[k]) * (v - maxCorner[k]);
+        }
+    }
+    return distanceSq <= radius * radius;
+}
+
+void TerrainChunkRenderer::nodeBounds(const TerrainQuadtree::Node& node,
+                                      QVector3D& minCorner, QVector3D& maxCorner) const
+{
+    const float resolution = static_cast<float>(m_dem->resolution);
+    const float exaggeration = static_cast<float>(m_verticalExaggeration);
+
+    // Power-of-two footprints overhang the DEM on the far edges; use the real extent
+    const int x1 = std::min(node.x + node.size, m_dem->width - 1);
+    const int y1 = std::min(node.y + node.size, m_dem->height - 1);
+
+    minCorner = QVector3D(node.x * resolution, node.y * resolution, node.minZ * exaggeration);
+    maxCorner = QVector3D(x1 * resolution, y1 * resolution, node.maxZ * exaggeration);
+}
+
+QVector<float> TerrainChunkRenderer::buildPatchVertices(const TerrainQuadtree::Node& node) const
+{
+    const DEMData& dem = *m_dem;
+    const int side = PATCH_CELLS + 1;
+    const int step = node.size / PATCH_CELLS;
+    const float resolution = static_cast<float>(dem.resolution);
+    const float exaggeration = static_cast<float>(m_verticalExaggeration);
+
+    // Grid to geographic, for sampling the overlay
+    const double lonPerCell = (dem.bottomRight.longitude() - dem.topLeft.longitude()) / std::max(dem.width - 1, 1);
+    const double latPerCell = (dem.topLeft.latitude() - dem.bottomRight.latitude()) / std::max(dem.height - 1, 1);
+
+    QVector<float> vertices;
+    vertices.reserve(side * side * FLOATS_PER_VERTEX);
+
+    for (int j = 0; j < side; ++j) {
+        for (int i = 0; i < side; ++i) {
+            // Vertices past the DEM edge collapse onto it (zero-area cells),
+            // so edge patches end at the last sample instead of a flat shelf
+            int gx = std::min(node.x + i * step, dem.width - 1);
+            int gy = std::min(node.y + j * step, dem.height - 1);
+            float elevation = sampleClamped(dem, gx, gy);
+
+            // Odd vertices collapse onto their even neighbour at full
+            // morph, which reproduces the next coarser patch exactly
+            int tx = std::min(node.x + (i - (i & 1)) * step, dem.width - 1);
+            int ty = std::min(node.y + (j - (j & 1)) * step, dem.height - 1);
+            float targetElevation = sampleClamped(dem, tx, ty);
+
+            // Central differences at this level's spacing
+            float hL = sampleClamped(dem, gx - step, gy);
+            float hR = sampleClamped(dem, gx + step, gy);
+            float hD = sampleClamped(dem, gx, gy - step);
+            float hU = sampleClamped(dem, gx, gy + step);
+            QVector3D normal = QVector3D(
+                (hL - hR) * exaggeration,
+                (hD - hU) * exaggeration,
+                2.0f * step * resolution).normalized();
+
+            QVector3D color = m_colorByElevation
+                ? ElevationColorScheme::getColor(
+                      elevation, dem.minElevation, dem.maxElevation,
+                      static_cast<ElevationColorScheme::Scheme>(m_colorScheme))
+                : QVector3D(0.5f, 0.5f, 0.5f);
+
+            if (m_overlay) {
+                Models::GeospatialCoordinate coord(
+                    dem.topLeft.latitude() - gy * latPerCell,
+                    dem.topLeft.longitude() + gx * lonPerCell);
+                if (m_overlay->contains(coord)) {
+                    float value = m_overlay->getElevationAt(coord);
+                    if (!std::isnan(value)) {
+                        color = ElevationColorScheme::getDifferenceColor(value, m_overlayRange);
+                    }
+                }
+            }
+
+            vertices << gx * resolution << gy * resolution << elevation * exaggeration;
+            vertices << (tx - gx) * resolution << (ty - gy) * resolution
+                     << (targetElevation - elevation) * exaggeration;
+            vertices << normal.x() << normal.y() << normal.z();
+            vertices << color.x() << color.y() << color.z();
+        }
+    }
+
+    return vertices;
+}
+
+TerrainChunkRenderer::Patch* TerrainChunkRenderer::acquirePatch(int nodeIndex, int& uploadBudget)
+{
+    auto it = m_patches.find(nodeIndex);
+    if (it != m_patches.end()) {
+        return &it.value();
+    }
+
+    if (uploadBudget <= 0) {
+        return nullptr;
+    }
+    --uploadBudget;
+
+    QVector<float> vertices = buildPatchVertices(m_quadtree.nodes()[nodeIndex]);
+
+    Patch patch;
+    patch.vertexBuffer = QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+    patch.vertexBuffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    patch.vertexBuffer.create();
+    patch.vertexBuffer.bind();
+    patch.vertexBuffer.allocate(vertices.constData(), vertices.size() * sizeof(float));
+    patch.vertexBuffer.release();
+    patch.lastUsedFrame = m_frame;
+
+    return &m_patches.insert(nodeIndex, patch).value();
+}
+
+void TerrainChunkRenderer::evictPatches()
+{
+    if (m_patches.size() <= m_maxPatches) {
+        return;
+    }
+
+    // Oldest first; never evict what was drawn this frame
+    QVector<QPair<qint64, int>> ages;
+    ages.reserve(m_patches.size());
+    for (auto it = m_patches.constBegin(); it != m_patches.constEnd(); ++it) {
+        if (it->lastUsedFrame < m_frame) {
+            ages.append(qMakePair(it->lastUsedFrame, it.key()));
+        }
+    }
+    std::sort(ages.begin(), ages.end());
+
+    int excess = m_patches.size() - m_maxPatches;
+    for (int i = 0; i < excess && i < ages.size(); ++i) {
+        auto it = m_patches.find(ages[i].second);
+        it->vertexBuffer.destroy();
+        m_patches.erase(it);
+    }
+}
+
+} // namespace UI
+} // namespace DroneMapper
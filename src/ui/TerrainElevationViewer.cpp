@@ -6,12 +6,26 @@
 #include <QWheelEvent>
 #include <QtMath>
 #include <QFileInfo>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QJsonDocument>
+#include "Logger.h"
+#include "Tracer.h"
 #include <cmath>
+#include <limits>
 #include <algorithm>
 
 namespace DroneMapper {
 namespace UI {
 
+namespace {
+
+constexpr int HOVER_QUERY_INTERVAL_MS = 50;  // At most one hover pick per interval
+constexpr int CONTOUR_CACHE_KB = 32 * 1024;  // Contour sets kept while the interval is varied
+
+} // namespace
+
 // DEMData implementation
 
 float DEMData::getElevation(int x, int y) const
@@ -230,6 +244,22 @@ QVector3D ElevationColorScheme::getColor(
     }
 }
 
+QVector3D ElevationColorScheme::getDifferenceColor(float change, float maxAbsChange)
+{
+    float t = std::clamp(change / std::max(maxAbsChange, 1e-6f), -1.0f, 1.0f);
+
+    if (t < 0.0f) {
+        return interpolateColor(
+            QVector3D(1.0f, 1.0f, 1.0f),  // White
+            QVector3D(0.1f, 0.3f, 0.9f),  // Blue (cut)
+            -t);
+    }
+    return interpolateColor(
+        QVector3D(1.0f, 1.0f, 1.0f),      // White
+        QVector3D(0.9f, 0.15f, 0.1f),     // Red (fill)
+        t);
+}
+
 QVector3D ElevationColorScheme::interpolateColor(
     const QVector3D& color1,
     const QVector3D& color2,
@@ -326,17 +356,33 @@ void TerrainCamera::updatePosition()
 TerrainElevationViewer::TerrainElevationViewer(QWidget* parent)
     : QOpenGLWidget(parent)
     , m_colorScheme(ElevationColorScheme::Terrain)
+    , m_terrainDirty(false)
+    , m_differenceRange(1.0f)
+    , m_showDifference(false)
+    , m_showViewshed(false)
+    , m_contourCache(CONTOUR_CACHE_KB)
+    , m_contourPolylineInterval(0.0)
     , m_leftButtonPressed(false)
     , m_middleButtonPressed(false)
     , m_rightButtonPressed(false)
+    , m_hoverTimer(new QTimer(this))
 {
     setFocusPolicy(Qt::StrongFocus);
+    setMouseTracking(true);  // Hover elevation queries
+
+    // Hover moves are coalesced: the latest position is picked once the
+    // interval runs out, instead of a pick and a signal per mouse event
+    m_hoverTimer->setSingleShot(true);
+    m_hoverTimer->setInterval(HOVER_QUERY_INTERVAL_MS);
+    connect(m_hoverTimer, &QTimer::timeout, this, [this]() {
+        getElevationAt(m_hoverPos);
+    });
 }
 
 TerrainElevationViewer::~TerrainElevationViewer()
 {
     makeCurrent();
-    // Cleanup OpenGL resources
+    m_chunkRenderer.cleanup();
     doneCurrent();
 }
 
@@ -362,6 +408,9 @@ bool TerrainElevationViewer::loadDEM(const QString& filePath)
     }
 
     if (success) {
+        m_rayCaster.build(m_demData);
+        m_showViewshed = false;
+        invalidateContours();
         generateTerrainMesh();
         update();
         emit demLoaded(filePath);
@@ -373,6 +422,9 @@ bool TerrainElevationViewer::loadDEM(const QString& filePath)
 void TerrainElevationViewer::setDEMData(const DEMData& data)
 {
     m_demData = data;
+    m_rayCaster.build(m_demData);
+    m_showViewshed = false;
+    invalidateContours();
     generateTerrainMesh();
     update();
 }
@@ -385,7 +437,14 @@ void TerrainElevationViewer::setFlightPlan(const Models::FlightPlan& plan)
 
 void TerrainElevationViewer::setSettings(const TerrainSettings& settings)
 {
+    bool meshChanged = settings.verticalExaggeration != m_settings.verticalExaggeration ||
+                       settings.colorByElevation != m_settings.colorByElevation;
+
     m_settings = settings;
+
+    if (meshChanged) {
+        generateTerrainMesh();
+    }
     update();
 }
 
@@ -404,17 +463,153 @@ bool TerrainElevationViewer::exportImage(const QString& filePath)
 
 float TerrainElevationViewer::getElevationAt(const QPoint& screenPos)
 {
-    Q_UNUSED(screenPos);
-    // Would implement ray-terrain intersection in production
-    return 0.0f;
+    QVector3D hit;
+    if (!pickTerrain(screenPos, hit)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    emit elevationQueried(hit.z());
+    return hit.z();
 }
 
 double TerrainElevationViewer::measureDistance(const QPoint& start, const QPoint& end)
 {
-    Q_UNUSED(start);
-    Q_UNUSED(end);
-    // Would implement 3D distance measurement in production
-    return 0.0;
+    QVector3D a;
+    QVector3D b;
+    if (!pickTerrain(start, a) || !pickTerrain(end, b)) {
+        return -1.0;
+    }
+
+    return (b - a).length();
+}
+
+bool TerrainElevationViewer::pickTerrain(const QPoint& screenPos, QVector3D& localPoint)
+{
+    QVector3D origin;
+    QVector3D direction;
+    if (!screenRay(screenPos, origin, direction)) {
+        return false;
+    }
+
+    return m_rayCaster.intersect(origin, direction, &localPoint);
+}
+
+bool TerrainElevationViewer::hasLineOfSight(const Models::GeospatialCoordinate& from, double fromAltitude,
+                                            const Models::GeospatialCoordinate& to, double toAltitude) const
+{
+    return m_rayCaster.lineOfSight(m_rayCaster.toLocal(from, fromAltitude),
+                                   m_rayCaster.toLocal(to, toAltitude));
+}
+
+QList<Core::AltitudeViolation> TerrainElevationViewer::checkVisualLineOfSight(
+    const ViewshedAnalyzer::Observer& pilot,
+    const Core::RegulatoryLimits& limits) const
+{
+    return ViewshedAnalyzer::checkVisualLineOfSight(m_demData, m_rayCaster, pilot, m_flightPlan, limits);
+}
+
+Viewshed TerrainElevationViewer::showViewshed(const ViewshedAnalyzer::Observer& pilot, double targetHeight)
+{
+    const Viewshed viewshed = ViewshedAnalyzer::compute(m_demData, pilot, targetHeight);
+    if (viewshed.width == 0) {
+        clearViewshed();
+        return viewshed;
+    }
+
+    // Hidden cells take the cut colour of the overlay ramp; visible cells keep the terrain colours
+    m_viewshedLayer.width = viewshed.width;
+    m_viewshedLayer.height = viewshed.height;
+    m_viewshedLayer.topLeft = m_demData.topLeft;
+    m_viewshedLayer.bottomRight = m_demData.bottomRight;
+    m_viewshedLayer.resolution = m_demData.resolution;
+    m_viewshedLayer.minElevation = -1.0f;
+    m_viewshedLayer.maxElevation = -1.0f;
+    m_viewshedLayer.elevations.resize(viewshed.visible.size());
+    for (int i = 0; i < viewshed.visible.size(); ++i) {
+        m_viewshedLayer.elevations[i] = viewshed.visible[i]
+            ? std::numeric_limits<float>::quiet_NaN()
+            : -1.0f;
+    }
+    m_showViewshed = true;
+
+    generateTerrainMesh();
+    update();
+    return viewshed;
+}
+
+void TerrainElevationViewer::clearViewshed()
+{
+    m_showViewshed = false;
+    m_viewshedLayer.elevations.clear();
+
+    generateTerrainMesh();
+    update();
+}
+
+void TerrainElevationViewer::setDifferenceLayer(const Geospatial::DEMDifferenceAnalyzer::Result& result)
+{
+    if (result.preview.isEmpty()) {
+        clearDifferenceLayer();
+        return;
+    }
+
+    m_differenceLayer.width = result.previewWidth;
+    m_differenceLayer.height = result.previewHeight;
+    m_differenceLayer.elevations = result.preview;
+    m_differenceLayer.topLeft = result.previewTopLeft;
+    m_differenceLayer.bottomRight = result.previewBottomRight;
+    m_differenceLayer.resolution = result.summary.pixelSize * result.previewFactor;
+    m_differenceLayer.minElevation = static_cast<float>(result.summary.minChange);
+    m_differenceLayer.maxElevation = static_cast<float>(result.summary.maxChange);
+
+    // Symmetric colour range so zero change stays white
+    m_differenceRange = static_cast<float>(std::max(std::abs(result.summary.minChange),
+                                                    std::abs(result.summary.maxChange)));
+    m_showDifference = true;
+    m_showViewshed = false;
+
+    generateTerrainMesh();
+    update();
+}
+
+void TerrainElevationViewer::clearDifferenceLayer()
+{
+    m_showDifference = false;
+    m_differenceLayer.elevations.clear();
+
+    generateTerrainMesh();
+    update();
+}
+
+bool TerrainElevationViewer::screenRay(const QPoint& screenPos, QVector3D& origin, QVector3D& direction)
+{
+    if (m_rayCaster.isEmpty() || width() <= 0 || height() <= 0) {
+        return false;
+    }
+
+    float aspect = static_cast<float>(width()) / height();
+    bool invertible = false;
+    QMatrix4x4 inverse = (m_camera.projectionMatrix(aspect) * m_camera.viewMatrix()).inverted(&invertible);
+    if (!invertible) {
+        return false;
+    }
+
+    float ndcX = 2.0f * screenPos.x() / width() - 1.0f;
+    float ndcY = 1.0f - 2.0f * screenPos.y() / height();
+
+    QVector3D nearPoint = inverse.map(QVector3D(ndcX, ndcY, -1.0f));
+    QVector3D farPoint = inverse.map(QVector3D(ndcX, ndcY, 1.0f));
+
+    // World z carries the vertical exaggeration; DEM-local z does not
+    float zScale = m_settings.verticalExaggeration > 0.0
+        ? static_cast<float>(1.0 / m_settings.verticalExaggeration)
+        : 1.0f;
+    nearPoint.setZ(nearPoint.z() * zScale);
+    farPoint.setZ(farPoint.z() * zScale);
+
+    origin = nearPoint;
+    direction = farPoint - nearPoint;
+    return true;
 }
 
 void TerrainElevationViewer::initializeGL()
@@ -425,9 +620,15 @@ void TerrainElevationViewer::initializeGL()
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
 
+    if (!m_chunkRenderer.initialize()) {
+        emit renderingError("Failed to initialize terrain shaders");
+    }
+
     // Generate test terrain if no DEM loaded
     if (m_demData.elevations.isEmpty()) {
         m_demData.generateTestTerrain(128, 128);
+        m_rayCaster.build(m_demData);
+        invalidateContours();
         generateTerrainMesh();
     }
 }
@@ -439,26 +640,43 @@ void TerrainElevationViewer::resizeGL(int w, int h)
 
 void TerrainElevationViewer::paintGL()
 {
+    TRACE_SCOPE("render", "TerrainElevationViewer::paintGL");
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    if (m_vertices.isEmpty()) {
+    if (m_demData.elevations.isEmpty()) {
         return;
     }
 
+    // Chunk rebuilds need the GL context, which is current here
+    if (m_terrainDirty) {
+        m_chunkRenderer.setDetailDistance(
+            static_cast<float>(64.0 * m_demData.resolution));
+        m_chunkRenderer.setDEM(&m_demData, m_settings.verticalExaggeration,
+                               m_colorScheme, m_settings.colorByElevation);
+        if (m_showViewshed) {
+            m_chunkRenderer.setOverlay(&m_viewshedLayer, 1.0f);
+        } else {
+            m_chunkRenderer.setOverlay(m_showDifference ? &m_differenceLayer : nullptr,
+                                       m_differenceRange);
+        }
+        m_terrainDirty = false;
+    }
+
     // Setup matrices
     float aspect = static_cast<float>(width()) / height();
     QMatrix4x4 projection = m_camera.projectionMatrix(aspect);
     QMatrix4x4 view = m_camera.viewMatrix();
-    QMatrix4x4 model;
+    QMatrix4x4 viewProjection = projection * view;
 
     // Render terrain
     if (m_settings.showTerrain) {
-        renderTerrain();
+        renderTerrain(viewProjection);
     }
 
     // Render wireframe
     if (m_settings.showWireframe) {
-        renderWireframe();
+        renderWireframe(viewProjection);
     }
 
     // Render contours
@@ -497,11 +715,28 @@ void TerrainElevationViewer::mouseMoveEvent(QMouseEvent* event)
         // Pan camera
         m_camera.pan(-delta.x() * 2.0f, delta.y() * 2.0f);
         update();
+    } else {
+        // Hover: report terrain elevation under the cursor
+        m_hoverPos = event->pos();
+        if (!m_hoverTimer->isActive()) {
+            m_hoverTimer->start();
+        }
     }
 
     m_lastMousePos = event->pos();
 }
 
+void TerrainElevationViewer::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton) {
+        m_leftButtonPressed = false;
+    } else if (event->button() == Qt::MiddleButton) {
+        m_middleButtonPressed = false;
+    } else if (event->button() == Qt::RightButton) {
+        m_rightButtonPressed = false;
+    }
+}
+
 void TerrainElevationViewer::wheelEvent(QWheelEvent* event)
 {
     float delta = event->angleDelta().y() * 0.5f;
@@ -515,57 +750,11 @@ void TerrainElevationViewer::generateTerrainMesh()
         return;
     }
 
-    m_vertices.clear();
-    m_indices.clear();
-
-    int width = m_demData.width;
-    int height = m_demData.height;
-
-    // Generate vertices
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            TerrainVertex vertex;
-
-            float elevation = m_demData.getElevation(x, y);
-            vertex.position = demToWorld(x, y, elevation * m_settings.verticalExaggeration);
-            vertex.normal = calculateNormal(x, y);
-            vertex.texCoord = QVector2D(
-                static_cast<float>(x) / (width - 1),
-                static_cast<float>(y) / (height - 1));
-
-            if (m_settings.colorByElevation) {
-                vertex.color = ElevationColorScheme::getColor(
-                    elevation,
-                    m_demData.minElevation,
-                    m_demData.maxElevation,
-                    m_colorScheme);
-            } else {
-                vertex.color = QVector3D(0.5f, 0.5f, 0.5f);
-            }
-
-            m_vertices.append(vertex);
-        }
-    }
-
-    // Generate indices for triangles
-    for (int y = 0; y < height - 1; ++y) {
-        for (int x = 0; x < width - 1; ++x) {
-            int i0 = y * width + x;
-            int i1 = y * width + (x + 1);
-            int i2 = (y + 1) * width + x;
-            int i3 = (y + 1) * width + (x + 1);
+    // Quadtree and patches are rebuilt lazily in paintGL
+    m_terrainDirty = true;
 
-            // First triangle
-            m_indices.append(i0);
-            m_indices.append(i2);
-            m_indices.append(i1);
-
-            // Second triangle
-            m_indices.append(i1);
-            m_indices.append(i2);
-            m_indices.append(i3);
-        }
-    }
+    // World-space contours depend on the vertical exaggeration
+    m_contourPolylineInterval = 0.0;
 }
 
 void TerrainElevationViewer::generateTerrainGrid()
@@ -573,57 +762,51 @@ void TerrainElevationViewer::generateTerrainGrid()
     generateTerrainMesh();
 }
 
-QVector3D TerrainElevationViewer::calculateNormal(int x, int y)
+void TerrainElevationViewer::renderTerrain(const QMatrix4x4& viewProjection)
 {
-    int width = m_demData.width;
-    int height = m_demData.height;
-
-    // Central differences for normal calculation
-    float hL = x > 0 ? m_demData.getElevation(x - 1, y) : m_demData.getElevation(x, y);
-    float hR = x < width - 1 ? m_demData.getElevation(x + 1, y) : m_demData.getElevation(x, y);
-    float hD = y > 0 ? m_demData.getElevation(x, y - 1) : m_demData.getElevation(x, y);
-    float hU = y < height - 1 ? m_demData.getElevation(x, y + 1) : m_demData.getElevation(x, y);
-
-    QVector3D normal(hL - hR, hD - hU, 2.0f * m_demData.resolution);
-    return normal.normalized();
-}
-
-void TerrainElevationViewer::renderTerrain()
-{
-    // Simplified rendering using immediate mode
-    // Production would use VBOs/VAOs
-    glBegin(GL_TRIANGLES);
-
-    for (int i = 0; i < m_indices.size(); i += 3) {
-        for (int j = 0; j < 3; ++j) {
-            const TerrainVertex& v = m_vertices[m_indices[i + j]];
+    // Chunked LOD; keep repainting while patches are still streaming in
+    bool streaming = m_chunkRenderer.render(
+        viewProjection, m_camera.position(), m_settings.enableLighting);
 
-            if (m_settings.enableLighting) {
-                glNormal3f(v.normal.x(), v.normal.y(), v.normal.z());
-            }
-
-            glColor3f(v.color.x(), v.color.y(), v.color.z());
-            glVertex3f(v.position.x(), v.position.y(), v.position.z());
-        }
+    if (streaming) {
+        update();
     }
-
-    glEnd();
 }
 
-void TerrainElevationViewer::renderWireframe()
+void TerrainElevationViewer::renderWireframe(const QMatrix4x4& viewProjection)
 {
     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    glColor3f(1.0f, 1.0f, 1.0f);
+    m_chunkRenderer.setSolidColor(Qt::white);
 
-    renderTerrain();
+    renderTerrain(viewProjection);
 
+    m_chunkRenderer.setSolidColor(QColor());
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 }
 
 void TerrainElevationViewer::renderContours()
 {
-    // Simplified contour rendering
-    // Production would use marching squares/cubes
+    double interval = m_settings.contourInterval;
+    if (interval <= 0.0) {
+        return;
+    }
+
+    if (m_contourPolylineInterval != interval) {
+        m_contourPolylines = generateContours(static_cast<float>(interval));
+        m_contourPolylineInterval = interval;
+    }
+
+    const QColor& color = m_settings.contourColor;
+    glColor4f(color.redF(), color.greenF(), color.blueF(), color.alphaF());
+    glLineWidth(1.0f);
+
+    for (const auto& polyline : m_contourPolylines) {
+        glBegin(GL_LINE_STRIP);
+        for (const auto& pos : polyline) {
+            glVertex3f(pos.x(), pos.y(), pos.z());
+        }
+        glEnd();
+    }
 }
 
 void TerrainElevationViewer::renderFlightPath()
@@ -648,14 +831,112 @@ void TerrainElevationViewer::renderAltitudeProfile()
 
 QVector<QVector<QVector3D>> TerrainElevationViewer::generateContours(float interval)
 {
-    Q_UNUSED(interval);
-    return QVector<QVector<QVector3D>>();
+    QVector<QVector<QVector3D>> polylines;
+
+    const QVector<ContourLine>& lines = contoursForInterval(interval);
+    polylines.reserve(lines.size());
+
+    for (const auto& line : lines) {
+        polylines.append(contourToWorld(line));
+    }
+
+    return polylines;
 }
 
 QVector<QVector3D> TerrainElevationViewer::traceContour(float elevation)
 {
-    Q_UNUSED(elevation);
-    return QVector<QVector3D>();
+    // Longest polyline at a single level
+    QVector<ContourLine> lines = ContourGenerator::generateLevels(m_demData, {elevation});
+
+    const ContourLine* longest = nullptr;
+    for (const auto& line : lines) {
+        if (!longest || line.points.size() > longest->points.size()) {
+            longest = &line;
+        }
+    }
+
+    return longest ? contourToWorld(*longest) : QVector<QVector3D>();
+}
+
+const QVector<ContourLine>& TerrainElevationViewer::contoursForInterval(double interval)
+{
+    // Intervals from a slider differ in the last bits; one entry per centimetre
+    const qint64 key = qMax<qint64>(1, qRound64(interval * 100.0));
+    if (const QVector<ContourLine>* cached = m_contourCache.object(key)) {
+        return *cached;
+    }
+    interval = key / 100.0;
+
+    // Drop sub-cell zigzags; contours are drawn over a 1-cell mesh anyway
+    ContourGenerator::Options options;
+    options.simplifyTolerance = 0.1;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<ContourLine> lines = ContourGenerator::generate(m_demData, interval, options);
+
+    LOG_INFO(QString("Generated %1 contour lines at %2 m interval in %3 ms")
+        .arg(lines.size())
+        .arg(interval)
+        .arg(timer.elapsed()));
+
+    // Cost in KB; a set larger than the budget still stays as the only entry
+    qint64 points = 0;
+    for (const ContourLine& line : lines) {
+        points += line.points.size();
+    }
+    const qint64 costKB = (points * qint64(sizeof(QPointF)) + qint64(lines.size()) * qint64(sizeof(ContourLine))) / 1024;
+    auto* entry = new QVector<ContourLine>(std::move(lines));
+    m_contourCache.insert(key, entry, std::clamp<qint64>(costKB, 1, m_contourCache.maxCost()));
+    return *entry;
+}
+
+QVector<QVector3D> TerrainElevationViewer::contourToWorld(const ContourLine& line) const
+{
+    QVector<QVector3D> polyline;
+    polyline.reserve(line.points.size() + 1);
+
+    // Lift slightly above the surface to avoid z-fighting
+    float z = static_cast<float>(line.elevation * m_settings.verticalExaggeration) + 0.5f;
+
+    for (const auto& p : line.points) {
+        polyline.append(QVector3D(static_cast<float>(p.x() * m_demData.resolution),
+                                  static_cast<float>(p.y() * m_demData.resolution),
+                                  z));
+    }
+
+    if (line.closed && !polyline.isEmpty()) {
+        polyline.append(polyline.first());
+    }
+
+    return polyline;
+}
+
+void TerrainElevationViewer::invalidateContours()
+{
+    m_contourCache.clear();
+    m_contourPolylines.clear();
+    m_contourPolylineInterval = 0.0;
+}
+
+bool TerrainElevationViewer::exportContoursGeoJSON(const QString& filePath)
+{
+    if (m_demData.elevations.isEmpty() || m_settings.contourInterval <= 0.0) {
+        return false;
+    }
+
+    QJsonDocument document = ContourGenerator::toGeoJson(
+        contoursForInterval(m_settings.contourInterval), m_demData);
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        emit renderingError("Cannot write contours: " + filePath);
+        return false;
+    }
+
+    file.write(document.toJson(QJsonDocument::Compact));
+    return true;
 }
 
 QVector3D TerrainElevationViewer::demToWorld(int x, int y, float elevation) const
@@ -701,12 +982,14 @@ AltitudeProfileWidget::AltitudeProfileWidget(QWidget* parent)
 void AltitudeProfileWidget::setFlightPlan(const Models::FlightPlan& plan)
 {
     m_flightPlan = plan;
+    m_profileEngine.setWaypoints(plan.waypoints());
     update();
 }
 
 void AltitudeProfileWidget::setDEMData(const DEMData& data)
 {
     m_demData = data;
+    m_profileEngine.setDEM(&m_demData);
     update();
 }
 
@@ -722,56 +1005,87 @@ void AltitudeProfileWidget::paintEvent(QPaintEvent* event)
         return;
     }
 
-    QVector<ProfilePoint> profile = calculateProfile();
+    QRectF plotArea = rect().adjusted(40, 20, -20, -40);
+    const int columnCount = std::max(static_cast<int>(plotArea.width()), 1);
+
+    // One min/max envelope per pixel column
+    QVector<ProfileColumn> columns = m_profileEngine.decimate(columnCount);
+    double maxDist = m_profileEngine.totalDistance();
 
-    if (profile.isEmpty()) {
+    if (columns.isEmpty() || maxDist <= 0.0) {
         return;
     }
 
-    // Draw profile
-    QRectF plotArea = rect().adjusted(40, 20, -20, -40);
-
     // Find min/max for scaling
-    double maxDist = profile.last().distance;
-    double maxAlt = 0;
-    double minAlt = profile.first().terrainElevation;
+    double maxAlt = -std::numeric_limits<double>::infinity();
+    double minAlt = std::numeric_limits<double>::infinity();
+
+    for (const auto& column : columns) {
+        if (column.valid) {
+            maxAlt = std::max(maxAlt, std::max(column.maxFlight, column.maxTerrain));
+            minAlt = std::min(minAlt, column.minTerrain);
+        }
+    }
 
-    for (const auto& point : profile) {
-        maxAlt = std::max(maxAlt, point.flightAltitude + point.terrainElevation);
-        minAlt = std::min(minAlt, point.terrainElevation);
+    if (minAlt > maxAlt) {
+        return;
     }
 
     double altRange = maxAlt - minAlt + 20; // Add 20m margin
 
-    // Draw terrain
+    auto toY = [&](double altitude) {
+        return plotArea.bottom() - ((altitude - minAlt) / altRange) * plotArea.height();
+    };
+
+    // Draw terrain (upper envelope filled, lower envelope traced back)
     QPainterPath terrainPath;
-    terrainPath.moveTo(
-        plotArea.left(),
-        plotArea.bottom() - ((profile[0].terrainElevation - minAlt) / altRange) * plotArea.height());
+    QPolygonF flightUpper;
+    QPolygonF flightLower;
+    bool started = false;
+
+    for (int c = 0; c < columns.size(); ++c) {
+        const ProfileColumn& column = columns[c];
+        if (!column.valid) {
+            continue;
+        }
+
+        double x = plotArea.left() + c + 0.5;
+        if (!started) {
+            terrainPath.moveTo(x, plotArea.bottom());
+            started = true;
+        }
+        terrainPath.lineTo(x, toY(column.maxTerrain));
 
-    for (const auto& point : profile) {
-        double x = plotArea.left() + (point.distance / maxDist) * plotArea.width();
-        double y = plotArea.bottom() - ((point.terrainElevation - minAlt) / altRange) * plotArea.height();
-        terrainPath.lineTo(x, y);
+        flightUpper.append(QPointF(x, toY(column.maxFlight)));
+        flightLower.prepend(QPointF(x, toY(column.minFlight)));
     }
 
-    terrainPath.lineTo(plotArea.right(), plotArea.bottom());
-    terrainPath.lineTo(plotArea.left(), plotArea.bottom());
+    terrainPath.lineTo(terrainPath.currentPosition().x(), plotArea.bottom());
+    terrainPath.closeSubpath();
 
     painter.fillPath(terrainPath, QColor(150, 100, 50, 150));
     painter.setPen(QPen(QColor(100, 70, 30), 2));
     painter.drawPath(terrainPath);
 
-    // Draw flight path
+    // Draw flight path (envelope collapses to a line where it is straight)
     painter.setPen(QPen(Qt::red, 2));
-    for (int i = 0; i < profile.size() - 1; ++i) {
-        double x1 = plotArea.left() + (profile[i].distance / maxDist) * plotArea.width();
-        double y1 = plotArea.bottom() - ((profile[i].flightAltitude + profile[i].terrainElevation - minAlt) / altRange) * plotArea.height();
-
-        double x2 = plotArea.left() + (profile[i + 1].distance / maxDist) * plotArea.width();
-        double y2 = plotArea.bottom() - ((profile[i + 1].flightAltitude + profile[i + 1].terrainElevation - minAlt) / altRange) * plotArea.height();
+    painter.drawPolyline(flightUpper);
+    painter.drawPolyline(flightLower);
+
+    // Highlight columns where the path dips into the terrain
+    painter.setPen(QPen(QColor(255, 0, 255), 1));
+    for (int c = 0; c < columns.size(); ++c) {
+        if (columns[c].valid && columns[c].minClearance < 0.0) {
+            double x = plotArea.left() + c + 0.5;
+            painter.drawLine(QPointF(x, toY(columns[c].minFlight)), QPointF(x, toY(columns[c].maxTerrain)));
+        }
+    }
 
-        painter.drawLine(QPointF(x1, y1), QPointF(x2, y2));
+    // Waypoint ticks
+    painter.setPen(QPen(Qt::darkGray, 1, Qt::DotLine));
+    for (double distance : m_profileEngine.waypointDistances()) {
+        double x = plotArea.left() + (distance / maxDist) * plotArea.width();
+        painter.drawLine(QPointF(x, plotArea.top()), QPointF(x, plotArea.bottom()));
     }
 
     // Draw axes
@@ -782,38 +1096,5 @@ void AltitudeProfileWidget::paintEvent(QPaintEvent* event)
                     QString("Distance: %1 m").arg(maxDist, 0, 'f', 0));
 }
 
-QVector<AltitudeProfileWidget::ProfilePoint> AltitudeProfileWidget::calculateProfile()
-{
-    QVector<ProfilePoint> profile;
-
-    double cumulativeDistance = 0.0;
-
-    for (int i = 0; i < m_flightPlan.waypoints().size(); ++i) {
-        const auto& waypoint = m_flightPlan.waypoints()[i];
-
-        ProfilePoint point;
-        point.distance = cumulativeDistance;
-        point.flightAltitude = waypoint.coordinate().altitude();
-
-        if (!m_demData.elevations.isEmpty()) {
-            point.terrainElevation = m_demData.getElevationAt(waypoint.coordinate());
-        } else {
-            point.terrainElevation = 0;
-        }
-
-        profile.append(point);
-
-        // Calculate distance to next waypoint
-        if (i < m_flightPlan.waypoints().size() - 1) {
-            const auto& nextWaypoint = m_flightPlan.waypoints()[i + 1];
-            cumulativeDistance += Geospatial::GeoUtils::distanceBetween(
-                waypoint.coordinate(),
-                nextWaypoint.coordinate());
-        }
-    }
-
-    return profile;
-}
-
 } // namespace UI
 } // namespace DroneMapper
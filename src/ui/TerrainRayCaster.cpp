@@ -0,0 +1,294 @@
+#include "TerrainRayCaster.h"
+#include "TerrainElevationViewer.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// NaN (no-data) never raises a maximum
+inline float maxIgnoringNaN(float a, float b)
+{
+    if (std::isnan(a)) return b;
+    if (std::isnan(b)) return a;
+    return std::max(a, b);
+}
+
+// Moller-Trumbore; returns ray parameter or INF
+double intersectTriangle(const double o[3], const double d[3],
+                         const double a[3], const double b[3], const double c[3])
+{
+    double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    double e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    double p[3] = { d[1] * e2[2] - d[2] * e2[1],
+                    d[2] * e2[0] - d[0] * e2[2],
+                    d[0] * e2[1] - d[1] * e2[0] };
+
+    double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    if (std::abs(det) < 1e-12) {
+        return INF;
+    }
+    double invDet = 1.0 / det;
+
+    double s[3] = { o[0] - a[0], o[1] - a[1], o[2] - a[2] };
+    double u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+    if (u < -1e-9 || u > 1.0 + 1e-9) {
+        return INF;
+    }
+
+    double q[3] = { s[1] * e1[2] - s[2] * e1[1],
+                    s[2] * e1[0] - s[0] * e1[2],
+                    s[0] * e1[1] - s[1] * e1[0] };
+    double v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * invDet;
+    if (v < -1e-9 || u + v > 1.0 + 1e-9) {
+        return INF;
+    }
+
+    return (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+}
+
+} // namespace
+
+TerrainRayCaster::TerrainRayCaster()
+    : m_dem(nullptr)
+{
+}
+
+void TerrainRayCaster::build(const DEMData& dem)
+{
+    clear();
+
+    if (dem.width < 2 || dem.height < 2 || dem.elevations.size() < dem.width * dem.height) {
+        return;
+    }
+
+    m_dem = &dem;
+
+    // Level 0: highest corner of every cell
+    Level base;
+    base.width = dem.width - 1;
+    base.height = dem.height - 1;
+    base.maxZ.resize(base.width * base.height);
+
+    const float* e = dem.elevations.constData();
+    for (int y = 0; y < base.height; ++y) {
+        const float* row0 = e + y * dem.width;
+        const float* row1 = row0 + dem.width;
+        float* out = base.maxZ.data() + y * base.width;
+        for (int x = 0; x < base.width; ++x) {
+            out[x] = maxIgnoringNaN(maxIgnoringNaN(row0[x], row0[x + 1]),
+                                    maxIgnoringNaN(row1[x], row1[x + 1]));
+        }
+    }
+    m_levels.append(base);
+
+    // Coarser levels: 2x2 maxima until a single block remains
+    while (m_levels.last().width > 1 || m_levels.last().height > 1) {
+        const Level& fine = m_levels.last();
+        Level coarse;
+        coarse.width = (fine.width + 1) / 2;
+        coarse.height = (fine.height + 1) / 2;
+        coarse.maxZ.fill(-std::numeric_limits<float>::infinity(), coarse.width * coarse.height);
+
+        for (int y = 0; y < fine.height; ++y) {
+            for (int x = 0; x < fine.width; ++x) {
+                float& target = coarse.maxZ[(y / 2) * coarse.width + (x / 2)];
+                target = maxIgnoringNaN(target, fine.maxZ[y * fine.width + x]);
+            }
+        }
+
+        m_levels.append(coarse);
+    }
+}
+
+void TerrainRayCaster::clear()
+{
+    m_dem = nullptr;
+    m_levels.clear();
+}
+
+bool TerrainRayCaster::intersect(const QVector3D& origin, const QVector3D& direction,
+                                 QVector3D* hitPoint, double maxDistance) const
+{
+    double length = direction.length();
+    if (isEmpty() || length <= 0.0) {
+        return false;
+    }
+
+    double tEnd = (maxDistance > 0.0) ? maxDistance / length : INF;
+    double tHit = 0.0;
+
+    if (!march(origin, direction, tEnd, tHit)) {
+        return false;
+    }
+
+    if (hitPoint) {
+        *hitPoint = origin + direction * static_cast<float>(tHit);
+    }
+    return true;
+}
+
+bool TerrainRayCaster::lineOfSight(const QVector3D& from, const QVector3D& to) const
+{
+    if (isEmpty()) {
+        return true;
+    }
+
+    // Stop just short of the target so points on the ground can see each other
+    double tHit = 0.0;
+    return !march(from, to - from, 1.0 - 1e-4, tHit);
+}
+
+QVector3D TerrainRayCaster::toLocal(const Models::GeospatialCoordinate& coord, double altitude) const
+{
+    if (!m_dem) {
+        return QVector3D(0, 0, static_cast<float>(altitude));
+    }
+
+    double totalDx = m_dem->bottomRight.longitude() - m_dem->topLeft.longitude();
+    double totalDy = m_dem->topLeft.latitude() - m_dem->bottomRight.latitude();
+
+    double col = (coord.longitude() - m_dem->topLeft.longitude()) / totalDx * (m_dem->width - 1);
+    double row = (m_dem->topLeft.latitude() - coord.latitude()) / totalDy * (m_dem->height - 1);
+
+    return QVector3D(static_cast<float>(col * m_dem->resolution),
+                     static_cast<float>(row * m_dem->resolution),
+                     static_cast<float>(altitude));
+}
+
+bool TerrainRayCaster::march(const QVector3D& origin, const QVector3D& direction,
+                             double tEnd, double& tHit) const
+{
+    // Work in cell units horizontally; the ray parameter is unchanged
+    const double res = m_dem->resolution > 0.0 ? m_dem->resolution : 1.0;
+    const double o[3] = { origin.x() / res, origin.y() / res, origin.z() };
+    const double d[3] = { direction.x() / res, direction.y() / res, direction.z() };
+
+    const int cellsX = m_levels.first().width;
+    const int cellsY = m_levels.first().height;
+
+    // Clip to the DEM footprint
+    double tStart = 0.0;
+    const double lo[2] = { 0.0, 0.0 };
+    const double hi[2] = { static_cast<double>(cellsX), static_cast<double>(cellsY) };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (d[axis] == 0.0) {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis]) {
+                return false;
+            }
+            continue;
+        }
+        double t0 = (lo[axis] - o[axis]) / d[axis];
+        double t1 = (hi[axis] - o[axis]) / d[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tStart = std::max(tStart, t0);
+        tEnd = std::min(tEnd, t1);
+    }
+
+    if (tStart > tEnd) {
+        return false;
+    }
+
+    // Step past block borders by ~1e-4 cell
+    const double horizontal = std::max(std::abs(d[0]), std::abs(d[1]));
+    const double step = 1e-4 / horizontal;
+
+    // A (near) vertical ray never leaves its cell: marching would not advance
+    if (!std::isfinite(step)) {
+        const int cx = std::clamp(static_cast<int>(std::floor(o[0])), 0, cellsX - 1);
+        const int cy = std::clamp(static_cast<int>(std::floor(o[1])), 0, cellsY - 1);
+        return intersectCell(cx, cy, o, d, tStart, tEnd, tHit);
+    }
+
+    const int top = m_levels.size() - 1;
+    int level = top;
+    double t = tStart;
+
+    while (t <= tEnd) {
+        const Level& L = m_levels[level];
+        const int size = 1 << level;
+
+        double px = o[0] + d[0] * t;
+        double py = o[1] + d[1] * t;
+        int cx = std::clamp(static_cast<int>(std::floor(px / size)), 0, L.width - 1);
+        int cy = std::clamp(static_cast<int>(std::floor(py / size)), 0, L.height - 1);
+
+        // Parameter where the ray leaves this block
+        double x0 = static_cast<double>(cx) * size;
+        double y0 = static_cast<double>(cy) * size;
+        double x1 = std::min(x0 + size, hi[0]);
+        double y1 = std::min(y0 + size, hi[1]);
+
+        double tx = (d[0] > 0.0) ? (x1 - o[0]) / d[0] : (d[0] < 0.0) ? (x0 - o[0]) / d[0] : INF;
+        double ty = (d[1] > 0.0) ? (y1 - o[1]) / d[1] : (d[1] < 0.0) ? (y0 - o[1]) / d[1] : INF;
+        double tExit = std::min(std::min(tx, ty), tEnd);
+        if (!std::isfinite(tExit)) {
+            return false;
+        }
+
+        // Lowest ray height inside the block (ray is linear in t)
+        double rayMinZ = std::min(o[2] + d[2] * t, o[2] + d[2] * tExit);
+
+        if (rayMinZ > L.maxZ[cy * L.width + cx]) {
+            // Entire block below the ray: skip it and try a coarser level
+            t = tExit + step;
+            level = std::min(level + 1, top);
+        } else if (level > 0) {
+            --level;
+        } else {
+            if (intersectCell(cx, cy, o, d, t - step, tExit + step, tHit)) {
+                return true;
+            }
+            t = tExit + step;
+        }
+    }
+
+    return false;
+}
+
+bool TerrainRayCaster::intersectCell(int cx, int cy, const double origin[3], const double direction[3],
+                                     double tMin, double tMax, double& tHit) const
+{
+    const int w = m_dem->width;
+    const float* e = m_dem->elevations.constData();
+
+    float e00 = e[cy * w + cx];
+    float e10 = e[cy * w + cx + 1];
+    float e11 = e[(cy + 1) * w + cx + 1];
+    float e01 = e[(cy + 1) * w + cx];
+
+    if (std::isnan(e00) || std::isnan(e10) || std::isnan(e11) || std::isnan(e01)) {
+        return false;  // No-data cell
+    }
+
+    const double v0[3] = { static_cast<double>(cx), static_cast<double>(cy), e00 };
+    const double v1[3] = { cx + 1.0, static_cast<double>(cy), e10 };
+    const double v2[3] = { cx + 1.0, cy + 1.0, e11 };
+    const double v3[3] = { static_cast<double>(cx), cy + 1.0, e01 };
+
+    const double candidates[2] = { intersectTriangle(origin, direction, v0, v1, v2),
+                                   intersectTriangle(origin, direction, v0, v2, v3) };
+    const double lower = std::max(tMin, 0.0);
+    double best = INF;
+
+    for (double t : candidates) {
+        if (t >= lower && t <= tMax) {
+            best = std::min(best, t);
+        }
+    }
+
+    if (best == INF) {
+        return false;
+    }
+
+    tHit = best;
+    return true;
+}
+
+} // namespace UI
+} // namespace DroneMapper
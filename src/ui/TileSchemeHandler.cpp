@@ -0,0 +1,379 @@
+#include "TileSchemeHandler.h"
+#include "Logger.h"
+#include <QWebEngineUrlScheme>
+#include <QWebEngineUrlRequestJob>
+#include <QWebEngineProfile>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QStandardPaths>
+#include <QUrlQuery>
+#include <QPointer>
+#include <QBuffer>
+#include <QImage>
+#include <QDateTime>
+#include <QDir>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int MAX_TILE_ZOOM = 24;
+constexpr int RENDER_THREADS = 4;
+constexpr qint64 BASEMAP_CACHE_BYTES = qint64(512) * 1024 * 1024;  // Per basemap
+constexpr qint64 ASSET_CACHE_BYTES = qint64(64) * 1024 * 1024;
+constexpr qint64 DEFAULT_MAX_AGE = 7 * 24 * 3600;   // Seconds, when upstream sends no freshness
+
+const char* USER_AGENT = "DroneMapper/1.0";
+
+// Map library and style hosts the page loads assets from
+const char* const ASSET_HOSTS[] = { "unpkg.com", "demotiles.maplibre.org" };
+
+bool isAssetHost(const QString& host)
+{
+    for (const char* allowed : ASSET_HOSTS) {
+        if (host == QLatin1String(allowed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Expiry time of a reply from Cache-Control (or Expires)
+ * @return Seconds since epoch, or -1 if the reply must not be stored
+ */
+qint64 cacheExpiry(QNetworkReply* reply)
+{
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    const QList<QByteArray> directives = reply->rawHeader("Cache-Control").toLower().split(',');
+    for (const QByteArray& entry : directives) {
+        const QByteArray directive = entry.trimmed();
+        if (directive == "no-store") {
+            return -1;
+        }
+        if (directive == "no-cache") {
+            return now;   // Stored for offline use, revalidated whenever online
+        }
+        if (directive.startsWith("max-age=")) {
+            bool ok = false;
+            const qint64 maxAge = directive.mid(8).toLongLong(&ok);
+            if (ok) {
+                return now + qMax<qint64>(0, maxAge);
+            }
+        }
+    }
+
+    const QDateTime expires = QDateTime::fromString(QString::fromLatin1(reply->rawHeader("Expires")),
+                                                    Qt::RFC2822Date);
+    return expires.isValid() ? expires.toSecsSinceEpoch() : now + DEFAULT_MAX_AGE;
+}
+
+/**
+ * @brief Parse "{z}/{x}/{y}" path parts (extension on y is ignored)
+ */
+bool parseTile(const QStringList& parts, int first, int* z, int* x, int* y)
+{
+    if (parts.size() != first + 3) {
+        return false;
+    }
+
+    bool okZ = false;
+    bool okX = false;
+    bool okY = false;
+    *z = parts[first].toInt(&okZ);
+    *x = parts[first + 1].toInt(&okX);
+    *y = parts[first + 2].section('.', 0, 0).toInt(&okY);
+
+    if (!okZ || !okX || !okY || *z < 0 || *z > MAX_TILE_ZOOM) {
+        return false;
+    }
+
+    const int tiles = 1 << *z;
+    return *x >= 0 && *y >= 0 && *x < tiles && *y < tiles;
+}
+
+QByteArray guessMimeType(const QUrl& url)
+{
+    const QString path = url.path();
+    if (path.endsWith(".js")) return "application/javascript";
+    if (path.endsWith(".css")) return "text/css";
+    if (path.endsWith(".json")) return "application/json";
+    if (path.endsWith(".pbf")) return "application/x-protobuf";
+    if (path.endsWith(".png")) return "image/png";
+    return "application/octet-stream";
+}
+
+const QByteArray& transparentTile()
+{
+    static const QByteArray png = [] {
+        QImage image(256, 256, QImage::Format_ARGB32);
+        image.fill(Qt::transparent);
+
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "PNG");
+        return data;
+    }();
+    return png;
+}
+
+} // namespace
+
+const QByteArray TileSchemeHandler::SCHEME = "dmtiles";
+
+void TileSchemeHandler::registerScheme()
+{
+    QWebEngineUrlScheme scheme(SCHEME);
+    scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+    QWebEngineUrlScheme::Flags flags = QWebEngineUrlScheme::SecureScheme |
+                                       QWebEngineUrlScheme::LocalAccessAllowed |
+                                       QWebEngineUrlScheme::CorsEnabled;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    flags |= QWebEngineUrlScheme::FetchApiAllowed;
+#endif
+    scheme.setFlags(flags);
+    QWebEngineUrlScheme::registerScheme(scheme);
+}
+
+TileSchemeHandler* TileSchemeHandler::install(QWebEngineProfile* profile)
+{
+    const QWebEngineUrlSchemeHandler* existing = profile->urlSchemeHandler(SCHEME);
+    if (existing) {
+        return qobject_cast<TileSchemeHandler*>(const_cast<QWebEngineUrlSchemeHandler*>(existing));
+    }
+
+    QString cacheDirectory = QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+                                 .filePath("tiles");
+    auto* handler = new TileSchemeHandler(cacheDirectory, profile);
+    profile->installUrlSchemeHandler(SCHEME, handler);
+    return handler;
+}
+
+TileSchemeHandler::TileSchemeHandler(const QString& cacheDirectory, QObject* parent)
+    : QWebEngineUrlSchemeHandler(parent)
+    , m_cacheDirectory(cacheDirectory)
+    , m_network(new QNetworkAccessManager(this))
+    , m_online(true)
+{
+    QDir().mkpath(m_cacheDirectory);
+    m_renderPool.setMaxThreadCount(RENDER_THREADS);
+
+    if (!m_assets.open(QDir(m_cacheDirectory).filePath("assets.mbtiles"))) {
+        LOG_ERROR("Cannot open asset cache: " + m_assets.lastError());
+    }
+    m_assets.setByteBudget(ASSET_CACHE_BYTES);
+
+    addBasemap("satellite",
+               "https://server.arcgisonline.com/ArcGIS/rest/services/World_Imagery/MapServer/tile/{z}/{y}/{x}",
+               "jpg");
+    addBasemap("osm", "https://tile.openstreetmap.org/{z}/{x}/{y}.png", "png");
+
+    LOG_INFO(QString("Tile cache at %1").arg(m_cacheDirectory));
+}
+
+TileSchemeHandler::~TileSchemeHandler()
+{
+    // Workers use m_overlays
+    m_renderPool.waitForDone();
+}
+
+void TileSchemeHandler::addBasemap(const QString& name, const QString& urlTemplate, const QString& format)
+{
+    Basemap basemap;
+    basemap.urlTemplate = urlTemplate;
+    basemap.mimeType = (format == "png") ? "image/png" : "image/jpeg";
+    basemap.store = std::make_shared<Core::TileStore>();
+
+    if (!basemap.store->open(QDir(m_cacheDirectory).filePath(name + ".mbtiles"))) {
+        LOG_ERROR(QString("Cannot open tile cache %1: %2").arg(name, basemap.store->lastError()));
+    } else if (basemap.store->metadata("name").isEmpty()) {
+        basemap.store->setMetadata("name", name);
+        basemap.store->setMetadata("format", format);
+        basemap.store->setMetadata("type", "baselayer");
+    }
+    basemap.store->setByteBudget(BASEMAP_CACHE_BYTES);
+
+    m_basemaps.insert(name, basemap);
+}
+
+void TileSchemeHandler::requestStarted(QWebEngineUrlRequestJob* job)
+{
+    const QUrl url = job->requestUrl();
+    const QString host = url.host();
+    const QStringList parts = url.path().split('/', Qt::SkipEmptyParts);
+
+    if (host == "basemap") {
+        serveBasemap(job, parts);
+    } else if (host == "overlay") {
+        serveOverlay(job, parts);
+    } else if (host == "asset") {
+        serveAsset(job, url);
+    } else {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+    }
+}
+
+void TileSchemeHandler::serveBasemap(QWebEngineUrlRequestJob* job, const QStringList& parts)
+{
+    int z = 0;
+    int x = 0;
+    int y = 0;
+    auto it = parts.isEmpty() ? m_basemaps.constEnd() : m_basemaps.constFind(parts.first());
+    if (it == m_basemaps.constEnd() || !parseTile(parts, 1, &z, &x, &y)) {
+        job->fail(QWebEngineUrlRequestJob::UrlInvalid);
+        return;
+    }
+
+    const Basemap& basemap = it.value();
+    bool stale = false;
+    const QByteArray cached = basemap.store->tile(z, x, y, &stale);
+
+    // Stale tiles are refetched when online and still served offline
+    if (!cached.isEmpty() && (!stale || !m_online)) {
+        reply(job, basemap.mimeType, cached);
+        return;
+    }
+
+    if (!m_online) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    QString upstream = basemap.urlTemplate;
+    upstream.replace("{z}", QString::number(z))
+            .replace("{x}", QString::number(x))
+            .replace("{y}", QString::number(y));
+
+    QNetworkRequest request{ QUrl(upstream) };
+    request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
+
+    QNetworkReply* networkReply = m_network->get(request);
+    QPointer<QWebEngineUrlRequestJob> guard(job);
+    std::shared_ptr<Core::TileStore> store = basemap.store;
+    const QByteArray mimeType = basemap.mimeType;
+
+    connect(networkReply, &QNetworkReply::finished, this, [=]() {
+        networkReply->deleteLater();
+
+        if (networkReply->error() != QNetworkReply::NoError) {
+            if (guard && !cached.isEmpty()) {
+                reply(guard, mimeType, cached);
+            } else if (guard) {
+                guard->fail(QWebEngineUrlRequestJob::RequestFailed);
+            }
+            return;
+        }
+
+        const QByteArray tile = networkReply->readAll();
+        const qint64 expires = cacheExpiry(networkReply);
+        if (expires >= 0) {
+            store->storeTile(z, x, y, tile, expires);
+        }
+
+        if (guard) {
+            reply(guard, mimeType, tile);
+        }
+    });
+}
+
+void TileSchemeHandler::serveOverlay(QWebEngineUrlRequestJob* job, const QStringList& parts)
+{
+    OverlayTileRenderer::Layer layer;
+    int z = 0;
+    int x = 0;
+    int y = 0;
+    if (parts.isEmpty() || !OverlayTileRenderer::layerFromName(parts.first(), &layer) ||
+        !parseTile(parts, 1, &z, &x, &y)) {
+        job->fail(QWebEngineUrlRequestJob::UrlInvalid);
+        return;
+    }
+
+    QPointer<QWebEngineUrlRequestJob> guard(job);
+    QPointer<TileSchemeHandler> self(this);
+
+    QtConcurrent::run(&m_renderPool, [this, guard, self, layer, z, x, y]() {
+        const QByteArray png = m_overlays.tile(layer, z, x, y);
+
+        // Jobs must be answered on the handler's thread
+        QMetaObject::invokeMethod(self, [guard, png]() {
+            if (guard) {
+                reply(guard, "image/png", png.isEmpty() ? transparentTile() : png);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void TileSchemeHandler::serveAsset(QWebEngineUrlRequestJob* job, const QUrl& url)
+{
+    const QUrl upstream(QUrlQuery(url).queryItemValue("url", QUrl::FullyDecoded));
+    if (!upstream.isValid() || upstream.scheme() != "https" || !isAssetHost(upstream.host())) {
+        job->fail(QWebEngineUrlRequestJob::UrlInvalid);
+        return;
+    }
+
+    const QString key = upstream.toString(QUrl::FullyEncoded);
+    QByteArray cachedType;
+    bool stale = false;
+    const QByteArray cached = m_assets.resource(key, &cachedType, &stale);
+    if (!cached.isEmpty() && (!stale || !m_online)) {
+        reply(job, cachedType, cached);
+        return;
+    }
+
+    if (!m_online) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    QNetworkRequest request(upstream);
+    request.setHeader(QNetworkRequest::UserAgentHeader, USER_AGENT);
+
+    QNetworkReply* networkReply = m_network->get(request);
+    QPointer<QWebEngineUrlRequestJob> guard(job);
+
+    connect(networkReply, &QNetworkReply::finished, this, [=]() {
+        networkReply->deleteLater();
+
+        if (networkReply->error() != QNetworkReply::NoError) {
+            if (guard && !cached.isEmpty()) {
+                reply(guard, cachedType, cached);
+            } else if (guard) {
+                guard->fail(QWebEngineUrlRequestJob::RequestFailed);
+            }
+            return;
+        }
+
+        QByteArray contentType = networkReply->header(QNetworkRequest::ContentTypeHeader)
+                                     .toString().section(';', 0, 0).trimmed().toUtf8();
+        if (contentType.isEmpty()) {
+            contentType = guessMimeType(upstream);
+        }
+
+        const QByteArray asset = networkReply->readAll();
+        const qint64 expires = cacheExpiry(networkReply);
+        if (expires >= 0) {
+            m_assets.storeResource(key, asset, contentType, expires);
+        }
+
+        if (guard) {
+            reply(guard, contentType, asset);
+        }
+    });
+}
+
+void TileSchemeHandler::reply(QWebEngineUrlRequestJob* job, const QByteArray& mimeType, const QByteArray& data)
+{
+    // QBuffer shares the QByteArray, no copy
+    auto* buffer = new QBuffer(job);
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+    job->reply(mimeType, buffer);
+}
+
+} // namespace UI
+} // namespace DroneMapper
@@ -0,0 +1,253 @@
+#include "ViewshedAnalyzer.h"
+#include "TerrainElevationViewer.h"
+#include "TerrainRayCaster.h"
+#include "Logger.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <QElapsedTimer>
+#include <QPair>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace DroneMapper {
+namespace UI {
+
+namespace {
+
+constexpr int RAYS_PER_CHUNK = 256;
+
+bool toGrid(const DEMData& dem, const Models::GeospatialCoordinate& coord, double& col, double& row)
+{
+    if (!dem.contains(coord)) {
+        return false;
+    }
+
+    double totalDx = dem.bottomRight.longitude() - dem.topLeft.longitude();
+    double totalDy = dem.topLeft.latitude() - dem.bottomRight.latitude();
+
+    col = (coord.longitude() - dem.topLeft.longitude()) / totalDx * (dem.width - 1);
+    row = (dem.topLeft.latitude() - coord.latitude()) / totalDy * (dem.height - 1);
+    return true;
+}
+
+} // namespace
+
+Viewshed ViewshedAnalyzer::compute(const DEMData& dem, const Observer& observer, double targetHeight)
+{
+    Viewshed result;
+
+    double col = 0.0;
+    double row = 0.0;
+    if (dem.width < 2 || dem.height < 2 || dem.elevations.size() < dem.width * dem.height ||
+        !toGrid(dem, observer.position, col, row)) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const int w = dem.width;
+    const int h = dem.height;
+    const int ox = std::clamp(static_cast<int>(std::lround(col)), 0, w - 1);
+    const int oy = std::clamp(static_cast<int>(std::lround(row)), 0, h - 1);
+    const double res = dem.resolution > 0.0 ? dem.resolution : 1.0;
+    const float* e = dem.elevations.constData();
+    const double eyeZ = e[oy * w + ox] + observer.eyeHeight;
+    const double maxRange = observer.maxRange;
+
+    // Analysis window: whole DEM, or the square around the observer's range
+    int x0 = 0, y0 = 0, x1 = w - 1, y1 = h - 1;
+    if (maxRange > 0.0) {
+        int r = static_cast<int>(std::ceil(maxRange / res));
+        x0 = std::max(ox - r, 0);
+        y0 = std::max(oy - r, 0);
+        x1 = std::min(ox + r, w - 1);
+        y1 = std::min(oy + r, h - 1);
+    }
+
+    // R2: one ray to every cell on the window border
+    QVector<QPair<int, int>> targets;
+    targets.reserve(2 * (x1 - x0 + 1) + 2 * (y1 - y0 + 1));
+    for (int x = x0; x <= x1; ++x) {
+        targets.append(qMakePair(x, y0));
+        if (y1 != y0) targets.append(qMakePair(x, y1));
+    }
+    for (int y = y0 + 1; y < y1; ++y) {
+        targets.append(qMakePair(x0, y));
+        if (x1 != x0) targets.append(qMakePair(x1, y));
+    }
+
+    // Rays cross near the observer; flags are only ever set, so relaxed atomics suffice
+    const qsizetype cellCount = static_cast<qsizetype>(w) * h;
+    std::unique_ptr<std::atomic<quint8>[]> flags(new std::atomic<quint8>[cellCount]());
+    std::atomic<quint8>* visible = flags.get();
+    const QPair<int, int>* targetData = targets.constData();
+
+    QVector<QPair<int, int>> chunks;
+    for (int begin = 0; begin < targets.size(); begin += RAYS_PER_CHUNK) {
+        chunks.append(qMakePair(begin, std::min(begin + RAYS_PER_CHUNK, static_cast<int>(targets.size()))));
+    }
+
+    QtConcurrent::blockingMap(chunks, [=](const QPair<int, int>& chunk) {
+        for (int r = chunk.first; r < chunk.second; ++r) {
+            const int dx = targetData[r].first - ox;
+            const int dy = targetData[r].second - oy;
+            const int steps = std::max(std::abs(dx), std::abs(dy));
+            const bool xMajor = std::abs(dx) >= std::abs(dy);
+            const double stepLength = std::hypot(dx, dy) * res / std::max(steps, 1);
+            double maxSlope = -std::numeric_limits<double>::infinity();
+
+            for (int i = 1; i <= steps; ++i) {
+                const double fx = ox + static_cast<double>(dx) * i / steps;
+                const double fy = oy + static_cast<double>(dy) * i / steps;
+                const double distance = stepLength * i;
+
+                if (maxRange > 0.0 && distance > maxRange) {
+                    break;
+                }
+
+                // Major axis lands on samples; interpolate across the minor axis
+                double z;
+                if (xMajor) {
+                    int x = static_cast<int>(std::lround(fx));
+                    int ya = static_cast<int>(std::floor(fy));
+                    int yb = std::min(ya + 1, h - 1);
+                    double t = fy - ya;
+                    z = e[ya * w + x] * (1.0 - t) + e[yb * w + x] * t;
+                } else {
+                    int y = static_cast<int>(std::lround(fy));
+                    int xa = static_cast<int>(std::floor(fx));
+                    int xb = std::min(xa + 1, w - 1);
+                    double t = fx - xa;
+                    z = e[y * w + xa] * (1.0 - t) + e[y * w + xb] * t;
+                }
+
+                if (std::isnan(z)) {
+                    continue;  // No-data: neither visible nor occluding
+                }
+
+                const double slope = (z - eyeZ) / distance;
+                const double targetSlope = (z + targetHeight - eyeZ) / distance;
+
+                if (targetSlope >= maxSlope) {
+                    int cx = static_cast<int>(std::lround(fx));
+                    int cy = static_cast<int>(std::lround(fy));
+                    visible[cy * w + cx].store(1, std::memory_order_relaxed);
+                }
+
+                maxSlope = std::max(maxSlope, slope);
+            }
+        }
+    });
+
+    visible[oy * w + ox].store(1, std::memory_order_relaxed);
+
+    result.width = w;
+    result.height = h;
+    result.visible.resize(cellCount);
+    quint8* out = result.visible.data();
+    for (qsizetype i = 0; i < cellCount; ++i) {
+        out[i] = visible[i].load(std::memory_order_relaxed);
+        result.visibleCells += out[i];
+    }
+    result.elapsedMs = timer.elapsed();
+
+    LOG_INFO(QString("Viewshed: %1 of %2 cells visible (%3 rays) in %4 ms")
+        .arg(result.visibleCells)
+        .arg(cellCount)
+        .arg(targets.size())
+        .arg(result.elapsedMs));
+
+    return result;
+}
+
+QVector<WaypointVisibility> ViewshedAnalyzer::checkWaypoints(const DEMData& dem,
+                                                             const TerrainRayCaster& caster,
+                                                             const Observer& observer,
+                                                             const Models::FlightPlan& plan,
+                                                             const std::atomic<bool>* cancelled)
+{
+    QVector<WaypointVisibility> result;
+
+    const auto waypoints = plan.waypoints();
+    result.reserve(waypoints.size());
+
+    QVector3D eye = caster.toLocal(observer.position,
+                                   dem.getElevationAt(observer.position) + observer.eyeHeight);
+
+    for (int i = 0; i < waypoints.size(); ++i) {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        const auto coord = waypoints[i].coordinate();
+        QVector3D target = caster.toLocal(coord, dem.getElevationAt(coord) + coord.altitude());
+
+        WaypointVisibility visibility;
+        visibility.waypointIndex = i;
+        visibility.visible = caster.lineOfSight(eye, target);
+        visibility.distance = std::hypot(target.x() - eye.x(), target.y() - eye.y());
+        visibility.slantDistance = (target - eye).length();
+        result.append(visibility);
+    }
+
+    return result;
+}
+
+QList<Core::AltitudeViolation> ViewshedAnalyzer::checkVisualLineOfSight(const DEMData& dem,
+                                                                        const TerrainRayCaster& caster,
+                                                                        const Observer& observer,
+                                                                        const Models::FlightPlan& plan,
+                                                                        const Core::RegulatoryLimits& limits,
+                                                                        const std::atomic<bool>* cancelled)
+{
+    QList<Core::AltitudeViolation> violations;
+
+    const auto waypoints = plan.waypoints();
+    const QVector<WaypointVisibility> visibility = checkWaypoints(dem, caster, observer, plan, cancelled);
+
+    for (const auto& v : visibility) {
+        const auto coord = waypoints[v.waypointIndex].coordinate();
+
+        if (!v.visible) {
+            Core::AltitudeViolation violation;
+            violation.severity = limits.requiresVisualLineOfSight
+                ? Core::ViolationSeverity::Critical
+                : Core::ViolationSeverity::Warning;
+            violation.type = "VLOS";
+            violation.description = QString("Terrain blocks the pilot's line of sight (%1 m away)")
+                .arg(v.slantDistance, 0, 'f', 0);
+            violation.location = coord;
+            violation.altitude = coord.altitude();
+            violation.limit = 0.0;
+            violation.exceedance = 0.0;
+            violation.waypointIndex = v.waypointIndex;
+            violation.recommendation = "Move the pilot position or raise the waypoint altitude";
+            violations.append(violation);
+        }
+
+        // The operator range limit is measured over the ground, not along the sight line
+        if (limits.maxDistanceFromOperator > 0.0 && v.distance > limits.maxDistanceFromOperator) {
+            Core::AltitudeViolation violation;
+            violation.severity = Core::ViolationSeverity::Illegal;
+            violation.type = "Range";
+            violation.description = QString("Waypoint is %1 m from the operator (maximum %2 m)")
+                .arg(v.distance, 0, 'f', 0)
+                .arg(limits.maxDistanceFromOperator, 0, 'f', 0);
+            violation.location = coord;
+            violation.altitude = coord.altitude();
+            violation.limit = limits.maxDistanceFromOperator;
+            violation.exceedance = v.distance - limits.maxDistanceFromOperator;
+            violation.waypointIndex = v.waypointIndex;
+            violation.recommendation = "Move the pilot closer or split the mission";
+            violations.append(violation);
+        }
+    }
+
+    return violations;
+}
+
+} // namespace UI
+} // namespace DroneMapper
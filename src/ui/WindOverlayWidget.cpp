@@ -1,14 +1,30 @@
 #include "WindOverlayWidget.h"
+#include "Tracer.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QPolygonF>
 #include <QTimerEvent>
+#include <QResizeEvent>
 #include <QtMath>
 #include <cmath>
+#include <algorithm>
 
 namespace DroneMapper {
 namespace UI {
 
+namespace {
+
+constexpr double METERS_PER_DEGREE = 111320.0;
+constexpr int FIELD_NODES = 64;             // Grid nodes per axis
+constexpr double FIELD_PADDING = 0.25;      // Extra extent around data and view
+constexpr int PARTICLE_AREA = 1500;         // Screen pixels per particle
+constexpr int MAX_PARTICLES = 2000;
+constexpr int PARTICLE_TRAIL = 8;
+constexpr int FRAME_MS = 50;                // 20 FPS
+constexpr double PARTICLE_STEP = 0.0015;    // Field widths per (m/s) per frame at speed 1.0
+
+} // namespace
+
 // WindDataPoint implementation
 
 double WindDataPoint::getBeaufortScale() const
@@ -146,6 +162,158 @@ QColor WindColorScheme::getColor(double speedMs, Scheme scheme)
     }
 }
 
+// WindVectorField implementation
+
+WindVectorField::WindVectorField()
+    : m_columns(0)
+    , m_rows(0)
+    , m_north(0.0)
+    , m_west(0.0)
+    , m_cellLat(0.0)
+    , m_cellLon(0.0)
+{
+}
+
+void WindVectorField::clear()
+{
+    m_columns = 0;
+    m_rows = 0;
+    m_u.clear();
+    m_v.clear();
+}
+
+void WindVectorField::build(const QList<WindDataPoint>& points,
+                            const Models::GeospatialCoordinate& topLeft,
+                            const Models::GeospatialCoordinate& bottomRight,
+                            int columns, int rows)
+{
+    clear();
+
+    if (points.isEmpty() || columns < 2 || rows < 2) {
+        return;
+    }
+
+    m_columns = columns;
+    m_rows = rows;
+    m_north = topLeft.latitude();
+    m_west = topLeft.longitude();
+    m_cellLat = (topLeft.latitude() - bottomRight.latitude()) / (rows - 1);
+    m_cellLon = (bottomRight.longitude() - topLeft.longitude()) / (columns - 1);
+
+    // Observations as local meters and vector components (blowing towards)
+    const double cosLat = std::cos(qDegreesToRadians((topLeft.latitude() + bottomRight.latitude()) / 2.0));
+    const int n = points.size();
+    QVector<double> px(n), py(n), pu(n), pv(n);
+    for (int i = 0; i < n; ++i) {
+        const auto& p = points[i];
+        const double towards = qDegreesToRadians(p.windDirection + 180.0);
+        px[i] = p.location.longitude() * METERS_PER_DEGREE * cosLat;
+        py[i] = p.location.latitude() * METERS_PER_DEGREE;
+        pu[i] = p.windSpeed * std::sin(towards);
+        pv[i] = p.windSpeed * std::cos(towards);
+    }
+
+    m_u.resize(columns * rows);
+    m_v.resize(columns * rows);
+
+    for (int row = 0; row < rows; ++row) {
+        const double y = (m_north - row * m_cellLat) * METERS_PER_DEGREE;
+
+        for (int col = 0; col < columns; ++col) {
+            const double x = (m_west + col * m_cellLon) * METERS_PER_DEGREE * cosLat;
+
+            double sumW = 0.0;
+            double sumU = 0.0;
+            double sumV = 0.0;
+            int exact = -1;
+
+            for (int i = 0; i < n; ++i) {
+                const double d2 = (px[i] - x) * (px[i] - x) + (py[i] - y) * (py[i] - y);
+                if (d2 < 1e-6) {
+                    exact = i;
+                    break;
+                }
+                const double w = 1.0 / d2;     // Power 2
+                sumW += w;
+                sumU += w * pu[i];
+                sumV += w * pv[i];
+            }
+
+            const int k = row * columns + col;
+            if (exact >= 0) {
+                m_u[k] = static_cast<float>(pu[exact]);
+                m_v[k] = static_cast<float>(pv[exact]);
+            } else {
+                m_u[k] = static_cast<float>(sumU / sumW);
+                m_v[k] = static_cast<float>(sumV / sumW);
+            }
+        }
+    }
+}
+
+bool WindVectorField::contains(const Models::GeospatialCoordinate& topLeft,
+                               const Models::GeospatialCoordinate& bottomRight) const
+{
+    if (isEmpty()) {
+        return false;
+    }
+
+    const double south = m_north - (m_rows - 1) * m_cellLat;
+    const double east = m_west + (m_columns - 1) * m_cellLon;
+
+    return topLeft.latitude() <= m_north && topLeft.longitude() >= m_west &&
+           bottomRight.latitude() >= south && bottomRight.longitude() <= east;
+}
+
+Models::GeospatialCoordinate WindVectorField::nodeCoordinate(int column, int row) const
+{
+    return Models::GeospatialCoordinate(m_north - row * m_cellLat, m_west + column * m_cellLon, 0);
+}
+
+bool WindVectorField::sampleGrid(double column, double row, double* u, double* v) const
+{
+    if (isEmpty() || !(column >= 0.0 && row >= 0.0 && column <= m_columns - 1 && row <= m_rows - 1)) {
+        return false;
+    }
+
+    const int c0 = std::min(static_cast<int>(column), m_columns - 2);
+    const int r0 = std::min(static_cast<int>(row), m_rows - 2);
+    const double fx = column - c0;
+    const double fy = row - r0;
+
+    const int k = r0 * m_columns + c0;
+    auto lerp2 = [&](const QVector<float>& f) {
+        const double top = f[k] + (f[k + 1] - f[k]) * fx;
+        const double bottom = f[k + m_columns] + (f[k + m_columns + 1] - f[k + m_columns]) * fx;
+        return top + (bottom - top) * fy;
+    };
+
+    *u = lerp2(m_u);
+    *v = lerp2(m_v);
+    return true;
+}
+
+bool WindVectorField::sample(const Models::GeospatialCoordinate& location, double* u, double* v) const
+{
+    if (isEmpty()) {
+        return false;
+    }
+
+    return sampleGrid((location.longitude() - m_west) / m_cellLon,
+                      (m_north - location.latitude()) / m_cellLat, u, v);
+}
+
+double WindVectorField::cellWidthMeters() const
+{
+    const double latitude = m_north - (m_rows - 1) * m_cellLat / 2.0;
+    return m_cellLon * METERS_PER_DEGREE * std::cos(qDegreesToRadians(latitude));
+}
+
+double WindVectorField::cellHeightMeters() const
+{
+    return m_cellLat * METERS_PER_DEGREE;
+}
+
 // WindOverlayWidget implementation
 
 WindOverlayWidget::WindOverlayWidget(QWidget* parent)
@@ -153,7 +321,10 @@ WindOverlayWidget::WindOverlayWidget(QWidget* parent)
     , m_weatherService(nullptr)
     , m_enabled(true)
     , m_animationTimerId(-1)
-    , m_animationPhase(0.0)
+    , m_fieldDirty(true)
+    , m_viewDirty(true)
+    , m_layerDirty(true)
+    , m_random(QRandomGenerator::securelySeeded())
 {
     setAttribute(Qt::WA_TransparentForMouseEvents);
     setAttribute(Qt::WA_TranslucentBackground);
@@ -163,10 +334,7 @@ WindOverlayWidget::WindOverlayWidget(QWidget* parent)
         return QPointF(coord.longitude(), coord.latitude());
     };
 
-    // Start animation timer
-    if (m_settings.animateFlow) {
-        m_animationTimerId = startTimer(50); // 20 FPS
-    }
+    updateAnimationTimer();
 }
 
 WindOverlayWidget::~WindOverlayWidget()
@@ -187,33 +355,37 @@ void WindOverlayWidget::setViewBounds(
 {
     m_topLeft = topLeft;
     m_bottomRight = bottomRight;
+
+    // Field only needs rebuilding when the view leaves its extent
+    if (!m_field.contains(topLeft, bottomRight)) {
+        m_fieldDirty = true;
+    }
+    m_viewDirty = true;
     update();
 }
 
 void WindOverlayWidget::setSettings(const WindOverlaySettings& settings)
 {
     m_settings = settings;
+    m_layerDirty = true;
 
-    // Update animation timer
-    if (m_settings.animateFlow && m_animationTimerId < 0) {
-        m_animationTimerId = startTimer(50);
-    } else if (!m_settings.animateFlow && m_animationTimerId >= 0) {
-        killTimer(m_animationTimerId);
-        m_animationTimerId = -1;
-    }
-
+    updateAnimationTimer();
     update();
 }
 
 void WindOverlayWidget::addWindDataPoint(const WindDataPoint& point)
 {
     m_windData.append(point);
+    m_fieldDirty = true;
+    m_layerDirty = true;
     update();
 }
 
 void WindOverlayWidget::clearData()
 {
     m_windData.clear();
+    m_fieldDirty = true;
+    m_layerDirty = true;
     update();
 }
 
@@ -248,33 +420,175 @@ void WindOverlayWidget::setCoordinateTransform(
     std::function<QPointF(const Models::GeospatialCoordinate&)> func)
 {
     m_coordTransform = func;
+    m_viewDirty = true;
     update();
 }
 
 void WindOverlayWidget::setEnabled(bool enabled)
 {
     m_enabled = enabled;
+    updateAnimationTimer();
     update();
 }
 
-void WindOverlayWidget::paintEvent(QPaintEvent* event)
+void WindOverlayWidget::updateAnimationTimer()
 {
-    Q_UNUSED(event);
+    // Only particles animate; the static layer never needs a timer
+    const bool animate = m_enabled && m_settings.animateFlow && m_settings.showStreamlines;
 
-    if (!m_enabled || m_windData.isEmpty()) {
+    if (animate && m_animationTimerId < 0) {
+        m_animationTimerId = startTimer(FRAME_MS);
+    } else if (!animate && m_animationTimerId >= 0) {
+        killTimer(m_animationTimerId);
+        m_animationTimerId = -1;
+    }
+}
+
+void WindOverlayWidget::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    m_viewDirty = true;
+}
+
+void WindOverlayWidget::ensureField()
+{
+    if (!m_fieldDirty) {
         return;
     }
+    m_fieldDirty = false;
 
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    if (m_windData.isEmpty()) {
+        m_field.clear();
+        m_particles.clear();
+        return;
+    }
 
-    // Set opacity
-    painter.setOpacity(m_settings.opacity / 100.0);
+    // Extent: data and current view, padded so small pans stay inside
+    double north = m_topLeft.latitude();
+    double south = m_bottomRight.latitude();
+    double west = m_topLeft.longitude();
+    double east = m_bottomRight.longitude();
+    if (!(north > south && east > west)) {
+        north = -90.0;
+        south = 90.0;
+        west = 180.0;
+        east = -180.0;
+    }
 
-    // Draw streamlines first (background)
-    if (m_settings.showStreamlines) {
-        drawStreamlines(painter);
+    for (const auto& point : m_windData) {
+        north = std::max(north, point.location.latitude());
+        south = std::min(south, point.location.latitude());
+        west = std::min(west, point.location.longitude());
+        east = std::max(east, point.location.longitude());
+    }
+
+    const double padLat = std::max((north - south) * FIELD_PADDING, 1e-3);
+    const double padLon = std::max((east - west) * FIELD_PADDING, 1e-3);
+
+    m_field.build(m_windData,
+                  Models::GeospatialCoordinate(north + padLat, west - padLon, 0),
+                  Models::GeospatialCoordinate(south - padLat, east + padLon, 0),
+                  FIELD_NODES, FIELD_NODES);
+
+    m_particles.clear();
+    m_viewDirty = true;
+}
+
+void WindOverlayWidget::ensureProjection()
+{
+    if (!m_viewDirty) {
+        return;
+    }
+    m_viewDirty = false;
+    m_layerDirty = true;
+
+    // Project the field nodes once per view change
+    m_nodeScreen.resize(m_field.columns() * m_field.rows());
+    for (int row = 0; row < m_field.rows(); ++row) {
+        for (int col = 0; col < m_field.columns(); ++col) {
+            m_nodeScreen[row * m_field.columns() + col] = coordinateToScreen(m_field.nodeCoordinate(col, row));
+        }
+    }
+
+    // Particle count follows the widget area
+    const int count = std::min(width() * height() / PARTICLE_AREA, MAX_PARTICLES);
+    m_particles.resize(m_field.isEmpty() ? 0 : count);
+    for (auto& particle : m_particles) {
+        respawnParticle(particle);
+        particle.age = m_random.bounded(particle.maxAge);
+    }
+}
+
+QPointF WindOverlayWidget::gridToScreen(double column, double row) const
+{
+    const int columns = m_field.columns();
+    const int c0 = std::clamp(static_cast<int>(column), 0, columns - 2);
+    const int r0 = std::clamp(static_cast<int>(row), 0, m_field.rows() - 2);
+    const double fx = column - c0;
+    const double fy = row - r0;
+
+    const QPointF* node = m_nodeScreen.constData() + r0 * columns + c0;
+    const QPointF top = node[0] + (node[1] - node[0]) * fx;
+    const QPointF bottom = node[columns] + (node[columns + 1] - node[columns]) * fx;
+    return top + (bottom - top) * fy;
+}
+
+void WindOverlayWidget::respawnParticle(Particle& particle)
+{
+    particle.column = static_cast<float>(m_random.bounded(static_cast<double>(m_field.columns() - 1)));
+    particle.row = static_cast<float>(m_random.bounded(static_cast<double>(m_field.rows() - 1)));
+    particle.age = 0;
+    particle.maxAge = 40 + m_random.bounded(60);
+    particle.trailLength = 1;
+    particle.trail[0] = gridToScreen(particle.column, particle.row);
+}
+
+void WindOverlayWidget::advectParticles()
+{
+    if (m_field.isEmpty() || m_nodeScreen.isEmpty()) {
+        return;
+    }
+
+    // Grid cells per (m/s) per frame; rows are rescaled so motion stays
+    // isotropic in meters, and grow southwards
+    const double stepX = PARTICLE_STEP * m_settings.animationSpeed * (m_field.columns() - 1);
+    const double stepY = stepX * m_field.cellWidthMeters() / std::max(m_field.cellHeightMeters(), 1e-6);
+
+    for (auto& particle : m_particles) {
+        double u = 0.0;
+        double v = 0.0;
+        if (++particle.age > particle.maxAge ||
+            !m_field.sampleGrid(particle.column, particle.row, &u, &v) ||
+            std::hypot(u, v) < m_settings.minWindSpeed) {
+            respawnParticle(particle);
+            continue;
+        }
+
+        particle.column += static_cast<float>(u * stepX);
+        particle.row -= static_cast<float>(v * stepY);
+
+        // Shift the trail and add the new head
+        const int length = std::min(particle.trailLength + 1, PARTICLE_TRAIL);
+        for (int i = length - 1; i > 0; --i) {
+            particle.trail[i] = particle.trail[i - 1];
+        }
+        particle.trail[0] = gridToScreen(particle.column, particle.row);
+        particle.trailLength = length;
     }
+}
+
+void WindOverlayWidget::renderStaticLayer()
+{
+    m_layerDirty = false;
+
+    const qreal dpr = devicePixelRatioF();
+    m_staticLayer = QPixmap(size() * dpr);
+    m_staticLayer.setDevicePixelRatio(dpr);
+    m_staticLayer.fill(Qt::transparent);
+
+    QPainter painter(&m_staticLayer);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setOpacity(m_settings.opacity / 100.0);
 
     // Draw wind data points
     for (const auto& dataPoint : m_windData) {
@@ -316,13 +630,38 @@ void WindOverlayWidget::paintEvent(QPaintEvent* event)
     }
 }
 
+void WindOverlayWidget::paintEvent(QPaintEvent* event)
+{
+    TRACE_SCOPE("render", "WindOverlayWidget::paintEvent");
+
+    Q_UNUSED(event);
+
+    if (!m_enabled || m_windData.isEmpty()) {
+        return;
+    }
+
+    ensureField();
+    ensureProjection();
+    if (m_layerDirty || m_staticLayer.size() != size() * devicePixelRatioF()) {
+        renderStaticLayer();
+    }
+
+    QPainter painter(this);
+
+    // Draw streamlines first (background)
+    if (m_settings.showStreamlines) {
+        painter.setOpacity(m_settings.opacity / 100.0);
+        drawStreamlines(painter);
+        painter.setOpacity(1.0);
+    }
+
+    painter.drawPixmap(0, 0, m_staticLayer);
+}
+
 void WindOverlayWidget::timerEvent(QTimerEvent* event)
 {
     if (event->timerId() == m_animationTimerId) {
-        m_animationPhase += m_settings.animationSpeed * 0.05;
-        if (m_animationPhase > 2.0 * M_PI) {
-            m_animationPhase -= 2.0 * M_PI;
-        }
+        advectParticles();
         update();
     }
 }
@@ -349,14 +688,6 @@ void WindOverlayWidget::drawWindArrow(
     // Draw arrow
     painter.drawPolygon(arrow);
 
-    // Add animation pulse
-    if (m_settings.animateFlow) {
-        double pulseScale = 1.0 + 0.2 * sin(m_animationPhase);
-        painter.scale(pulseScale, pulseScale);
-        painter.setOpacity(0.5);
-        painter.drawPolygon(arrow);
-    }
-
     painter.restore();
 }
 
@@ -401,15 +732,25 @@ void WindOverlayWidget::drawWindText(
 
 void WindOverlayWidget::drawStreamlines(QPainter& painter)
 {
-    // Simplified streamline visualization
-    // In production, would use proper flow field integration
-
+    // Particle trails, batched by segment age so older segments fade
     painter.save();
-    painter.setPen(QPen(QColor(255, 255, 255, 100), 1));
+    painter.setRenderHint(QPainter::Antialiasing, false);
 
-    // This is a placeholder - actual streamlines require
-    // Runge-Kutta integration through the wind field
-    // For now, just draw flow lines based on local wind direction
+    QVector<QLineF> segments;
+    segments.reserve(m_particles.size());
+
+    for (int age = 0; age < PARTICLE_TRAIL - 1; ++age) {
+        segments.clear();
+        for (const auto& particle : m_particles) {
+            if (age + 1 < particle.trailLength) {
+                segments.append(QLineF(particle.trail[age], particle.trail[age + 1]));
+            }
+        }
+
+        const int alpha = 220 * (PARTICLE_TRAIL - 1 - age) / (PARTICLE_TRAIL - 1);
+        painter.setPen(QPen(QColor(255, 255, 255, alpha), 1.5));
+        painter.drawLines(segments);
+    }
 
     painter.restore();
 }
@@ -451,15 +792,25 @@ QList<WindDataPoint> WindOverlayWidget::interpolateWindField()
 
 WindDataPoint WindOverlayWidget::interpolateWindAt(const Models::GeospatialCoordinate& location)
 {
-    Q_UNUSED(location);
-
-    // Find nearest wind data points and interpolate
-    // Simplified - return first point
-    if (!m_windData.isEmpty()) {
-        return m_windData.first();
+    ensureField();
+
+    WindDataPoint point;
+    point.location = location;
+    point.windSpeed = 0;
+    point.windDirection = 0;
+    point.gustSpeed = 0;
+    point.timestamp = QDateTime::currentDateTime();
+    point.source = "Interpolated";
+
+    double u = 0.0;
+    double v = 0.0;
+    if (m_field.sample(location, &u, &v)) {
+        point.windSpeed = std::hypot(u, v);
+        // Back to meteorological convention (direction wind comes from)
+        point.windDirection = std::fmod(qRadiansToDegrees(std::atan2(u, v)) + 180.0, 360.0);
     }
 
-    return WindDataPoint();
+    return point;
 }
 
 QPointF WindOverlayWidget::coordinateToScreen(const Models::GeospatialCoordinate& coord) const
@@ -0,0 +1,126 @@
+#include "core/MpscRingBuffer.h"
+#include <QtTest>
+#include <thread>
+#include <vector>
+
+using DroneMapper::Core::MpscRingBuffer;
+
+class TestMpscRingBuffer : public QObject {
+    Q_OBJECT
+
+private slots:
+    void capacityRoundsUp();
+    void fifoOrder();
+    void fullQueueRejects();
+    void wrapsAround();
+    void concurrentProducers();
+};
+
+void TestMpscRingBuffer::capacityRoundsUp()
+{
+    QCOMPARE(MpscRingBuffer<int>(0).capacity(), std::size_t(2));
+    QCOMPARE(MpscRingBuffer<int>(5).capacity(), std::size_t(8));
+    QCOMPARE(MpscRingBuffer<int>(64).capacity(), std::size_t(64));
+}
+
+void TestMpscRingBuffer::fifoOrder()
+{
+    MpscRingBuffer<int> queue(8);
+    QVERIFY(queue.isEmpty());
+
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(queue.tryPush(int(i)));
+    }
+    QVERIFY(!queue.isEmpty());
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(queue.tryPop(value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!queue.tryPop(value));
+    QVERIFY(queue.isEmpty());
+}
+
+void TestMpscRingBuffer::fullQueueRejects()
+{
+    MpscRingBuffer<std::vector<int>> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(queue.tryPush(std::vector<int>(1, i)));
+    }
+
+    // A rejected item is left untouched for the caller to retry
+    std::vector<int> item(3, 7);
+    QVERIFY(!queue.tryPush(std::move(item)));
+    QCOMPARE(item.size(), std::size_t(3));
+
+    std::vector<int> popped;
+    QVERIFY(queue.tryPop(popped));
+    QCOMPARE(popped.front(), 0);
+    QVERIFY(queue.tryPush(std::move(item)));
+}
+
+void TestMpscRingBuffer::wrapsAround()
+{
+    MpscRingBuffer<int> queue(4);
+    int value = 0;
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(queue.tryPush(int(i)));
+        QVERIFY(queue.tryPush(int(i + 1)));
+        QVERIFY(queue.tryPop(value));
+        QCOMPARE(value, i);
+        QVERIFY(queue.tryPop(value));
+        QCOMPARE(value, i + 1);
+    }
+    QVERIFY(queue.isEmpty());
+}
+
+void TestMpscRingBuffer::concurrentProducers()
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int ITEMS_PER_PRODUCER = 100000;
+
+    // Small queue so producers keep hitting the full case
+    MpscRingBuffer<std::pair<int, int>> queue(64);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCERS; ++producer) {
+        producers.emplace_back([&queue, producer]() {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                while (!queue.tryPush(std::make_pair(producer, i))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Items from one producer arrive in the order it pushed them
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    bool ordered = true;
+    std::pair<int, int> item;
+    while (received < PRODUCERS * ITEMS_PER_PRODUCER) {
+        if (!queue.tryPop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && item.first >= 0 && item.first < PRODUCERS && item.second == next[item.first];
+        if (item.first >= 0 && item.first < PRODUCERS) {
+            next[item.first] = item.second + 1;
+        }
+        ++received;
+    }
+
+    for (std::thread& thread : producers) {
+        thread.join();
+    }
+
+    QVERIFY(ordered);
+    QVERIFY(queue.isEmpty());
+    for (int producer = 0; producer < PRODUCERS; ++producer) {
+        QCOMPARE(next[producer], ITEMS_PER_PRODUCER);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestMpscRingBuffer)
+#include "tst_mpscringbuffer.moc"
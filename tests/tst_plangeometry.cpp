@@ -0,0 +1,200 @@
+#include "models/FlightPlan.h"
+#include "core/FlightPathOptimizer.h"
+#include <QtTest>
+#include <cmath>
+#include <random>
+
+using namespace DroneMapper;
+using Models::FlightPlan;
+using Models::GeospatialCoordinate;
+using Models::PlanGeometry;
+using Models::SegmentGeometry;
+using Models::Waypoint;
+
+namespace {
+
+Waypoint randomWaypoint(std::mt19937& rng)
+{
+    std::uniform_real_distribution<double> offset(-0.01, 0.01);
+    std::uniform_real_distribution<double> altitude(40.0, 120.0);
+    return Waypoint(GeospatialCoordinate(47.0 + offset(rng), 8.0 + offset(rng), altitude(rng)));
+}
+
+// Incrementally maintained geometry must match a full rebuild exactly
+bool matchesRebuild(const FlightPlan& plan, QString* message)
+{
+    PlanGeometry expected;
+    expected.rebuild(plan.waypoints());
+
+    const auto& actual = plan.geometry().segments();
+    if (actual.size() != expected.segments().size()) {
+        *message = QString("%1 legs, expected %2").arg(actual.size()).arg(expected.segments().size());
+        return false;
+    }
+    for (int i = 0; i < actual.size(); ++i) {
+        const SegmentGeometry& a = actual[i];
+        const SegmentGeometry& b = expected.segments()[i];
+        if (a.length != b.length || a.bearing != b.bearing || a.climb != b.climb || a.turnAngle != b.turnAngle) {
+            *message = QString("leg %1 differs from rebuild").arg(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+class TestPlanGeometry : public QObject {
+    Q_OBJECT
+
+private slots:
+    void appendMatchesRebuild();
+    void setWaypoint();
+    void removeWaypoint();
+    void replaced_data();
+    void replaced();
+    void randomEdits();
+    void turnCountMatchesOptimizer();
+};
+
+void TestPlanGeometry::appendMatchesRebuild()
+{
+    std::mt19937 rng(1);
+    FlightPlan plan;
+    QCOMPARE(plan.geometry().segmentCount(), 0);
+
+    QString message;
+    for (int i = 0; i < 20; ++i) {
+        plan.addWaypoint(randomWaypoint(rng));
+        QVERIFY2(matchesRebuild(plan, &message), qPrintable(message));
+    }
+    QCOMPARE(plan.geometry().segmentCount(), 19);
+    QCOMPARE(plan.geometry().lastUpdatedSegments(), 1);
+}
+
+void TestPlanGeometry::setWaypoint()
+{
+    std::mt19937 rng(2);
+    FlightPlan plan;
+    for (int i = 0; i < 10; ++i) {
+        plan.addWaypoint(randomWaypoint(rng));
+    }
+
+    QString message;
+    for (int index : { 0, 1, 5, 8, 9 }) {
+        plan.setWaypoint(index, randomWaypoint(rng));
+        QVERIFY2(matchesRebuild(plan, &message), qPrintable(message));
+        QVERIFY(plan.geometry().lastUpdatedSegments() <= 2);
+    }
+}
+
+void TestPlanGeometry::removeWaypoint()
+{
+    std::mt19937 rng(3);
+    FlightPlan plan;
+    for (int i = 0; i < 12; ++i) {
+        plan.addWaypoint(randomWaypoint(rng));
+    }
+
+    // First, last and interior waypoints, down to a single leg and below
+    QString message;
+    for (int index : { 0, 10, 4, 1, 6, 0, 4, 2, 1, 1, 0 }) {
+        plan.removeWaypoint(index);
+        QVERIFY2(matchesRebuild(plan, &message), qPrintable(message));
+    }
+    QCOMPARE(plan.waypointCount(), 1);
+    QCOMPARE(plan.geometry().segmentCount(), 0);
+}
+
+void TestPlanGeometry::replaced_data()
+{
+    QTest::addColumn<int>("start");
+    QTest::addColumn<int>("removeCount");
+    QTest::addColumn<int>("insertCount");
+
+    QTest::newRow("insert at front") << 0 << 0 << 3;
+    QTest::newRow("insert in middle") << 4 << 0 << 2;
+    QTest::newRow("insert at end") << 10 << 0 << 2;
+    QTest::newRow("remove front") << 0 << 3 << 0;
+    QTest::newRow("remove middle") << 3 << 4 << 0;
+    QTest::newRow("remove tail") << 7 << 3 << 0;
+    QTest::newRow("grow middle") << 2 << 2 << 5;
+    QTest::newRow("shrink middle") << 2 << 5 << 1;
+    QTest::newRow("swap one") << 5 << 1 << 1;
+    QTest::newRow("replace all") << 0 << 10 << 4;
+    QTest::newRow("leave one") << 0 << 9 << 0;
+}
+
+void TestPlanGeometry::replaced()
+{
+    QFETCH(int, start);
+    QFETCH(int, removeCount);
+    QFETCH(int, insertCount);
+
+    std::mt19937 rng(4);
+    FlightPlan plan;
+    for (int i = 0; i < 10; ++i) {
+        plan.addWaypoint(randomWaypoint(rng));
+    }
+
+    QList<Waypoint> replacement;
+    for (int i = 0; i < insertCount; ++i) {
+        replacement.append(randomWaypoint(rng));
+    }
+    plan.replaceWaypoints(start, removeCount, replacement);
+
+    QString message;
+    QCOMPARE(plan.waypointCount(), 10 - removeCount + insertCount);
+    QVERIFY2(matchesRebuild(plan, &message), qPrintable(message));
+}
+
+void TestPlanGeometry::randomEdits()
+{
+    std::mt19937 rng(5);
+    FlightPlan plan;
+    QString message;
+
+    for (int step = 0; step < 2000; ++step) {
+        const int count = plan.waypointCount();
+        const int action = static_cast<int>(rng() % 4);
+
+        if (count < 2 || action == 0) {
+            plan.addWaypoint(randomWaypoint(rng));
+        } else if (action == 1) {
+            plan.setWaypoint(static_cast<int>(rng() % count), randomWaypoint(rng));
+        } else if (action == 2) {
+            plan.removeWaypoint(static_cast<int>(rng() % count));
+        } else {
+            const int start = static_cast<int>(rng() % (count + 1));
+            const int removeCount = static_cast<int>(rng() % (count - start + 1));
+            QList<Waypoint> replacement;
+            for (int i = static_cast<int>(rng() % 4); i > 0; --i) {
+                replacement.append(randomWaypoint(rng));
+            }
+            plan.replaceWaypoints(start, removeCount, replacement);
+        }
+
+        QVERIFY2(matchesRebuild(plan, &message),
+                 qPrintable(QString("step %1: %2").arg(step).arg(message)));
+    }
+}
+
+void TestPlanGeometry::turnCountMatchesOptimizer()
+{
+    std::mt19937 rng(6);
+    for (int iteration = 0; iteration < 50; ++iteration) {
+        FlightPlan plan;
+        const int count = static_cast<int>(rng() % 30);
+        for (int i = 0; i < count; ++i) {
+            plan.addWaypoint(randomWaypoint(rng));
+        }
+
+        for (double threshold : { 10.0, 30.0, 90.0 }) {
+            QCOMPARE(plan.geometry().turnCount(threshold),
+                     Core::FlightPathOptimizer::calculateDirectionChanges(plan.waypoints(), threshold));
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestPlanGeometry)
+#include "tst_plangeometry.moc"
@@ -0,0 +1,197 @@
+#include "geospatial/PolygonClipper.h"
+#include <QtTest>
+#include <cmath>
+#include <random>
+
+using namespace DroneMapper::Geospatial;
+
+namespace {
+
+// Nonzero winding number of a ring around a point
+int winding(const QPolygonF& ring, const QPointF& p)
+{
+    int w = 0;
+    const int n = ring.size();
+    for (int i = 0; i < n; ++i) {
+        const QPointF a = ring[i];
+        const QPointF b = ring[(i + 1) % n];
+        const double side = (b.x() - a.x()) * (p.y() - a.y()) - (p.x() - a.x()) * (b.y() - a.y());
+        if (a.y() <= p.y()) {
+            if (b.y() > p.y() && side > 0.0) {
+                ++w;
+            }
+        } else if (b.y() <= p.y() && side < 0.0) {
+            --w;
+        }
+    }
+    return w;
+}
+
+bool insideRings(const QList<QPolygonF>& rings, const QPointF& p)
+{
+    int w = 0;
+    for (const QPolygonF& ring : rings) {
+        w += winding(ring, p);
+    }
+    return w != 0;
+}
+
+bool insideResult(const MultiPolygon& result, const QPointF& p)
+{
+    for (const PolygonWithHoles& polygon : result) {
+        if (winding(polygon.outer, p) == 0) {
+            continue;
+        }
+        bool inHole = false;
+        for (const QPolygonF& hole : polygon.holes) {
+            inHole = inHole || winding(hole, p) != 0;
+        }
+        if (!inHole) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QPolygonF square(double x, double y, double size)
+{
+    return QPolygonF({ QPointF(x, y), QPointF(x + size, y),
+                       QPointF(x + size, y + size), QPointF(x, y + size) });
+}
+
+double totalArea(const MultiPolygon& result)
+{
+    double area = 0.0;
+    for (const PolygonWithHoles& polygon : result) {
+        area += polygon.area();
+    }
+    return area;
+}
+
+} // namespace
+
+class TestPolygonClipper : public QObject {
+    Q_OBJECT
+
+private slots:
+    void squareWithHole();
+    void disjointOperands();
+    void sharedEdges();
+    void randomOperands_data();
+    void randomOperands();
+};
+
+void TestPolygonClipper::squareWithHole()
+{
+    MultiPolygon result = PolygonClipper::compute({ square(0, 0, 100) }, { square(25, 25, 50) },
+                                                  PolygonClipper::Operation::Difference);
+
+    QCOMPARE(result.size(), qsizetype(1));
+    QCOMPARE(result.first().holes.size(), qsizetype(1));
+    QVERIFY(PolygonClipper::signedArea(result.first().outer) > 0.0);
+    QVERIFY(PolygonClipper::signedArea(result.first().holes.first()) < 0.0);
+    QVERIFY(std::abs(result.first().area() - 7500.0) < 1e-3);
+}
+
+void TestPolygonClipper::disjointOperands()
+{
+    const QPolygonF a = square(0, 0, 10);
+    const QPolygonF b = square(100, 100, 10);
+
+    QCOMPARE(PolygonClipper::compute({ a }, { b }, PolygonClipper::Operation::Intersection).size(), qsizetype(0));
+    QCOMPARE(PolygonClipper::compute({ a }, { b }, PolygonClipper::Operation::Union).size(), qsizetype(2));
+
+    MultiPolygon difference = PolygonClipper::compute({ a }, { b }, PolygonClipper::Operation::Difference);
+    QCOMPARE(difference.size(), qsizetype(1));
+    QVERIFY(std::abs(totalArea(difference) - 100.0) < 1e-3);
+}
+
+void TestPolygonClipper::sharedEdges()
+{
+    // Two squares sharing an edge merge into one rectangle
+    MultiPolygon merged = PolygonClipper::compute({ square(0, 0, 10) }, { square(10, 0, 10) },
+                                                  PolygonClipper::Operation::Union);
+    QCOMPARE(merged.size(), qsizetype(1));
+    QVERIFY(merged.first().holes.isEmpty());
+    QVERIFY(std::abs(totalArea(merged) - 200.0) < 1e-3);
+
+    // Identical operands cancel out
+    QCOMPARE(PolygonClipper::compute({ square(0, 0, 10) }, { square(0, 0, 10) },
+                                     PolygonClipper::Operation::Difference).size(), qsizetype(0));
+}
+
+void TestPolygonClipper::randomOperands_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<int>("operation");
+
+    const char* modes[] = { "few circles", "many circles", "grid squares", "slivers" };
+    const char* operations[] = { "union", "intersection", "difference" };
+    for (int mode = 0; mode < 4; ++mode) {
+        for (int operation = 0; operation < 3; ++operation) {
+            QTest::addRow("%s %s", modes[mode], operations[operation]) << mode << operation;
+        }
+    }
+}
+
+void TestPolygonClipper::randomOperands()
+{
+    QFETCH(int, mode);
+    QFETCH(int, operation);
+
+    const auto op = static_cast<PolygonClipper::Operation>(operation);
+    std::mt19937 rng(1000 * mode + operation);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> sample(-500.0, 2500.0);
+    const double size = 1000.0;
+
+    for (int iteration = 0; iteration < 10; ++iteration) {
+        // Star-shaped subject around (size, size)
+        QPolygonF subject;
+        const int corners = 3 + static_cast<int>(rng() % 8);
+        for (int i = 0; i < corners; ++i) {
+            const double angle = 2.0 * M_PI * i / corners;
+            const double radius = size * (0.5 + 0.5 * unit(rng));
+            subject.append(QPointF(size + radius * std::cos(angle), size + radius * std::sin(angle)));
+        }
+
+        QList<QPolygonF> clip;
+        const int clipCount = (mode == 0) ? 5 : (mode == 1) ? 200 : 30;
+        for (int i = 0; i < clipCount; ++i) {
+            QPointF center(unit(rng) * 2.0 * size, unit(rng) * 2.0 * size);
+            if (mode == 2) {
+                // Squares on a coarse grid: many collinear and coincident edges
+                center = QPointF(std::round(center.x() / 100.0) * 100.0, std::round(center.y() / 100.0) * 100.0);
+                const double half = 100.0 * (1 + rng() % 3);
+                clip.append(square(center.x() - half, center.y() - half, 2.0 * half));
+            } else if (mode == 3) {
+                // Thin triangles sharing vertices with the subject
+                clip.append(QPolygonF({ subject[rng() % corners], subject[rng() % corners], center }));
+            } else {
+                clip.append(PolygonClipper::circle(center, 20.0 + unit(rng) * 300.0, 1.0));
+            }
+        }
+
+        const MultiPolygon result = PolygonClipper::compute({ subject }, clip, op);
+
+        // Points on an edge may fall either way; allow a couple of them
+        int mismatched = 0;
+        for (int k = 0; k < 2000; ++k) {
+            const QPointF p(sample(rng), sample(rng));
+            const bool inSubject = insideRings({ subject }, p);
+            const bool inClip = insideRings(clip, p);
+            const bool expected = (op == PolygonClipper::Operation::Union) ? (inSubject || inClip)
+                                : (op == PolygonClipper::Operation::Intersection) ? (inSubject && inClip)
+                                : (inSubject && !inClip);
+            if (expected != insideResult(result, p)) {
+                ++mismatched;
+            }
+        }
+
+        QVERIFY2(mismatched <= 2, qPrintable(QString("iteration %1: %2 of 2000 samples misclassified")
+                                                 .arg(iteration).arg(mismatched)));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestPolygonClipper)
+#include "tst_polygonclipper.moc"
@@ -0,0 +1,212 @@
+#include "geospatial/PolygonOffsetter.h"
+#include <QtTest>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace DroneMapper::Geospatial;
+
+namespace {
+
+bool insideRing(const QPolygonF& ring, const QPointF& p)
+{
+    return ring.containsPoint(p, Qt::WindingFill);
+}
+
+bool insideResult(const MultiPolygon& result, const QPointF& p)
+{
+    for (const PolygonWithHoles& polygon : result) {
+        if (!insideRing(polygon.outer, p)) {
+            continue;
+        }
+        bool inHole = false;
+        for (const QPolygonF& hole : polygon.holes) {
+            inHole = inHole || insideRing(hole, p);
+        }
+        if (!inHole) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double distanceToRing(const QPolygonF& ring, const QPointF& p)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < ring.size(); ++i) {
+        const QPointF a = ring[i];
+        const QPointF b = ring[(i + 1) % ring.size()];
+        const QPointF ab = b - a;
+        const double lengthSq = QPointF::dotProduct(ab, ab);
+        const double t = lengthSq > 0.0 ? std::clamp(QPointF::dotProduct(p - a, ab) / lengthSq, 0.0, 1.0) : 0.0;
+        const QPointF d = p - (a + ab * t);
+        best = std::min(best, std::hypot(d.x(), d.y()));
+    }
+    return best;
+}
+
+double totalArea(const MultiPolygon& result)
+{
+    double area = 0.0;
+    for (const PolygonWithHoles& polygon : result) {
+        area += polygon.area();
+    }
+    return area;
+}
+
+QPolygonF square(double size)
+{
+    return QPolygonF({ QPointF(0, 0), QPointF(size, 0), QPointF(size, size), QPointF(0, size) });
+}
+
+// Simple star-shaped ring with convex and reflex vertices
+QPolygonF randomStar(std::mt19937& rng, bool clockwise)
+{
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const int corners = 5 + static_cast<int>(rng() % 12);
+    QPolygonF ring;
+    for (int i = 0; i < corners; ++i) {
+        const double angle = 2.0 * M_PI * i / corners * (clockwise ? -1.0 : 1.0);
+        const double radius = 100.0 * (0.4 + 0.6 * unit(rng));
+        ring.append(QPointF(radius * std::cos(angle), radius * std::sin(angle)));
+    }
+    return ring;
+}
+
+} // namespace
+
+class TestPolygonOffsetter : public QObject {
+    Q_OBJECT
+
+private slots:
+    void squareAreas_data();
+    void squareAreas();
+    void insetVanishes();
+    void offsetAllKeepsOrder();
+    void randomRings_data();
+    void randomRings();
+};
+
+void TestPolygonOffsetter::squareAreas_data()
+{
+    QTest::addColumn<int>("join");
+    QTest::addColumn<double>("delta");
+    QTest::addColumn<double>("expected");
+
+    const double s = 100.0;
+    const double d = 10.0;
+    QTest::newRow("miter grow") << int(PolygonOffsetter::JoinType::Miter) << d << (s + 2 * d) * (s + 2 * d);
+    QTest::newRow("round grow") << int(PolygonOffsetter::JoinType::Round) << d << s * s + 4 * s * d + M_PI * d * d;
+    QTest::newRow("square grow") << int(PolygonOffsetter::JoinType::Square) << d
+                                 << (s + 2 * d) * (s + 2 * d) - 4 * (d * d * (3.0 - 2.0 * std::sqrt(2.0)));
+    QTest::newRow("miter shrink") << int(PolygonOffsetter::JoinType::Miter) << -d << (s - 2 * d) * (s - 2 * d);
+    QTest::newRow("round shrink") << int(PolygonOffsetter::JoinType::Round) << -d << (s - 2 * d) * (s - 2 * d);
+}
+
+void TestPolygonOffsetter::squareAreas()
+{
+    QFETCH(int, join);
+    QFETCH(double, delta);
+    QFETCH(double, expected);
+
+    PolygonOffsetter::Options options;
+    options.join = static_cast<PolygonOffsetter::JoinType>(join);
+    options.arcTolerance = 0.01;
+
+    const MultiPolygon result = PolygonOffsetter::offset(square(100.0), delta, options);
+
+    QCOMPARE(result.size(), qsizetype(1));
+    QVERIFY(result.first().holes.isEmpty());
+    QVERIFY2(std::abs(totalArea(result) - expected) < 0.5,
+             qPrintable(QString("area %1, expected %2").arg(totalArea(result)).arg(expected)));
+}
+
+void TestPolygonOffsetter::insetVanishes()
+{
+    QVERIFY(PolygonOffsetter::offset(square(10.0), -6.0).isEmpty());
+    QVERIFY(PolygonOffsetter::offset(QPolygonF({ QPointF(0, 0), QPointF(1, 1) }), 5.0).isEmpty());
+}
+
+void TestPolygonOffsetter::offsetAllKeepsOrder()
+{
+    QList<QPolygonF> rings;
+    for (int i = 1; i <= 16; ++i) {
+        rings.append(square(10.0 * i));
+    }
+
+    PolygonOffsetter::Options options;
+    options.join = PolygonOffsetter::JoinType::Miter;
+    const QList<MultiPolygon> results = PolygonOffsetter::offsetAll(rings, 1.0, options);
+
+    QCOMPARE(results.size(), rings.size());
+    for (int i = 0; i < results.size(); ++i) {
+        const double side = 10.0 * (i + 1) + 2.0;
+        QVERIFY(std::abs(totalArea(results[i]) - side * side) < 1e-3);
+    }
+}
+
+void TestPolygonOffsetter::randomRings_data()
+{
+    QTest::addColumn<int>("join");
+    QTest::addColumn<double>("delta");
+
+    const char* joins[] = { "miter", "round", "square" };
+    for (int join = 0; join < 3; ++join) {
+        QTest::addRow("%s grow", joins[join]) << join << 12.0;
+        QTest::addRow("%s shrink", joins[join]) << join << -12.0;
+    }
+}
+
+void TestPolygonOffsetter::randomRings()
+{
+    QFETCH(int, join);
+    QFETCH(double, delta);
+
+    PolygonOffsetter::Options options;
+    options.join = static_cast<PolygonOffsetter::JoinType>(join);
+
+    // Round joins follow the distance exactly; miter and square corners
+    // may reach further out, up to the miter limit
+    const double distance = std::abs(delta);
+    const double tolerance = options.arcTolerance + 1e-3;
+    const double reach = (options.join == PolygonOffsetter::JoinType::Round)
+        ? distance
+        : distance * std::max(options.miterLimit, std::sqrt(2.0));
+
+    std::mt19937 rng(100 * join + (delta > 0.0 ? 1 : 2));
+    std::uniform_real_distribution<double> sample(-130.0, 130.0);
+
+    for (int iteration = 0; iteration < 40; ++iteration) {
+        const QPolygonF ring = randomStar(rng, iteration % 2 == 1);
+        const MultiPolygon result = PolygonOffsetter::offset(ring, delta, options);
+
+        for (int k = 0; k < 2000; ++k) {
+            const QPointF p(sample(rng), sample(rng));
+            const bool inRing = insideRing(ring, p);
+            const double d = distanceToRing(ring, p);
+            const bool inResult = insideResult(result, p);
+
+            if (delta > 0.0) {
+                if (inRing || d < distance - tolerance) {
+                    QVERIFY2(inResult, qPrintable(QString("iteration %1: (%2, %3) missing from outset")
+                                                      .arg(iteration).arg(p.x()).arg(p.y())));
+                } else if (d > reach + tolerance) {
+                    QVERIFY2(!inResult, qPrintable(QString("iteration %1: (%2, %3) beyond outset")
+                                                       .arg(iteration).arg(p.x()).arg(p.y())));
+                }
+            } else {
+                if (!inRing || d < distance - tolerance) {
+                    QVERIFY2(!inResult, qPrintable(QString("iteration %1: (%2, %3) inside inset margin")
+                                                       .arg(iteration).arg(p.x()).arg(p.y())));
+                } else if (d > reach + tolerance) {
+                    QVERIFY2(inResult, qPrintable(QString("iteration %1: (%2, %3) missing from inset")
+                                                      .arg(iteration).arg(p.x()).arg(p.y())));
+                }
+            }
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestPolygonOffsetter)
+#include "tst_polygonoffsetter.moc"